@@ -3,6 +3,7 @@
 
 #include "core/core.grpc.pb.h"
 #include "mavsdk.h"
+#include "trace.h"
 
 namespace mavsdk {
 namespace backend {
@@ -31,6 +32,7 @@ public:
                     createRpcConnectionStateResponse(system->is_connected());
 
                 std::lock_guard<std::mutex> lock(connection_state_mutex);
+                MAVSDK_TRACE_SCOPE("core.subscribe_connection_state");
                 writer->Write(rpc_connection_state_response);
             }
         });
@@ -6,6 +6,7 @@
 #include "plugins/calibration/calibration.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -163,6 +164,7 @@ public:
                 rpc_response.set_allocated_calibration_result(rpc_calibration_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("calibration.subscribe_calibrate_gyro");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -206,6 +208,7 @@ public:
                 rpc_response.set_allocated_calibration_result(rpc_calibration_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("calibration.subscribe_calibrate_accelerometer");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -249,6 +252,7 @@ public:
                 rpc_response.set_allocated_calibration_result(rpc_calibration_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("calibration.subscribe_calibrate_magnetometer");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -292,6 +296,7 @@ public:
                 rpc_response.set_allocated_calibration_result(rpc_calibration_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("calibration.subscribe_calibrate_level_horizon");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -335,6 +340,7 @@ public:
                 rpc_response.set_allocated_calibration_result(rpc_calibration_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("calibration.subscribe_calibrate_gimbal_accelerometer");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -6,6 +6,7 @@
 #include "plugins/camera/camera.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -688,6 +689,7 @@ public:
                 rpc_response.set_mode(translateToRpcMode(mode));
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("camera.subscribe_mode");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _camera.subscribe_mode(nullptr);
 
@@ -724,6 +726,7 @@ public:
                     translateToRpcInformation(information).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("camera.subscribe_information");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _camera.subscribe_information(nullptr);
 
@@ -760,6 +763,7 @@ public:
                     translateToRpcVideoStreamInfo(video_stream_info).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("camera.subscribe_video_stream_info");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _camera.subscribe_video_stream_info(nullptr);
 
@@ -796,6 +800,7 @@ public:
                     translateToRpcCaptureInfo(capture_info).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("camera.subscribe_capture_info");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _camera.subscribe_capture_info(nullptr);
 
@@ -831,6 +836,7 @@ public:
                 rpc_response.set_allocated_camera_status(translateToRpcStatus(status).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("camera.subscribe_status");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _camera.subscribe_status(nullptr);
 
@@ -869,6 +875,7 @@ public:
                 }
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("camera.subscribe_current_settings");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _camera.subscribe_current_settings(nullptr);
 
@@ -907,6 +914,7 @@ public:
                 }
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("camera.subscribe_possible_setting_options");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _camera.subscribe_possible_setting_options(nullptr);
 
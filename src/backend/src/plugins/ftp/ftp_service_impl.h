@@ -6,6 +6,7 @@
 #include "plugins/ftp/ftp.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -175,6 +176,7 @@ public:
                 rpc_response.set_allocated_ftp_result(rpc_ftp_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("ftp.subscribe_download");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -219,6 +221,7 @@ public:
                 rpc_response.set_allocated_ftp_result(rpc_ftp_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("ftp.subscribe_upload");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -6,6 +6,7 @@
 #include "plugins/log_files/log_files.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -183,6 +184,7 @@ public:
                 rpc_response.set_allocated_log_files_result(rpc_log_files_result);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("log_files.subscribe_download_log_file");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
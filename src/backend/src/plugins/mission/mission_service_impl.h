@@ -6,6 +6,7 @@
 #include "plugins/mission/mission.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -421,6 +422,7 @@ public:
                     translateToRpcMissionProgress(mission_progress).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("mission.subscribe_mission_progress");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _mission.subscribe_mission_progress(nullptr);
 
@@ -6,6 +6,7 @@
 #include "plugins/mission_raw/mission_raw.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -342,6 +343,7 @@ public:
                     translateToRpcMissionProgress(mission_progress).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("mission_raw.subscribe_mission_progress");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _mission_raw.subscribe_mission_progress(nullptr);
 
@@ -377,6 +379,7 @@ public:
                 rpc_response.set_mission_changed(mission_changed);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("mission_raw.subscribe_mission_changed");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _mission_raw.subscribe_mission_changed(nullptr);
 
@@ -6,6 +6,7 @@
 #include "plugins/shell/shell.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -119,6 +120,7 @@ public:
                 rpc_response.set_data(receive);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("shell.subscribe_receive");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _shell.subscribe_receive(nullptr);
 
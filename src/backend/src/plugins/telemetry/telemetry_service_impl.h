@@ -6,6 +6,7 @@
 #include "plugins/telemetry/telemetry.h"
 
 #include "log.h"
+#include "trace.h"
 #include <atomic>
 #include <cmath>
 #include <future>
@@ -1131,6 +1132,7 @@ public:
                 rpc_response.set_allocated_position(translateToRpcPosition(position).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_position");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_position(nullptr);
 
@@ -1166,6 +1168,7 @@ public:
                 rpc_response.set_allocated_home(translateToRpcPosition(home).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_home");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_home(nullptr);
 
@@ -1201,6 +1204,7 @@ public:
                 rpc_response.set_is_in_air(in_air);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_in_air");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_in_air(nullptr);
 
@@ -1236,6 +1240,7 @@ public:
                 rpc_response.set_landed_state(translateToRpcLandedState(landed_state));
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_landed_state");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_landed_state(nullptr);
 
@@ -1271,6 +1276,7 @@ public:
                 rpc_response.set_is_armed(armed);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_armed");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_armed(nullptr);
 
@@ -1307,6 +1313,7 @@ public:
                     translateToRpcQuaternion(attitude_quaternion).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_attitude_quaternion");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_attitude_quaternion(nullptr);
 
@@ -1343,6 +1350,7 @@ public:
                     translateToRpcEulerAngle(attitude_euler).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_attitude_euler");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_attitude_euler(nullptr);
 
@@ -1379,6 +1387,7 @@ public:
                     translateToRpcAngularVelocityBody(attitude_angular_velocity_body).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_attitude_angular_velocity_body");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_attitude_angular_velocity_body(nullptr);
 
@@ -1415,6 +1424,7 @@ public:
                     translateToRpcQuaternion(camera_attitude_quaternion).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_camera_attitude_quaternion");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_camera_attitude_quaternion(nullptr);
 
@@ -1451,6 +1461,7 @@ public:
                     translateToRpcEulerAngle(camera_attitude_euler).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_camera_attitude_euler");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_camera_attitude_euler(nullptr);
 
@@ -1487,6 +1498,7 @@ public:
                     translateToRpcVelocityNed(velocity_ned).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_velocity_ned");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_velocity_ned(nullptr);
 
@@ -1522,6 +1534,7 @@ public:
                 rpc_response.set_allocated_gps_info(translateToRpcGpsInfo(gps_info).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_gps_info");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_gps_info(nullptr);
 
@@ -1557,6 +1570,7 @@ public:
                 rpc_response.set_allocated_battery(translateToRpcBattery(battery).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_battery");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_battery(nullptr);
 
@@ -1592,6 +1606,7 @@ public:
                 rpc_response.set_flight_mode(translateToRpcFlightMode(flight_mode));
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_flight_mode");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_flight_mode(nullptr);
 
@@ -1627,6 +1642,7 @@ public:
                 rpc_response.set_allocated_health(translateToRpcHealth(health).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_health");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_health(nullptr);
 
@@ -1662,6 +1678,7 @@ public:
                 rpc_response.set_allocated_rc_status(translateToRpcRcStatus(rc_status).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_rc_status");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_rc_status(nullptr);
 
@@ -1698,6 +1715,7 @@ public:
                     translateToRpcStatusText(status_text).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_status_text");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_status_text(nullptr);
 
@@ -1734,6 +1752,7 @@ public:
                     translateToRpcActuatorControlTarget(actuator_control_target).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_actuator_control_target");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_actuator_control_target(nullptr);
 
@@ -1770,6 +1789,7 @@ public:
                     translateToRpcActuatorOutputStatus(actuator_output_status).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_actuator_output_status");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_actuator_output_status(nullptr);
 
@@ -1805,6 +1825,7 @@ public:
                 rpc_response.set_allocated_odometry(translateToRpcOdometry(odometry).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_odometry");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_odometry(nullptr);
 
@@ -1841,6 +1862,7 @@ public:
                     translateToRpcPositionVelocityNed(position_velocity_ned).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_position_velocity_ned");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_position_velocity_ned(nullptr);
 
@@ -1877,6 +1899,7 @@ public:
                     translateToRpcGroundTruth(ground_truth).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_ground_truth");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_ground_truth(nullptr);
 
@@ -1913,6 +1936,7 @@ public:
                     translateToRpcFixedwingMetrics(fixedwing_metrics).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_fixedwing_metrics");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_fixedwing_metrics(nullptr);
 
@@ -1948,6 +1972,7 @@ public:
                 rpc_response.set_allocated_imu(translateToRpcImu(imu).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_imu");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_imu(nullptr);
 
@@ -1983,6 +2008,7 @@ public:
                 rpc_response.set_is_health_all_ok(health_all_ok);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_health_all_ok");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_health_all_ok(nullptr);
 
@@ -2018,6 +2044,7 @@ public:
                 rpc_response.set_time_us(unix_epoch_time);
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_unix_epoch_time");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_unix_epoch_time(nullptr);
 
@@ -2054,6 +2081,7 @@ public:
                     translateToRpcDistanceSensor(distance_sensor).release());
 
                 std::unique_lock<std::mutex> lock(subscribe_mutex);
+                MAVSDK_TRACE_SCOPE("telemetry.subscribe_distance_sensor");
                 if (!*is_finished && !writer->Write(rpc_response)) {
                     _telemetry.subscribe_distance_sensor(nullptr);
 
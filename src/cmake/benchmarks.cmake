@@ -0,0 +1,38 @@
+include_directories(${PROJECT_SOURCE_DIR}/core)
+include_directories(${PROJECT_SOURCE_DIR}/third_party/mavlink/include)
+
+find_package(benchmark REQUIRED)
+
+add_executable(benchmarks
+    ${BENCHMARK_SOURCES}
+)
+
+set_target_properties(benchmarks
+    PROPERTIES COMPILE_FLAGS ${warnings}
+)
+
+target_link_libraries(benchmarks
+    mavsdk
+    mavsdk_ftp
+    mavsdk_camera
+    mavsdk_mission
+    mavsdk_geofence
+    mavsdk_telemetry
+    JsonCpp::jsoncpp
+    benchmark::benchmark
+    benchmark::benchmark_main
+)
+
+# The benchmarks read their test files relative to the root of the repository.
+set(BENCHMARKS_JSON_OUTPUT ${CMAKE_BINARY_DIR}/benchmarks.json CACHE FILEPATH
+    "Where run_benchmarks writes the results to")
+
+add_custom_target(run_benchmarks
+    COMMAND benchmarks
+        --benchmark_out=${BENCHMARKS_JSON_OUTPUT}
+        --benchmark_out_format=json
+    WORKING_DIRECTORY ${PROJECT_SOURCE_DIR}/..
+    DEPENDS benchmarks
+    COMMENT "Running benchmarks, results in ${BENCHMARKS_JSON_OUTPUT}"
+    USES_TERMINAL
+)
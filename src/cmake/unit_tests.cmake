@@ -1,8 +1,6 @@
 include_directories(${PROJECT_SOURCE_DIR}/core)
 include_directories(${PROJECT_SOURCE_DIR}/third_party/mavlink/include)
 
-find_package(JsonCpp REQUIRED)
-
 add_executable(unit_tests_runner
     ${UNIT_TEST_SOURCES}
 )
@@ -16,10 +14,13 @@ set_target_properties(unit_tests_runner
 target_link_libraries(unit_tests_runner
     mavsdk
     mavsdk_mission
+    mavsdk_geofence
     mavsdk_camera
     mavsdk_calibration
+    mavsdk_ftp
     mavsdk_telemetry
     CURL::libcurl
+    ${CMAKE_DL_LIBS}
     JsonCpp::jsoncpp
     gtest
     gtest_main
@@ -0,0 +1,167 @@
+#include "async_message_sender.h"
+#include <algorithm>
+
+namespace mavsdk {
+
+AsyncMessageSender::AsyncMessageSender(
+    const SendMessagesCallback& send_messages, size_t capacity) :
+    _send_messages(send_messages),
+    _queue(capacity)
+{
+    _thread = new std::thread(&AsyncMessageSender::run, this);
+}
+
+AsyncMessageSender::~AsyncMessageSender()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wake_mutex);
+        _should_exit = true;
+    }
+    _wake_cv.notify_one();
+
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+}
+
+void AsyncMessageSender::send_message(
+    const mavlink_message_t& message, uint64_t timestamp_us, bool coalesce)
+{
+    Item item{};
+    item.message = message;
+    item.timestamp_us = timestamp_us;
+    item.handed_over = Clock::now();
+    item.target = target_of(message);
+    item.coalesce = coalesce;
+
+    // Make space by dropping the oldest messages, the new ones are more useful.
+    while (!_queue.try_push(item)) {
+        Item dropped;
+        if (_queue.try_pop(dropped)) {
+            ++_num_dropped;
+        }
+    }
+
+    {
+        // Only held briefly, and never while sending.
+        std::lock_guard<std::mutex> lock(_wake_mutex);
+        _has_new = true;
+    }
+    _wake_cv.notify_one();
+}
+
+uint16_t AsyncMessageSender::target_of(const mavlink_message_t& message)
+{
+    const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(message.msgid);
+    if (entry == nullptr) {
+        return 0;
+    }
+
+    // MAVLink 2 cuts off trailing zeros, so the fields might be missing.
+    const auto* payload = reinterpret_cast<const uint8_t*>(message.payload64);
+    uint8_t target_system = 0;
+    uint8_t target_component = 0;
+    if ((entry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM) != 0 &&
+        entry->target_system_ofs < message.len) {
+        target_system = payload[entry->target_system_ofs];
+    }
+    if ((entry->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_COMPONENT) != 0 &&
+        entry->target_component_ofs < message.len) {
+        target_component = payload[entry->target_component_ofs];
+    }
+    return static_cast<uint16_t>((target_system << 8) | target_component);
+}
+
+AsyncMessageSender::Stats AsyncMessageSender::stats() const
+{
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    Stats stats = _stats;
+    stats.num_dropped = _num_dropped;
+    return stats;
+}
+
+void AsyncMessageSender::run()
+{
+    std::vector<Item> batch;
+    batch.reserve(_queue.capacity());
+    std::vector<mavlink_message_t> messages;
+    messages.reserve(_queue.capacity());
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_wake_mutex);
+            _wake_cv.wait(lock, [this]() { return _has_new || _should_exit; });
+            if (_should_exit) {
+                break;
+            }
+            _has_new = false;
+        }
+
+        collect_batch(batch);
+        if (!batch.empty()) {
+            send_batch(batch, messages);
+        }
+    }
+}
+
+void AsyncMessageSender::collect_batch(std::vector<Item>& batch)
+{
+    batch.clear();
+    Item item;
+    while (_queue.try_pop(item)) {
+        batch.push_back(item);
+    }
+
+    std::stable_sort(batch.begin(), batch.end(), [](const Item& lhs, const Item& rhs) {
+        return lhs.timestamp_us < rhs.timestamp_us;
+    });
+
+    // Only the newest message of each type to each target is worth sending.
+    // Batches are small, so looking through the later ones is cheap enough.
+    size_t num_kept = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const Item& current = batch[i];
+        const bool superseded =
+            current.coalesce &&
+            std::any_of(batch.begin() + i + 1, batch.end(), [&current](const Item& later) {
+                return later.coalesce && later.message.msgid == current.message.msgid &&
+                       later.target == current.target;
+            });
+        if (superseded) {
+            ++_num_dropped;
+            continue;
+        }
+        batch[num_kept++] = batch[i];
+    }
+    batch.resize(num_kept);
+}
+
+void AsyncMessageSender::send_batch(
+    const std::vector<Item>& batch, std::vector<mavlink_message_t>& messages)
+{
+    messages.clear();
+    for (const auto& item : batch) {
+        messages.push_back(item.message);
+    }
+
+    const bool success = _send_messages(messages);
+    const auto now = Clock::now();
+
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    ++_stats.num_batches;
+    if (!success) {
+        ++_stats.num_send_failures;
+        return;
+    }
+
+    for (const auto& item : batch) {
+        const double latency_us =
+            std::chrono::duration<double, std::micro>(now - item.handed_over).count();
+        ++_stats.num_sent;
+        _latency_sum_us += latency_us;
+        _stats.latency_max_us = std::max(_stats.latency_max_us, latency_us);
+    }
+    _stats.latency_mean_us = _latency_sum_us / static_cast<double>(_stats.num_sent);
+}
+
+} // namespace mavsdk
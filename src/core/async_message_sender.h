@@ -0,0 +1,91 @@
+#pragma once
+
+#include "bounded_queue.h"
+#include "mavlink_include.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mavsdk {
+
+// Sends messages from a thread of its own, so that callers producing
+// messages at a high rate are not held up by the connections.
+//
+// Messages are handed over through a bounded queue. If the queue is full,
+// the oldest message is dropped. All messages pending when the thread wakes
+// up are sent as one batch, ordered by their timestamps. Older messages of
+// the same type and to the same target system and component in a batch are
+// superseded by the newest one and dropped.
+class AsyncMessageSender {
+public:
+    using SendMessagesCallback = std::function<bool(std::vector<mavlink_message_t>&)>;
+
+    explicit AsyncMessageSender(
+        const SendMessagesCallback& send_messages, size_t capacity = DEFAULT_CAPACITY);
+    ~AsyncMessageSender();
+
+    // Can be called from any thread. Messages which must all arrive, e.g.
+    // commands, are sent with coalesce set to false. They neither supersede
+    // others nor are superseded.
+    void send_message(
+        const mavlink_message_t& message, uint64_t timestamp_us, bool coalesce = true);
+
+    struct Stats {
+        uint64_t num_sent{0};
+        uint64_t num_dropped{0};
+        uint64_t num_batches{0};
+        uint64_t num_send_failures{0};
+        // From handing a message over until it was written to the connections.
+        double latency_mean_us{0.0};
+        double latency_max_us{0.0};
+    };
+
+    Stats stats() const;
+
+    static constexpr size_t DEFAULT_CAPACITY = 32;
+
+    // Non-copyable
+    AsyncMessageSender(const AsyncMessageSender&) = delete;
+    const AsyncMessageSender& operator=(const AsyncMessageSender&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Item {
+        mavlink_message_t message{};
+        uint64_t timestamp_us{0};
+        Clock::time_point handed_over{};
+        // Target system and component, 0 for broadcast.
+        uint16_t target{0};
+        bool coalesce{true};
+    };
+
+    static uint16_t target_of(const mavlink_message_t& message);
+
+    void run();
+    void collect_batch(std::vector<Item>& batch);
+    void send_batch(const std::vector<Item>& batch, std::vector<mavlink_message_t>& messages);
+
+    SendMessagesCallback _send_messages;
+
+    BoundedQueue<Item> _queue;
+    std::atomic<uint64_t> _num_dropped{0};
+
+    std::mutex _wake_mutex{};
+    std::condition_variable _wake_cv{};
+    bool _has_new{false};
+    bool _should_exit{false};
+
+    mutable std::mutex _stats_mutex{};
+    Stats _stats{};
+    double _latency_sum_us{0.0};
+
+    std::thread* _thread{nullptr};
+};
+
+} // namespace mavsdk
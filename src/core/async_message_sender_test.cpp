@@ -0,0 +1,195 @@
+#include "async_message_sender.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+// Records the batches, and can hold up sending to build a backlog.
+class FakeConnection {
+public:
+    AsyncMessageSender::SendMessagesCallback callback()
+    {
+        return [this](std::vector<mavlink_message_t>& messages) {
+            std::unique_lock<std::mutex> lock(mutex);
+            batches.push_back(messages);
+            cv.notify_all();
+            cv.wait(lock, [this]() { return !blocked; });
+            return true;
+        };
+    }
+
+    void unblock()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocked = false;
+        cv.notify_all();
+    }
+
+    bool wait_for_batches(size_t num)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(
+            lock, std::chrono::seconds(1), [this, num]() { return batches.size() >= num; });
+    }
+
+    std::mutex mutex{};
+    std::condition_variable cv{};
+    bool blocked{false};
+    std::vector<std::vector<mavlink_message_t>> batches{};
+};
+
+static mavlink_message_t make_message(uint32_t message_id, uint8_t sequence)
+{
+    mavlink_message_t message{};
+    message.msgid = message_id;
+    message.seq = sequence;
+    return message;
+}
+
+TEST(AsyncMessageSender, SendsRightAway)
+{
+    FakeConnection connection;
+    AsyncMessageSender sender(connection.callback());
+
+    sender.send_message(make_message(102, 0), 1000);
+    ASSERT_TRUE(connection.wait_for_batches(1));
+
+    {
+        std::lock_guard<std::mutex> lock(connection.mutex);
+        ASSERT_EQ(connection.batches[0].size(), 1);
+        EXPECT_EQ(connection.batches[0][0].msgid, 102);
+    }
+
+    // The stats are updated once sending returned.
+    auto stats = sender.stats();
+    for (int i = 0; i < 100 && stats.num_sent == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        stats = sender.stats();
+    }
+    EXPECT_EQ(stats.num_sent, 1);
+    EXPECT_EQ(stats.num_dropped, 0);
+    EXPECT_EQ(stats.num_batches, 1);
+    EXPECT_GE(stats.latency_max_us, stats.latency_mean_us);
+}
+
+TEST(AsyncMessageSender, BatchesBacklogOrderedAndSuperseded)
+{
+    FakeConnection connection;
+    connection.blocked = true;
+    AsyncMessageSender sender(connection.callback());
+
+    // The first one holds up the sender, the others pile up meanwhile.
+    sender.send_message(make_message(102, 0), 1000);
+    ASSERT_TRUE(connection.wait_for_batches(1));
+
+    sender.send_message(make_message(331, 1), 3000);
+    sender.send_message(make_message(102, 2), 2000);
+    sender.send_message(make_message(102, 3), 4000);
+    sender.send_message(make_message(138, 4), 2500);
+
+    connection.unblock();
+    ASSERT_TRUE(connection.wait_for_batches(2));
+
+    std::lock_guard<std::mutex> lock(connection.mutex);
+    const auto& batch = connection.batches[1];
+    ASSERT_EQ(batch.size(), 3);
+    EXPECT_EQ(batch[0].seq, 4);
+    EXPECT_EQ(batch[1].seq, 1);
+    EXPECT_EQ(batch[2].seq, 3);
+
+    EXPECT_EQ(sender.stats().num_dropped, 1);
+}
+
+static mavlink_message_t
+make_command(uint8_t target_system, uint8_t target_component, uint8_t sequence)
+{
+    mavlink_message_t message{};
+    mavlink_msg_command_long_pack(
+        1, 190, &message, target_system, target_component, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    message.seq = sequence;
+    return message;
+}
+
+TEST(AsyncMessageSender, SupersedesOnlyForSameTarget)
+{
+    FakeConnection connection;
+    connection.blocked = true;
+    AsyncMessageSender sender(connection.callback());
+
+    sender.send_message(make_message(102, 0), 0);
+    ASSERT_TRUE(connection.wait_for_batches(1));
+
+    sender.send_message(make_command(1, 1, 1), 1);
+    sender.send_message(make_command(2, 1, 2), 2);
+    sender.send_message(make_command(1, 100, 3), 3);
+    sender.send_message(make_command(1, 1, 4), 4);
+
+    connection.unblock();
+    ASSERT_TRUE(connection.wait_for_batches(2));
+
+    std::lock_guard<std::mutex> lock(connection.mutex);
+    const auto& batch = connection.batches[1];
+    ASSERT_EQ(batch.size(), 3);
+    EXPECT_EQ(batch[0].seq, 2);
+    EXPECT_EQ(batch[1].seq, 3);
+    EXPECT_EQ(batch[2].seq, 4);
+
+    EXPECT_EQ(sender.stats().num_dropped, 1);
+}
+
+TEST(AsyncMessageSender, NeverSupersedesWithoutCoalesce)
+{
+    FakeConnection connection;
+    connection.blocked = true;
+    AsyncMessageSender sender(connection.callback());
+
+    sender.send_message(make_message(102, 0), 0);
+    ASSERT_TRUE(connection.wait_for_batches(1));
+
+    sender.send_message(make_command(1, 1, 1), 1, false);
+    sender.send_message(make_command(1, 1, 2), 2);
+    sender.send_message(make_command(1, 1, 3), 3, false);
+    sender.send_message(make_command(1, 1, 4), 4);
+
+    connection.unblock();
+    ASSERT_TRUE(connection.wait_for_batches(2));
+
+    std::lock_guard<std::mutex> lock(connection.mutex);
+    const auto& batch = connection.batches[1];
+    ASSERT_EQ(batch.size(), 3);
+    EXPECT_EQ(batch[0].seq, 1);
+    EXPECT_EQ(batch[1].seq, 3);
+    EXPECT_EQ(batch[2].seq, 4);
+
+    EXPECT_EQ(sender.stats().num_dropped, 1);
+}
+
+TEST(AsyncMessageSender, DropsOldestIfFull)
+{
+    FakeConnection connection;
+    connection.blocked = true;
+    AsyncMessageSender sender(connection.callback(), 4);
+
+    sender.send_message(make_message(0, 0), 0);
+    ASSERT_TRUE(connection.wait_for_batches(1));
+
+    // Different types, so none is superseded.
+    for (uint8_t i = 1; i <= 6; ++i) {
+        sender.send_message(make_message(i, i), i);
+    }
+
+    connection.unblock();
+    ASSERT_TRUE(connection.wait_for_batches(2));
+
+    std::lock_guard<std::mutex> lock(connection.mutex);
+    const auto& batch = connection.batches[1];
+    ASSERT_EQ(batch.size(), 4);
+    EXPECT_EQ(batch[0].seq, 3);
+    EXPECT_EQ(batch[3].seq, 6);
+
+    EXPECT_EQ(sender.stats().num_dropped, 2);
+}
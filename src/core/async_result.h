@@ -0,0 +1,185 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define MAVSDK_HAS_COROUTINES 1
+#endif
+#endif
+
+#include "thread_pool.h"
+
+namespace mavsdk {
+
+// The outcome of an asynchronous call, to continue with once it is there,
+// instead of blocking a thread until then.
+//
+// It is made from any of the `_async` functions which take a callback:
+//
+//     auto upload = async_call<Geofence::Result>(
+//         [&](auto callback) { geofence.upload_geofence_async(polygons, callback); });
+//
+// With C++20 coroutines it can be awaited. The coroutine is suspended in the
+// meantime, so it doesn't take up a thread:
+//
+//     const Geofence::Result result = co_await upload;
+//
+// Otherwise, a callback is set with then(). Either of them is only set once.
+// They are resumed or called from the thread completing the call, usually the
+// user callback thread, or posted to a thread pool if one is set with on().
+//
+// The value is the argument of the callback or, for several arguments, a
+// tuple of them. Only the first call of the callback counts.
+template<typename... Args> class AsyncResult {
+public:
+    static_assert(sizeof...(Args) > 0, "The callback needs to have arguments");
+
+    using Callback = std::function<void(Args...)>;
+    using Value = typename std::conditional<
+        sizeof...(Args) == 1,
+        typename std::tuple_element<0, std::tuple<Args...>>::type,
+        std::tuple<Args...>>::type;
+
+    AsyncResult() : _state(std::make_shared<State>()) {}
+    ~AsyncResult() = default;
+
+    // The callback to pass to the asynchronous call.
+    Callback callback() const
+    {
+        auto state = _state;
+        return [state](Args... args) { state->complete(Value{std::move(args)...}); };
+    }
+
+    // Continues on the thread pool given, which has to outlive the call.
+    AsyncResult& on(ThreadPool& thread_pool)
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->thread_pool = &thread_pool;
+        return *this;
+    }
+
+    void then(const std::function<void(Value)>& callback)
+    {
+        auto state = _state;
+        const std::function<void()> continuation = [state, callback]() {
+            callback(state->take());
+        };
+        if (!_state->set_continuation(continuation)) {
+            continuation();
+        }
+    }
+
+    bool is_done() const
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        return _state->value.has_value();
+    }
+
+    // Blocks until done. Not to be used on the thread which completes the
+    // call, such as the user callback thread.
+    Value get()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_state->mutex);
+            _state->done_cv.wait(lock, [this]() { return _state->value.has_value(); });
+        }
+        return _state->take();
+    }
+
+#if defined(MAVSDK_HAS_COROUTINES)
+    bool await_ready() const { return is_done(); }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        return _state->set_continuation([handle]() { handle.resume(); });
+    }
+
+    Value await_resume() { return _state->take(); }
+#endif
+
+private:
+    struct State {
+        std::mutex mutex{};
+        std::condition_variable done_cv{};
+        std::optional<Value> value{};
+        std::function<void()> continuation{};
+        ThreadPool* thread_pool{nullptr};
+
+        void complete(Value&& new_value)
+        {
+            std::function<void()> to_continue;
+            ThreadPool* pool;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (value.has_value()) {
+                    return;
+                }
+                value.emplace(std::move(new_value));
+                to_continue = std::move(continuation);
+                pool = thread_pool;
+            }
+            done_cv.notify_all();
+            run(to_continue, pool);
+        }
+
+        // Returns false, without keeping it, if done already and the
+        // continuation is to go ahead right away on the calling thread.
+        bool set_continuation(const std::function<void()>& new_continuation)
+        {
+            ThreadPool* pool;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!value.has_value()) {
+                    continuation = new_continuation;
+                    return true;
+                }
+                pool = thread_pool;
+            }
+            if (pool != nullptr) {
+                // Still go through the pool, as promised.
+                pool->post(new_continuation);
+                return true;
+            }
+            return false;
+        }
+
+        Value take()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return std::move(*value);
+        }
+
+        static void run(const std::function<void()>& to_continue, ThreadPool* pool)
+        {
+            if (!to_continue) {
+                return;
+            }
+            if (pool != nullptr) {
+                pool->post(to_continue);
+            } else {
+                to_continue();
+            }
+        }
+    };
+
+    std::shared_ptr<State> _state;
+};
+
+// Starts an asynchronous call, start is given the callback to pass to it.
+template<typename... Args, typename Start> AsyncResult<Args...> async_call(Start&& start)
+{
+    AsyncResult<Args...> result;
+    start(result.callback());
+    return result;
+}
+
+} // namespace mavsdk
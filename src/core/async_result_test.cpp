@@ -0,0 +1,176 @@
+#include "async_result.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+enum class Result { Success, Timeout };
+
+using ResultCallback = std::function<void(Result)>;
+using EntriesCallback = std::function<void(Result, std::vector<std::string>)>;
+
+// Like the `_async` functions of the plugins, completes on a thread of its own.
+class FakePlugin {
+public:
+    ~FakePlugin()
+    {
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    void do_async(const ResultCallback& callback)
+    {
+        _threads.emplace_back([callback]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            callback(Result::Success);
+        });
+    }
+
+    void get_entries_async(const EntriesCallback& callback)
+    {
+        _threads.emplace_back([callback]() { callback(Result::Timeout, {"a", "b"}); });
+    }
+
+private:
+    std::vector<std::thread> _threads{};
+};
+
+} // namespace
+
+TEST(AsyncResult, Gets)
+{
+    FakePlugin plugin;
+    auto result = async_call<Result>([&](auto callback) { plugin.do_async(callback); });
+    EXPECT_EQ(result.get(), Result::Success);
+    EXPECT_TRUE(result.is_done());
+}
+
+TEST(AsyncResult, GetsTupleOfSeveralArguments)
+{
+    FakePlugin plugin;
+    auto result = async_call<Result, std::vector<std::string>>(
+        [&](auto callback) { plugin.get_entries_async(callback); });
+
+    const auto value = result.get();
+    EXPECT_EQ(std::get<0>(value), Result::Timeout);
+    EXPECT_EQ(std::get<1>(value), (std::vector<std::string>{"a", "b"}));
+}
+
+TEST(AsyncResult, CallsThenWhenDone)
+{
+    FakePlugin plugin;
+    std::atomic<bool> called{false};
+    const auto caller = std::this_thread::get_id();
+    std::thread::id called_on;
+
+    auto result = async_call<Result>([&](auto callback) { plugin.do_async(callback); });
+    result.then([&](Result value) {
+        EXPECT_EQ(value, Result::Success);
+        called_on = std::this_thread::get_id();
+        called = true;
+    });
+
+    for (int i = 0; i < 100 && !called; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(called);
+    EXPECT_NE(called_on, caller);
+}
+
+TEST(AsyncResult, CallsThenRightAwayIfDone)
+{
+    auto result = async_call<Result>([](auto callback) { callback(Result::Success); });
+
+    bool called = false;
+    result.then([&called](Result value) {
+        EXPECT_EQ(value, Result::Success);
+        called = true;
+    });
+    EXPECT_TRUE(called);
+}
+
+TEST(AsyncResult, IgnoresLaterCalls)
+{
+    auto result = async_call<Result>([](auto callback) {
+        callback(Result::Timeout);
+        callback(Result::Success);
+    });
+    EXPECT_EQ(result.get(), Result::Timeout);
+}
+
+TEST(AsyncResult, ContinuesOnThreadPool)
+{
+    ThreadPool thread_pool(2);
+    FakePlugin plugin;
+
+    // Many pending calls, without a blocked thread for each of them.
+    constexpr int num_calls = 1000;
+    std::atomic<int> num_done{0};
+    std::vector<AsyncResult<Result>> results;
+    for (int i = 0; i < num_calls; ++i) {
+        AsyncResult<Result> result;
+        result.on(thread_pool).then([&num_done](Result value) {
+            if (value == Result::Success) {
+                ++num_done;
+            }
+        });
+        results.push_back(result);
+    }
+    for (auto& result : results) {
+        result.callback()(Result::Success);
+    }
+
+    for (int i = 0; i < 100 && num_done < num_calls; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(num_done, num_calls);
+}
+
+#if defined(MAVSDK_HAS_COROUTINES)
+
+namespace {
+
+// Just enough of a coroutine type to start one and let it run on its own.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+Detached upload_twice(FakePlugin& plugin, std::atomic<int>& num_done)
+{
+    for (int i = 0; i < 2; ++i) {
+        const Result result =
+            co_await async_call<Result>([&](auto callback) { plugin.do_async(callback); });
+        if (result == Result::Success) {
+            ++num_done;
+        }
+    }
+}
+
+} // namespace
+
+TEST(AsyncResult, Awaits)
+{
+    FakePlugin plugin;
+    std::atomic<int> num_done{0};
+    upload_twice(plugin, num_done);
+
+    for (int i = 0; i < 100 && num_done < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(num_done, 2);
+}
+
+#endif
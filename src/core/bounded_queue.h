@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace mavsdk {
+
+// A fixed size queue which does not lock and does not allocate after
+// construction. Any thread can push or pop.
+//
+// Every slot carries a sequence number which tells whether it is ready to
+// be written or read in the current round, see Dmitry Vyukov's bounded
+// MPMC queue.
+template<typename T> class BoundedQueue {
+public:
+    // The capacity is rounded up to a power of two.
+    explicit BoundedQueue(size_t capacity) :
+        _mask(round_up_to_power_of_two(capacity) - 1),
+        _slots(new Slot[_mask + 1])
+    {
+        for (size_t i = 0; i <= _mask; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~BoundedQueue() = default;
+
+    // Returns false if the queue is full, the item is left untouched then.
+    bool try_push(const T& item) { return push(item); }
+    bool try_push(T&& item) { return push(std::move(item)); }
+
+    // Returns false if the queue is empty.
+    bool try_pop(T& item)
+    {
+        size_t pos = _pop_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &_slots[pos & _mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _pop_pos.load(std::memory_order_relaxed);
+            }
+        }
+        item = std::move(slot->item);
+        slot->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // Non-copyable
+    BoundedQueue(const BoundedQueue&) = delete;
+    const BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        T item{};
+    };
+
+    template<typename U> bool push(U&& item)
+    {
+        size_t pos = _push_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &_slots[pos & _mask];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _push_pos.load(std::memory_order_relaxed);
+            }
+        }
+        slot->item = std::forward<U>(item);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    static size_t round_up_to_power_of_two(size_t value)
+    {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+
+    // On separate cache lines, so pushing and popping don't slow each other down.
+    alignas(64) std::atomic<size_t> _push_pos{0};
+    alignas(64) std::atomic<size_t> _pop_pos{0};
+};
+
+} // namespace mavsdk
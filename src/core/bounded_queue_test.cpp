@@ -0,0 +1,66 @@
+#include "bounded_queue.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+TEST(BoundedQueue, FillAndEmpty)
+{
+    BoundedQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4);
+
+    int item = 0;
+    EXPECT_FALSE(queue.try_pop(item));
+
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(5));
+
+    EXPECT_TRUE(queue.try_pop(item));
+    EXPECT_EQ(item, 1);
+    EXPECT_TRUE(queue.try_push(5));
+
+    for (int i = 2; i <= 5; ++i) {
+        EXPECT_TRUE(queue.try_pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(queue.try_pop(item));
+}
+
+TEST(BoundedQueue, PassesEverythingBetweenThreads)
+{
+    BoundedQueue<uint64_t> queue(16);
+    const uint64_t num_items = 100000;
+    const unsigned num_producers = 3;
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue, num_items]() {
+            for (uint64_t i = 1; i <= num_items; ++i) {
+                while (!queue.try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint64_t sum = 0;
+    uint64_t num_popped = 0;
+    while (num_popped < num_items * num_producers) {
+        uint64_t item;
+        if (queue.try_pop(item)) {
+            sum += item;
+            ++num_popped;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(sum, num_producers * num_items * (num_items + 1) / 2);
+}
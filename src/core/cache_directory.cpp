@@ -0,0 +1,76 @@
+#include "cache_directory.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(WINDOWS)
+#include <direct.h>
+#define mkdir(D, M) _mkdir(D)
+#endif
+
+namespace mavsdk {
+
+std::string default_cache_directory(const std::string& name)
+{
+#if defined(WINDOWS)
+    const std::string separator = "\\";
+#else
+    const std::string separator = "/";
+#endif
+
+    if (const char* env_p = std::getenv("MAVSDK_CACHE_DIR")) {
+        return std::string(env_p) + separator + name;
+    }
+
+#if defined(WINDOWS)
+    if (const char* env_p = std::getenv("LOCALAPPDATA")) {
+        return std::string(env_p) + "\\mavsdk\\" + name;
+    }
+#elif defined(ANDROID) || defined(IOS)
+    // There is no reliable cache directory to use without the app telling us.
+#else
+    if (const char* env_p = std::getenv("XDG_CACHE_HOME")) {
+        return std::string(env_p) + "/mavsdk/" + name;
+    }
+    if (const char* env_p = std::getenv("HOME")) {
+        return std::string(env_p) + "/.cache/mavsdk/" + name;
+    }
+#endif
+    return {};
+}
+
+bool create_cache_directory(const std::string& path)
+{
+    if (path.empty()) {
+        return false;
+    }
+
+    for (std::size_t pos = path.find_first_of("/\\", 1); pos != std::string::npos;
+         pos = path.find_first_of("/\\", pos + 1)) {
+        mkdir(path.substr(0, pos).c_str(), 0755);
+    }
+    mkdir(path.c_str(), 0755);
+
+    struct stat buffer;
+    return stat(path.c_str(), &buffer) == 0 && (buffer.st_mode & S_IFDIR) != 0;
+}
+
+std::string cache_file_name(const std::string& key)
+{
+    // FNV-1a, users need to store and compare the key itself to rule out
+    // collisions.
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : key) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+
+    char name[17];
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return name;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+namespace mavsdk {
+
+// Returns the directory where MAVSDK can cache things named name, e.g.
+// ~/.cache/mavsdk/<name> on Linux. The base directory can be overridden using
+// the environment variable MAVSDK_CACHE_DIR.
+//
+// Returns an empty string if there is no suitable directory in which case
+// caching should be skipped.
+std::string default_cache_directory(const std::string& name);
+
+// Creates the directory including all its parents.
+bool create_cache_directory(const std::string& path);
+
+// Short, file name safe, hash of a key such as a URL.
+std::string cache_file_name(const std::string& key);
+
+} // namespace mavsdk
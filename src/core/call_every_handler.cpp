@@ -1,4 +1,5 @@
 #include "call_every_handler.h"
+#include "log.h"
 
 namespace mavsdk {
 
@@ -8,24 +9,28 @@ CallEveryHandler::~CallEveryHandler() {}
 
 void CallEveryHandler::add(std::function<void()> callback, double interval_s, void** cookie)
 {
-    auto new_entry = std::make_shared<Entry>();
-    new_entry->callback = callback;
+    Entry new_entry;
+    new_entry.callback = std::move(callback);
     auto before = _time.steady_time();
     // Make sure it gets run straightaway. The epsilon seemed not enough so
     // we use the arbitrary value of 1 ms.
     _time.shift_steady_time_by(before, -interval_s - 0.001);
-    new_entry->last_time = before;
-    new_entry->interval_s = interval_s;
-
-    void* new_cookie = static_cast<void*>(new_entry.get());
+    new_entry.last_time = before;
+    new_entry.interval_s = interval_s;
 
+    TimerWheel<Entry>::Handle handle;
     {
         std::lock_guard<std::mutex> lock(_entries_mutex);
-        _entries.insert(std::pair<void*, std::shared_ptr<Entry>>(new_cookie, new_entry));
+        const auto time = next_time(new_entry);
+        handle = _entries.add(std::move(new_entry), time);
+    }
+
+    if (handle == TimerWheel<Entry>::INVALID_HANDLE) {
+        LogErr() << "Too many call every entries";
     }
 
     if (cookie != nullptr) {
-        *cookie = new_cookie;
+        *cookie = reinterpret_cast<void*>(handle);
     }
 }
 
@@ -33,9 +38,13 @@ void CallEveryHandler::change(double interval_s, const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_entries_mutex);
 
-    auto it = _entries.find(const_cast<void*>(cookie));
-    if (it != _entries.end()) {
-        it->second->interval_s = interval_s;
+    const auto handle = reinterpret_cast<TimerWheel<Entry>::Handle>(cookie);
+    Entry* entry = _entries.get(handle);
+    if (entry != nullptr) {
+        entry->interval_s = interval_s;
+        if (!_entries.is_expired(handle)) {
+            _entries.reschedule(handle, next_time(*entry));
+        }
     }
 }
 
@@ -43,9 +52,13 @@ void CallEveryHandler::reset(const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_entries_mutex);
 
-    auto it = _entries.find(const_cast<void*>(cookie));
-    if (it != _entries.end()) {
-        it->second->last_time = _time.steady_time();
+    const auto handle = reinterpret_cast<TimerWheel<Entry>::Handle>(cookie);
+    Entry* entry = _entries.get(handle);
+    if (entry != nullptr) {
+        entry->last_time = _time.steady_time();
+        if (!_entries.is_expired(handle)) {
+            _entries.reschedule(handle, next_time(*entry));
+        }
     }
 }
 
@@ -53,40 +66,44 @@ void CallEveryHandler::remove(const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_entries_mutex);
 
-    auto it = _entries.find(const_cast<void*>(cookie));
-    if (it != _entries.end()) {
-        _entries.erase(const_cast<void*>(cookie));
-        _iterator_invalidated = true;
-    }
+    _entries.remove(reinterpret_cast<TimerWheel<Entry>::Handle>(cookie));
 }
 
 void CallEveryHandler::run_once()
 {
-    _entries_mutex.lock();
+    std::vector<TimerWheel<Entry>::Handle> expired;
 
-    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
-        if (_time.elapsed_since_s(it->second->last_time) > double(it->second->interval_s)) {
-            _time.shift_steady_time_by(it->second->last_time, double(it->second->interval_s));
+    std::unique_lock<std::mutex> lock(_entries_mutex);
 
-            if (it->second->callback) {
-                // Get a copy for the callback because we unlock.
-                std::function<void()> callback = it->second->callback;
+    _entries.collect_expired(_time.steady_time(), expired);
 
-                // Unlock while we callback because it might in turn want to add timeouts.
-                _entries_mutex.unlock();
-                callback();
-                _entries_mutex.lock();
-            }
+    for (const auto handle : expired) {
+        // An earlier callback might have removed it.
+        if (!_entries.is_expired(handle)) {
+            continue;
         }
 
-        // We leave the loop.
-        // FIXME: there should be a nicer way to do this.
-        if (_iterator_invalidated) {
-            _iterator_invalidated = false;
-            break;
+        Entry* entry = _entries.get(handle);
+        _time.shift_steady_time_by(entry->last_time, double(entry->interval_s));
+        _entries.reschedule(handle, next_time(*entry));
+
+        if (entry->callback) {
+            // Get a copy for the callback because we unlock.
+            std::function<void()> callback = entry->callback;
+
+            // Unlock while we callback because it might in turn want to add timeouts.
+            lock.unlock();
+            callback();
+            lock.lock();
         }
     }
-    _entries_mutex.unlock();
+}
+
+dl_time_t CallEveryHandler::next_time(const Entry& entry)
+{
+    // Due once more than the interval has passed.
+    return entry.last_time + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::duration<double>(entry.interval_s));
 }
 
 } // namespace mavsdk
@@ -1,10 +1,9 @@
 #pragma once
 
 #include <mutex>
-#include <memory>
 #include <functional>
-#include <unordered_map>
 #include "global_include.h"
+#include "timer_wheel.h"
 
 namespace mavsdk {
 
@@ -19,6 +18,8 @@ public:
     CallEveryHandler& operator=(CallEveryHandler const&) = delete; // Copy assign
     CallEveryHandler& operator=(CallEveryHandler&&) = delete; // Move assign
 
+    // The cookie is a handle of the timer wheel, it stays invalid once the
+    // entry has been removed.
     void add(std::function<void()> callback, double interval_s, void** cookie);
     void change(double interval_s, const void* cookie);
     void reset(const void* cookie);
@@ -33,11 +34,14 @@ private:
         double interval_s{0.0f};
     };
 
-    std::unordered_map<void*, std::shared_ptr<Entry>> _entries{};
-    std::mutex _entries_mutex{};
-    bool _iterator_invalidated{false};
+    static dl_time_t next_time(const Entry& entry);
 
     Time& _time;
+
+    // Started lazily, the time might not be usable yet while we are
+    // constructed.
+    TimerWheel<Entry> _entries{};
+    std::mutex _entries_mutex{};
 };
 
 } // namespace mavsdk
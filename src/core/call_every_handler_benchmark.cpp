@@ -0,0 +1,27 @@
+#include "call_every_handler.h"
+#include <vector>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// Checking for due calls while none is due, as happens on every loop of the
+// work thread.
+static void BM_CallEveryHandlerRunOnce(benchmark::State& state)
+{
+    Time time;
+    CallEveryHandler handler(time);
+
+    std::vector<void*> cookies(static_cast<size_t>(state.range(0)));
+    for (auto& cookie : cookies) {
+        handler.add([]() {}, 100.0, &cookie);
+    }
+    // Let the first calls, which are immediate, happen before measuring.
+    handler.run_once();
+
+    for (auto _ : state) {
+        handler.run_once();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CallEveryHandlerRunOnce)->Arg(1)->Arg(10)->Arg(100)->Arg(10000);
@@ -144,3 +144,31 @@ TEST(CallEveryHandler, CallImmediately)
     }
     EXPECT_EQ(num_called, 1);
 }
+
+namespace {
+
+class CountingTime : public Time {
+public:
+    dl_time_t steady_time() override
+    {
+        ++num_calls;
+        return Time::steady_time();
+    }
+
+    unsigned num_calls{0};
+};
+
+} // namespace
+
+TEST(CallEveryHandler, DoesNotReadTimeWhenConstructed)
+{
+    // The owner might pass a time which is not constructed yet.
+    CountingTime time;
+    CallEveryHandler ceh(time);
+    EXPECT_EQ(time.num_calls, 0u);
+
+    int num_called = 0;
+    ceh.add([&num_called]() { ++num_called; }, 0.1, nullptr);
+    ceh.run_once();
+    EXPECT_EQ(num_called, 1);
+}
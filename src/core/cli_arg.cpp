@@ -4,6 +4,7 @@
 #include <vector>
 #include <cctype>
 #include <climits>
+#include <cstdlib>
 
 namespace mavsdk {
 
@@ -13,6 +14,7 @@ void CliArg::reset()
     _path.clear();
     _baudrate = 0;
     _port = 0;
+    _replay_speed = 1.0;
 }
 
 bool CliArg::parse(const std::string& uri)
@@ -24,6 +26,11 @@ bool CliArg::parse(const std::string& uri)
         return false;
     }
 
+    if (_protocol == Protocol::Replay) {
+        // Paths can contain ':', so options are given as a query instead.
+        return find_replay_options(rest) && find_path(rest);
+    }
+
     if (!find_path(rest)) {
         return false;
     }
@@ -47,6 +54,7 @@ bool CliArg::find_protocol(std::string& rest)
     const std::string tcp = "tcp";
     const std::string serial = "serial";
     const std::string serial_flowcontrol = "serial_flowcontrol";
+    const std::string replay = "replay";
     const std::string delimiter = "://";
 
     if (rest.find(udp + delimiter) == 0) {
@@ -67,6 +75,10 @@ bool CliArg::find_protocol(std::string& rest)
         _flow_control_enabled = true;
         rest.erase(0, serial_flowcontrol.length() + delimiter.length());
         return true;
+    } else if (rest.find(replay + delimiter) == 0) {
+        _protocol = Protocol::Replay;
+        rest.erase(0, replay.length() + delimiter.length());
+        return true;
     } else {
         LogWarn() << "Unknown protocol";
         return false;
@@ -79,12 +91,21 @@ bool CliArg::find_path(std::string& rest)
         if (_protocol == Protocol::Udp || _protocol == Protocol::Tcp) {
             // We have to use the default path
             return true;
+        } else if (_protocol == Protocol::Replay) {
+            LogWarn() << "Path for replay file required.";
+            return false;
         } else {
             LogWarn() << "Path for serial device required.";
             return false;
         }
     }
 
+    if (_protocol == Protocol::Replay) {
+        _path = rest;
+        rest = "";
+        return true;
+    }
+
     const std::string delimiter = ":";
     size_t pos = rest.find(delimiter);
     if (pos != rest.npos) {
@@ -165,4 +186,31 @@ bool CliArg::find_baudrate(std::string& rest)
     return true;
 }
 
+bool CliArg::find_replay_options(std::string& rest)
+{
+    const auto query_start = rest.find('?');
+    if (query_start == std::string::npos) {
+        return true;
+    }
+
+    std::string query = rest.substr(query_start + 1);
+    rest.erase(query_start);
+
+    const std::string speed = "speed=";
+    if (query.find(speed) != 0) {
+        LogWarn() << "Unknown replay option";
+        return false;
+    }
+    query.erase(0, speed.length());
+
+    char* end = nullptr;
+    _replay_speed = std::strtod(query.c_str(), &end);
+    if (query.empty() || end != query.c_str() + query.length() || !(_replay_speed >= 0.0)) {
+        LogWarn() << "Invalid replay speed";
+        _replay_speed = 1.0;
+        return false;
+    }
+    return true;
+}
+
 } // namespace mavsdk
@@ -164,3 +164,34 @@ TEST(CliArg, SerialConnections)
     EXPECT_FALSE(ca.parse("serial://SOM3:57600"));
     EXPECT_FALSE(ca.parse("serial://COM3:-1"));
 }
+
+TEST(CliArg, ReplayConnections)
+{
+    CliArg ca;
+
+    EXPECT_TRUE(ca.parse("replay://flight.tlog"));
+    EXPECT_EQ(ca.get_protocol(), CliArg::Protocol::Replay);
+    EXPECT_STREQ(ca.get_path().c_str(), "flight.tlog");
+    EXPECT_DOUBLE_EQ(1.0, ca.get_replay_speed());
+
+    EXPECT_TRUE(ca.parse("replay:///home/user/logs/flight.tlog?speed=10"));
+    EXPECT_EQ(ca.get_protocol(), CliArg::Protocol::Replay);
+    EXPECT_STREQ(ca.get_path().c_str(), "/home/user/logs/flight.tlog");
+    EXPECT_DOUBLE_EQ(10.0, ca.get_replay_speed());
+
+    EXPECT_TRUE(ca.parse("replay://C:\\logs\\flight.tlog?speed=0.5"));
+    EXPECT_STREQ(ca.get_path().c_str(), "C:\\logs\\flight.tlog");
+    EXPECT_DOUBLE_EQ(0.5, ca.get_replay_speed());
+
+    // As fast as possible.
+    EXPECT_TRUE(ca.parse("replay://flight.tlog?speed=0"));
+    EXPECT_DOUBLE_EQ(0.0, ca.get_replay_speed());
+
+    // All the wrong combinations.
+    EXPECT_FALSE(ca.parse("replay://"));
+    EXPECT_FALSE(ca.parse("replay://?speed=2"));
+    EXPECT_FALSE(ca.parse("replay://flight.tlog?speed="));
+    EXPECT_FALSE(ca.parse("replay://flight.tlog?speed=-1"));
+    EXPECT_FALSE(ca.parse("replay://flight.tlog?speed=fast"));
+    EXPECT_FALSE(ca.parse("replay://flight.tlog?loop=1"));
+}
@@ -2,6 +2,7 @@
 #include "mavsdk_impl.h"
 #include "mavlink_channels.h"
 #include "global_include.h"
+#include "trace.h"
 
 namespace mavsdk {
 
@@ -24,7 +25,7 @@ bool Connection::start_mavlink_receiver()
         return false;
     }
 
-    _mavlink_receiver.reset(new MAVLinkReceiver(channel));
+    _mavlink_receiver.reset(new MAVLinkReceiver(channel, &_stats));
     return true;
 }
 
@@ -40,7 +41,25 @@ void Connection::stop_mavlink_receiver()
 
 void Connection::receive_message(mavlink_message_t& message)
 {
+    MAVSDK_TRACE_SCOPE("receive_message", message.msgid);
+    _stats.message_received(message);
     _receiver_callback(message);
 }
 
+bool Connection::send_messages(const std::vector<mavlink_message_t>& messages)
+{
+    bool success = true;
+    for (const auto& message : messages) {
+        success = send_message(message) && success;
+    }
+    return success;
+}
+
+void Connection::append_to_buffer(std::vector<uint8_t>& buffer, const mavlink_message_t& message)
+{
+    uint8_t message_buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t message_len = mavlink_msg_to_send_buffer(message_buffer, &message);
+    buffer.insert(buffer.end(), message_buffer, message_buffer + message_len);
+}
+
 } // namespace mavsdk
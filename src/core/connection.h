@@ -1,8 +1,10 @@
 #pragma once
 
 #include "mavsdk.h"
+#include "link_stats.h"
 #include "mavlink_receiver.h"
 #include <memory>
+#include <vector>
 
 namespace mavsdk {
 
@@ -18,6 +20,11 @@ public:
 
     virtual bool send_message(const mavlink_message_t& message) = 0;
 
+    // Connections which can write several messages at once override this.
+    virtual bool send_messages(const std::vector<mavlink_message_t>& messages);
+
+    ConnectionStats& stats() { return _stats; }
+
     // Non-copyable
     Connection(const Connection&) = delete;
     const Connection& operator=(const Connection&) = delete;
@@ -27,7 +34,10 @@ protected:
     void stop_mavlink_receiver();
     void receive_message(mavlink_message_t& message);
 
+    static void append_to_buffer(std::vector<uint8_t>& buffer, const mavlink_message_t& message);
+
     receiver_callback_t _receiver_callback{};
+    ConnectionStats _stats{};
     std::unique_ptr<MAVLinkReceiver> _mavlink_receiver;
 
     // void received_mavlink_message(mavlink_message_t &);
@@ -0,0 +1,56 @@
+#include "frame_ring_buffer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace mavsdk {
+
+FrameRingBuffer::FrameRingBuffer(size_t capacity) : _data(capacity) {}
+
+bool FrameRingBuffer::push(const uint8_t* frame, size_t len)
+{
+    if (len == 0 || len > _data.size() - _size) {
+        return false;
+    }
+
+    const size_t tail = (_head + _size) % _data.size();
+    const size_t first_part = std::min(len, _data.size() - tail);
+    std::memcpy(&_data[tail], frame, first_part);
+    if (first_part < len) {
+        std::memcpy(&_data[0], frame + first_part, len - first_part);
+    }
+
+    _size += len;
+    _frame_lengths.push_back(len);
+    return true;
+}
+
+std::pair<const uint8_t*, size_t> FrameRingBuffer::front() const
+{
+    if (_size == 0) {
+        return {nullptr, 0};
+    }
+    return {&_data[_head], std::min(_size, _data.size() - _head)};
+}
+
+void FrameRingBuffer::consume(size_t len)
+{
+    len = std::min(len, _size);
+
+    _head = (_head + len) % _data.size();
+    _size -= len;
+
+    _front_consumed += len;
+    while (!_frame_lengths.empty() && _front_consumed >= _frame_lengths.front()) {
+        _front_consumed -= _frame_lengths.front();
+        _frame_lengths.pop_front();
+    }
+}
+
+void FrameRingBuffer::drop_partial_frame()
+{
+    if (_front_consumed > 0) {
+        consume(_frame_lengths.front() - _front_consumed);
+    }
+}
+
+} // namespace mavsdk
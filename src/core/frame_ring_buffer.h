@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace mavsdk {
+
+// Bytes of whole frames waiting to be sent, in a ring of fixed size.
+//
+// The frames can be sent in chunks of any size. If sending a frame is
+// interrupted, what remains of it can be dropped, so that the next
+// connection doesn't start in the middle of a frame.
+class FrameRingBuffer {
+public:
+    explicit FrameRingBuffer(size_t capacity);
+    ~FrameRingBuffer() = default;
+
+    // Returns false and adds nothing if the frame doesn't fit.
+    bool push(const uint8_t* frame, size_t len);
+
+    // The next bytes to send, as much as is contiguous. Empty if there
+    // is nothing to send.
+    std::pair<const uint8_t*, size_t> front() const;
+
+    // Removes bytes which have been sent, at most the size of front().
+    void consume(size_t len);
+
+    // Removes what remains of a frame of which only a part was consumed.
+    void drop_partial_frame();
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    size_t capacity() const { return _data.size(); }
+    size_t num_frames() const { return _frame_lengths.size(); }
+
+private:
+    std::vector<uint8_t> _data;
+    size_t _head{0};
+    size_t _size{0};
+
+    std::deque<size_t> _frame_lengths{};
+    // Bytes of the first frame which have been consumed already.
+    size_t _front_consumed{0};
+};
+
+} // namespace mavsdk
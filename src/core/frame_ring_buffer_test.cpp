@@ -0,0 +1,92 @@
+#include "frame_ring_buffer.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace mavsdk;
+
+static std::vector<uint8_t> take_all(FrameRingBuffer& buffer)
+{
+    std::vector<uint8_t> result;
+    while (!buffer.empty()) {
+        const auto front = buffer.front();
+        result.insert(result.end(), front.first, front.first + front.second);
+        buffer.consume(front.second);
+    }
+    return result;
+}
+
+TEST(FrameRingBuffer, KeepsOrder)
+{
+    FrameRingBuffer buffer(16);
+
+    const uint8_t frame1[] = {1, 2, 3};
+    const uint8_t frame2[] = {4, 5};
+    EXPECT_TRUE(buffer.push(frame1, sizeof(frame1)));
+    EXPECT_TRUE(buffer.push(frame2, sizeof(frame2)));
+    EXPECT_EQ(buffer.size(), 5u);
+    EXPECT_EQ(buffer.num_frames(), 2u);
+
+    EXPECT_EQ(take_all(buffer), std::vector<uint8_t>({1, 2, 3, 4, 5}));
+    EXPECT_EQ(buffer.num_frames(), 0u);
+}
+
+TEST(FrameRingBuffer, RejectsWhatDoesNotFit)
+{
+    FrameRingBuffer buffer(4);
+
+    const uint8_t frame[] = {1, 2, 3};
+    EXPECT_TRUE(buffer.push(frame, sizeof(frame)));
+    EXPECT_FALSE(buffer.push(frame, sizeof(frame)));
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_FALSE(buffer.push(frame, 0));
+}
+
+TEST(FrameRingBuffer, WrapsAround)
+{
+    FrameRingBuffer buffer(8);
+
+    const uint8_t frame1[] = {1, 2, 3, 4, 5, 6};
+    const uint8_t frame2[] = {7, 8, 9, 10, 11};
+    EXPECT_TRUE(buffer.push(frame1, sizeof(frame1)));
+    buffer.consume(6);
+    EXPECT_TRUE(buffer.push(frame2, sizeof(frame2)));
+
+    // Only the part up to the end of the ring is contiguous.
+    EXPECT_EQ(buffer.front().second, 2u);
+    EXPECT_EQ(take_all(buffer), std::vector<uint8_t>({7, 8, 9, 10, 11}));
+}
+
+TEST(FrameRingBuffer, DropsRestOfPartiallySentFrame)
+{
+    FrameRingBuffer buffer(16);
+
+    const uint8_t frame1[] = {1, 2, 3, 4};
+    const uint8_t frame2[] = {5, 6};
+    buffer.push(frame1, sizeof(frame1));
+    buffer.push(frame2, sizeof(frame2));
+
+    buffer.consume(3);
+    buffer.drop_partial_frame();
+    EXPECT_EQ(buffer.num_frames(), 1u);
+
+    // Nothing to drop at a frame boundary.
+    buffer.drop_partial_frame();
+    EXPECT_EQ(take_all(buffer), std::vector<uint8_t>({5, 6}));
+}
+
+TEST(FrameRingBuffer, PartialSendsAcrossFrames)
+{
+    FrameRingBuffer buffer(16);
+
+    const uint8_t frame1[] = {1, 2, 3};
+    const uint8_t frame2[] = {4, 5, 6};
+    buffer.push(frame1, sizeof(frame1));
+    buffer.push(frame2, sizeof(frame2));
+
+    // Ends in the middle of the second frame.
+    buffer.consume(4);
+    EXPECT_EQ(buffer.num_frames(), 1u);
+    buffer.drop_partial_frame();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.num_frames(), 0u);
+}
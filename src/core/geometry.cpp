@@ -1,13 +1,228 @@
 #include "geometry.h"
 #include "global_include.h"
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// The batch conversions are plain loops which the compiler vectorizes, see
+// CMakeLists.txt for the flags this needs. This lets it also build them for
+// AVX2 and pick at runtime. On ARM64, NEON is always there.
+#if defined(LINUX) && !defined(ANDROID) && defined(__x86_64__) && defined(__GNUC__) && \
+    !defined(__clang__)
+#define GEOMETRY_TARGET_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define GEOMETRY_TARGET_CLONES
+#endif
+
+// The helpers need to be inlined into the loops to be vectorized.
+#if defined(__GNUC__)
+#define GEOMETRY_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define GEOMETRY_INLINE __forceinline
+#else
+#define GEOMETRY_INLINE inline
+#endif
 
 namespace mavsdk {
 namespace geometry {
 
+namespace {
+
+// Approximations of sin, cos and asin, accurate to about an ulp. Unlike the
+// ones of the standard library, they have no branches and no function calls,
+// so that loops using them can be vectorized. The polynomials are the ones
+// of fdlibm.
+
+constexpr double PI_2 = M_PI / 2.0;
+
+GEOMETRY_INLINE uint64_t to_bits(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+GEOMETRY_INLINE double from_bits(uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Only meant for the range of angles we see here, up to a few multiples of
+// pi, the reduction loses precision for very large arguments.
+GEOMETRY_INLINE void fast_sin_cos(double x, double& sin_x, double& cos_x)
+{
+    // Adding 1.5 * 2^52 rounds to an integer which ends up in the low bits.
+    constexpr double round_magic = 6755399441055744.0;
+    const double shifted = x * (2.0 / M_PI) + round_magic;
+    const double n = shifted - round_magic;
+    const uint64_t quadrant = to_bits(shifted) & 3;
+
+    // Pi / 2 split into parts so that the products with n are exact.
+    constexpr double pio2_1 = 1.57079632673412561417e+00;
+    constexpr double pio2_2 = 6.07710050630396597660e-11;
+    constexpr double pio2_2t = 2.02226624879595063154e-21;
+    const double r = ((x - n * pio2_1) - n * pio2_2) - n * pio2_2t;
+    const double z = r * r;
+
+    const double s =
+        r + r * z *
+                (-1.66666666666666324348e-01 +
+                 z * (8.33333333332248946124e-03 +
+                      z * (-1.98412698298579493134e-04 +
+                           z * (2.75573137070700676789e-06 +
+                                z * (-2.50507602534068634195e-08 +
+                                     z * 1.58969099521155010221e-10)))));
+    const double c = 1.0 - 0.5 * z +
+                     z * z *
+                         (4.16666666666666019037e-02 +
+                          z * (-1.38888888888741095749e-03 +
+                               z * (2.48015872894767294178e-05 +
+                                    z * (-2.75573143513906633035e-07 +
+                                         z * (2.08757232129817482790e-09 +
+                                              z * -1.13596475577881948265e-11)))));
+
+    // Odd quadrants swap sin and cos, the quadrant decides the signs.
+    const uint64_t swap_mask = 0 - (quadrant & 1);
+    const uint64_t sign_bit = uint64_t(1) << 63;
+    const uint64_t s_bits = to_bits(s);
+    const uint64_t c_bits = to_bits(c);
+    sin_x = from_bits(
+        ((s_bits & ~swap_mask) | (c_bits & swap_mask)) ^ ((quadrant & 2) != 0 ? sign_bit : 0));
+    cos_x = from_bits(
+        ((c_bits & ~swap_mask) | (s_bits & swap_mask)) ^
+        (((quadrant + 1) & 2) != 0 ? sign_bit : 0));
+}
+
+// asin for |x| <= 0.5.
+GEOMETRY_INLINE double fast_asin_kernel(double x)
+{
+    const double t = x * x;
+    const double p =
+        t * (1.66666666666666657415e-01 +
+             t * (-3.25565818622400915405e-01 +
+                  t * (2.01212532134862925881e-01 +
+                       t * (-4.00555345006794114027e-02 +
+                            t * (7.91534994289814532176e-04 + t * 3.47933107596021167570e-05)))));
+    const double q =
+        1.0 + t * (-2.40339491173441421878e+00 +
+                   t * (2.02094576023350569471e+00 +
+                        t * (-6.88283971605453293030e-01 + t * 7.70381505559019352791e-02)));
+    return x + x * (p / q);
+}
+
+GEOMETRY_INLINE double fast_asin(double x)
+{
+    const double a = std::fabs(x);
+    // Above 0.5, asin(a) = pi / 2 - 2 * asin(sqrt((1 - a) / 2)).
+    const bool big = a > 0.5;
+    const double r = fast_asin_kernel(big ? std::sqrt((1.0 - a) * 0.5) : a);
+    return std::copysign(big ? PI_2 - 2.0 * r : r, x);
+}
+
+GEOMETRY_INLINE double fast_acos(double x)
+{
+    const double a = std::fabs(x);
+    // Above 0.5, acos(a) = 2 * asin(sqrt((1 - a) / 2)), and acos(-a) = pi - acos(a).
+    const bool big = a > 0.5;
+    const double r = fast_asin_kernel(big ? std::sqrt((1.0 - a) * 0.5) : x);
+    return big ? (x > 0.0 ? 2.0 * r : M_PI - 2.0 * r) : PI_2 - r;
+}
+
+GEOMETRY_INLINE double fast_atan2(double y, double x)
+{
+    // At the origin this ends up as 0, like atan2.
+    const double h = std::sqrt(x * x + y * y);
+    const bool at_origin = !(h > 0.0);
+    const double s = at_origin ? 0.0 : std::fabs(y) / h;
+    const double c = at_origin ? 1.0 : x / h;
+
+    // Close to the x axis asin of the sine is accurate, otherwise asin of
+    // the cosine is.
+    const bool near_x_axis = s <= std::fabs(c);
+    const double a = fast_asin(near_x_axis ? s : c);
+    const double angle = near_x_axis ? (c >= 0.0 ? a : M_PI - a) : PI_2 - a;
+    return std::copysign(angle, y);
+}
+
+GEOMETRY_TARGET_CLONES
+void local_from_global_batch(
+    const double* latitude_deg,
+    const double* longitude_deg,
+    double* north_m,
+    double* east_m,
+    size_t count,
+    double ref_lon_rad,
+    double ref_sin_lat,
+    double ref_cos_lat,
+    double world_radius_m)
+{
+    for (size_t i = 0; i < count; ++i) {
+        double sin_lat;
+        double cos_lat;
+        fast_sin_cos(M_PI / 180.0 * latitude_deg[i], sin_lat, cos_lat);
+
+        double sin_d_lon;
+        double cos_d_lon;
+        fast_sin_cos(M_PI / 180.0 * longitude_deg[i] - ref_lon_rad, sin_d_lon, cos_d_lon);
+
+        double arg = ref_sin_lat * sin_lat + ref_cos_lat * cos_lat * cos_d_lon;
+        arg = (arg > 1.0) ? 1.0 : (arg < -1.0) ? -1.0 : arg;
+        const double c = fast_acos(arg);
+
+        // The sine of c follows from its cosine, which is arg.
+        const double sin_c = std::sqrt((1.0 - arg) * (1.0 + arg));
+        const double k = (c > 0.0) ? (c / sin_c) : 1.0;
+
+        north_m[i] =
+            k * (ref_cos_lat * sin_lat - ref_sin_lat * cos_lat * cos_d_lon) * world_radius_m;
+        east_m[i] = k * cos_lat * sin_d_lon * world_radius_m;
+    }
+}
+
+GEOMETRY_TARGET_CLONES
+void global_from_local_batch(
+    const double* north_m,
+    const double* east_m,
+    double* latitude_deg,
+    double* longitude_deg,
+    size_t count,
+    double ref_lat_rad,
+    double ref_lon_rad,
+    double ref_sin_lat,
+    double ref_cos_lat,
+    double world_radius_m)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const double x_rad = north_m[i] / world_radius_m;
+        const double y_rad = east_m[i] / world_radius_m;
+        const double c = std::sqrt(x_rad * x_rad + y_rad * y_rad);
+
+        double sin_c;
+        double cos_c;
+        fast_sin_cos(c, sin_c, cos_c);
+
+        const bool at_reference = !(c > 0.0);
+        const double sin_c_by_c = at_reference ? 1.0 : sin_c / c;
+
+        const double lat_rad = fast_asin(cos_c * ref_sin_lat + x_rad * sin_c_by_c * ref_cos_lat);
+        const double lon_rad =
+            ref_lon_rad +
+            fast_atan2(y_rad * sin_c, c * ref_cos_lat * cos_c - x_rad * ref_sin_lat * sin_c);
+
+        latitude_deg[i] = 180.0 / M_PI * (at_reference ? ref_lat_rad : lat_rad);
+        longitude_deg[i] = 180.0 / M_PI * (at_reference ? ref_lon_rad : lon_rad);
+    }
+}
+
+} // namespace
+
 CoordinateTransformation::CoordinateTransformation(GlobalCoordinate reference) :
     _ref_lat_rad(rad(reference.latitude_deg)),
-    _ref_lon_rad(rad(reference.longitude_deg))
+    _ref_lon_rad(rad(reference.longitude_deg)),
+    _ref_sin_lat(sin(_ref_lat_rad)),
+    _ref_cos_lat(cos(_ref_lat_rad))
 {}
 
 CoordinateTransformation::LocalCoordinate
@@ -21,17 +236,14 @@ CoordinateTransformation::local_from_global(GlobalCoordinate global_coordinate)
 
     const double cos_d_lon = cos(lon_rad - _ref_lon_rad);
 
-    const double ref_sin_lat = sin(_ref_lat_rad);
-    const double ref_cos_lat = cos(_ref_lat_rad);
-
     const double arg =
-        constrain(ref_sin_lat * sin_lat + ref_cos_lat * cos_lat * cos_d_lon, -1.0, 1.0);
+        constrain(_ref_sin_lat * sin_lat + _ref_cos_lat * cos_lat * cos_d_lon, -1.0, 1.0);
     const double c = acos(arg);
 
     const double k = (fabs(c) > 0) ? (c / sin(c)) : 1.0;
 
     return LocalCoordinate{
-        k * (ref_cos_lat * sin_lat - ref_sin_lat * cos_lat * cos_d_lon) * world_radius_m,
+        k * (_ref_cos_lat * sin_lat - _ref_sin_lat * cos_lat * cos_d_lon) * world_radius_m,
         k * cos_lat * sin(lon_rad - _ref_lon_rad) * world_radius_m};
 }
 
@@ -48,13 +260,10 @@ CoordinateTransformation::global_from_local(LocalCoordinate local_coordinate) co
         const double sin_c = sin(c);
         const double cos_c = cos(c);
 
-        const double ref_sin_lat = sin(_ref_lat_rad);
-        const double ref_cos_lat = cos(_ref_lat_rad);
-
-        const double lat_rad = asin(cos_c * ref_sin_lat + (x_rad * sin_c * ref_cos_lat) / c);
+        const double lat_rad = asin(cos_c * _ref_sin_lat + (x_rad * sin_c * _ref_cos_lat) / c);
         const double lon_rad =
             (_ref_lon_rad +
-             atan2(y_rad * sin_c, c * ref_cos_lat * cos_c - x_rad * ref_sin_lat * sin_c));
+             atan2(y_rad * sin_c, c * _ref_cos_lat * cos_c - x_rad * _ref_sin_lat * sin_c));
 
         global.latitude_deg = deg(lat_rad);
         global.longitude_deg = deg(lon_rad);
@@ -67,6 +276,45 @@ CoordinateTransformation::global_from_local(LocalCoordinate local_coordinate) co
     return global;
 }
 
+void CoordinateTransformation::local_from_global(
+    const double* latitude_deg,
+    const double* longitude_deg,
+    double* north_m,
+    double* east_m,
+    size_t count) const
+{
+    local_from_global_batch(
+        latitude_deg,
+        longitude_deg,
+        north_m,
+        east_m,
+        count,
+        _ref_lon_rad,
+        _ref_sin_lat,
+        _ref_cos_lat,
+        world_radius_m);
+}
+
+void CoordinateTransformation::global_from_local(
+    const double* north_m,
+    const double* east_m,
+    double* latitude_deg,
+    double* longitude_deg,
+    size_t count) const
+{
+    global_from_local_batch(
+        north_m,
+        east_m,
+        latitude_deg,
+        longitude_deg,
+        count,
+        _ref_lat_rad,
+        _ref_lon_rad,
+        _ref_sin_lat,
+        _ref_cos_lat,
+        world_radius_m);
+}
+
 constexpr double CoordinateTransformation::rad(double deg)
 {
     return M_PI / 180.0 * deg;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace mavsdk {
 namespace geometry {
 
@@ -56,6 +58,46 @@ public:
      */
     GlobalCoordinate global_from_local(LocalCoordinate local_coordinate) const;
 
+    /**
+     * @brief Calculate local coordinates from global coordinates for many points.
+     *
+     * The points are passed as separate arrays of count elements each.
+     * This is considerably faster than converting point by point, the
+     * result differs from local_from_global by far less than a millimeter.
+     *
+     * @param latitude_deg Latitudes of the points to project from.
+     * @param longitude_deg Longitudes of the points to project from.
+     * @param north_m Set to the north positions of the points.
+     * @param east_m Set to the east positions of the points.
+     * @param count Number of points.
+     */
+    void local_from_global(
+        const double* latitude_deg,
+        const double* longitude_deg,
+        double* north_m,
+        double* east_m,
+        size_t count) const;
+
+    /**
+     * @brief Calculate global coordinates from local coordinates for many points.
+     *
+     * The points are passed as separate arrays of count elements each.
+     * This is considerably faster than converting point by point, the
+     * result differs from global_from_local by far less than a millimeter.
+     *
+     * @param north_m North positions of the points to project from.
+     * @param east_m East positions of the points to project from.
+     * @param latitude_deg Set to the latitudes of the points.
+     * @param longitude_deg Set to the longitudes of the points.
+     * @param count Number of points.
+     */
+    void global_from_local(
+        const double* north_m,
+        const double* east_m,
+        double* latitude_deg,
+        double* longitude_deg,
+        size_t count) const;
+
     /**
      * @brief Destructor.
      */
@@ -68,6 +110,8 @@ private:
 
     double _ref_lat_rad;
     double _ref_lon_rad;
+    double _ref_sin_lat;
+    double _ref_cos_lat;
     static constexpr double world_radius_m{6371000.0};
 };
 
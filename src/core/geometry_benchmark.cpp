@@ -0,0 +1,101 @@
+#include "geometry.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace mavsdk::geometry;
+
+// Points in a grid of about 2 by 2 km around the reference, as for a survey.
+static void make_grid(
+    size_t count,
+    std::vector<double>& latitudes_deg,
+    std::vector<double>& longitudes_deg,
+    std::vector<double>& norths_m,
+    std::vector<double>& easts_m)
+{
+    latitudes_deg.resize(count);
+    longitudes_deg.resize(count);
+    norths_m.resize(count);
+    easts_m.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        latitudes_deg[i] = 47.356042 + 0.00001 * static_cast<double>(i % 1000) - 0.005;
+        longitudes_deg[i] = 8.519031 + 0.00001 * static_cast<double>(i / 1000) - 0.005;
+        norths_m[i] = static_cast<double>(i % 1000) - 500.0;
+        easts_m[i] = static_cast<double>(i / 1000) - 500.0;
+    }
+}
+
+static void BM_LocalFromGlobal(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<double> lats, lons, norths, easts;
+    make_grid(count, lats, lons, norths, easts);
+    CoordinateTransformation ct({47.356042, 8.519031});
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto local = ct.local_from_global({lats[i], lons[i]});
+            norths[i] = local.north_m;
+            easts[i] = local.east_m;
+        }
+        benchmark::DoNotOptimize(norths.data());
+        benchmark::DoNotOptimize(easts.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_LocalFromGlobal)->Arg(1000)->Arg(100000);
+
+static void BM_LocalFromGlobalBatch(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<double> lats, lons, norths, easts;
+    make_grid(count, lats, lons, norths, easts);
+    CoordinateTransformation ct({47.356042, 8.519031});
+
+    for (auto _ : state) {
+        ct.local_from_global(lats.data(), lons.data(), norths.data(), easts.data(), count);
+        benchmark::DoNotOptimize(norths.data());
+        benchmark::DoNotOptimize(easts.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_LocalFromGlobalBatch)->Arg(1000)->Arg(100000);
+
+static void BM_GlobalFromLocal(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<double> lats, lons, norths, easts;
+    make_grid(count, lats, lons, norths, easts);
+    CoordinateTransformation ct({47.356042, 8.519031});
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto global = ct.global_from_local({norths[i], easts[i]});
+            lats[i] = global.latitude_deg;
+            lons[i] = global.longitude_deg;
+        }
+        benchmark::DoNotOptimize(lats.data());
+        benchmark::DoNotOptimize(lons.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_GlobalFromLocal)->Arg(1000)->Arg(100000);
+
+static void BM_GlobalFromLocalBatch(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<double> lats, lons, norths, easts;
+    make_grid(count, lats, lons, norths, easts);
+    CoordinateTransformation ct({47.356042, 8.519031});
+
+    for (auto _ : state) {
+        ct.global_from_local(norths.data(), easts.data(), lats.data(), lons.data(), count);
+        benchmark::DoNotOptimize(lats.data());
+        benchmark::DoNotOptimize(lons.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_GlobalFromLocalBatch)->Arg(1000)->Arg(100000);
@@ -1,4 +1,6 @@
 #include "geometry.h"
+#include <cmath>
+#include <vector>
 #include <gtest/gtest.h>
 
 using namespace mavsdk::geometry;
@@ -48,3 +50,73 @@ TEST(Geoemtry, LocalToGlobalAndBack)
     EXPECT_NEAR(location.north_m, location_again.north_m, 1e-8);
     EXPECT_NEAR(location.east_m, location_again.east_m, 1e-8);
 }
+
+// The batch conversions use their own approximations of the trigonometric
+// functions, they should match the single point ones closely everywhere.
+TEST(Geometry, BatchMatchesSinglePoint)
+{
+    const CoordinateTransformation::GlobalCoordinate references[] = {
+        {47.356042, 8.519031},
+        {-26.693518, 153.104172},
+        {0.0, 0.0},
+        {89.9, -179.9},
+        {-60.0, 179.5}};
+
+    std::vector<double> latitudes_deg;
+    std::vector<double> longitudes_deg;
+    for (double lat = -89.5; lat <= 89.5; lat += 4.75) {
+        for (double lon = -179.5; lon <= 179.5; lon += 9.25) {
+            latitudes_deg.push_back(lat);
+            longitudes_deg.push_back(lon);
+        }
+    }
+
+    std::vector<double> norths_m;
+    std::vector<double> easts_m;
+    for (double north = -20000.0; north <= 20000.0; north += 1234.5) {
+        for (double east = -20000.0; east <= 20000.0; east += 987.6) {
+            norths_m.push_back(north);
+            easts_m.push_back(east);
+        }
+    }
+    // Exactly at the reference, and the smallest offsets.
+    norths_m.insert(norths_m.end(), {0.0, 1e-9, 0.0, -0.001});
+    easts_m.insert(easts_m.end(), {0.0, 0.0, -1e-9, 0.001});
+
+    for (const auto& reference : references) {
+        CoordinateTransformation ct(reference);
+
+        // Close to the reference too, where it matters most.
+        auto lats = latitudes_deg;
+        auto lons = longitudes_deg;
+        for (double offset = -0.01; offset <= 0.01; offset += 0.00123) {
+            lats.push_back(reference.latitude_deg + offset);
+            lons.push_back(reference.longitude_deg - offset);
+        }
+        lats.push_back(reference.latitude_deg);
+        lons.push_back(reference.longitude_deg);
+
+        std::vector<double> norths(lats.size());
+        std::vector<double> easts(lats.size());
+        ct.local_from_global(lats.data(), lons.data(), norths.data(), easts.data(), lats.size());
+
+        for (size_t i = 0; i < lats.size(); ++i) {
+            const auto local = ct.local_from_global({lats[i], lons[i]});
+            // Far away from the reference, the projection itself gets imprecise.
+            const double tolerance_m = 1e-6 + std::abs(local.north_m + local.east_m) * 1e-12;
+            EXPECT_NEAR(norths[i], local.north_m, tolerance_m);
+            EXPECT_NEAR(easts[i], local.east_m, tolerance_m);
+        }
+
+        std::vector<double> lats_back(norths_m.size());
+        std::vector<double> lons_back(norths_m.size());
+        ct.global_from_local(
+            norths_m.data(), easts_m.data(), lats_back.data(), lons_back.data(), norths_m.size());
+
+        for (size_t i = 0; i < norths_m.size(); ++i) {
+            const auto global = ct.global_from_local({norths_m[i], easts_m[i]});
+            EXPECT_NEAR(lats_back[i], global.latitude_deg, 1e-9);
+            EXPECT_NEAR(lons_back[i], global.longitude_deg, 1e-9);
+        }
+    }
+}
@@ -135,6 +135,81 @@ void FakeTime::add_overhead()
     _current += std::chrono::microseconds(50);
 }
 
+VirtualTime::VirtualTime() : Time() {}
+
+VirtualTime::~VirtualTime() {}
+
+dl_time_t VirtualTime::steady_time()
+{
+    if (!_is_virtual) {
+        return real_steady_time();
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_is_virtual) {
+        return real_steady_time();
+    }
+    return _steady_origin +
+           std::chrono::duration_cast<steady_clock::duration>(_current - _system_origin);
+}
+
+dl_system_time_t VirtualTime::system_time()
+{
+    if (!_is_virtual) {
+        return system_clock::now();
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_is_virtual) {
+        return system_clock::now();
+    }
+    return _current;
+}
+
+void VirtualTime::set_system_time(dl_system_time_t system_time)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_is_virtual) {
+        // Continue from the real steady time, so that timeouts which are
+        // already running don't jump.
+        _steady_origin = real_steady_time();
+        _system_origin = system_time;
+        _current = system_time;
+        _is_virtual = true;
+        return;
+    }
+    if (system_time > _current) {
+        _current = system_time;
+    }
+}
+
+void VirtualTime::set_real()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_is_virtual) {
+        return;
+    }
+    const auto virtual_steady_time =
+        _steady_origin +
+        std::chrono::duration_cast<steady_clock::duration>(_current - _system_origin);
+    const auto ahead = virtual_steady_time - real_steady_time();
+    if (ahead > steady_clock::duration::zero()) {
+        _real_steady_offset_ns +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(ahead).count();
+    }
+    _is_virtual = false;
+}
+
+bool VirtualTime::is_virtual() const
+{
+    return _is_virtual;
+}
+
+dl_time_t VirtualTime::real_steady_time() const
+{
+    return steady_clock::now() +
+           std::chrono::duration_cast<steady_clock::duration>(
+               std::chrono::nanoseconds(_real_steady_offset_ns.load()));
+}
+
 double to_rad_from_deg(double deg)
 {
     return deg / 180.0 * M_PI;
@@ -2,7 +2,9 @@
 
 #define UNUSED(x) (void)(x)
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <thread>
 #include <mutex>
 
@@ -77,6 +79,40 @@ private:
     void add_overhead();
 };
 
+// Follows the real clock until it is set for the first time. From then on it
+// only moves when it is set again, e.g. to the timestamps of replayed
+// messages, until it is made real again. Sleeping still takes real time.
+class VirtualTime : public Time {
+public:
+    VirtualTime();
+
+    virtual ~VirtualTime();
+    virtual dl_time_t steady_time() override;
+    virtual dl_system_time_t system_time() override;
+
+    // Times before the current one are ignored, so that the clock never
+    // goes backwards.
+    void set_system_time(dl_system_time_t system_time);
+
+    // Goes back to the real clock, e.g. once a replay is over. The steady
+    // time never goes backwards, if the virtual one was ahead it stays ahead
+    // by the same amount.
+    void set_real();
+
+    bool is_virtual() const;
+
+private:
+    dl_time_t real_steady_time() const;
+
+    mutable std::mutex _mutex{};
+    // Read without the mutex, so that the real clock is not slowed down.
+    std::atomic<bool> _is_virtual{false};
+    std::atomic<int64_t> _real_steady_offset_ns{0};
+    dl_time_t _steady_origin{};
+    dl_system_time_t _system_origin{};
+    dl_system_time_t _current{};
+};
+
 class AutopilotTime {
 public:
     AutopilotTime();
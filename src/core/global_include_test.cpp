@@ -53,6 +53,59 @@ TEST(GlobalInclude, ElapsedIncreasing)
     ASSERT_GT(now, before);
 }
 
+TEST(GlobalInclude, VirtualTimeOnlyMovesWhenSet)
+{
+    VirtualTime time{};
+    EXPECT_FALSE(time.is_virtual());
+
+    const dl_time_t real_before = time.steady_time();
+    const auto start = std::chrono::system_clock::now() - std::chrono::hours(24);
+    time.set_system_time(start);
+    EXPECT_TRUE(time.is_virtual());
+    EXPECT_EQ(time.system_time(), start);
+
+    // Continues from the real steady time.
+    const dl_time_t steady_start = time.steady_time();
+    EXPECT_GE(steady_start, real_before);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(time.steady_time(), steady_start);
+
+    time.set_system_time(start + std::chrono::seconds(3));
+    EXPECT_DOUBLE_EQ(time.elapsed_since_s(steady_start), 3.0);
+    EXPECT_EQ(time.system_time(), start + std::chrono::seconds(3));
+
+    // Never goes backwards.
+    time.set_system_time(start + std::chrono::seconds(1));
+    EXPECT_EQ(time.system_time(), start + std::chrono::seconds(3));
+}
+
+TEST(GlobalInclude, VirtualTimeCanBeMadeReal)
+{
+    VirtualTime time{};
+    const auto start = std::chrono::system_clock::now() - std::chrono::hours(24);
+    time.set_system_time(start);
+    const dl_time_t steady_start = time.steady_time();
+    time.set_system_time(start + std::chrono::hours(1));
+
+    time.set_real();
+    EXPECT_FALSE(time.is_virtual());
+    EXPECT_GT(time.system_time(), start + std::chrono::hours(23));
+
+    // The steady time continues from where the virtual one was ahead, and
+    // moves again.
+    const dl_time_t steady_real = time.steady_time();
+    EXPECT_GE(time.elapsed_since_s(steady_start), 3600.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_GT(time.steady_time(), steady_real);
+
+    // It can be made virtual again.
+    time.set_system_time(start);
+    EXPECT_TRUE(time.is_virtual());
+    EXPECT_EQ(time.system_time(), start);
+    EXPECT_GE(time.steady_time(), steady_real);
+}
+
 TEST(GlobalInclude, RadDegDouble)
 {
     ASSERT_DOUBLE_EQ(0.0, to_rad_from_deg(0.0));
@@ -1,17 +1,60 @@
 #include "http_loader.h"
+#include "cache_directory.h"
 #include "curl_wrapper.h"
+#include "global_include.h"
+#include "log.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
 
 namespace mavsdk {
 
+namespace {
+
+// Headers of the response which we need for the cache.
+struct ResponseHeaders {
+    std::string etag{};
+    std::string last_modified{};
+};
+
+} // namespace
+
+struct HttpLoader::Transfer {
+    std::string url{};
+    CURL* easy{nullptr};
+    curl_slist* headers{nullptr};
+    bool started{false};
+    bool cancelled{false};
+
+    // Either the content is kept in memory or written to a file.
+    std::string content{};
+    FILE* file{nullptr};
+    std::string local_path{};
+
+    text_callback_t text_callback{nullptr};
+    dl_up_progress progress{};
+
+    // Used for the cache.
+    std::string cached_content{};
+    ResponseHeaders response_headers{};
+};
+
 #ifdef TESTING
 HttpLoader::HttpLoader(const std::shared_ptr<ICurlWrapper>& curl_wrapper) :
-    _curl_wrapper(curl_wrapper)
+    _curl_wrapper(curl_wrapper),
+    _use_multi(false)
 {
     start();
 }
 #endif
 
-HttpLoader::HttpLoader() : _curl_wrapper(std::make_shared<CurlWrapper>())
+HttpLoader::HttpLoader(const std::string& cache_directory) :
+    _curl_wrapper(std::make_shared<CurlWrapper>()),
+    _cache_directory(cache_directory)
 {
     start();
 }
@@ -21,6 +64,11 @@ HttpLoader::~HttpLoader()
     stop();
 }
 
+std::string HttpLoader::default_cache_directory()
+{
+    return mavsdk::default_cache_directory("http");
+}
+
 void HttpLoader::start()
 {
     _should_exit = false;
@@ -36,6 +84,18 @@ void HttpLoader::stop()
         delete _work_thread;
         _work_thread = nullptr;
     }
+
+    {
+        std::lock_guard<std::mutex> lock(_multi_mutex);
+        if (_multi_handle != nullptr) {
+            curl_multi_wakeup(_multi_handle);
+        }
+    }
+    if (_multi_thread != nullptr) {
+        _multi_thread->join();
+        delete _multi_thread;
+        _multi_thread = nullptr;
+    }
 }
 
 bool HttpLoader::download_sync(const std::string& url, const std::string& local_path)
@@ -50,8 +110,26 @@ void HttpLoader::download_async(
     const std::string& local_path,
     const progress_callback_t& progress_callback)
 {
-    auto work_item = std::make_shared<DownloadItem>(url, local_path, progress_callback);
-    _work_queue.enqueue(work_item);
+    if (!_use_multi) {
+        auto work_item = std::make_shared<DownloadItem>(url, local_path, progress_callback);
+        _work_queue.enqueue(work_item);
+        return;
+    }
+
+    auto transfer = std::make_shared<Transfer>();
+    transfer->url = url;
+    transfer->local_path = local_path;
+    transfer->progress.progress_callback = progress_callback;
+    transfer->file = fopen(local_path.c_str(), "wb");
+    if (transfer->file == nullptr) {
+        LogErr() << "Could not open " << local_path << " for download";
+        if (progress_callback != nullptr) {
+            progress_callback(0, Status::Error, CURLcode::CURLE_WRITE_ERROR);
+        }
+        return;
+    }
+
+    add_transfer(transfer);
 }
 
 bool HttpLoader::upload_sync(const std::string& target_url, const std::string& local_path)
@@ -85,6 +163,17 @@ void HttpLoader::work_thread(HttpLoader* self)
 void HttpLoader::do_item(
     const std::shared_ptr<WorkItem>& item, const std::shared_ptr<ICurlWrapper>& curl_wrapper)
 {
+    auto download_text_item = std::dynamic_pointer_cast<DownloadTextItem>(item);
+    if (nullptr != download_text_item) {
+        std::string content;
+        const bool success = curl_wrapper->download_text(download_text_item->get_url(), content);
+        const auto callback = download_text_item->get_callback();
+        if (callback) {
+            callback(success, content);
+        }
+        return;
+    }
+
     auto download_item = std::dynamic_pointer_cast<DownloadItem>(item);
     if (nullptr != download_item) {
         do_download(download_item, curl_wrapper);
@@ -116,8 +205,421 @@ bool HttpLoader::do_upload(
 
 bool HttpLoader::download_text_sync(const std::string& url, std::string& content)
 {
-    bool success = _curl_wrapper->download_text(url, content);
-    return success;
+    if (!_use_multi) {
+        bool success = _curl_wrapper->download_text(url, content);
+        return success;
+    }
+
+    // Go through the multi handle as well to use the cache and open connections.
+    auto prom = std::make_shared<std::promise<bool>>();
+    auto fut = prom->get_future();
+    download_text_async(url, [prom, &content](bool success, const std::string& result) {
+        content = result;
+        prom->set_value(success);
+    });
+    return fut.get();
+}
+
+void* HttpLoader::download_text_async(const std::string& url, const text_callback_t& callback)
+{
+    if (!_use_multi) {
+        auto work_item = std::make_shared<DownloadTextItem>(url, callback);
+        _work_queue.enqueue(work_item);
+        return nullptr;
+    }
+
+    auto transfer = std::make_shared<Transfer>();
+    transfer->url = url;
+    transfer->text_callback = callback;
+
+    return add_transfer(transfer);
+}
+
+void HttpLoader::cancel(void* cookie)
+{
+    if (cookie == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_multi_mutex);
+    auto it = _transfers.find(cookie);
+    if (it == _transfers.end()) {
+        return;
+    }
+    it->second->cancelled = true;
+    curl_multi_wakeup(_multi_handle);
+}
+
+void* HttpLoader::add_transfer(const std::shared_ptr<Transfer>& transfer)
+{
+    {
+        std::lock_guard<std::mutex> lock(_multi_mutex);
+
+        if (!_should_exit && _multi_handle == nullptr) {
+            _multi_handle = curl_multi_init();
+            if (_multi_handle != nullptr) {
+                // Allow a few parallel transfers to the same camera while
+                // reusing the connections afterwards.
+                curl_multi_setopt(_multi_handle, CURLMOPT_MAX_HOST_CONNECTIONS, 4L);
+                curl_multi_setopt(_multi_handle, CURLMOPT_MAXCONNECTS, 16L);
+            }
+        }
+
+        if (!_should_exit && _multi_handle != nullptr) {
+            if (_multi_thread == nullptr) {
+                _multi_thread = new std::thread(multi_thread, this);
+            }
+
+            void* cookie = reinterpret_cast<void*>(++_last_cookie);
+            _transfers.emplace(cookie, transfer);
+            curl_multi_wakeup(_multi_handle);
+
+            return cookie;
+        }
+    }
+
+    if (_should_exit) {
+        LogErr() << "Error: cannot start transfer because the loader is stopped.";
+    } else {
+        LogErr() << "Error: cannot start transfer because of curl initialization error.";
+    }
+    if (transfer->file != nullptr) {
+        fclose(transfer->file);
+        transfer->file = nullptr;
+        remove(transfer->local_path.c_str());
+    }
+    report_failure(*transfer, CURLE_FAILED_INIT);
+    return nullptr;
+}
+
+void HttpLoader::multi_thread(HttpLoader* self)
+{
+    std::vector<std::shared_ptr<Transfer>> failed;
+
+    while (!self->_should_exit) {
+        {
+            std::lock_guard<std::mutex> lock(self->_multi_mutex);
+            self->update_transfers(failed);
+        }
+        for (const auto& transfer : failed) {
+            report_failure(*transfer, CURLE_FAILED_INIT);
+        }
+        failed.clear();
+
+        int still_running = 0;
+        curl_multi_perform(self->_multi_handle, &still_running);
+
+        int msgs_left = 0;
+        CURLMsg* msg;
+        while ((msg = curl_multi_info_read(self->_multi_handle, &msgs_left)) != nullptr) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            void* cookie = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &cookie);
+            self->finish_transfer(cookie, msg->data.result);
+        }
+
+        curl_multi_poll(self->_multi_handle, nullptr, 0, 1000, nullptr);
+    }
+
+    // Clean up whatever is left. Transfers which were not cancelled have
+    // failed and are told so once the lock is released.
+    {
+        std::lock_guard<std::mutex> lock(self->_multi_mutex);
+        for (auto& entry : self->_transfers) {
+            if (!entry.second->cancelled) {
+                failed.push_back(entry.second);
+                entry.second->cancelled = true;
+            }
+        }
+        self->update_transfers(failed);
+        curl_multi_cleanup(self->_multi_handle);
+        self->_multi_handle = nullptr;
+    }
+    for (const auto& transfer : failed) {
+        report_failure(*transfer, CURLE_ABORTED_BY_CALLBACK);
+    }
+}
+
+void HttpLoader::update_transfers(std::vector<std::shared_ptr<Transfer>>& failed)
+{
+    for (auto it = _transfers.begin(); it != _transfers.end();) {
+        auto& transfer = *it->second;
+        if (transfer.cancelled) {
+            if (transfer.easy != nullptr) {
+                curl_multi_remove_handle(_multi_handle, transfer.easy);
+                curl_easy_cleanup(transfer.easy);
+            }
+            curl_slist_free_all(transfer.headers);
+            if (transfer.file != nullptr) {
+                fclose(transfer.file);
+                remove(transfer.local_path.c_str());
+            }
+            it = _transfers.erase(it);
+            continue;
+        }
+
+        if (!transfer.started) {
+            transfer.started = true;
+            transfer.easy = curl_easy_init();
+            if (transfer.easy == nullptr) {
+                LogErr() << "Error: cannot start transfer because of curl initialization error.";
+                failed.push_back(it->second);
+                // Cleaned up right away as if it was cancelled.
+                transfer.cancelled = true;
+                continue;
+            }
+            curl_easy_setopt(transfer.easy, CURLOPT_PRIVATE, it->first);
+            start_transfer(transfer);
+            curl_multi_add_handle(_multi_handle, transfer.easy);
+        }
+        ++it;
+    }
+}
+
+static size_t write_to_string(void* contents, size_t size, size_t nmemb, void* userp)
+{
+    reinterpret_cast<std::string*>(userp)->append(reinterpret_cast<char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+static bool header_matches(const std::string& line, const char* name, std::string& value)
+{
+    const size_t name_len = strlen(name);
+    if (line.size() <= name_len || line[name_len] != ':') {
+        return false;
+    }
+    for (size_t i = 0; i < name_len; ++i) {
+        if (std::tolower(static_cast<unsigned char>(line[i])) != name[i]) {
+            return false;
+        }
+    }
+    const auto begin = line.find_first_not_of(" \t", name_len + 1);
+    const auto end = line.find_last_not_of(" \t\r\n");
+    value = (begin == std::string::npos) ? std::string() : line.substr(begin, end - begin + 1);
+    return true;
+}
+
+static size_t header_callback(char* buffer, size_t size, size_t nitems, void* userp)
+{
+    auto& response_headers = *reinterpret_cast<ResponseHeaders*>(userp);
+    const std::string line(buffer, size * nitems);
+
+    if (line.compare(0, 5, "HTTP/") == 0) {
+        // A new response, e.g. after a redirect.
+        response_headers = ResponseHeaders{};
+    } else if (!header_matches(line, "etag", response_headers.etag)) {
+        header_matches(line, "last-modified", response_headers.last_modified);
+    }
+
+    return size * nitems;
+}
+
+static int download_progress_update(
+    void* p, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+    UNUSED(ultotal);
+    UNUSED(ulnow);
+
+    auto* myp = reinterpret_cast<dl_up_progress*>(p);
+
+    if (myp->progress_callback == nullptr) {
+        return 0;
+    }
+
+    if (dltotal == 0 || dlnow == 0) {
+        return myp->progress_callback(0, Status::Idle, CURLcode::CURLE_OK);
+    }
+
+    int percentage = static_cast<int>(100 * dlnow / dltotal);
+
+    if (percentage > myp->progress_in_percentage) {
+        myp->progress_in_percentage = percentage;
+        return myp->progress_callback(percentage, Status::Downloading, CURLcode::CURLE_OK);
+    }
+
+    return 0;
+}
+
+static bool read_cache(
+    const std::string& directory,
+    const std::string& url,
+    std::string& etag,
+    std::string& last_modified,
+    std::string& content)
+{
+    if (directory.empty()) {
+        return false;
+    }
+
+    std::ifstream file(directory + "/" + cache_file_name(url), std::ios::binary);
+    std::string cached_url;
+    if (!file || !std::getline(file, cached_url) || cached_url != url ||
+        !std::getline(file, etag) || !std::getline(file, last_modified)) {
+        return false;
+    }
+
+    content.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static void write_cache(
+    const std::string& directory,
+    const std::string& url,
+    const std::string& etag,
+    const std::string& last_modified,
+    const std::string& content)
+{
+    if (directory.empty() || url.find('\n') != std::string::npos ||
+        !create_cache_directory(directory)) {
+        return;
+    }
+
+    const auto path = directory + "/" + cache_file_name(url);
+    const auto temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file << url << '\n' << etag << '\n' << last_modified << '\n';
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+        file.close();
+        if (file.fail()) {
+            remove(temp_path.c_str());
+            return;
+        }
+    }
+    remove(path.c_str());
+    if (rename(temp_path.c_str(), path.c_str()) != 0) {
+        remove(temp_path.c_str());
+    }
+}
+
+void HttpLoader::start_transfer(Transfer& transfer)
+{
+    CURL* curl = transfer.easy;
+
+    curl_easy_setopt(curl, CURLOPT_URL, transfer.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
+    // Give up on transfers which have stalled, rather than keeping them, and
+    // the connection, forever. Slow but steady transfers can take their time.
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 30L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+
+    if (transfer.file != nullptr) {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, nullptr);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, transfer.file);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, download_progress_update);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &transfer.progress);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        return;
+    }
+
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_to_string);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer.content);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer.response_headers);
+
+    // Ask the server to only send the content if it has changed since we cached it.
+    std::string etag;
+    std::string last_modified;
+    if (read_cache(_cache_directory, transfer.url, etag, last_modified, transfer.cached_content)) {
+        if (!etag.empty()) {
+            transfer.headers =
+                curl_slist_append(transfer.headers, ("If-None-Match: " + etag).c_str());
+        }
+        if (!last_modified.empty()) {
+            transfer.headers = curl_slist_append(
+                transfer.headers, ("If-Modified-Since: " + last_modified).c_str());
+        }
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.headers);
+    }
+}
+
+void HttpLoader::finish_transfer(void* cookie, CURLcode curl_result)
+{
+    std::shared_ptr<Transfer> transfer;
+    {
+        std::lock_guard<std::mutex> lock(_multi_mutex);
+        auto it = _transfers.find(cookie);
+        if (it == _transfers.end()) {
+            return;
+        }
+        transfer = std::move(it->second);
+        _transfers.erase(it);
+
+        curl_multi_remove_handle(_multi_handle, transfer->easy);
+        if (transfer->cancelled) {
+            curl_easy_cleanup(transfer->easy);
+            curl_slist_free_all(transfer->headers);
+            if (transfer->file != nullptr) {
+                fclose(transfer->file);
+                remove(transfer->local_path.c_str());
+            }
+            return;
+        }
+    }
+
+    long response_code = 0;
+    curl_easy_getinfo(transfer->easy, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_cleanup(transfer->easy);
+    curl_slist_free_all(transfer->headers);
+
+    const bool success = (curl_result == CURLE_OK && response_code < 400);
+
+    if (transfer->file != nullptr) {
+        fclose(transfer->file);
+        const auto progress_callback = transfer->progress.progress_callback;
+        if (success) {
+            if (progress_callback != nullptr) {
+                progress_callback(100, Status::Finished, curl_result);
+            }
+        } else {
+            remove(transfer->local_path.c_str());
+            LogErr() << "Error while downloading file " << transfer->url << ": "
+                     << (curl_result != CURLE_OK ? curl_easy_strerror(curl_result) :
+                                                   std::to_string(response_code));
+            if (progress_callback != nullptr) {
+                progress_callback(
+                    0,
+                    Status::Error,
+                    (curl_result != CURLE_OK) ? curl_result : CURLE_HTTP_RETURNED_ERROR);
+            }
+        }
+        return;
+    }
+
+    if (success && response_code == 304) {
+        transfer->content = std::move(transfer->cached_content);
+    } else if (
+        success && (!transfer->response_headers.etag.empty() ||
+                    !transfer->response_headers.last_modified.empty())) {
+        write_cache(
+            _cache_directory,
+            transfer->url,
+            transfer->response_headers.etag,
+            transfer->response_headers.last_modified,
+            transfer->content);
+    } else if (!success) {
+        LogErr() << "Error while downloading " << transfer->url << ": "
+                 << (curl_result != CURLE_OK ? curl_easy_strerror(curl_result) :
+                                               std::to_string(response_code));
+    }
+
+    if (transfer->text_callback) {
+        transfer->text_callback(success, transfer->content);
+    }
+}
+
+void HttpLoader::report_failure(Transfer& transfer, CURLcode curl_result)
+{
+    if (transfer.text_callback) {
+        transfer.text_callback(false, std::string());
+    } else if (transfer.progress.progress_callback != nullptr) {
+        transfer.progress.progress_callback(0, Status::Error, curl_result);
+    }
 }
 
 } // namespace mavsdk
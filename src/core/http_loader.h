@@ -2,8 +2,12 @@
 
 #include <thread>
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "safe_queue.h"
 #include "curl_wrapper.h"
 
@@ -11,25 +15,52 @@ namespace mavsdk {
 
 class ICurlWrapper;
 
+// Downloads and uploads files over HTTP.
+//
+// Asynchronous transfers run concurrently on one thread using a curl multi
+// handle, so connections to the same host are kept alive and reused. Text
+// downloads are cached in a directory using ETag and Last-Modified, so that
+// content which has not changed is not transferred again.
 class HttpLoader {
 public:
 #ifdef TESTING
     HttpLoader(const std::shared_ptr<ICurlWrapper>& curl_wrapper);
 #endif
 
-    explicit HttpLoader();
+    explicit HttpLoader(const std::string& cache_directory = default_cache_directory());
     ~HttpLoader();
 
+    static std::string default_cache_directory();
+
     void start();
     void stop();
 
     bool download_sync(const std::string& url, const std::string& local_path);
     bool download_text_sync(const std::string& url, std::string& content);
+    // The progress callback ends with Status::Finished or Status::Error, the
+    // latter also if the download can't be started or the loader is stopped
+    // before it is done.
     void download_async(
         const std::string& url,
         const std::string& local_path,
         const progress_callback_t& progress_callback = nullptr);
 
+    typedef std::function<void(bool success, const std::string& content)> text_callback_t;
+
+    // The callback is called from the loader's thread, so it must not block
+    // and must not call download_text_sync. Ideally it hands the result over
+    // to another thread, see cancel().
+    // The callback is called exactly once, unless the download is cancelled.
+    // If the download can't be started, or the loader is stopped before it
+    // is done, that is with success false, possibly before this returns.
+    // Returns a cookie which can be used to cancel the download.
+    void* download_text_async(const std::string& url, const text_callback_t& callback);
+
+    // After this returns, the callback of the download is not called anymore,
+    // unless it is running already. That one is not waited for, so that the
+    // callback is free to use whatever the caller of cancel holds.
+    void cancel(void* cookie);
+
     bool upload_sync(const std::string& target_url, const std::string& local_path);
     void upload_async(
         const std::string& target_url,
@@ -52,15 +83,21 @@ private:
 
     class DownloadTextItem : public WorkItem {
     public:
-        DownloadTextItem(const std::string& url) : _url(url) {}
+        DownloadTextItem(const std::string& url, const text_callback_t& callback) :
+            _url(url),
+            _callback(callback)
+        {}
 
         std::string get_url() const { return _url; }
 
+        text_callback_t get_callback() const { return _callback; }
+
         DownloadTextItem(DownloadTextItem&) = delete;
         DownloadTextItem operator=(DownloadTextItem&) = delete;
 
     private:
         std::string _url;
+        text_callback_t _callback{};
     };
 
     class DownloadItem : public WorkItem {
@@ -124,12 +161,34 @@ private:
     static bool do_upload(
         const std::shared_ptr<UploadItem>& item, const std::shared_ptr<ICurlWrapper>& curl_wrapper);
 
+    struct Transfer;
+
+    void* add_transfer(const std::shared_ptr<Transfer>& transfer);
+    static void multi_thread(HttpLoader* self);
+    // Assume to have the lock for _multi_mutex. Transfers which could not be
+    // started are appended to failed, for the caller to report them without
+    // the lock.
+    void update_transfers(std::vector<std::shared_ptr<Transfer>>& failed);
+    void start_transfer(Transfer& transfer);
+    void finish_transfer(void* cookie, CURLcode curl_result);
+    static void report_failure(Transfer& transfer, CURLcode curl_result);
+
     std::shared_ptr<ICurlWrapper> _curl_wrapper;
 
     SafeQueue<std::shared_ptr<WorkItem>> _work_queue{};
     std::thread* _work_thread = nullptr;
 
     std::atomic<bool> _should_exit{false};
+
+    // Only used without an injected curl wrapper.
+    bool _use_multi{true};
+    const std::string _cache_directory;
+
+    std::mutex _multi_mutex{};
+    std::thread* _multi_thread = nullptr;
+    CURLM* _multi_handle = nullptr;
+    std::unordered_map<void*, std::shared_ptr<Transfer>> _transfers{};
+    uintptr_t _last_cookie{0};
 };
 
 } // namespace mavsdk
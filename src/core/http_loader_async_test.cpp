@@ -0,0 +1,540 @@
+#include "http_loader.h"
+#include "cache_directory.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#if defined(LINUX)
+#include <dlfcn.h>
+#endif
+
+using namespace mavsdk;
+
+#if defined(LINUX)
+// Fakes for libcurl's handle constructors, so that the tests can make them
+// fail. They replace the ones of libcurl in the whole test binary and
+// forward to them unless told otherwise. This relies on symbol
+// interposition, which is why it is only done on Linux.
+static std::atomic<bool> fail_curl_easy_init{false};
+static std::atomic<bool> fail_curl_multi_init{false};
+
+extern "C" CURL* curl_easy_init()
+{
+    static const auto real_curl_easy_init =
+        reinterpret_cast<CURL* (*)()>(dlsym(RTLD_NEXT, "curl_easy_init"));
+    return fail_curl_easy_init ? nullptr : real_curl_easy_init();
+}
+
+extern "C" CURLM* curl_multi_init()
+{
+    static const auto real_curl_multi_init =
+        reinterpret_cast<CURLM* (*)()>(dlsym(RTLD_NEXT, "curl_multi_init"));
+    return fail_curl_multi_init ? nullptr : real_curl_multi_init();
+}
+#endif
+
+// Minimal HTTP/1.1 server on localhost supporting keep-alive and ETags.
+class HttpStubServer {
+public:
+    struct Resource {
+        std::string body{};
+        std::string etag{};
+        int delay_ms{0};
+    };
+
+    HttpStubServer()
+    {
+        _listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        int yes = 1;
+        setsockopt(_listen_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(_listen_fd, 16);
+
+        socklen_t len = sizeof(addr);
+        getsockname(_listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        _port = ntohs(addr.sin_port);
+
+        _accept_thread = std::thread([this]() { accept_connections(); });
+    }
+
+    ~HttpStubServer()
+    {
+        _should_exit = true;
+        shutdown(_listen_fd, SHUT_RDWR);
+        close(_listen_fd);
+        _accept_thread.join();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const int fd : _client_fds) {
+                shutdown(fd, SHUT_RDWR);
+            }
+        }
+        for (auto& thread : _client_threads) {
+            thread.join();
+        }
+    }
+
+    std::string url(const std::string& path) const
+    {
+        return "http://127.0.0.1:" + std::to_string(_port) + path;
+    }
+
+    void add(const std::string& path, const Resource& resource)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _resources[path] = resource;
+    }
+
+    int connections() const { return _connections; }
+    int requests() const { return _requests; }
+    int not_modified() const { return _not_modified; }
+
+private:
+    void accept_connections()
+    {
+        while (!_should_exit) {
+            const int fd = accept(_listen_fd, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+            ++_connections;
+            std::lock_guard<std::mutex> lock(_mutex);
+            _client_fds.push_back(fd);
+            _client_threads.emplace_back([this, fd]() { serve(fd); });
+        }
+    }
+
+    void serve(int fd)
+    {
+        std::string buffer;
+        char chunk[1024];
+        while (true) {
+            const auto header_end = buffer.find("\r\n\r\n");
+            if (header_end == std::string::npos) {
+                const auto received = recv(fd, chunk, sizeof(chunk), 0);
+                if (received <= 0) {
+                    break;
+                }
+                buffer.append(chunk, static_cast<size_t>(received));
+                continue;
+            }
+
+            const std::string request = buffer.substr(0, header_end);
+            buffer.erase(0, header_end + 4);
+            ++_requests;
+
+            const auto path_begin = request.find(' ') + 1;
+            const std::string path =
+                request.substr(path_begin, request.find(' ', path_begin) - path_begin);
+
+            std::string if_none_match;
+            const auto inm = request.find("If-None-Match: ");
+            if (inm != std::string::npos) {
+                const auto value_begin = inm + 15;
+                if_none_match = request.substr(
+                    value_begin, request.find("\r\n", value_begin) - value_begin);
+            }
+
+            Resource resource;
+            bool found;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                const auto it = _resources.find(path);
+                found = (it != _resources.end());
+                if (found) {
+                    resource = it->second;
+                }
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(resource.delay_ms));
+
+            std::string response;
+            if (!found) {
+                response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+            } else if (!resource.etag.empty() && if_none_match == resource.etag) {
+                ++_not_modified;
+                response = "HTTP/1.1 304 Not Modified\r\nETag: " + resource.etag + "\r\n\r\n";
+            } else {
+                response = "HTTP/1.1 200 OK\r\nContent-Length: " +
+                           std::to_string(resource.body.size()) + "\r\n";
+                if (!resource.etag.empty()) {
+                    response += "ETag: " + resource.etag + "\r\n";
+                }
+                response += "\r\n" + resource.body;
+            }
+            send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+        }
+        close(fd);
+    }
+
+    int _listen_fd{-1};
+    uint16_t _port{0};
+    std::atomic<bool> _should_exit{false};
+    std::atomic<int> _connections{0};
+    std::atomic<int> _requests{0};
+    std::atomic<int> _not_modified{0};
+
+    std::mutex _mutex{};
+    std::map<std::string, Resource> _resources{};
+    std::vector<int> _client_fds{};
+    std::vector<std::thread> _client_threads{};
+    std::thread _accept_thread{};
+};
+
+// Waits for a number of text downloads to finish.
+class TextResults {
+public:
+    HttpLoader::text_callback_t callback()
+    {
+        return [this](bool success, const std::string& content) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _results.emplace_back(success, content);
+            _cv.notify_all();
+        };
+    }
+
+    bool wait_for(size_t num, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cv.wait_for(lock, timeout, [this, num]() { return _results.size() >= num; });
+    }
+
+    std::vector<std::pair<bool, std::string>> results()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _results;
+    }
+
+private:
+    std::mutex _mutex{};
+    std::condition_variable _cv{};
+    std::vector<std::pair<bool, std::string>> _results{};
+};
+
+TEST(HttpLoaderAsync, DownloadText)
+{
+    HttpStubServer server;
+    server.add("/definition.xml", {"<mavlinkcamera/>", "", 0});
+
+    HttpLoader http_loader("");
+    TextResults results;
+    http_loader.download_text_async(server.url("/definition.xml"), results.callback());
+
+    ASSERT_TRUE(results.wait_for(1));
+    EXPECT_TRUE(results.results()[0].first);
+    EXPECT_EQ(results.results()[0].second, "<mavlinkcamera/>");
+
+    std::string content;
+    EXPECT_TRUE(http_loader.download_text_sync(server.url("/definition.xml"), content));
+    EXPECT_EQ(content, "<mavlinkcamera/>");
+}
+
+TEST(HttpLoaderAsync, NotFound)
+{
+    HttpStubServer server;
+
+    HttpLoader http_loader("");
+    TextResults results;
+    http_loader.download_text_async(server.url("/missing.xml"), results.callback());
+
+    ASSERT_TRUE(results.wait_for(1));
+    EXPECT_FALSE(results.results()[0].first);
+}
+
+TEST(HttpLoaderAsync, ConcurrentDownloads)
+{
+    HttpStubServer server;
+    server.add("/1.xml", {"one", "", 500});
+    server.add("/2.xml", {"two", "", 500});
+    server.add("/3.xml", {"three", "", 500});
+
+    HttpLoader http_loader("");
+    TextResults results;
+
+    const auto start = std::chrono::steady_clock::now();
+    http_loader.download_text_async(server.url("/1.xml"), results.callback());
+    http_loader.download_text_async(server.url("/2.xml"), results.callback());
+    http_loader.download_text_async(server.url("/3.xml"), results.callback());
+    ASSERT_TRUE(results.wait_for(3));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // One after the other would take at least 1.5 s.
+    EXPECT_LT(elapsed, std::chrono::milliseconds(1200));
+    for (const auto& result : results.results()) {
+        EXPECT_TRUE(result.first);
+    }
+}
+
+TEST(HttpLoaderAsync, ConnectionIsReused)
+{
+    HttpStubServer server;
+    server.add("/definition.xml", {"content", "", 0});
+
+    HttpLoader http_loader("");
+    TextResults results;
+
+    for (size_t i = 1; i <= 3; ++i) {
+        http_loader.download_text_async(server.url("/definition.xml"), results.callback());
+        ASSERT_TRUE(results.wait_for(i));
+    }
+
+    EXPECT_EQ(server.requests(), 3);
+    EXPECT_EQ(server.connections(), 1);
+}
+
+TEST(HttpLoaderAsync, NotModifiedIsServedFromCache)
+{
+    const std::string cache_directory = "http_loader_async_test_cache";
+
+    HttpStubServer server;
+    server.add("/definition.xml", {"cached content", "\"v1\"", 0});
+    const std::string cache_path =
+        cache_directory + "/" + cache_file_name(server.url("/definition.xml"));
+
+    {
+        HttpLoader http_loader(cache_directory);
+        TextResults results;
+        http_loader.download_text_async(server.url("/definition.xml"), results.callback());
+        ASSERT_TRUE(results.wait_for(1));
+        EXPECT_EQ(results.results()[0].second, "cached content");
+    }
+    EXPECT_EQ(server.not_modified(), 0);
+
+    {
+        // A new loader uses what was cached by the last one.
+        HttpLoader http_loader(cache_directory);
+        TextResults results;
+        http_loader.download_text_async(server.url("/definition.xml"), results.callback());
+        ASSERT_TRUE(results.wait_for(1));
+        EXPECT_TRUE(results.results()[0].first);
+        EXPECT_EQ(results.results()[0].second, "cached content");
+    }
+    EXPECT_EQ(server.not_modified(), 1);
+
+    // Changed on the server.
+    server.add("/definition.xml", {"new content", "\"v2\"", 0});
+    {
+        HttpLoader http_loader(cache_directory);
+        TextResults results;
+        http_loader.download_text_async(server.url("/definition.xml"), results.callback());
+        ASSERT_TRUE(results.wait_for(1));
+        EXPECT_EQ(results.results()[0].second, "new content");
+    }
+    EXPECT_EQ(server.not_modified(), 1);
+
+    remove(cache_path.c_str());
+    rmdir(cache_directory.c_str());
+}
+
+TEST(HttpLoaderAsync, Cancel)
+{
+    HttpStubServer server;
+    server.add("/slow.xml", {"slow", "", 300});
+
+    HttpLoader http_loader("");
+    TextResults results;
+    auto cookie = http_loader.download_text_async(server.url("/slow.xml"), results.callback());
+    http_loader.cancel(cookie);
+
+    EXPECT_FALSE(results.wait_for(1, std::chrono::milliseconds(600)));
+}
+
+TEST(HttpLoaderAsync, DownloadFile)
+{
+    const std::string local_path = "http_loader_async_test.bin";
+    const std::string body(100000, 'x');
+
+    HttpStubServer server;
+    server.add("/media.jpg", {body, "", 0});
+
+    HttpLoader http_loader("");
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;
+    http_loader.download_async(
+        server.url("/media.jpg"),
+        local_path,
+        [&](int /*progress*/, Status status, CURLcode /*curl_code*/) -> int {
+            if (status == Status::Finished || status == Status::Error) {
+                std::lock_guard<std::mutex> lock(mutex);
+                finished = (status == Status::Finished);
+                cv.notify_all();
+            }
+            return 0;
+        });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&]() { return finished; }));
+    }
+
+    std::ifstream file(local_path, std::ios::binary);
+    const std::string content(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, body);
+
+    remove(local_path.c_str());
+}
+
+// Waits for the end of a file download.
+class FileResult {
+public:
+    progress_callback_t callback()
+    {
+        return [this](int /*progress*/, Status status, CURLcode /*curl_code*/) -> int {
+            if (status == Status::Finished || status == Status::Error) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _statuses.push_back(status);
+                _cv.notify_all();
+            }
+            return 0;
+        };
+    }
+
+    bool wait(std::chrono::milliseconds timeout = std::chrono::seconds(5))
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cv.wait_for(lock, timeout, [this]() { return !_statuses.empty(); });
+    }
+
+    std::vector<Status> statuses()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _statuses;
+    }
+
+private:
+    std::mutex _mutex{};
+    std::condition_variable _cv{};
+    std::vector<Status> _statuses{};
+};
+
+#if defined(LINUX)
+TEST(HttpLoaderAsync, FailsIfMultiHandleCannotBeCreated)
+{
+    HttpStubServer server;
+    server.add("/definition.xml", {"content", "", 0});
+
+    HttpLoader http_loader("");
+
+    fail_curl_multi_init = true;
+    TextResults results;
+    EXPECT_EQ(
+        http_loader.download_text_async(server.url("/definition.xml"), results.callback()),
+        nullptr);
+    std::string content;
+    EXPECT_FALSE(http_loader.download_text_sync(server.url("/definition.xml"), content));
+
+    const std::string local_path = "http_loader_async_test_multi_init.bin";
+    FileResult file_result;
+    http_loader.download_async(server.url("/definition.xml"), local_path, file_result.callback());
+    fail_curl_multi_init = false;
+
+    ASSERT_TRUE(results.wait_for(1));
+    EXPECT_FALSE(results.results()[0].first);
+    ASSERT_TRUE(file_result.wait());
+    EXPECT_EQ(file_result.statuses(), std::vector<Status>({Status::Error}));
+    EXPECT_FALSE(std::ifstream(local_path).good());
+
+    // It is tried again with the next download.
+    EXPECT_TRUE(http_loader.download_text_sync(server.url("/definition.xml"), content));
+    EXPECT_EQ(content, "content");
+}
+
+TEST(HttpLoaderAsync, FailsIfEasyHandleCannotBeCreated)
+{
+    HttpStubServer server;
+    server.add("/definition.xml", {"content", "", 0});
+
+    HttpLoader http_loader("");
+
+    // Get the multi handle set up first.
+    std::string content;
+    ASSERT_TRUE(http_loader.download_text_sync(server.url("/definition.xml"), content));
+
+    fail_curl_easy_init = true;
+    EXPECT_FALSE(http_loader.download_text_sync(server.url("/definition.xml"), content));
+
+    const std::string local_path = "http_loader_async_test_easy_init.bin";
+    FileResult file_result;
+    http_loader.download_async(server.url("/definition.xml"), local_path, file_result.callback());
+    ASSERT_TRUE(file_result.wait());
+    fail_curl_easy_init = false;
+
+    EXPECT_EQ(file_result.statuses(), std::vector<Status>({Status::Error}));
+    EXPECT_FALSE(std::ifstream(local_path).good());
+}
+
+#endif
+
+TEST(HttpLoaderAsync, StopFailsTransfersInFlight)
+{
+    HttpStubServer server;
+    server.add("/slow.xml", {"slow", "", 1000});
+
+    HttpLoader http_loader("");
+
+    TextResults results;
+    http_loader.download_text_async(server.url("/slow.xml"), results.callback());
+
+    const std::string local_path = "http_loader_async_test_stop.bin";
+    FileResult file_result;
+    http_loader.download_async(server.url("/slow.xml"), local_path, file_result.callback());
+
+    bool sync_success = true;
+    std::thread sync_thread([&]() {
+        std::string content;
+        sync_success = http_loader.download_text_sync(server.url("/slow.xml"), content);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto before = std::chrono::steady_clock::now();
+    http_loader.stop();
+    sync_thread.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::milliseconds(1000));
+
+    EXPECT_FALSE(sync_success);
+    ASSERT_TRUE(results.wait_for(1, std::chrono::milliseconds(0)));
+    EXPECT_EQ(results.results().size(), 1u);
+    EXPECT_FALSE(results.results()[0].first);
+    ASSERT_TRUE(file_result.wait(std::chrono::milliseconds(0)));
+    EXPECT_EQ(file_result.statuses(), std::vector<Status>({Status::Error}));
+    EXPECT_FALSE(std::ifstream(local_path).good());
+
+    // Nothing can be started once stopped.
+    std::string content;
+    EXPECT_FALSE(http_loader.download_text_sync(server.url("/slow.xml"), content));
+}
+
+TEST(HttpLoaderAsync, DestructionFailsTransfersInFlight)
+{
+    HttpStubServer server;
+    server.add("/slow.xml", {"slow", "", 1000});
+
+    TextResults results;
+    {
+        HttpLoader http_loader("");
+        http_loader.download_text_async(server.url("/slow.xml"), results.callback());
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    ASSERT_TRUE(results.wait_for(1, std::chrono::milliseconds(0)));
+    EXPECT_FALSE(results.results()[0].first);
+}
@@ -0,0 +1,145 @@
+#include "link_stats.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+namespace mavsdk {
+
+size_t ShardedCounter::shard_index()
+{
+    static thread_local const size_t index =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) % NUM_SHARDS;
+    return index;
+}
+
+void ConnectionStats::bytes_received(size_t num_bytes)
+{
+    _bytes_received.add(num_bytes);
+}
+
+void ConnectionStats::parse_errors(uint64_t num_errors)
+{
+    _crc_errors.add(num_errors);
+}
+
+void ConnectionStats::message_received(const mavlink_message_t& message)
+{
+    _messages_received.add(1);
+
+    const uint16_t key = static_cast<uint16_t>((message.sysid << 8) | message.compid);
+    const auto it = _last_sequence.find(key);
+    if (it == _last_sequence.end()) {
+        _last_sequence.emplace(key, message.seq);
+        return;
+    }
+
+    // The sequence number wraps around at 256. Big jumps are more likely
+    // a reboot or messages arriving out of order than this many lost.
+    const uint8_t gap = static_cast<uint8_t>(message.seq - it->second - 1);
+    if (gap > 0 && gap < 128) {
+        _messages_lost.add(gap);
+    }
+    it->second = message.seq;
+}
+
+void ConnectionStats::message_sent(const mavlink_message_t& message)
+{
+    _messages_sent.add(1);
+    _bytes_sent.add(mavlink_msg_get_send_buffer_length(&message));
+}
+
+ConnectionStats::Snapshot ConnectionStats::snapshot() const
+{
+    Snapshot snapshot;
+    snapshot.bytes_received = _bytes_received.get();
+    snapshot.bytes_sent = _bytes_sent.get();
+    snapshot.messages_received = _messages_received.get();
+    snapshot.messages_sent = _messages_sent.get();
+    snapshot.crc_errors = _crc_errors.get();
+    snapshot.messages_lost = _messages_lost.get();
+    return snapshot;
+}
+
+MessageStats::MessageStats() : _slots(new Slot[CAPACITY]) {}
+
+MessageStats::Slot* MessageStats::find_or_add(uint32_t message_id)
+{
+    // Linear probing, the first free slot is claimed for a new message.
+    const size_t start = (message_id * 2654435761u) % CAPACITY;
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        Slot& slot = _slots[(start + i) % CAPACITY];
+        uint32_t current = slot.message_id.load(std::memory_order_acquire);
+        if (current == message_id) {
+            return &slot;
+        }
+        if (current == EMPTY) {
+            if (slot.message_id.compare_exchange_strong(
+                    current, message_id, std::memory_order_acq_rel) ||
+                current == message_id) {
+                return &slot;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void MessageStats::message_handled(
+    uint32_t message_id, int64_t received_ns, int64_t handler_time_ns)
+{
+    Slot* slot = find_or_add(message_id);
+    if (slot == nullptr) {
+        return;
+    }
+
+    slot->num_received.fetch_add(1, std::memory_order_relaxed);
+
+    const int64_t last_received_ns =
+        slot->last_received_ns.exchange(received_ns, std::memory_order_relaxed);
+    if (last_received_ns != 0 && received_ns > last_received_ns) {
+        // Exponential moving average of the interval, so the rate follows changes.
+        const auto interval_ns = static_cast<double>(received_ns - last_received_ns);
+        const double average_ns = slot->interval_average_ns.load(std::memory_order_relaxed);
+        slot->interval_average_ns.store(
+            average_ns == 0.0 ? interval_ns : 0.9 * average_ns + 0.1 * interval_ns,
+            std::memory_order_relaxed);
+    }
+
+    slot->handler_time_sum_ns.fetch_add(handler_time_ns, std::memory_order_relaxed);
+    int64_t max_ns = slot->handler_time_max_ns.load(std::memory_order_relaxed);
+    while (handler_time_ns > max_ns &&
+           !slot->handler_time_max_ns.compare_exchange_weak(
+               max_ns, handler_time_ns, std::memory_order_relaxed)) {}
+}
+
+std::vector<MessageStats::Entry> MessageStats::snapshot() const
+{
+    std::vector<Entry> entries;
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        const Slot& slot = _slots[i];
+        const uint32_t message_id = slot.message_id.load(std::memory_order_acquire);
+        if (message_id == EMPTY) {
+            continue;
+        }
+
+        Entry entry;
+        entry.message_id = message_id;
+        entry.num_received = slot.num_received.load(std::memory_order_relaxed);
+        const double interval_ns = slot.interval_average_ns.load(std::memory_order_relaxed);
+        entry.rate_hz = interval_ns > 0.0 ? 1e9 / interval_ns : 0.0;
+        if (entry.num_received > 0) {
+            entry.handler_time_mean_us =
+                static_cast<double>(slot.handler_time_sum_ns.load(std::memory_order_relaxed)) /
+                static_cast<double>(entry.num_received) / 1e3;
+        }
+        entry.handler_time_max_us =
+            static_cast<double>(slot.handler_time_max_ns.load(std::memory_order_relaxed)) / 1e3;
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return lhs.message_id < rhs.message_id;
+    });
+    return entries;
+}
+
+} // namespace mavsdk
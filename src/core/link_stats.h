@@ -0,0 +1,141 @@
+#pragma once
+
+#include "mavlink_include.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace mavsdk {
+
+// A counter which many threads can add to without contending for the same
+// cache line. Every thread adds to one of a few shards, reading sums them up.
+class ShardedCounter {
+public:
+    ShardedCounter() = default;
+    ~ShardedCounter() = default;
+
+    void add(uint64_t value)
+    {
+        _shards[shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t get() const
+    {
+        uint64_t sum = 0;
+        for (const auto& shard : _shards) {
+            sum += shard.value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    static constexpr size_t NUM_SHARDS = 8;
+
+    // Non-copyable
+    ShardedCounter(const ShardedCounter&) = delete;
+    const ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+private:
+    static size_t shard_index();
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    Shard _shards[NUM_SHARDS];
+};
+
+// Counters of one connection.
+class ConnectionStats {
+public:
+    ConnectionStats() = default;
+    ~ConnectionStats() = default;
+
+    // Only called from the receiving thread of the connection.
+    void bytes_received(size_t num_bytes);
+    void parse_errors(uint64_t num_errors);
+    void message_received(const mavlink_message_t& message);
+
+    // Can be called from any thread.
+    void message_sent(const mavlink_message_t& message);
+
+    struct Snapshot {
+        uint64_t bytes_received{0};
+        uint64_t bytes_sent{0};
+        uint64_t messages_received{0};
+        uint64_t messages_sent{0};
+        // Frames dropped by the parser, mostly because of CRC errors.
+        uint64_t crc_errors{0};
+        // Missing from the sequence numbers of the received messages.
+        uint64_t messages_lost{0};
+    };
+
+    Snapshot snapshot() const;
+
+    // Non-copyable
+    ConnectionStats(const ConnectionStats&) = delete;
+    const ConnectionStats& operator=(const ConnectionStats&) = delete;
+
+private:
+    ShardedCounter _bytes_received{};
+    ShardedCounter _bytes_sent{};
+    ShardedCounter _messages_received{};
+    ShardedCounter _messages_sent{};
+    ShardedCounter _crc_errors{};
+    ShardedCounter _messages_lost{};
+
+    // Last sequence number per sysid and compid, only used by the receiving thread.
+    std::unordered_map<uint16_t, uint8_t> _last_sequence{};
+};
+
+// Counters per message id, for messages after they have been received.
+//
+// Entries are added without locking to a table of fixed size, messages which
+// don't fit anymore are not counted.
+class MessageStats {
+public:
+    MessageStats();
+    ~MessageStats() = default;
+
+    // Updating the same message from several threads at once is safe, but
+    // the rate and the maximum can be slightly off then.
+    void message_handled(uint32_t message_id, int64_t received_ns, int64_t handler_time_ns);
+
+    struct Entry {
+        uint32_t message_id{0};
+        uint64_t num_received{0};
+        double rate_hz{0.0};
+        double handler_time_mean_us{0.0};
+        double handler_time_max_us{0.0};
+    };
+
+    // Sorted by message id.
+    std::vector<Entry> snapshot() const;
+
+    static constexpr size_t CAPACITY = 512;
+
+    // Non-copyable
+    MessageStats(const MessageStats&) = delete;
+    const MessageStats& operator=(const MessageStats&) = delete;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> message_id{EMPTY};
+        std::atomic<uint64_t> num_received{0};
+        std::atomic<int64_t> last_received_ns{0};
+        std::atomic<double> interval_average_ns{0.0};
+        std::atomic<int64_t> handler_time_sum_ns{0};
+        std::atomic<int64_t> handler_time_max_ns{0};
+    };
+
+    Slot* find_or_add(uint32_t message_id);
+
+    // Message ids have 24 bits, so this never clashes.
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    std::unique_ptr<Slot[]> _slots;
+};
+
+} // namespace mavsdk
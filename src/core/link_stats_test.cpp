@@ -0,0 +1,153 @@
+#include "link_stats.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+static mavlink_message_t make_message(uint8_t sysid, uint8_t compid, uint8_t seq)
+{
+    mavlink_message_t message{};
+    message.sysid = sysid;
+    message.compid = compid;
+    message.seq = seq;
+    message.len = 9;
+    return message;
+}
+
+TEST(LinkStats, ShardedCounterSumsAllThreads)
+{
+    ShardedCounter counter;
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < 4; ++i) {
+        threads.emplace_back([&counter]() {
+            for (unsigned j = 0; j < 10000; ++j) {
+                counter.add(2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.get(), 4u * 10000u * 2u);
+}
+
+TEST(LinkStats, CountsLostMessagesPerSender)
+{
+    ConnectionStats stats;
+
+    stats.message_received(make_message(1, 1, 10));
+    stats.message_received(make_message(1, 1, 11));
+    // Another sender has its own sequence.
+    stats.message_received(make_message(2, 1, 200));
+    // Two missing.
+    stats.message_received(make_message(1, 1, 14));
+    stats.message_received(make_message(2, 1, 201));
+
+    auto snapshot = stats.snapshot();
+    EXPECT_EQ(snapshot.messages_received, 5u);
+    EXPECT_EQ(snapshot.messages_lost, 2u);
+}
+
+TEST(LinkStats, CountsLostMessagesAcrossWrap)
+{
+    ConnectionStats stats;
+
+    stats.message_received(make_message(1, 1, 254));
+    stats.message_received(make_message(1, 1, 255));
+    stats.message_received(make_message(1, 1, 0));
+    // 1 missing.
+    stats.message_received(make_message(1, 1, 2));
+
+    EXPECT_EQ(stats.snapshot().messages_lost, 1u);
+}
+
+TEST(LinkStats, IgnoresDuplicatesAndBigJumps)
+{
+    ConnectionStats stats;
+
+    stats.message_received(make_message(1, 1, 5));
+    stats.message_received(make_message(1, 1, 5));
+    stats.message_received(make_message(1, 1, 4));
+    stats.message_received(make_message(1, 1, 200));
+
+    EXPECT_EQ(stats.snapshot().messages_lost, 0u);
+}
+
+TEST(LinkStats, CountsBytesAndErrors)
+{
+    ConnectionStats stats;
+    const auto message = make_message(1, 1, 0);
+
+    stats.bytes_received(100);
+    stats.bytes_received(20);
+    stats.parse_errors(3);
+    stats.message_sent(message);
+    stats.message_sent(message);
+
+    auto snapshot = stats.snapshot();
+    EXPECT_EQ(snapshot.bytes_received, 120u);
+    EXPECT_EQ(snapshot.crc_errors, 3u);
+    EXPECT_EQ(snapshot.messages_sent, 2u);
+    EXPECT_EQ(snapshot.bytes_sent, 2u * mavlink_msg_get_send_buffer_length(&message));
+}
+
+TEST(LinkStats, MessageStatsRateAndHandlerTime)
+{
+    MessageStats stats;
+
+    // 10 Hz with handlers taking 1 and 3 us.
+    for (int64_t i = 1; i <= 20; ++i) {
+        stats.message_handled(30, i * 100000000, i % 2 == 0 ? 1000 : 3000);
+    }
+    stats.message_handled(0, 1000, 500);
+
+    const auto entries = stats.snapshot();
+    ASSERT_EQ(entries.size(), 2u);
+
+    EXPECT_EQ(entries[0].message_id, 0u);
+    EXPECT_EQ(entries[0].num_received, 1u);
+    EXPECT_DOUBLE_EQ(entries[0].rate_hz, 0.0);
+
+    EXPECT_EQ(entries[1].message_id, 30u);
+    EXPECT_EQ(entries[1].num_received, 20u);
+    EXPECT_NEAR(entries[1].rate_hz, 10.0, 1e-6);
+    EXPECT_DOUBLE_EQ(entries[1].handler_time_mean_us, 2.0);
+    EXPECT_DOUBLE_EQ(entries[1].handler_time_max_us, 3.0);
+}
+
+TEST(LinkStats, MessageStatsFromSeveralThreads)
+{
+    MessageStats stats;
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < 4; ++i) {
+        threads.emplace_back([&stats]() {
+            for (uint32_t j = 0; j < 1000; ++j) {
+                stats.message_handled(j % 100, 1000 + j, 10);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto entries = stats.snapshot();
+    ASSERT_EQ(entries.size(), 100u);
+    for (const auto& entry : entries) {
+        EXPECT_EQ(entry.num_received, 40u);
+    }
+}
+
+TEST(LinkStats, MessageStatsIgnoresMessagesBeyondCapacity)
+{
+    MessageStats stats;
+
+    for (uint32_t id = 0; id < MessageStats::CAPACITY + 10; ++id) {
+        stats.message_handled(id, 1, 1);
+    }
+
+    EXPECT_EQ(stats.snapshot().size(), MessageStats::CAPACITY);
+}
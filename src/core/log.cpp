@@ -1,5 +1,22 @@
 #include "log.h"
+#include "bounded_queue.h"
 #include "global_include.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(ANDROID)
+#include <android/log.h>
+#endif
 
 #if defined(WINDOWS)
 #include "Windows.h"
@@ -70,4 +87,438 @@ void set_color(Color color)
 #endif
 }
 
+namespace {
+
+// Debug and above by default, set_level can change it at runtime.
+std::atomic<int> runtime_level{static_cast<int>(log::Level::Debug)};
+
+struct LogRecord {
+    int64_t time_us{0};
+    log::Level level{log::Level::Debug};
+    // Always points to a string literal, so it is safe to keep around.
+    const char* file{nullptr};
+    int line{0};
+    std::string message{};
+};
+
+// Set while writing a record, so that messages logged from within a
+// callback are printed directly instead of coming back around.
+thread_local bool writing_record = false;
+
+// Takes the records from the threads logging and writes them from a thread
+// of its own, so that the callers don't wait for the console or files.
+//
+// The binary file starts with "MAVSDKLOG" and a version byte, followed by
+// records of: time since epoch in us (u64), level (u8), line (u32), length
+// of file name (u16), file name, length of message (u32), message. All
+// integers are little-endian.
+class LogBackend {
+public:
+    // Deliberately never destroyed, so that it can still be used while
+    // other static objects are destroyed.
+    static LogBackend& instance()
+    {
+        static auto* backend = new LogBackend();
+        return *backend;
+    }
+
+    void submit(LogRecord&& record)
+    {
+        if (_stopped || writing_record) {
+            write_directly(record);
+            return;
+        }
+
+        // Rather wait than lose messages, the queue is only ever full if
+        // something is logged in a tight loop.
+        while (!_queue.try_push(std::move(record))) {
+            wake_up();
+            std::this_thread::yield();
+            if (_stopped) {
+                write_directly(record);
+                return;
+            }
+        }
+        ++_num_submitted;
+        if (_sleeping) {
+            wake_up();
+        }
+    }
+
+    void subscribe(const log::Callback& callback)
+    {
+        std::lock_guard<std::mutex> lock(_output_mutex);
+        _callback = callback;
+    }
+
+    bool set_binary_file(const std::string& path)
+    {
+        std::lock_guard<std::mutex> lock(_output_mutex);
+        if (_binary_file.is_open()) {
+            _binary_file.close();
+        }
+        _binary_file.clear();
+
+        if (path.empty()) {
+            return true;
+        }
+
+        _binary_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!_binary_file) {
+            return false;
+        }
+        static constexpr char magic[] = "MAVSDKLOG";
+        _binary_file.write(magic, sizeof(magic) - 1);
+        _binary_file.put(static_cast<char>(BINARY_FORMAT_VERSION));
+        return static_cast<bool>(_binary_file);
+    }
+
+    void flush()
+    {
+        if (writing_record) {
+            // Called from within the callback, everything before has been written.
+            return;
+        }
+
+        if (!_stopped) {
+            const uint64_t target = _num_submitted;
+            wake_up();
+            std::unique_lock<std::mutex> lock(_flushed_mutex);
+            _flushed_cv.wait(lock, [this, target]() { return _num_written >= target || _stopped; });
+        }
+
+        std::lock_guard<std::mutex> lock(_output_mutex);
+        flush_outputs();
+    }
+
+    // Called at exit, everything logged afterwards is written directly.
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wake_mutex);
+            _should_exit = true;
+        }
+        _wake_cv.notify_one();
+
+        _thread->join();
+        delete _thread;
+        _thread = nullptr;
+
+        _stopped = true;
+        _flushed_cv.notify_all();
+
+        // In case something was pushed while the thread was exiting.
+        LogRecord record;
+        while (_queue.try_pop(record)) {
+            write_directly(record);
+        }
+
+        std::lock_guard<std::mutex> lock(_output_mutex);
+        flush_outputs();
+    }
+
+    // Non-copyable
+    LogBackend(const LogBackend&) = delete;
+    const LogBackend& operator=(const LogBackend&) = delete;
+
+private:
+    LogBackend()
+    {
+        _thread = new std::thread(&LogBackend::run, this);
+        std::atexit([]() { LogBackend::instance().stop(); });
+    }
+
+    ~LogBackend() = default;
+
+    void wake_up()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wake_mutex);
+            _has_new = true;
+        }
+        _wake_cv.notify_one();
+    }
+
+    void run()
+    {
+        std::vector<LogRecord> batch;
+        batch.reserve(QUEUE_CAPACITY);
+
+        while (true) {
+            collect_batch(batch);
+            if (!batch.empty()) {
+                write_batch(batch);
+                continue;
+            }
+
+            // Announce going to sleep before checking a last time, so that
+            // either we see the new record or the thread submitting it sees
+            // us sleeping.
+            _sleeping = true;
+            if (_num_submitted != _num_collected) {
+                _sleeping = false;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_wake_mutex);
+            // The timeout is only a safety net, we should be woken up.
+            _wake_cv.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+                return _has_new || _should_exit;
+            });
+            _has_new = false;
+            _sleeping = false;
+            if (_should_exit) {
+                lock.unlock();
+                collect_batch(batch);
+                write_batch(batch);
+                break;
+            }
+        }
+    }
+
+    void collect_batch(std::vector<LogRecord>& batch)
+    {
+        batch.clear();
+        LogRecord record;
+        while (batch.size() < QUEUE_CAPACITY && _queue.try_pop(record)) {
+            batch.push_back(std::move(record));
+        }
+        _num_collected += batch.size();
+    }
+
+    void write_batch(const std::vector<LogRecord>& batch)
+    {
+        if (batch.empty()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_output_mutex);
+            for (const auto& record : batch) {
+                write(record);
+            }
+            flush_outputs();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_flushed_mutex);
+            _num_written += batch.size();
+        }
+        _flushed_cv.notify_all();
+    }
+
+    void write_directly(const LogRecord& record)
+    {
+        if (writing_record) {
+            // Logged from within the callback.
+            write_console(record);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_output_mutex);
+        write(record);
+        flush_outputs();
+    }
+
+    // Assumes to have the lock for _output_mutex.
+    void write(const LogRecord& record)
+    {
+        writing_record = true;
+
+        bool handled = false;
+        if (_callback) {
+            handled = _callback(record.level, record.message, record.file, record.line);
+        }
+        if (!handled) {
+            write_console(record);
+        }
+        if (_binary_file.is_open()) {
+            write_binary(record);
+        }
+
+        writing_record = false;
+    }
+
+    // Assumes to have the lock for _output_mutex.
+    void flush_outputs()
+    {
+#if !defined(ANDROID)
+        std::cout.flush();
+#endif
+        if (_binary_file.is_open()) {
+            _binary_file.flush();
+        }
+    }
+
+    static void write_console(const LogRecord& record)
+    {
+#if defined(ANDROID)
+        switch (record.level) {
+            case log::Level::Debug:
+                __android_log_print(ANDROID_LOG_DEBUG, "Mavsdk", "%s", record.message.c_str());
+                break;
+            case log::Level::Info:
+                __android_log_print(ANDROID_LOG_INFO, "Mavsdk", "%s", record.message.c_str());
+                break;
+            case log::Level::Warn:
+                __android_log_print(ANDROID_LOG_WARN, "Mavsdk", "%s", record.message.c_str());
+                break;
+            case log::Level::Err:
+                __android_log_print(ANDROID_LOG_ERROR, "Mavsdk", "%s", record.message.c_str());
+                break;
+        }
+#else
+        switch (record.level) {
+            case log::Level::Debug:
+                set_color(Color::Green);
+                break;
+            case log::Level::Info:
+                set_color(Color::Blue);
+                break;
+            case log::Level::Warn:
+                set_color(Color::Yellow);
+                break;
+            case log::Level::Err:
+                set_color(Color::Red);
+                break;
+        }
+
+        // The time when the message was logged, not when it is written.
+        const time_t rawtime = static_cast<time_t>(record.time_us / 1000000);
+        struct tm* timeinfo = localtime(&rawtime);
+        char time_buffer[10]{}; // We need 8 characters + \0
+        strftime(time_buffer, sizeof(time_buffer), "%I:%M:%S", timeinfo);
+        std::cout << "[" << time_buffer;
+
+        switch (record.level) {
+            case log::Level::Debug:
+                std::cout << "|Debug] ";
+                break;
+            case log::Level::Info:
+                std::cout << "|Info ] ";
+                break;
+            case log::Level::Warn:
+                std::cout << "|Warn ] ";
+                break;
+            case log::Level::Err:
+                std::cout << "|Error] ";
+                break;
+        }
+
+        set_color(Color::Reset);
+
+        std::cout << record.message;
+        std::cout << " (" << record.file << ":" << std::dec << record.line << ")";
+
+        // No std::endl, the output is flushed once per batch.
+        std::cout << '\n';
+#endif
+    }
+
+    // Assumes to have the lock for _output_mutex.
+    void write_binary(const LogRecord& record)
+    {
+        const size_t file_len = std::min<size_t>(std::strlen(record.file), UINT16_MAX);
+        const size_t message_len = std::min<size_t>(record.message.size(), UINT32_MAX);
+
+        write_le(static_cast<uint64_t>(record.time_us), 8);
+        write_le(static_cast<uint64_t>(record.level), 1);
+        write_le(static_cast<uint64_t>(record.line), 4);
+        write_le(file_len, 2);
+        _binary_file.write(record.file, static_cast<std::streamsize>(file_len));
+        write_le(message_len, 4);
+        _binary_file.write(record.message.data(), static_cast<std::streamsize>(message_len));
+    }
+
+    // Assumes to have the lock for _output_mutex.
+    void write_le(uint64_t value, size_t num_bytes)
+    {
+        char bytes[8];
+        for (size_t i = 0; i < num_bytes; ++i) {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+        _binary_file.write(bytes, static_cast<std::streamsize>(num_bytes));
+    }
+
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+    static constexpr uint8_t BINARY_FORMAT_VERSION = 1;
+
+    BoundedQueue<LogRecord> _queue{QUEUE_CAPACITY};
+    std::atomic<uint64_t> _num_submitted{0};
+    // Only used by the logging thread.
+    uint64_t _num_collected{0};
+    std::atomic<bool> _sleeping{false};
+    std::atomic<bool> _stopped{false};
+
+    std::mutex _wake_mutex{};
+    std::condition_variable _wake_cv{};
+    bool _has_new{false};
+    bool _should_exit{false};
+
+    std::mutex _flushed_mutex{};
+    std::condition_variable _flushed_cv{};
+    uint64_t _num_written{0};
+
+    std::mutex _output_mutex{};
+    log::Callback _callback{nullptr};
+    std::ofstream _binary_file{};
+
+    std::thread* _thread{nullptr};
+};
+
+} // namespace
+
+int runtime_log_level()
+{
+    return runtime_level.load(std::memory_order_relaxed);
+}
+
+void log_message(log::Level level, const char* filename, int filenumber, std::string&& message)
+{
+    LogRecord record;
+    record.time_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+    record.level = level;
+    record.file = filename;
+    record.line = filenumber;
+    record.message = std::move(message);
+
+    LogBackend::instance().submit(std::move(record));
+
+    // Errors are often the last thing logged before a crash or abort(), so
+    // they must not be left sitting in the queue.
+    if (level == log::Level::Err) {
+        LogBackend::instance().flush();
+    }
+}
+
+namespace log {
+
+void subscribe(const Callback& callback)
+{
+    LogBackend::instance().subscribe(callback);
+}
+
+void set_level(Level level)
+{
+    runtime_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+Level get_level()
+{
+    return static_cast<Level>(runtime_level.load(std::memory_order_relaxed));
+}
+
+bool set_binary_file(const std::string& path)
+{
+    return LogBackend::instance().set_binary_file(path);
+}
+
+void flush()
+{
+    LogBackend::instance().flush();
+}
+
+} // namespace log
+
 } // namespace mavsdk
@@ -2,18 +2,26 @@
 
 #include <sstream>
 #include "global_include.h"
+#include "log_callback.h"
 
-#if defined(ANDROID)
-#include <android/log.h>
-#else
-#include <iostream>
-#include <ctime>
+// Statements below this level are compiled out.
+#ifndef MAVSDK_LOG_LEVEL_MIN
+#define MAVSDK_LOG_LEVEL_MIN 0
 #endif
 
-#define LogDebug() LogDebugDetailed(__FILENAME__, __LINE__)
-#define LogInfo() LogInfoDetailed(__FILENAME__, __LINE__)
-#define LogWarn() LogWarnDetailed(__FILENAME__, __LINE__)
-#define LogErr() LogErrDetailed(__FILENAME__, __LINE__)
+// The streamed arguments are only evaluated if the level is enabled. The
+// conditional keeps it a single expression, so it is safe to use in an if
+// without braces. LogVoidify makes both branches void, & binds more weakly
+// than <<.
+#define MAVSDK_LOG_IF_ENABLED(level, log_detailed) \
+    !mavsdk::log_enabled(level) ?                  \
+        (void)0 :                                  \
+        mavsdk::LogVoidify() & log_detailed(__FILENAME__, __LINE__)
+
+#define LogDebug() MAVSDK_LOG_IF_ENABLED(mavsdk::log::Level::Debug, mavsdk::LogDebugDetailed)
+#define LogInfo() MAVSDK_LOG_IF_ENABLED(mavsdk::log::Level::Info, mavsdk::LogInfoDetailed)
+#define LogWarn() MAVSDK_LOG_IF_ENABLED(mavsdk::log::Level::Warn, mavsdk::LogWarnDetailed)
+#define LogErr() MAVSDK_LOG_IF_ENABLED(mavsdk::log::Level::Err, mavsdk::LogErrDetailed)
 
 namespace mavsdk {
 
@@ -21,6 +29,18 @@ enum class Color { Red, Green, Yellow, Blue, Gray, Reset };
 
 void set_color(Color color);
 
+int runtime_log_level();
+
+inline bool log_enabled(log::Level level)
+{
+    return static_cast<int>(level) >= MAVSDK_LOG_LEVEL_MIN &&
+           static_cast<int>(level) >= runtime_log_level();
+}
+
+// Hands the message over to the logging thread, which adds the time and
+// writes it out. For errors it waits until the message has been written.
+void log_message(log::Level level, const char* filename, int filenumber, std::string&& message);
+
 class LogDetailed {
 public:
     LogDetailed(const char* filename, int filenumber) :
@@ -37,91 +57,30 @@ public:
 
     virtual ~LogDetailed()
     {
-#if ANDROID
-        switch (_log_level) {
-            case LogLevel::Debug:
-                __android_log_print(ANDROID_LOG_DEBUG, "Mavsdk", "%s", _s.str().c_str());
-                break;
-            case LogLevel::Info:
-                __android_log_print(ANDROID_LOG_INFO, "Mavsdk", "%s", _s.str().c_str());
-                break;
-            case LogLevel::Warn:
-                __android_log_print(ANDROID_LOG_WARN, "Mavsdk", "%s", _s.str().c_str());
-                break;
-            case LogLevel::Err:
-                __android_log_print(ANDROID_LOG_ERROR, "Mavsdk", "%s", _s.str().c_str());
-                break;
-        }
-        // Unused:
-        (void)_caller_filename;
-        (void)_caller_filenumber;
-#else
-
-        switch (_log_level) {
-            case LogLevel::Debug:
-                set_color(Color::Green);
-                break;
-            case LogLevel::Info:
-                set_color(Color::Blue);
-                break;
-            case LogLevel::Warn:
-                set_color(Color::Yellow);
-                break;
-            case LogLevel::Err:
-                set_color(Color::Red);
-                break;
-        }
-
-        // Time output taken from:
-        // https://stackoverflow.com/questions/16357999#answer-16358264
-        time_t rawtime;
-        time(&rawtime);
-        struct tm* timeinfo = localtime(&rawtime);
-        char time_buffer[10]{}; // We need 8 characters + \0
-        strftime(time_buffer, sizeof(time_buffer), "%I:%M:%S", timeinfo);
-        std::cout << "[" << time_buffer;
-
-        switch (_log_level) {
-            case LogLevel::Debug:
-                std::cout << "|Debug] ";
-                break;
-            case LogLevel::Info:
-                std::cout << "|Info ] ";
-                break;
-            case LogLevel::Warn:
-                std::cout << "|Warn ] ";
-                break;
-            case LogLevel::Err:
-                std::cout << "|Error] ";
-                break;
-        }
-
-        set_color(Color::Reset);
-
-        std::cout << _s.str();
-        std::cout << " (" << _caller_filename << ":" << std::dec << _caller_filenumber << ")";
-
-        std::cout << std::endl;
-#endif
+        log_message(_log_level, _caller_filename, _caller_filenumber, _s.str());
     }
 
     LogDetailed(const mavsdk::LogDetailed&) = delete;
     void operator=(const mavsdk::LogDetailed&) = delete;
 
 protected:
-    enum LogLevel { Debug, Info, Warn, Err } _log_level = LogLevel::Debug;
+    log::Level _log_level = log::Level::Debug;
 
 private:
-    std::stringstream _s;
+    std::ostringstream _s;
     const char* _caller_filename;
     int _caller_filenumber;
 };
 
+struct LogVoidify {
+    void operator&(const LogDetailed&) {}
+};
+
 class LogDebugDetailed : public LogDetailed {
 public:
     LogDebugDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
     {
-        _log_level = LogLevel::Debug;
+        _log_level = log::Level::Debug;
     }
 };
 
@@ -129,7 +88,7 @@ class LogInfoDetailed : public LogDetailed {
 public:
     LogInfoDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
     {
-        _log_level = LogLevel::Info;
+        _log_level = log::Level::Info;
     }
 };
 
@@ -137,7 +96,7 @@ class LogWarnDetailed : public LogDetailed {
 public:
     LogWarnDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
     {
-        _log_level = LogLevel::Warn;
+        _log_level = log::Level::Warn;
     }
 };
 
@@ -145,7 +104,7 @@ class LogErrDetailed : public LogDetailed {
 public:
     LogErrDetailed(const char* filename, int filenumber) : LogDetailed(filename, filenumber)
     {
-        _log_level = LogLevel::Err;
+        _log_level = log::Level::Err;
     }
 };
 
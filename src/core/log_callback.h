@@ -0,0 +1,62 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace mavsdk {
+namespace log {
+
+/**
+ * @brief Log levels, in increasing severity.
+ */
+enum class Level : int {
+    Debug = 0, /**< @brief Debug messages. */
+    Info = 1, /**< @brief Informational messages. */
+    Warn = 2, /**< @brief Warnings. */
+    Err = 3, /**< @brief Errors. */
+};
+
+/**
+ * @brief Callback type for log messages.
+ *
+ * The callback is called from the logging thread of the library.
+ *
+ * @return `true` if the message was handled and should not be printed to the console.
+ */
+using Callback = std::function<bool(
+    Level level, const std::string& message, const std::string& file, int line)>;
+
+/**
+ * @brief Subscribe to log messages, an empty callback unsubscribes.
+ */
+void subscribe(const Callback& callback);
+
+/**
+ * @brief Set the minimum level of messages to log, messages below it cost next to nothing.
+ *
+ * Messages can also be compiled out by defining `MAVSDK_LOG_LEVEL_MIN` (0 to 3) when building
+ * the library.
+ */
+void set_level(Level level);
+
+/**
+ * @brief Get the minimum level of messages to log.
+ */
+Level get_level();
+
+/**
+ * @brief Additionally write all messages to a file in a compact binary format.
+ *
+ * An empty path closes the file again.
+ *
+ * @return `true` if the file could be opened.
+ */
+bool set_binary_file(const std::string& path);
+
+/**
+ * @brief Block until all messages logged so far have been written.
+ */
+void flush();
+
+} // namespace log
+} // namespace mavsdk
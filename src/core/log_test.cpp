@@ -0,0 +1,168 @@
+#include "log.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+struct Received {
+    log::Level level;
+    std::string message;
+    std::string file;
+    int line;
+};
+
+class LogTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        log::subscribe([this](
+                           log::Level level,
+                           const std::string& message,
+                           const std::string& file,
+                           int line) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _received.push_back(Received{level, message, file, line});
+            return true;
+        });
+    }
+
+    void TearDown() override
+    {
+        log::subscribe(nullptr);
+        log::set_level(log::Level::Debug);
+    }
+
+    std::vector<Received> received()
+    {
+        log::flush();
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _received;
+    }
+
+    std::mutex _mutex{};
+    std::vector<Received> _received{};
+};
+
+uint64_t read_le(std::ifstream& file, size_t num_bytes)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < num_bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(file.get())) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+TEST_F(LogTest, CallbackReceivesMessages)
+{
+    LogInfo() << "Hello " << 42;
+    LogErr() << "Something failed";
+
+    const auto messages = received();
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0].level, log::Level::Info);
+    EXPECT_EQ(messages[0].message, "Hello 42");
+    EXPECT_NE(messages[0].file.find("log_test.cpp"), std::string::npos);
+    EXPECT_GT(messages[0].line, 0);
+    EXPECT_EQ(messages[1].level, log::Level::Err);
+    EXPECT_EQ(messages[1].message, "Something failed");
+}
+
+TEST_F(LogTest, KeepsOrderAcrossManyMessages)
+{
+    // More than fit into the queue at once.
+    for (int i = 0; i < 5000; ++i) {
+        LogDebug() << i;
+    }
+
+    const auto messages = received();
+    ASSERT_EQ(messages.size(), 5000);
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_EQ(messages[i].message, std::to_string(i));
+    }
+}
+
+TEST_F(LogTest, SkipsMessagesBelowLevel)
+{
+    log::set_level(log::Level::Warn);
+    EXPECT_EQ(log::get_level(), log::Level::Warn);
+
+    int num_evaluated = 0;
+    auto evaluate = [&num_evaluated]() { return ++num_evaluated; };
+
+    LogDebug() << evaluate();
+    LogInfo() << evaluate();
+    LogWarn() << evaluate();
+
+    // Must still bind correctly without braces.
+    if (num_evaluated == 1)
+        LogErr() << "error";
+    else
+        FAIL();
+
+    EXPECT_EQ(num_evaluated, 1);
+
+    const auto messages = received();
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0].level, log::Level::Warn);
+    EXPECT_EQ(messages[1].level, log::Level::Err);
+}
+
+TEST_F(LogTest, WritesErrorsBeforeReturning)
+{
+    LogInfo() << "info";
+    LogErr() << "error";
+
+    // No flush, the error and everything before it has to be out already.
+    std::lock_guard<std::mutex> lock(_mutex);
+    ASSERT_EQ(_received.size(), 2);
+    EXPECT_EQ(_received[0].message, "info");
+    EXPECT_EQ(_received[1].message, "error");
+}
+
+TEST_F(LogTest, WritesBinaryFile)
+{
+    const std::string path = "log_test.bin";
+    ASSERT_TRUE(log::set_binary_file(path));
+
+    LogWarn() << "first";
+    LogInfo() << "second";
+    log::flush();
+    ASSERT_TRUE(log::set_binary_file(""));
+
+    std::ifstream file(path, std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+
+    char magic[9];
+    file.read(magic, sizeof(magic));
+    EXPECT_EQ(std::string(magic, sizeof(magic)), "MAVSDKLOG");
+    EXPECT_EQ(file.get(), 1);
+
+    const std::vector<std::pair<log::Level, std::string>> expected{
+        {log::Level::Warn, "first"}, {log::Level::Info, "second"}};
+
+    for (const auto& entry : expected) {
+        const uint64_t time_us = read_le(file, 8);
+        EXPECT_GT(time_us, 0);
+        EXPECT_EQ(static_cast<log::Level>(read_le(file, 1)), entry.first);
+        EXPECT_GT(read_le(file, 4), 0);
+        std::string filename(read_le(file, 2), '\0');
+        file.read(&filename[0], static_cast<std::streamsize>(filename.size()));
+        EXPECT_NE(filename.find("log_test.cpp"), std::string::npos);
+        std::string message(read_le(file, 4), '\0');
+        file.read(&message[0], static_cast<std::streamsize>(message.size()));
+        EXPECT_EQ(message, entry.second);
+    }
+    ASSERT_TRUE(file.good());
+    file.get();
+    EXPECT_TRUE(file.eof());
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace mavsdk {
+
+// Passes the latest value from one writing thread to one reading thread
+// without locks. Values which the reader did not pick up in time are
+// overwritten.
+//
+// This is a triple buffer: the writer and the reader each own one of the
+// buffers and swap it with the third one when they are done with it.
+template<typename T> class Mailbox {
+public:
+    Mailbox() = default;
+    ~Mailbox() = default;
+
+    // Only to be called from the writing thread.
+    void write(const T& value)
+    {
+        _buffers[_write_index] = value;
+        const uint8_t previous =
+            _shared.exchange(_write_index | NEW_VALUE_FLAG, std::memory_order_acq_rel);
+        _write_index = previous & INDEX_MASK;
+    }
+
+    // Only to be called from the reading thread.
+    // Copies the latest value and returns whether it is new since the last
+    // read. Before anything is written, this is a default constructed T.
+    bool read(T& value)
+    {
+        const bool is_new = (_shared.load(std::memory_order_acquire) & NEW_VALUE_FLAG) != 0;
+        if (is_new) {
+            const uint8_t previous = _shared.exchange(_read_index, std::memory_order_acq_rel);
+            _read_index = previous & INDEX_MASK;
+        }
+        value = _buffers[_read_index];
+        return is_new;
+    }
+
+    // Non-copyable
+    Mailbox(const Mailbox&) = delete;
+    const Mailbox& operator=(const Mailbox&) = delete;
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t NEW_VALUE_FLAG = 0x4;
+
+    std::array<T, 3> _buffers{};
+    uint8_t _write_index{0};
+    std::atomic<uint8_t> _shared{1};
+    uint8_t _read_index{2};
+};
+
+} // namespace mavsdk
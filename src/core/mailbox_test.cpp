@@ -0,0 +1,67 @@
+#include "mailbox.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace mavsdk;
+
+TEST(Mailbox, KeepsLatestValue)
+{
+    Mailbox<int> mailbox{};
+
+    int value = -1;
+    EXPECT_FALSE(mailbox.read(value));
+    EXPECT_EQ(value, 0);
+
+    mailbox.write(1);
+    EXPECT_TRUE(mailbox.read(value));
+    EXPECT_EQ(value, 1);
+
+    // Without a new value, the last one is read again.
+    EXPECT_FALSE(mailbox.read(value));
+    EXPECT_EQ(value, 1);
+
+    mailbox.write(2);
+    mailbox.write(3);
+    mailbox.write(4);
+    EXPECT_TRUE(mailbox.read(value));
+    EXPECT_EQ(value, 4);
+    EXPECT_FALSE(mailbox.read(value));
+    EXPECT_EQ(value, 4);
+}
+
+TEST(Mailbox, ReadsConsistentValuesAcrossThreads)
+{
+    struct Pair {
+        int first{0};
+        int second{0};
+    };
+
+    Mailbox<Pair> mailbox{};
+    std::atomic<bool> done{false};
+    const int num_writes = 200000;
+
+    std::thread writer([&]() {
+        for (int i = 1; i <= num_writes; ++i) {
+            mailbox.write(Pair{i, -i});
+        }
+        done = true;
+    });
+
+    int last = 0;
+    bool consistent = true;
+    bool in_order = true;
+    while (!done || last != num_writes) {
+        Pair pair{};
+        mailbox.read(pair);
+        consistent = consistent && pair.first == -pair.second;
+        in_order = in_order && pair.first >= last;
+        last = pair.first;
+    }
+
+    writer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(last, num_writes);
+}
@@ -0,0 +1,89 @@
+#include "mapped_file.h"
+#include <fstream>
+#include <iterator>
+
+#if !defined(WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mavsdk {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+#if !defined(WINDOWS)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat stat_buf;
+    if (fstat(fd, &stat_buf) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    const auto size = static_cast<size_t>(stat_buf.st_size);
+    if (size == 0 || !S_ISREG(stat_buf.st_mode)) {
+        // Nothing to map, or not a file which can be mapped.
+        ::close(fd);
+        return read_into_buffer(path);
+    }
+
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (mapped != MAP_FAILED) {
+        madvise(mapped, size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(mapped);
+        _size = size;
+        _is_mapped = true;
+        return true;
+    }
+#endif
+
+    return read_into_buffer(path);
+}
+
+void MappedFile::close()
+{
+#if !defined(WINDOWS)
+    if (_is_mapped) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+    _is_mapped = false;
+    _buffer.clear();
+    _buffer.shrink_to_fit();
+}
+
+bool MappedFile::read_into_buffer(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (file.bad()) {
+        _buffer.clear();
+        return false;
+    }
+
+    _data = _buffer.empty() ? nullptr : _buffer.data();
+    _size = _buffer.size();
+    return true;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace mavsdk {
+
+// A whole file to read from. It is mapped into memory where possible,
+// otherwise read into a buffer.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+
+    // nullptr for an empty file.
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    const MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+    bool read_into_buffer(const std::string& path);
+
+    const char* _data{nullptr};
+    size_t _size{0};
+    bool _is_mapped{false};
+    std::vector<char> _buffer{};
+};
+
+} // namespace mavsdk
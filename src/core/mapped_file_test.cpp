@@ -0,0 +1,51 @@
+#include "mapped_file.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace mavsdk;
+
+static const std::string TEST_FILE = "mapped_file_test.tmp";
+
+static void write_file(const std::string& content)
+{
+    std::ofstream file(TEST_FILE, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+TEST(MappedFile, ReadsWholeFile)
+{
+    const std::string content = std::string(100000, 'x') + "end";
+    write_file(content);
+
+    MappedFile file;
+    ASSERT_TRUE(file.open(TEST_FILE));
+    ASSERT_EQ(file.size(), content.size());
+    EXPECT_EQ(std::string(file.data(), file.size()), content);
+
+    file.close();
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_EQ(file.size(), 0u);
+
+    std::remove(TEST_FILE.c_str());
+}
+
+TEST(MappedFile, EmptyFile)
+{
+    write_file("");
+
+    MappedFile file;
+    ASSERT_TRUE(file.open(TEST_FILE));
+    EXPECT_EQ(file.data(), nullptr);
+    EXPECT_EQ(file.size(), 0u);
+
+    std::remove(TEST_FILE.c_str());
+}
+
+TEST(MappedFile, MissingFile)
+{
+    MappedFile file;
+    EXPECT_FALSE(file.open("this_file_does_not_exist.tmp"));
+    EXPECT_EQ(file.size(), 0u);
+}
@@ -1,5 +1,6 @@
 #include <mutex>
 #include "mavlink_message_handler.h"
+#include "trace.h"
 
 namespace mavsdk {
 
@@ -52,6 +53,7 @@ void MAVLinkMessageHandler::process_message(const mavlink_message_t& message)
             LogDebug() << "Forwarding msg " << int(message.msgid) << " to " << size_t(it->cookie);
             forwarded = true;
 #endif
+            MAVSDK_TRACE_SCOPE("message_handler", message.msgid);
             it->callback(message);
         }
     }
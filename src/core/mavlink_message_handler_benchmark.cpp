@@ -0,0 +1,29 @@
+#include "mavlink_message_handler.h"
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// Dispatching one message with as many handlers registered as plugins
+// typically do.
+static void BM_MAVLinkMessageHandlerProcessMessage(benchmark::State& state)
+{
+    const auto num_handlers = static_cast<uint16_t>(state.range(0));
+
+    MAVLinkMessageHandler handler;
+    unsigned num_called = 0;
+    for (uint16_t i = 0; i < num_handlers; ++i) {
+        handler.register_one(
+            i, [&num_called](const mavlink_message_t&) { ++num_called; }, &handler);
+    }
+
+    mavlink_message_t message{};
+    message.msgid = num_handlers - 1;
+
+    for (auto _ : state) {
+        handler.process_message(message);
+    }
+
+    benchmark::DoNotOptimize(num_called);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MAVLinkMessageHandlerProcessMessage)->Arg(1)->Arg(16)->Arg(128);
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include "mavlink_mission_items.h"
+
+namespace mavsdk {
+
+MAVLinkMissionItems::MAVLinkMissionItems(const std::vector<ItemInt>& items)
+{
+    reserve(items.size());
+    for (const auto& item : items) {
+        push_back(item);
+    }
+}
+
+void MAVLinkMissionItems::reserve(size_t num_items)
+{
+    _frame.reserve(num_items);
+    _command.reserve(num_items);
+    _current.reserve(num_items);
+    _autocontinue.reserve(num_items);
+    _param1.reserve(num_items);
+    _param2.reserve(num_items);
+    _param3.reserve(num_items);
+    _param4.reserve(num_items);
+    _x.reserve(num_items);
+    _y.reserve(num_items);
+    _z.reserve(num_items);
+    _mission_type.reserve(num_items);
+    _user_index.reserve(num_items);
+}
+
+void MAVLinkMissionItems::clear()
+{
+    _frame.clear();
+    _command.clear();
+    _current.clear();
+    _autocontinue.clear();
+    _param1.clear();
+    _param2.clear();
+    _param3.clear();
+    _param4.clear();
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _mission_type.clear();
+    _user_index.clear();
+    _first_sequence.clear();
+    _has_valid_sequence = true;
+    _num_current = 0;
+}
+
+void MAVLinkMissionItems::push_back(const ItemInt& item, int user_index)
+{
+    if (item.seq != size()) {
+        _has_valid_sequence = false;
+    }
+    _num_current += item.current;
+
+    _frame.push_back(item.frame);
+    _command.push_back(item.command);
+    _current.push_back(item.current);
+    _autocontinue.push_back(item.autocontinue);
+    _param1.push_back(item.param1);
+    _param2.push_back(item.param2);
+    _param3.push_back(item.param3);
+    _param4.push_back(item.param4);
+    _x.push_back(item.x);
+    _y.push_back(item.y);
+    _z.push_back(item.z);
+    _mission_type.push_back(item.mission_type);
+
+    _user_index.push_back(-1);
+    set_user_index(size() - 1, user_index);
+}
+
+void MAVLinkMissionItems::set_user_index(size_t seq, int user_index)
+{
+    _user_index[seq] = user_index;
+
+    // As items come in order, the first one of a user item is the one
+    // which goes past the highest index so far.
+    if (user_index >= num_user_items()) {
+        _first_sequence.resize(static_cast<size_t>(user_index) + 1, -1);
+        _first_sequence.back() = static_cast<int>(seq);
+    }
+}
+
+MAVLinkMissionItems::ItemInt MAVLinkMissionItems::at(size_t seq) const
+{
+    return ItemInt{
+        static_cast<uint16_t>(seq),
+        _frame[seq],
+        _command[seq],
+        _current[seq],
+        _autocontinue[seq],
+        _param1[seq],
+        _param2[seq],
+        _param3[seq],
+        _param4[seq],
+        _x[seq],
+        _y[seq],
+        _z[seq],
+        _mission_type[seq]};
+}
+
+std::vector<MAVLinkMissionItems::ItemInt> MAVLinkMissionItems::to_vector() const
+{
+    std::vector<ItemInt> items;
+    items.reserve(size());
+    for (size_t seq = 0; seq < size(); ++seq) {
+        items.push_back(at(seq));
+    }
+    return items;
+}
+
+int MAVLinkMissionItems::first_sequence(int user_index) const
+{
+    if (user_index < 0 || user_index >= num_user_items()) {
+        return -1;
+    }
+    return _first_sequence[static_cast<size_t>(user_index)];
+}
+
+bool MAVLinkMissionItems::all_of_mission_type(uint8_t mission_type) const
+{
+    return std::all_of(_mission_type.cbegin(), _mission_type.cend(), [mission_type](uint8_t type) {
+        return type == mission_type;
+    });
+}
+
+} // namespace mavsdk
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mavsdk {
+
+// Mission items as they are transferred with MISSION_ITEM_INT, stored field
+// by field rather than item by item.
+//
+// Item i is the one with sequence number i. Each item can also be tagged
+// with the index of the item it was created from in the plugin using it,
+// e.g. the Mission::MissionItem, so that the mapping in both directions is
+// a lookup.
+//
+// It is filled once by the plugin, then shared with the transfer and kept
+// by the plugin without copying it.
+class MAVLinkMissionItems {
+public:
+    struct ItemInt {
+        uint16_t seq;
+        uint8_t frame;
+        uint16_t command;
+        uint8_t current;
+        uint8_t autocontinue;
+        float param1;
+        float param2;
+        float param3;
+        float param4;
+        int32_t x;
+        int32_t y;
+        float z;
+        uint8_t mission_type;
+
+        bool operator==(const ItemInt& other) const
+        {
+            return (
+                seq == other.seq && frame == other.frame && command == other.command &&
+                current == other.current && autocontinue == other.autocontinue &&
+                param1 == other.param1 && param2 == other.param2 && param3 == other.param3 &&
+                param4 == other.param4 && x == other.x && y == other.y && z == other.z &&
+                mission_type == other.mission_type);
+        }
+    };
+
+    MAVLinkMissionItems() = default;
+    explicit MAVLinkMissionItems(const std::vector<ItemInt>& items);
+    ~MAVLinkMissionItems() = default;
+
+    void reserve(size_t num_items);
+    void clear();
+
+    size_t size() const { return _command.size(); }
+    bool empty() const { return _command.empty(); }
+
+    // Appends an item, item.seq is expected to be its index.
+    void push_back(const ItemInt& item) { push_back(item, -1); }
+
+    // Appends an item which was created from the user item user_index, or
+    // from none if it is negative. Items of the same user item need to be
+    // appended one after another, and in the order of the user items.
+    void push_back(const ItemInt& item, int user_index);
+
+    // Tags an item which was appended without user index, the items need
+    // to be tagged in order and with the same rules as for push_back.
+    void set_user_index(size_t seq, int user_index);
+
+    ItemInt at(size_t seq) const;
+    std::vector<ItemInt> to_vector() const;
+
+    // -1 if the item doesn't belong to any user item.
+    int user_index(size_t seq) const { return _user_index[seq]; }
+
+    // The first item of a user item, -1 if there is none.
+    int first_sequence(int user_index) const;
+
+    // The highest user index plus one.
+    int num_user_items() const { return static_cast<int>(_first_sequence.size()); }
+
+    // Whether the seq of all ItemInts added was their index.
+    bool has_valid_sequence() const { return _has_valid_sequence; }
+
+    unsigned num_current() const { return _num_current; }
+    bool all_of_mission_type(uint8_t mission_type) const;
+
+private:
+    std::vector<uint8_t> _frame{};
+    std::vector<uint16_t> _command{};
+    std::vector<uint8_t> _current{};
+    std::vector<uint8_t> _autocontinue{};
+    std::vector<float> _param1{};
+    std::vector<float> _param2{};
+    std::vector<float> _param3{};
+    std::vector<float> _param4{};
+    std::vector<int32_t> _x{};
+    std::vector<int32_t> _y{};
+    std::vector<float> _z{};
+    std::vector<uint8_t> _mission_type{};
+
+    std::vector<int> _user_index{};
+    std::vector<int> _first_sequence{};
+
+    bool _has_valid_sequence{true};
+    unsigned _num_current{0};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include "mavlink_mission_items.h"
+
+using namespace mavsdk;
+
+using ItemInt = MAVLinkMissionItems::ItemInt;
+
+static ItemInt make_item(uint16_t sequence)
+{
+    return ItemInt{
+        sequence,
+        3,
+        16,
+        uint8_t(sequence == 0 ? 1 : 0),
+        1,
+        1.0f,
+        2.0f,
+        3.0f,
+        4.0f,
+        int32_t(473977418 + sequence),
+        85455939,
+        float(sequence),
+        0};
+}
+
+TEST(MAVLinkMissionItems, RoundTripsItems)
+{
+    std::vector<ItemInt> items;
+    for (uint16_t i = 0; i < 10; ++i) {
+        items.push_back(make_item(i));
+    }
+
+    MAVLinkMissionItems mission_items(items);
+
+    EXPECT_EQ(mission_items.size(), 10u);
+    EXPECT_EQ(mission_items.at(4), items[4]);
+    EXPECT_EQ(mission_items.to_vector(), items);
+    EXPECT_TRUE(mission_items.has_valid_sequence());
+    EXPECT_EQ(mission_items.num_current(), 1u);
+    EXPECT_TRUE(mission_items.all_of_mission_type(0));
+    EXPECT_FALSE(mission_items.all_of_mission_type(1));
+}
+
+TEST(MAVLinkMissionItems, DetectsWrongSequence)
+{
+    MAVLinkMissionItems mission_items;
+    mission_items.push_back(make_item(0));
+    mission_items.push_back(make_item(2));
+
+    EXPECT_FALSE(mission_items.has_valid_sequence());
+
+    mission_items.clear();
+    EXPECT_TRUE(mission_items.empty());
+    EXPECT_TRUE(mission_items.has_valid_sequence());
+}
+
+TEST(MAVLinkMissionItems, MapsUserItems)
+{
+    MAVLinkMissionItems mission_items;
+    mission_items.reserve(6);
+
+    // User item 1 doesn't create any items, user item 3 creates three.
+    mission_items.push_back(make_item(0), 0);
+    mission_items.push_back(make_item(1), 2);
+    mission_items.push_back(make_item(2), 3);
+    mission_items.push_back(make_item(3), 3);
+    mission_items.push_back(make_item(4), 3);
+    mission_items.push_back(make_item(5), 4);
+
+    EXPECT_EQ(mission_items.num_user_items(), 5);
+
+    EXPECT_EQ(mission_items.user_index(0), 0);
+    EXPECT_EQ(mission_items.user_index(3), 3);
+    EXPECT_EQ(mission_items.user_index(5), 4);
+
+    EXPECT_EQ(mission_items.first_sequence(0), 0);
+    EXPECT_EQ(mission_items.first_sequence(1), -1);
+    EXPECT_EQ(mission_items.first_sequence(2), 1);
+    EXPECT_EQ(mission_items.first_sequence(3), 2);
+    EXPECT_EQ(mission_items.first_sequence(4), 5);
+    EXPECT_EQ(mission_items.first_sequence(5), -1);
+    EXPECT_EQ(mission_items.first_sequence(-1), -1);
+}
+
+TEST(MAVLinkMissionItems, MapsUserItemsAfterTheFact)
+{
+    MAVLinkMissionItems mission_items;
+    for (uint16_t i = 0; i < 4; ++i) {
+        mission_items.push_back(make_item(i));
+    }
+
+    EXPECT_EQ(mission_items.num_user_items(), 0);
+    EXPECT_EQ(mission_items.user_index(2), -1);
+
+    mission_items.set_user_index(0, 0);
+    mission_items.set_user_index(1, 0);
+    mission_items.set_user_index(2, 1);
+
+    EXPECT_EQ(mission_items.num_user_items(), 2);
+    EXPECT_EQ(mission_items.first_sequence(1), 2);
+    EXPECT_EQ(mission_items.user_index(3), -1);
+}
@@ -1,4 +1,4 @@
-#include <algorithm>
+#include <utility>
 #include "mavlink_mission_transfer.h"
 #include "log.h"
 
@@ -14,7 +14,7 @@ MAVLinkMissionTransfer::MAVLinkMissionTransfer(
 MAVLinkMissionTransfer::~MAVLinkMissionTransfer() {}
 
 std::weak_ptr<MAVLinkMissionTransfer::WorkItem> MAVLinkMissionTransfer::upload_items_async(
-    uint8_t type, const std::vector<ItemInt>& items, ResultCallback callback)
+    uint8_t type, std::shared_ptr<const MAVLinkMissionItems> items, ResultCallback callback)
 {
     auto ptr = std::make_shared<UploadWorkItem>(
         _sender, _message_handler, _timeout_handler, type, items, callback);
@@ -25,7 +25,7 @@ std::weak_ptr<MAVLinkMissionTransfer::WorkItem> MAVLinkMissionTransfer::upload_i
 }
 
 std::weak_ptr<MAVLinkMissionTransfer::WorkItem>
-MAVLinkMissionTransfer::download_items_async(uint8_t type, ResultAndItemsCallback callback)
+MAVLinkMissionTransfer::download_items_async(uint8_t type, ResultAndMissionItemsCallback callback)
 {
     auto ptr = std::make_shared<DownloadWorkItem>(
         _sender, _message_handler, _timeout_handler, type, callback);
@@ -35,6 +35,24 @@ MAVLinkMissionTransfer::download_items_async(uint8_t type, ResultAndItemsCallbac
     return std::weak_ptr<WorkItem>(ptr);
 }
 
+std::weak_ptr<MAVLinkMissionTransfer::WorkItem> MAVLinkMissionTransfer::upload_items_async(
+    uint8_t type, const std::vector<ItemInt>& items, ResultCallback callback)
+{
+    return upload_items_async(type, std::make_shared<const MAVLinkMissionItems>(items), callback);
+}
+
+std::weak_ptr<MAVLinkMissionTransfer::WorkItem>
+MAVLinkMissionTransfer::download_items_async(uint8_t type, ResultAndItemsCallback callback)
+{
+    ResultAndMissionItemsCallback items_callback = nullptr;
+    if (callback) {
+        items_callback = [callback](Result result, std::shared_ptr<MAVLinkMissionItems> items) {
+            callback(result, items->to_vector());
+        };
+    }
+    return download_items_async(type, items_callback);
+}
+
 void MAVLinkMissionTransfer::clear_items_async(uint8_t type, ResultCallback callback)
 {
     auto ptr = std::make_shared<ClearWorkItem>(
@@ -104,10 +122,10 @@ MAVLinkMissionTransfer::UploadWorkItem::UploadWorkItem(
     MAVLinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
     uint8_t type,
-    const std::vector<ItemInt>& items,
+    std::shared_ptr<const MAVLinkMissionItems> items,
     ResultCallback callback) :
     WorkItem(sender, message_handler, timeout_handler, type),
-    _items(items),
+    _items(std::move(items)),
     _callback(callback)
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -140,31 +158,22 @@ void MAVLinkMissionTransfer::UploadWorkItem::start()
     std::lock_guard<std::mutex> lock(_mutex);
 
     _started = true;
-    if (_items.size() == 0) {
+    if (!_items || _items->empty()) {
         callback_and_reset(Result::NoMissionAvailable);
         return;
     }
 
-    int count = 0;
-    for (const auto& item : _items) {
-        if (count++ != item.seq) {
-            callback_and_reset(Result::InvalidSequence);
-            return;
-        }
+    if (!_items->has_valid_sequence()) {
+        callback_and_reset(Result::InvalidSequence);
+        return;
     }
 
-    int num_currents = 0;
-    std::for_each(_items.cbegin(), _items.cend(), [&num_currents](const ItemInt& item) {
-        num_currents += item.current;
-    });
-    if (num_currents != 1) {
+    if (_items->num_current() != 1) {
         callback_and_reset(Result::CurrentInvalid);
         return;
     }
 
-    if (std::any_of(_items.cbegin(), _items.cend(), [this](const ItemInt& item) {
-            return item.mission_type != _type;
-        })) {
+    if (!_items->all_of_mission_type(_type)) {
         callback_and_reset(Result::MissionTypeNotConsistent);
         return;
     }
@@ -195,7 +204,7 @@ void MAVLinkMissionTransfer::UploadWorkItem::send_count()
         &message,
         _sender.target_address.system_id,
         _sender.target_address.component_id,
-        _items.size(),
+        _items->size(),
         _type);
 
     if (!_sender.send_message(message)) {
@@ -292,11 +301,13 @@ void MAVLinkMissionTransfer::UploadWorkItem::process_mission_request_int(
 
 void MAVLinkMissionTransfer::UploadWorkItem::send_mission_item()
 {
-    if (_next_sequence >= _items.size()) {
+    if (_next_sequence >= _items->size()) {
         LogErr() << "send_mission_item: sequence out of bounds";
         return;
     }
 
+    const auto item = _items->at(_next_sequence);
+
     mavlink_message_t message;
     mavlink_msg_mission_item_int_pack(
         _sender.own_address.system_id,
@@ -305,17 +316,17 @@ void MAVLinkMissionTransfer::UploadWorkItem::send_mission_item()
         _sender.target_address.system_id,
         _sender.target_address.component_id,
         _next_sequence,
-        _items[_next_sequence].frame,
-        _items[_next_sequence].command,
-        _items[_next_sequence].current,
-        _items[_next_sequence].autocontinue,
-        _items[_next_sequence].param1,
-        _items[_next_sequence].param2,
-        _items[_next_sequence].param3,
-        _items[_next_sequence].param4,
-        _items[_next_sequence].x,
-        _items[_next_sequence].y,
-        _items[_next_sequence].z,
+        item.frame,
+        item.command,
+        item.current,
+        item.autocontinue,
+        item.param1,
+        item.param2,
+        item.param3,
+        item.param4,
+        item.x,
+        item.y,
+        item.z,
         _type);
 
     ++_next_sequence;
@@ -379,7 +390,7 @@ void MAVLinkMissionTransfer::UploadWorkItem::process_mission_ack(const mavlink_m
             return;
     }
 
-    if (_next_sequence == _items.size()) {
+    if (_next_sequence == _items->size()) {
         callback_and_reset(Result::Success);
     } else {
         callback_and_reset(Result::ProtocolError);
@@ -421,8 +432,9 @@ MAVLinkMissionTransfer::DownloadWorkItem::DownloadWorkItem(
     MAVLinkMessageHandler& message_handler,
     TimeoutHandler& timeout_handler,
     uint8_t type,
-    ResultAndItemsCallback callback) :
+    ResultAndMissionItemsCallback callback) :
     WorkItem(sender, message_handler, timeout_handler, type),
+    _items(std::make_shared<MAVLinkMissionItems>()),
     _callback(callback)
 {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -450,7 +462,7 @@ void MAVLinkMissionTransfer::DownloadWorkItem::start()
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    _items.clear();
+    _items = std::make_shared<MAVLinkMissionItems>();
     _started = true;
     _retries_done = 0;
     _timeout_handler.add([this]() { process_timeout(); }, timeout_s, &_cookie);
@@ -567,6 +579,7 @@ void MAVLinkMissionTransfer::DownloadWorkItem::process_mission_count(
     _step = Step::RequestItem;
     _retries_done = 0;
     _expected_count = count.count;
+    _items->reserve(_expected_count);
     request_item();
 }
 
@@ -580,7 +593,7 @@ void MAVLinkMissionTransfer::DownloadWorkItem::process_mission_item_int(
     mavlink_mission_item_int_t item_int;
     mavlink_msg_mission_item_int_decode(&message, &item_int);
 
-    _items.push_back(ItemInt{
+    _items->push_back(ItemInt{
         item_int.seq,
         item_int.frame,
         item_int.command,
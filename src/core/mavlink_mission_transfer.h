@@ -8,6 +8,7 @@
 #include <vector>
 #include "mavlink_address.h"
 #include "mavlink_include.h"
+#include "mavlink_mission_items.h"
 #include "mavlink_message_handler.h"
 #include "timeout_handler.h"
 #include "locked_queue.h"
@@ -45,34 +46,12 @@ public:
         InvalidParam,
     };
 
-    struct ItemInt {
-        uint16_t seq;
-        uint8_t frame;
-        uint16_t command;
-        uint8_t current;
-        uint8_t autocontinue;
-        float param1;
-        float param2;
-        float param3;
-        float param4;
-        int32_t x;
-        int32_t y;
-        float z;
-        uint8_t mission_type;
-
-        bool operator==(const ItemInt& other) const
-        {
-            return (
-                seq == other.seq && frame == other.frame && command == other.command &&
-                current == other.current && autocontinue == other.autocontinue &&
-                param1 == other.param1 && param2 == other.param2 && param3 == other.param3 &&
-                param4 == other.param4 && x == other.x && y == other.y && z == other.z &&
-                mission_type == other.mission_type);
-        }
-    };
+    using ItemInt = MAVLinkMissionItems::ItemInt;
 
     using ResultCallback = std::function<void(Result result)>;
     using ResultAndItemsCallback = std::function<void(Result result, std::vector<ItemInt> items)>;
+    using ResultAndMissionItemsCallback =
+        std::function<void(Result result, std::shared_ptr<MAVLinkMissionItems> items)>;
 
     class WorkItem {
     public:
@@ -109,7 +88,7 @@ public:
             MAVLinkMessageHandler& message_handler,
             TimeoutHandler& timeout_handler,
             uint8_t type,
-            const std::vector<ItemInt>& items,
+            std::shared_ptr<const MAVLinkMissionItems> items,
             ResultCallback callback);
 
         virtual ~UploadWorkItem();
@@ -137,7 +116,7 @@ public:
             SendItems,
         } _step{Step::SendCount};
 
-        std::vector<ItemInt> _items{};
+        std::shared_ptr<const MAVLinkMissionItems> _items{};
         ResultCallback _callback{nullptr};
         std::size_t _next_sequence{0};
         void* _cookie{nullptr};
@@ -151,7 +130,7 @@ public:
             MAVLinkMessageHandler& message_handler,
             TimeoutHandler& timeout_handler,
             uint8_t type,
-            ResultAndItemsCallback callback);
+            ResultAndMissionItemsCallback callback);
 
         virtual ~DownloadWorkItem();
         void start() override;
@@ -177,8 +156,8 @@ public:
             RequestItem,
         } _step{Step::RequestList};
 
-        std::vector<ItemInt> _items{};
-        ResultAndItemsCallback _callback{nullptr};
+        std::shared_ptr<MAVLinkMissionItems> _items{};
+        ResultAndMissionItemsCallback _callback{nullptr};
         void* _cookie{nullptr};
         std::size_t _next_sequence{0};
         std::size_t _expected_count{0};
@@ -253,6 +232,14 @@ public:
 
     ~MAVLinkMissionTransfer();
 
+    // The items are not copied, they must not be changed until the upload is done.
+    std::weak_ptr<WorkItem> upload_items_async(
+        uint8_t type, std::shared_ptr<const MAVLinkMissionItems> items, ResultCallback callback);
+
+    std::weak_ptr<WorkItem>
+    download_items_async(uint8_t type, ResultAndMissionItemsCallback callback);
+
+    // Same as above, with the items copied from and to vectors.
     std::weak_ptr<WorkItem>
     upload_items_async(uint8_t type, const std::vector<ItemInt>& items, ResultCallback callback);
 
@@ -1,4 +1,5 @@
 #include "mavlink_parameters.h"
+#include "async_result.h"
 #include "system_impl.h"
 #include <cstring>
 #include <future>
@@ -149,14 +150,11 @@ void MAVLinkParameters::get_all_params_async(get_all_params_callback_t callback)
 
 std::map<std::string, MAVLinkParameters::ParamValue> MAVLinkParameters::get_all_params()
 {
-    std::promise<std::map<std::string, ParamValue>> prom;
-    auto res = prom.get_future();
-
-    get_all_params_async([&prom](std::map<std::string, MAVLinkParameters::ParamValue> all_params) {
-        prom.set_value(all_params);
-    });
-
-    return res.get();
+    return async_call<std::map<std::string, ParamValue>>(
+               [this](const get_all_params_callback_t& callback) {
+                   get_all_params_async(callback);
+               })
+        .get();
 }
 
 void MAVLinkParameters::cancel_all_param(const void* cookie)
@@ -7,8 +7,9 @@
 
 namespace mavsdk {
 
-MAVLinkReceiver::MAVLinkReceiver(uint8_t channel) :
-    _channel(channel)
+MAVLinkReceiver::MAVLinkReceiver(uint8_t channel, ConnectionStats* stats) :
+    _channel(channel),
+    _stats(stats)
 #if DROP_DEBUG == 1
     ,
     _last_time()
@@ -20,6 +21,10 @@ void MAVLinkReceiver::set_new_datagram(char* datagram, unsigned datagram_len)
     _datagram = datagram;
     _datagram_len = datagram_len;
 
+    if (_stats != nullptr) {
+        _stats->bytes_received(datagram_len);
+    }
+
 #if DROP_DEBUG == 1
     _bytes_received += _datagram_len;
 #endif
@@ -47,6 +52,12 @@ bool MAVLinkReceiver::parse_message()
     // No (more) messages, let's give up.
     _datagram = nullptr;
     _datagram_len = 0;
+
+    if (_stats != nullptr && _status.parse_error != _last_parse_error_count) {
+        // The parser only has an 8 bit counter for frames with a bad CRC.
+        _stats->parse_errors(static_cast<uint8_t>(_status.parse_error - _last_parse_error_count));
+        _last_parse_error_count = _status.parse_error;
+    }
     return false;
 }
 
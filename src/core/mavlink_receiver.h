@@ -2,13 +2,15 @@
 
 #include "mavlink_include.h"
 #include "global_include.h"
+#include "link_stats.h"
 #include <cstdint>
 
 namespace mavsdk {
 
 class MAVLinkReceiver {
 public:
-    explicit MAVLinkReceiver(uint8_t channel);
+    // The bytes received and the frames dropped are counted in stats if given.
+    explicit MAVLinkReceiver(uint8_t channel, ConnectionStats* stats = nullptr);
 
     uint8_t get_channel() { return _channel; }
 
@@ -37,6 +39,9 @@ private:
     char* _datagram = nullptr;
     unsigned _datagram_len = 0;
 
+    ConnectionStats* _stats = nullptr;
+    uint8_t _last_parse_error_count = 0;
+
 #if DROP_DEBUG == 1
     unsigned _bytes_received = 0;
 
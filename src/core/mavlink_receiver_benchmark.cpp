@@ -0,0 +1,75 @@
+#include "mavlink_receiver.h"
+#include <vector>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// A mix of messages as typically streamed by an autopilot.
+static std::vector<char> create_stream(unsigned num_messages)
+{
+    std::vector<char> stream;
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+
+    for (unsigned i = 0; i < num_messages; ++i) {
+        mavlink_message_t message;
+        switch (i % 3) {
+            case 0:
+                mavlink_msg_heartbeat_pack(
+                    1, 1, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+                break;
+            case 1:
+                mavlink_msg_attitude_quaternion_pack(
+                    1, 1, &message, i, 1.0f, 0.0f, 0.0f, 0.0f, 0.1f, 0.2f, 0.3f, nullptr);
+                break;
+            default:
+                mavlink_msg_global_position_int_pack(
+                    1, 1, &message, i, 473977418, 85455938, 488000, 10000, 1, 2, 3, 9000);
+                break;
+        }
+        const auto len = mavlink_msg_to_send_buffer(buffer, &message);
+        stream.insert(stream.end(), buffer, buffer + len);
+    }
+    return stream;
+}
+
+static void BM_MAVLinkReceiverParseMessage(benchmark::State& state)
+{
+    auto stream = create_stream(static_cast<unsigned>(state.range(0)));
+
+    MAVLinkReceiver receiver(0);
+    int64_t num_messages = 0;
+
+    for (auto _ : state) {
+        receiver.set_new_datagram(stream.data(), static_cast<unsigned>(stream.size()));
+        while (receiver.parse_message()) {
+            benchmark::DoNotOptimize(receiver.get_last_message());
+            ++num_messages;
+        }
+    }
+
+    state.SetItemsProcessed(num_messages);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.size()));
+}
+BENCHMARK(BM_MAVLinkReceiverParseMessage)->Arg(1)->Arg(30);
+
+// With counting enabled, as used by every connection.
+static void BM_MAVLinkReceiverParseMessageWithStats(benchmark::State& state)
+{
+    auto stream = create_stream(30);
+
+    ConnectionStats stats;
+    MAVLinkReceiver receiver(0, &stats);
+    int64_t num_messages = 0;
+
+    for (auto _ : state) {
+        receiver.set_new_datagram(stream.data(), static_cast<unsigned>(stream.size()));
+        while (receiver.parse_message()) {
+            stats.message_received(receiver.get_last_message());
+            ++num_messages;
+        }
+    }
+
+    state.SetItemsProcessed(num_messages);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(stream.size()));
+}
+BENCHMARK(BM_MAVLinkReceiverParseMessageWithStats);
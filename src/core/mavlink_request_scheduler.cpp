@@ -0,0 +1,352 @@
+#include "mavlink_request_scheduler.h"
+#include "log.h"
+#include <algorithm>
+
+namespace mavsdk {
+
+MAVLinkRequestScheduler::MAVLinkRequestScheduler(
+    Time& time, const SendCommandCallback& send_command) :
+    _time(time),
+    _send_command(send_command)
+{}
+
+void MAVLinkRequestScheduler::add(const Request& request, double interval_s, const void* cookie)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto entry_key = key(request.message_id, request.component_id);
+    auto it = _entries.find(entry_key);
+    if (it == _entries.end()) {
+        Entry entry{};
+        entry.request = request;
+        entry.method = first_method(request);
+        it = _entries.emplace(entry_key, entry).first;
+    }
+
+    Entry& entry = it->second;
+    const double previous_interval_s = entry.interval_s;
+    entry.intervals_s[cookie] = interval_s;
+    update_interval(entry);
+
+    if (entry.method == Method::Stream && entry.interval_s != previous_interval_s) {
+        // Ask for the new rate, or fall back to polling if that fails.
+        entry.method = Method::SetMessageInterval;
+        entry.requested = false;
+    }
+    // A shorter interval should take effect right away.
+    entry.backoff_factor = 1;
+}
+
+void MAVLinkRequestScheduler::remove(
+    uint16_t message_id, uint8_t component_id, const void* cookie)
+{
+    std::vector<PendingCommand> pending;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const auto entry_key = key(message_id, component_id);
+        auto it = _entries.find(entry_key);
+        if (it == _entries.end()) {
+            return;
+        }
+        it->second.intervals_s.erase(cookie);
+        erase_if_unused(entry_key, pending);
+    }
+    send(pending);
+}
+
+void MAVLinkRequestScheduler::remove_all(const void* cookie)
+{
+    std::vector<PendingCommand> pending;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::vector<uint32_t> entry_keys;
+        for (auto& entry : _entries) {
+            if (entry.second.intervals_s.erase(cookie) > 0) {
+                entry_keys.push_back(entry.first);
+            }
+        }
+        for (const auto entry_key : entry_keys) {
+            erase_if_unused(entry_key, pending);
+        }
+    }
+    send(pending);
+}
+
+void MAVLinkRequestScheduler::process_message(const mavlink_message_t& message)
+{
+    if (message.msgid > UINT16_MAX) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(key(static_cast<uint16_t>(message.msgid), message.compid));
+    if (it == _entries.end()) {
+        return;
+    }
+
+    Entry& entry = it->second;
+    entry.last_received = _time.steady_time();
+
+    if (entry.method == Method::Stream) {
+        return;
+    }
+
+    // Poll less often as long as nothing changes.
+    const uint64_t hash = content_hash(message, entry.request);
+    if (entry.has_content && hash == entry.content_hash) {
+        entry.backoff_factor = std::min(entry.backoff_factor * 2, MAX_BACKOFF_FACTOR);
+    } else {
+        entry.backoff_factor = 1;
+    }
+    entry.has_content = true;
+    entry.content_hash = hash;
+}
+
+void MAVLinkRequestScheduler::do_work()
+{
+    std::vector<PendingCommand> pending;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto& item : _entries) {
+            Entry& entry = item.second;
+
+            if (entry.in_flight) {
+                continue;
+            }
+
+            if (entry.method == Method::Stream) {
+                // Some components accept the command but don't stream.
+                const double timeout_s = std::max(3.0 * entry.interval_s, 1.0);
+                if (_time.elapsed_since_s(entry.last_received) > timeout_s) {
+                    LogWarn() << "Message " << entry.request.message_id << " from component "
+                              << int(entry.request.component_id)
+                              << " not streamed, polling instead";
+                    entry.method = poll_method(entry.request);
+                    entry.requested = false;
+                } else {
+                    continue;
+                }
+            }
+
+            if (entry.requested &&
+                _time.elapsed_since_s(entry.last_requested) <
+                    entry.interval_s * entry.backoff_factor) {
+                continue;
+            }
+
+            pending.push_back(make_request(item.first, entry));
+        }
+    }
+    send(pending);
+}
+
+uint32_t MAVLinkRequestScheduler::key(uint16_t message_id, uint8_t component_id)
+{
+    return (static_cast<uint32_t>(component_id) << 16) | message_id;
+}
+
+uint64_t
+MAVLinkRequestScheduler::content_hash(const mavlink_message_t& message, const Request& request)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    const auto* payload = reinterpret_cast<const uint8_t*>(message.payload64);
+    for (unsigned i = 0; i < message.len; ++i) {
+        if (i >= request.ignored_offset && i < request.ignored_offset + request.ignored_size) {
+            continue;
+        }
+        hash = (hash ^ payload[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool MAVLinkRequestScheduler::is_failure(MavlinkCommandSender::Result result)
+{
+    return result != MavlinkCommandSender::Result::Success &&
+           result != MavlinkCommandSender::Result::InProgress;
+}
+
+MavlinkCommandSender::CommandLong MAVLinkRequestScheduler::make_command_set_message_interval(
+    const Request& request, double interval_s)
+{
+    MavlinkCommandSender::CommandLong command{};
+
+    command.command = MAV_CMD_SET_MESSAGE_INTERVAL;
+    command.params.param1 = float(request.message_id);
+    // 0 requests the default rate.
+    command.params.param2 = interval_s > 0.0 ? static_cast<float>(interval_s * 1e6) : 0.0f;
+    command.target_component_id = request.component_id;
+
+    return command;
+}
+
+MavlinkCommandSender::CommandLong
+MAVLinkRequestScheduler::make_command_request_message(const Request& request)
+{
+    MavlinkCommandSender::CommandLong command{};
+
+    command.command = MAV_CMD_REQUEST_MESSAGE;
+    command.params.param1 = float(request.message_id);
+    command.params.param2 = 0.0f;
+    command.target_component_id = request.component_id;
+
+    return command;
+}
+
+void MAVLinkRequestScheduler::update_interval(Entry& entry)
+{
+    entry.interval_s = 0.0;
+    for (const auto& interval : entry.intervals_s) {
+        if (entry.interval_s == 0.0 || interval.second < entry.interval_s) {
+            entry.interval_s = interval.second;
+        }
+    }
+}
+
+void MAVLinkRequestScheduler::erase_if_unused(
+    uint32_t entry_key, std::vector<PendingCommand>& pending)
+{
+    auto it = _entries.find(entry_key);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    Entry& entry = it->second;
+    if (!entry.intervals_s.empty()) {
+        update_interval(entry);
+        return;
+    }
+
+    if (entry.method == Method::Stream) {
+        // Go back to the default rate. That is not necessarily the rate the
+        // component had before, if something else configured it.
+        pending.push_back({make_command_set_message_interval(entry.request, 0.0), nullptr});
+    }
+    _entries.erase(it);
+}
+
+MAVLinkRequestScheduler::Method MAVLinkRequestScheduler::first_method(const Request& request)
+{
+    if (!_components[request.component_id].set_message_interval_unsupported) {
+        return Method::SetMessageInterval;
+    }
+    return poll_method(request);
+}
+
+MAVLinkRequestScheduler::Method MAVLinkRequestScheduler::poll_method(const Request& request)
+{
+    if (_components[request.component_id].request_message_unsupported &&
+        request.fallback_command.command != 0) {
+        return Method::FallbackCommand;
+    }
+    return Method::RequestMessage;
+}
+
+MAVLinkRequestScheduler::PendingCommand
+MAVLinkRequestScheduler::make_request(uint32_t entry_key, Entry& entry)
+{
+    entry.in_flight = true;
+    entry.requested = true;
+    entry.last_requested = _time.steady_time();
+
+    const Method method = entry.method;
+
+    PendingCommand pending{};
+    switch (method) {
+        case Method::SetMessageInterval:
+            pending.command = make_command_set_message_interval(entry.request, entry.interval_s);
+            break;
+        case Method::RequestMessage:
+            pending.command = make_command_request_message(entry.request);
+            break;
+        case Method::FallbackCommand:
+            pending.command = entry.request.fallback_command;
+            pending.command.target_component_id = entry.request.component_id;
+            break;
+        case Method::Stream:
+            break;
+    }
+
+    pending.callback = [this, entry_key, method](MavlinkCommandSender::Result result, float) {
+        receive_result(entry_key, method, result);
+    };
+    return pending;
+}
+
+void MAVLinkRequestScheduler::receive_result(
+    uint32_t entry_key, Method method, MavlinkCommandSender::Result result)
+{
+    if (result == MavlinkCommandSender::Result::InProgress) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(entry_key);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    Entry& entry = it->second;
+    entry.in_flight = false;
+
+    if (entry.method != method) {
+        // Changed in the meantime, the result is not relevant anymore.
+        return;
+    }
+
+    if (result == MavlinkCommandSender::Result::NoSystem ||
+        result == MavlinkCommandSender::Result::ConnectionError ||
+        result == MavlinkCommandSender::Result::Busy) {
+        // Says nothing about the component, try again next time.
+        return;
+    }
+
+    Component& component = _components[entry.request.component_id];
+
+    switch (method) {
+        case Method::SetMessageInterval:
+            if (is_failure(result)) {
+                if (result == MavlinkCommandSender::Result::Unsupported) {
+                    component.set_message_interval_unsupported = true;
+                }
+                entry.method = poll_method(entry.request);
+                entry.requested = false;
+            } else {
+                entry.method = Method::Stream;
+                entry.last_received = _time.steady_time();
+            }
+            break;
+
+        case Method::RequestMessage:
+            // Components without support for MAV_CMD_REQUEST_MESSAGE don't
+            // necessarily acknowledge it.
+            if (is_failure(result) && entry.request.fallback_command.command != 0 &&
+                (result == MavlinkCommandSender::Result::Unsupported ||
+                 result == MavlinkCommandSender::Result::CommandDenied ||
+                 result == MavlinkCommandSender::Result::Timeout)) {
+                component.request_message_unsupported = true;
+                entry.method = Method::FallbackCommand;
+                entry.requested = false;
+            }
+            break;
+
+        case Method::FallbackCommand:
+        case Method::Stream:
+            break;
+    }
+}
+
+void MAVLinkRequestScheduler::send(const std::vector<PendingCommand>& pending)
+{
+    // Without holding the lock because results can be reported right away.
+    for (const auto& item : pending) {
+        _send_command(item.command, item.callback);
+    }
+}
+
+} // namespace mavsdk
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "global_include.h"
+#include "mavlink_commands.h"
+#include "mavlink_include.h"
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mavsdk {
+
+// Requests messages from components of a system periodically.
+//
+// Requests of the same message from the same component are merged, so a
+// message is only requested at the shortest interval asked for. If the
+// component accepts MAV_CMD_SET_MESSAGE_INTERVAL, the message is streamed
+// instead of polled. Otherwise it is polled using MAV_CMD_REQUEST_MESSAGE,
+// or the request's fallback command if that is not supported. Polling backs
+// off while the content of the message does not change.
+class MAVLinkRequestScheduler {
+public:
+    using SendCommandCallback = std::function<void(
+        const MavlinkCommandSender::CommandLong&,
+        const MavlinkCommandSender::CommandResultCallback&)>;
+
+    MAVLinkRequestScheduler(Time& time, const SendCommandCallback& send_command);
+    ~MAVLinkRequestScheduler() = default;
+
+    struct Request {
+        uint16_t message_id{0};
+        uint8_t component_id{0};
+
+        // Used if MAV_CMD_REQUEST_MESSAGE is not supported, e.g.
+        // MAV_CMD_REQUEST_CAMERA_INFORMATION. Unused if the command is 0.
+        MavlinkCommandSender::CommandLong fallback_command{};
+
+        // Bytes of the payload, e.g. a timestamp, which are ignored when
+        // checking whether the content has changed.
+        uint8_t ignored_offset{0};
+        uint8_t ignored_size{0};
+    };
+
+    void add(const Request& request, double interval_s, const void* cookie);
+    void remove(uint16_t message_id, uint8_t component_id, const void* cookie);
+    void remove_all(const void* cookie);
+
+    void process_message(const mavlink_message_t& message);
+
+    void do_work();
+
+    // The longest interval is the requested one multiplied by this.
+    static constexpr unsigned MAX_BACKOFF_FACTOR = 4;
+
+    // Non-copyable
+    MAVLinkRequestScheduler(const MAVLinkRequestScheduler&) = delete;
+    const MAVLinkRequestScheduler& operator=(const MAVLinkRequestScheduler&) = delete;
+
+private:
+    enum class Method { SetMessageInterval, Stream, RequestMessage, FallbackCommand };
+
+    struct Entry {
+        Request request{};
+        std::unordered_map<const void*, double> intervals_s{};
+        double interval_s{0.0};
+        Method method{Method::SetMessageInterval};
+        bool in_flight{false};
+        bool requested{false};
+        dl_time_t last_requested{};
+        dl_time_t last_received{};
+        bool has_content{false};
+        uint64_t content_hash{0};
+        unsigned backoff_factor{1};
+    };
+
+    // What we learnt about the commands a component supports.
+    struct Component {
+        bool set_message_interval_unsupported{false};
+        bool request_message_unsupported{false};
+    };
+
+    struct PendingCommand {
+        MavlinkCommandSender::CommandLong command{};
+        MavlinkCommandSender::CommandResultCallback callback{};
+    };
+
+    static uint32_t key(uint16_t message_id, uint8_t component_id);
+    static uint64_t content_hash(const mavlink_message_t& message, const Request& request);
+    static bool is_failure(MavlinkCommandSender::Result result);
+
+    static MavlinkCommandSender::CommandLong
+    make_command_set_message_interval(const Request& request, double interval_s);
+    static MavlinkCommandSender::CommandLong make_command_request_message(const Request& request);
+
+    // Assumes to have the lock for _mutex.
+    static void update_interval(Entry& entry);
+    void erase_if_unused(uint32_t entry_key, std::vector<PendingCommand>& pending);
+    Method first_method(const Request& request);
+    Method poll_method(const Request& request);
+    PendingCommand make_request(uint32_t entry_key, Entry& entry);
+
+    void receive_result(uint32_t entry_key, Method method, MavlinkCommandSender::Result result);
+    void send(const std::vector<PendingCommand>& pending);
+
+    Time& _time;
+    SendCommandCallback _send_command;
+
+    std::mutex _mutex{};
+    std::unordered_map<uint32_t, Entry> _entries{};
+    std::unordered_map<uint8_t, Component> _components{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+
+#include "global_include.h"
+#include "mavlink_request_scheduler.h"
+
+using namespace mavsdk;
+
+using Result = MavlinkCommandSender::Result;
+using CommandLong = MavlinkCommandSender::CommandLong;
+using Request = MAVLinkRequestScheduler::Request;
+
+static constexpr uint16_t message_id = 262;
+static constexpr uint16_t other_message_id = 261;
+static constexpr uint8_t component_id = 100;
+
+// Records the commands sent and answers them right away.
+class FakeCommandSender {
+public:
+    MAVLinkRequestScheduler::SendCommandCallback callback()
+    {
+        return [this](
+                   const CommandLong& command,
+                   const MavlinkCommandSender::CommandResultCallback& result_callback) {
+            commands.push_back(command);
+            if (result_callback) {
+                result_callback(result_for(command.command), NAN);
+            }
+        };
+    }
+
+    Result result_for(uint16_t command) const
+    {
+        switch (command) {
+            case MAV_CMD_SET_MESSAGE_INTERVAL:
+                return set_message_interval_result;
+            case MAV_CMD_REQUEST_MESSAGE:
+                return request_message_result;
+            default:
+                return Result::Success;
+        }
+    }
+
+    size_t count(uint16_t command) const
+    {
+        size_t num = 0;
+        for (const auto& sent : commands) {
+            if (sent.command == command) {
+                ++num;
+            }
+        }
+        return num;
+    }
+
+    Result set_message_interval_result{Result::Unsupported};
+    Result request_message_result{Result::Success};
+    std::vector<CommandLong> commands{};
+};
+
+static mavlink_message_t make_message(uint16_t id, uint8_t content, uint8_t timestamp)
+{
+    mavlink_message_t message{};
+    message.msgid = id;
+    message.compid = component_id;
+    message.len = 8;
+    auto* payload = reinterpret_cast<uint8_t*>(message.payload64);
+    payload[0] = timestamp;
+    payload[4] = content;
+    return message;
+}
+
+static Request make_request(uint16_t id, uint16_t fallback_command = 0)
+{
+    Request request{};
+    request.message_id = id;
+    request.component_id = component_id;
+    request.fallback_command.command = fallback_command;
+    request.ignored_offset = 0;
+    request.ignored_size = 4;
+    return request;
+}
+
+// Runs the scheduler for some time and answers all requests, either with
+// new or the same content.
+static void run_for(
+    MAVLinkRequestScheduler& scheduler,
+    FakeTime& time,
+    FakeCommandSender& sender,
+    double duration_s,
+    bool content_changes = true)
+{
+    const auto start = time.steady_time();
+    while (time.elapsed_since_s(start) < duration_s) {
+        const size_t sent_before = sender.commands.size();
+        scheduler.do_work();
+        for (size_t i = sent_before; i < sender.commands.size(); ++i) {
+            const auto& command = sender.commands[i];
+            if (command.command != MAV_CMD_SET_MESSAGE_INTERVAL) {
+                const auto counter = static_cast<uint8_t>(sender.commands.size());
+                scheduler.process_message(make_message(
+                    static_cast<uint16_t>(command.params.param1),
+                    content_changes ? counter : 0,
+                    counter));
+            }
+        }
+        time.sleep_for(std::chrono::milliseconds(100));
+    }
+}
+
+TEST(MAVLinkRequestScheduler, MergesDuplicateRequests)
+{
+    FakeTime time;
+    FakeCommandSender sender;
+    MAVLinkRequestScheduler scheduler(time, sender.callback());
+
+    int first_cookie;
+    int second_cookie;
+    scheduler.add(make_request(message_id), 1.0, &first_cookie);
+    scheduler.add(make_request(message_id), 1.0, &second_cookie);
+
+    run_for(scheduler, time, sender, 10.0);
+
+    EXPECT_EQ(sender.count(MAV_CMD_SET_MESSAGE_INTERVAL), 1);
+    EXPECT_GE(sender.count(MAV_CMD_REQUEST_MESSAGE), 9);
+    EXPECT_LE(sender.count(MAV_CMD_REQUEST_MESSAGE), 11);
+
+    // The shortest interval is used.
+    sender.commands.clear();
+    scheduler.add(make_request(message_id), 0.5, &second_cookie);
+    run_for(scheduler, time, sender, 10.0);
+    EXPECT_GE(sender.count(MAV_CMD_REQUEST_MESSAGE), 19);
+
+    // And back once it is removed.
+    sender.commands.clear();
+    scheduler.remove(message_id, component_id, &second_cookie);
+    run_for(scheduler, time, sender, 10.0);
+    EXPECT_LE(sender.count(MAV_CMD_REQUEST_MESSAGE), 11);
+
+    sender.commands.clear();
+    scheduler.remove_all(&first_cookie);
+    run_for(scheduler, time, sender, 5.0);
+    EXPECT_TRUE(sender.commands.empty());
+}
+
+TEST(MAVLinkRequestScheduler, StreamsIfSupported)
+{
+    FakeTime time;
+    FakeCommandSender sender;
+    sender.set_message_interval_result = Result::Success;
+    MAVLinkRequestScheduler scheduler(time, sender.callback());
+
+    int cookie;
+    scheduler.add(make_request(message_id), 0.5, &cookie);
+    scheduler.do_work();
+
+    ASSERT_EQ(sender.commands.size(), 1);
+    EXPECT_EQ(sender.commands[0].command, MAV_CMD_SET_MESSAGE_INTERVAL);
+    EXPECT_EQ(sender.commands[0].params.param1, float(message_id));
+    EXPECT_EQ(sender.commands[0].params.param2, 500000.0f);
+    EXPECT_EQ(sender.commands[0].target_component_id, component_id);
+
+    for (int i = 0; i < 20; ++i) {
+        scheduler.process_message(make_message(message_id, 0, 0));
+        time.sleep_for(std::chrono::milliseconds(500));
+        scheduler.do_work();
+    }
+    EXPECT_EQ(sender.commands.size(), 1);
+
+    // The default rate is restored.
+    scheduler.remove(message_id, component_id, &cookie);
+    ASSERT_EQ(sender.commands.size(), 2);
+    EXPECT_EQ(sender.commands[1].command, MAV_CMD_SET_MESSAGE_INTERVAL);
+    EXPECT_EQ(sender.commands[1].params.param2, 0.0f);
+}
+
+TEST(MAVLinkRequestScheduler, PollsIfNotStreamed)
+{
+    FakeTime time;
+    FakeCommandSender sender;
+    sender.set_message_interval_result = Result::Success;
+    MAVLinkRequestScheduler scheduler(time, sender.callback());
+
+    int cookie;
+    scheduler.add(make_request(message_id), 0.5, &cookie);
+
+    for (int i = 0; i < 20; ++i) {
+        scheduler.do_work();
+        time.sleep_for(std::chrono::milliseconds(250));
+    }
+
+    EXPECT_EQ(sender.count(MAV_CMD_SET_MESSAGE_INTERVAL), 1);
+    EXPECT_GE(sender.count(MAV_CMD_REQUEST_MESSAGE), 1);
+}
+
+TEST(MAVLinkRequestScheduler, UsesFallbackCommand)
+{
+    FakeTime time;
+    FakeCommandSender sender;
+    sender.request_message_result = Result::Unsupported;
+    MAVLinkRequestScheduler scheduler(time, sender.callback());
+
+    int cookie;
+    scheduler.add(
+        make_request(message_id, MAV_CMD_REQUEST_CAMERA_CAPTURE_STATUS), 1.0, &cookie);
+    run_for(scheduler, time, sender, 0.5);
+
+    ASSERT_EQ(sender.commands.size(), 3);
+    EXPECT_EQ(sender.commands[0].command, MAV_CMD_SET_MESSAGE_INTERVAL);
+    EXPECT_EQ(sender.commands[1].command, MAV_CMD_REQUEST_MESSAGE);
+    EXPECT_EQ(sender.commands[2].command, MAV_CMD_REQUEST_CAMERA_CAPTURE_STATUS);
+    EXPECT_EQ(sender.commands[2].target_component_id, component_id);
+
+    // What the component doesn't support is not tried again.
+    sender.commands.clear();
+    scheduler.add(
+        make_request(other_message_id, MAV_CMD_REQUEST_CAMERA_CAPTURE_STATUS), 1.0, &cookie);
+    run_for(scheduler, time, sender, 0.5);
+
+    ASSERT_EQ(sender.commands.size(), 1);
+    EXPECT_EQ(sender.commands[0].command, MAV_CMD_REQUEST_CAMERA_CAPTURE_STATUS);
+}
+
+TEST(MAVLinkRequestScheduler, BacksOffWhileContentIsUnchanged)
+{
+    FakeTime time;
+    FakeCommandSender sender;
+    MAVLinkRequestScheduler scheduler(time, sender.callback());
+
+    int cookie;
+    scheduler.add(make_request(message_id), 1.0, &cookie);
+
+    // Only the ignored timestamp changes.
+    run_for(scheduler, time, sender, 20.0, false);
+    const size_t unchanged_requests = sender.count(MAV_CMD_REQUEST_MESSAGE);
+    EXPECT_LE(unchanged_requests, 8);
+    EXPECT_GE(unchanged_requests, 20 / MAVLinkRequestScheduler::MAX_BACKOFF_FACTOR);
+
+    // A change is noticed at the next request at the latest, after that
+    // the message is requested at the full rate again.
+    run_for(scheduler, time, sender, MAVLinkRequestScheduler::MAX_BACKOFF_FACTOR * 1.0);
+    sender.commands.clear();
+    run_for(scheduler, time, sender, 10.0);
+    EXPECT_GE(sender.count(MAV_CMD_REQUEST_MESSAGE), 9);
+}
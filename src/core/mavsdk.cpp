@@ -83,6 +83,22 @@ bool Mavsdk::is_connected(const uint64_t uuid) const
     return _impl->is_connected(uuid);
 }
 
+bool Mavsdk::start_tlog_recording(
+    const std::string& path, uint64_t max_file_size, unsigned max_files)
+{
+    return _impl->start_tlog_recording(path, max_file_size, max_files);
+}
+
+void Mavsdk::stop_tlog_recording()
+{
+    _impl->stop_tlog_recording();
+}
+
+Mavsdk::Stats Mavsdk::get_stats() const
+{
+    return _impl->get_stats();
+}
+
 void Mavsdk::subscribe_on_new_system(const NewSystemCallback callback)
 {
     _impl->subscribe_on_new_system(callback);
@@ -59,11 +59,13 @@ public:
     /**
      * @brief Adds Connection via URL
      *
-     * Supports connection: Serial, TCP or UDP.
+     * Supports connection: Serial, TCP, UDP or the replay of a telemetry log.
      * Connection URL format should be:
      * - UDP - udp://[Bind_host][:Bind_port]
      * - TCP - tcp://[Remote_host][:Remote_port]
      * - Serial - serial://Dev_Node[:Baudrate]
+     * - Replay - replay://Tlog_path[?speed=Speed] (speed relative to the recording, 0 for as
+     *   fast as possible)
      *
      * @param connection_url connection URL string.
      * @return The result of adding the connection.
@@ -276,6 +278,86 @@ public:
      */
     DEPRECATED System& system(uint64_t uuid) const;
 
+    /**
+     * @brief Record all MAVLink messages sent and received into telemetry log (tlog) files.
+     *
+     * Every message is preceded by the time it was sent or received in microseconds since the
+     * epoch, as used by QGroundControl. Once a file has reached `max_file_size`, the recording
+     * continues in a new file with a number appended to the name, e.g. `flight_1.tlog`, and the
+     * oldest files are removed to keep at most `max_files` (0 keeps all).
+     *
+     * Messages are written from a separate thread. If it can't keep up, messages are skipped
+     * rather than slowing down the communication.
+     *
+     * @param path Path of the first file.
+     * @param max_file_size Maximum size of a file in bytes.
+     * @param max_files Maximum number of files to keep.
+     * @return true if the recording was started.
+     */
+    bool start_tlog_recording(
+        const std::string& path,
+        uint64_t max_file_size = 64 * 1024 * 1024,
+        unsigned max_files = 10);
+
+    /**
+     * @brief Stop recording the telemetry log, see `start_tlog_recording`.
+     */
+    void stop_tlog_recording();
+
+    /**
+     * @brief Statistics about the communication, see `get_stats`.
+     *
+     * All counters start when the connection is added, or when Mavsdk is created.
+     */
+    struct Stats {
+        /**
+         * @brief Counters of one connection.
+         */
+        struct Connection {
+            uint64_t bytes_received{0}; /**< @brief Bytes received. */
+            uint64_t bytes_sent{0}; /**< @brief Bytes sent. */
+            uint64_t messages_received{0}; /**< @brief Messages received. */
+            uint64_t messages_sent{0}; /**< @brief Messages sent. */
+            uint64_t crc_errors{0}; /**< @brief Frames dropped, mostly because of CRC errors. */
+            uint64_t messages_lost{0}; /**< @brief Messages missing according to the
+                                          sequence numbers of each sender. */
+        };
+
+        /**
+         * @brief Counters of one type of message received.
+         */
+        struct Message {
+            uint32_t message_id{0}; /**< @brief MAVLink message id. */
+            uint64_t num_received{0}; /**< @brief Messages received. */
+            double rate_hz{0.0}; /**< @brief Current rate of the messages. */
+            double handler_time_mean_us{0.0}; /**< @brief Mean time spent handling one. */
+            double handler_time_max_us{0.0}; /**< @brief Longest time spent handling one. */
+        };
+
+        /**
+         * @brief State of the queue of callbacks to the user.
+         */
+        struct UserCallbacks {
+            uint64_t queue_depth{0}; /**< @brief Callbacks currently waiting. */
+            uint64_t max_queue_depth{0}; /**< @brief Most callbacks waiting at once. */
+            double max_latency_us{0.0}; /**< @brief Longest wait until a callback was called. */
+            uint64_t num_dropped{0}; /**< @brief Callbacks dropped because the queue was full. */
+        };
+
+        std::vector<Connection> connections{}; /**< @brief In the order they were added. */
+        std::vector<Message> messages{}; /**< @brief Sorted by message id. */
+        UserCallbacks user_callbacks{}; /**< @brief The queue of user callbacks. */
+    };
+
+    /**
+     * @brief Get statistics about the communication.
+     *
+     * The counters are cheap enough to be always on, and only summed up when calling this.
+     *
+     * @return The current statistics.
+     */
+    Stats get_stats() const;
+
     /**
      * @brief Callback type discover and timeout notifications.
      */
@@ -10,7 +10,9 @@
 #include "system.h"
 #include "system_impl.h"
 #include "serial_connection.h"
+#include "replay_connection.h"
 #include "cli_arg.h"
+#include "trace.h"
 #include "version.h"
 
 namespace mavsdk {
@@ -26,6 +28,14 @@ MavsdkImpl::MavsdkImpl() : timeout_handler(_time), call_every_handler(_time)
         }
     }
 
+#if defined(ENABLE_TRACING)
+    if (const char* env_p = std::getenv("MAVSDK_TRACE_FILE")) {
+        LogDebug() << "Tracing into " << env_p;
+        _trace_file = env_p;
+        Trace::start();
+    }
+#endif
+
     _work_thread = new std::thread(&MavsdkImpl::work_thread, this);
 
     _process_user_callbacks_thread =
@@ -61,6 +71,12 @@ MavsdkImpl::~MavsdkImpl()
         std::lock_guard<std::mutex> lock(_connections_mutex);
         _connections.clear();
     }
+
+#if defined(ENABLE_TRACING)
+    if (!_trace_file.empty() && !Trace::write_json(_trace_file)) {
+        LogErr() << "Could not write trace to " << _trace_file;
+    }
+#endif
 }
 
 std::string MavsdkImpl::version() const
@@ -111,6 +127,8 @@ std::vector<std::shared_ptr<System>> MavsdkImpl::systems() const
 
 void MavsdkImpl::receive_message(mavlink_message_t& message)
 {
+    _tlog_recorder.record(message);
+
     // Don't ever create a system with sysid 0.
     if (message.sysid == 0) {
         return;
@@ -146,12 +164,22 @@ void MavsdkImpl::receive_message(mavlink_message_t& message)
     }
 
     if (_systems.find(message.sysid) != _systems.end()) {
+        const auto started = std::chrono::steady_clock::now();
         _systems.at(message.sysid)->system_impl()->process_mavlink_message(message);
+        const auto handler_time = std::chrono::steady_clock::now() - started;
+
+        _message_stats.message_handled(
+            message.msgid,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(started.time_since_epoch())
+                .count(),
+            std::chrono::duration_cast<std::chrono::nanoseconds>(handler_time).count());
     }
 }
 
 bool MavsdkImpl::send_message(mavlink_message_t& message)
 {
+    _tlog_recorder.record(message);
+
     std::lock_guard<std::mutex> lock(_connections_mutex);
 
     for (auto it = _connections.begin(); it != _connections.end(); ++it) {
@@ -159,6 +187,28 @@ bool MavsdkImpl::send_message(mavlink_message_t& message)
             LogErr() << "send fail";
             return false;
         }
+        (**it).stats().message_sent(message);
+    }
+
+    return true;
+}
+
+bool MavsdkImpl::send_messages(const std::vector<mavlink_message_t>& messages)
+{
+    for (const auto& message : messages) {
+        _tlog_recorder.record(message);
+    }
+
+    std::lock_guard<std::mutex> lock(_connections_mutex);
+
+    for (auto it = _connections.begin(); it != _connections.end(); ++it) {
+        if (!(**it).send_messages(messages)) {
+            LogErr() << "send fail";
+            return false;
+        }
+        for (const auto& message : messages) {
+            (**it).stats().message_sent(message);
+        }
     }
 
     return true;
@@ -205,6 +255,10 @@ ConnectionResult MavsdkImpl::add_any_connection(const std::string& connection_ur
             return add_serial_connection(cli_arg.get_path(), baudrate, flow_control);
         }
 
+        case CliArg::Protocol::Replay: {
+            return add_replay_connection(cli_arg.get_path(), cli_arg.get_replay_speed());
+        }
+
         default:
             return ConnectionResult::ConnectionError;
     }
@@ -275,6 +329,26 @@ MavsdkImpl::add_serial_connection(const std::string& dev_path, int baudrate, boo
     return ret;
 }
 
+ConnectionResult MavsdkImpl::add_replay_connection(const std::string& path, double speed)
+{
+    // Run the handlers along with the recorded time instead of waiting for
+    // the work thread, so that they see the same times on every replay.
+    auto new_conn = std::make_shared<ReplayConnection>(
+        std::bind(&MavsdkImpl::receive_message, this, std::placeholders::_1),
+        path,
+        speed,
+        _time,
+        [this]() { run_handlers(); });
+    if (!new_conn) {
+        return ConnectionResult::ConnectionError;
+    }
+    ConnectionResult ret = new_conn->start();
+    if (ret == ConnectionResult::Success) {
+        add_connection(new_conn);
+    }
+    return ret;
+}
+
 void MavsdkImpl::add_connection(std::shared_ptr<Connection> new_connection)
 {
     std::lock_guard<std::mutex> lock(_connections_mutex);
@@ -492,12 +566,22 @@ void MavsdkImpl::register_on_timeout(const Mavsdk::event_callback_t callback)
 void MavsdkImpl::work_thread()
 {
     while (!_should_exit) {
-        timeout_handler.run_once();
-        call_every_handler.run_once();
+        // While replaying, the replay connection runs them instead, along with
+        // the recorded time. Once it is done, the time is real again.
+        if (!_time.is_virtual()) {
+            run_handlers();
+        }
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 }
 
+void MavsdkImpl::run_handlers()
+{
+    std::lock_guard<std::mutex> lock(_run_handlers_mutex);
+    timeout_handler.run_once();
+    call_every_handler.run_once();
+}
+
 void MavsdkImpl::call_user_callback_located(
     const std::string& filename, const int linenumber, const std::function<void()>& func)
 {
@@ -513,12 +597,22 @@ void MavsdkImpl::call_user_callback_located(
                "See: https://mavsdk.mavlink.io/develop/en/cpp/troubleshooting.html#user_callbacks";
 
     } else if (callback_size == 100) {
+        ++_user_callbacks_dropped;
         return;
     }
 
+    const uint64_t depth = callback_size + 1;
+    uint64_t max_depth = _user_callbacks_max_depth;
+    while (depth > max_depth && !_user_callbacks_max_depth.compare_exchange_weak(max_depth, depth)) {}
+
     // We only need to keep track of filename and linenumber if we're actually debugging this.
     UserCallback user_callback =
         _callback_debugging ? UserCallback{func, filename, linenumber} : UserCallback{func};
+    user_callback.enqueued = std::chrono::steady_clock::now();
+#if defined(ENABLE_TRACING)
+    user_callback.trace_id = Trace::next_id();
+#endif
+    MAVSDK_TRACE_ASYNC_BEGIN("user_callback_queue", user_callback.trace_id);
 
     _user_callback_queue.enqueue(user_callback);
 }
@@ -530,6 +624,15 @@ void MavsdkImpl::process_user_callbacks_thread()
         if (!callback.first) {
             continue;
         }
+        MAVSDK_TRACE_ASYNC_END("user_callback_queue", callback.second.trace_id);
+
+        const int64_t latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now() - callback.second.enqueued)
+                                       .count();
+        if (latency_ns > _user_callbacks_max_latency_ns) {
+            // Only this thread writes it.
+            _user_callbacks_max_latency_ns = latency_ns;
+        }
 
         void* cookie{nullptr};
 
@@ -551,7 +654,10 @@ void MavsdkImpl::process_user_callbacks_thread()
             },
             timeout_s,
             &cookie);
-        callback.second.func();
+        {
+            MAVSDK_TRACE_SCOPE("user_callback");
+            callback.second.func();
+        }
         timeout_handler.remove(cookie);
     }
 }
@@ -562,6 +668,55 @@ void MavsdkImpl::start_sending_heartbeat()
         [this]() { send_heartbeat(); }, _HEARTBEAT_SEND_INTERVAL_S, &_heartbeat_send_cookie);
 }
 
+Mavsdk::Stats MavsdkImpl::get_stats()
+{
+    Mavsdk::Stats stats;
+
+    {
+        std::lock_guard<std::mutex> lock(_connections_mutex);
+        for (const auto& connection : _connections) {
+            const auto snapshot = connection->stats().snapshot();
+            Mavsdk::Stats::Connection connection_stats;
+            connection_stats.bytes_received = snapshot.bytes_received;
+            connection_stats.bytes_sent = snapshot.bytes_sent;
+            connection_stats.messages_received = snapshot.messages_received;
+            connection_stats.messages_sent = snapshot.messages_sent;
+            connection_stats.crc_errors = snapshot.crc_errors;
+            connection_stats.messages_lost = snapshot.messages_lost;
+            stats.connections.push_back(connection_stats);
+        }
+    }
+
+    for (const auto& entry : _message_stats.snapshot()) {
+        Mavsdk::Stats::Message message_stats;
+        message_stats.message_id = entry.message_id;
+        message_stats.num_received = entry.num_received;
+        message_stats.rate_hz = entry.rate_hz;
+        message_stats.handler_time_mean_us = entry.handler_time_mean_us;
+        message_stats.handler_time_max_us = entry.handler_time_max_us;
+        stats.messages.push_back(message_stats);
+    }
+
+    stats.user_callbacks.queue_depth = _user_callback_queue.size();
+    stats.user_callbacks.max_queue_depth = _user_callbacks_max_depth;
+    stats.user_callbacks.max_latency_us =
+        static_cast<double>(_user_callbacks_max_latency_ns.load()) / 1e3;
+    stats.user_callbacks.num_dropped = _user_callbacks_dropped;
+
+    return stats;
+}
+
+bool MavsdkImpl::start_tlog_recording(
+    const std::string& path, uint64_t max_file_size, unsigned max_files)
+{
+    return _tlog_recorder.start(path, max_file_size, max_files);
+}
+
+void MavsdkImpl::stop_tlog_recording()
+{
+    _tlog_recorder.stop();
+}
+
 void MavsdkImpl::send_heartbeat()
 {
     mavlink_message_t message;
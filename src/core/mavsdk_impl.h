@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <unordered_map>
 #include <mutex>
 #include <vector>
@@ -7,12 +8,15 @@
 
 #include "call_every_handler.h"
 #include "connection.h"
+#include "http_loader.h"
+#include "link_stats.h"
 #include "mavsdk.h"
 #include "mavlink_include.h"
 #include "mavlink_address.h"
 #include "safe_queue.h"
 #include "system.h"
 #include "timeout_handler.h"
+#include "tlog_recorder.h"
 
 namespace mavsdk {
 
@@ -40,6 +44,7 @@ public:
 
     void receive_message(mavlink_message_t& message);
     bool send_message(mavlink_message_t& message);
+    bool send_messages(const std::vector<mavlink_message_t>& messages);
 
     ConnectionResult add_any_connection(const std::string& connection_url);
     ConnectionResult
@@ -49,6 +54,7 @@ public:
     ConnectionResult
     add_serial_connection(const std::string& dev_path, int baudrate, bool flow_control);
     ConnectionResult setup_udp_remote(const std::string& remote_ip, int remote_port);
+    ConnectionResult add_replay_connection(const std::string& path, double speed);
 
     std::vector<std::shared_ptr<System>> systems() const;
 
@@ -74,8 +80,14 @@ public:
 
     void start_sending_heartbeat();
 
+    Mavsdk::Stats get_stats();
+
+    bool start_tlog_recording(const std::string& path, uint64_t max_file_size, unsigned max_files);
+    void stop_tlog_recording();
+
     TimeoutHandler timeout_handler;
     CallEveryHandler call_every_handler;
+    HttpLoader http_loader{};
 
     void call_user_callback_located(
         const std::string& filename, const int linenumber, const std::function<void()>& func);
@@ -88,12 +100,15 @@ private:
     bool does_system_exist(uint8_t system_id);
 
     void work_thread();
+    void run_handlers();
     void process_user_callbacks_thread();
 
     void send_heartbeat();
 
     using system_entry_t = std::pair<uint8_t, std::shared_ptr<System>>;
 
+    TlogRecorder _tlog_recorder{};
+
     std::mutex _connections_mutex{};
     std::vector<std::shared_ptr<Connection>> _connections{};
 
@@ -106,7 +121,8 @@ private:
     Mavsdk::event_callback_t _on_discover_callback{nullptr};
     Mavsdk::event_callback_t _on_timeout_callback{nullptr};
 
-    Time _time{};
+    // Replay connections make it follow the time of the recording.
+    VirtualTime _time{};
 
     Mavsdk::Configuration _configuration{Mavsdk::Configuration::UsageType::GroundStation};
     bool _is_single_system{false};
@@ -126,11 +142,25 @@ private:
         std::function<void()> func{};
         std::string filename{};
         int linenumber{};
+        std::chrono::steady_clock::time_point enqueued{};
+#if defined(ENABLE_TRACING)
+        uint64_t trace_id{0};
+#endif
     };
 
     std::thread* _work_thread{nullptr};
+    std::mutex _run_handlers_mutex{};
     std::thread* _process_user_callbacks_thread{nullptr};
     SafeQueue<UserCallback> _user_callback_queue{};
+    std::atomic<uint64_t> _user_callbacks_max_depth{0};
+    std::atomic<uint64_t> _user_callbacks_dropped{0};
+    std::atomic<int64_t> _user_callbacks_max_latency_ns{0};
+
+    MessageStats _message_stats{};
+
+#if defined(ENABLE_TRACING)
+    std::string _trace_file{};
+#endif
     bool _callback_debugging{false};
 
     static constexpr double _HEARTBEAT_SEND_INTERVAL_S = 1.0;
@@ -1,5 +1,7 @@
 #include "mavsdk.h"
 #include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
 
 using namespace mavsdk;
 
@@ -8,3 +10,12 @@ TEST(Mavsdk, version)
     Mavsdk mavsdk;
     ASSERT_GT(mavsdk.version().size(), 5);
 }
+
+TEST(Mavsdk, ConstructsAndDestructsRepeatedly)
+{
+    // Each instance sets up its handlers and threads, and tears them down.
+    for (unsigned i = 0; i < 3; ++i) {
+        Mavsdk mavsdk;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
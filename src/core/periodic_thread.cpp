@@ -0,0 +1,122 @@
+#include "periodic_thread.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(LINUX) || defined(ANDROID)
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace mavsdk {
+
+PeriodicThread::~PeriodicThread()
+{
+    stop();
+}
+
+void PeriodicThread::start(double rate_hz, const std::function<void()>& callback)
+{
+    stop();
+
+    if (rate_hz <= 0.0 || !callback) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        _stats = Stats{};
+        _jitter_m2_us2 = 0.0;
+    }
+
+    _callback = callback;
+    _should_exit = false;
+
+    const auto period =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+    _thread = new std::thread(&PeriodicThread::run, this, period);
+}
+
+void PeriodicThread::stop()
+{
+    if (_thread == nullptr) {
+        return;
+    }
+
+    // The thread notices this at its next deadline at the latest.
+    _should_exit = true;
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+    _callback = nullptr;
+}
+
+bool PeriodicThread::is_running() const
+{
+    return _thread != nullptr;
+}
+
+PeriodicThread::Stats PeriodicThread::stats() const
+{
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    return _stats;
+}
+
+void PeriodicThread::run(Clock::duration period)
+{
+    auto deadline = Clock::now() + period;
+
+    while (!_should_exit) {
+        sleep_until(deadline);
+        if (_should_exit) {
+            break;
+        }
+
+        const auto lateness = Clock::now() - deadline;
+        uint64_t num_missed = 0;
+        if (lateness >= period) {
+            num_missed = static_cast<uint64_t>(lateness / period);
+            deadline += period * num_missed;
+        }
+
+        _callback();
+
+        record(lateness - period * num_missed, num_missed);
+        deadline += period;
+    }
+}
+
+void PeriodicThread::record(Clock::duration lateness, uint64_t num_missed)
+{
+    const double lateness_us = std::chrono::duration<double, std::micro>(lateness).count();
+
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+
+    ++_stats.num_calls;
+    _stats.num_missed_deadlines += num_missed;
+
+    const double delta = lateness_us - _stats.jitter_mean_us;
+    _stats.jitter_mean_us += delta / static_cast<double>(_stats.num_calls);
+    _jitter_m2_us2 += delta * (lateness_us - _stats.jitter_mean_us);
+    _stats.jitter_stddev_us = std::sqrt(_jitter_m2_us2 / static_cast<double>(_stats.num_calls));
+    _stats.jitter_max_us = std::max(_stats.jitter_max_us, lateness_us);
+}
+
+void PeriodicThread::sleep_until(Clock::time_point deadline)
+{
+#if defined(LINUX) || defined(ANDROID)
+    // The steady clock is CLOCK_MONOTONIC here. Sleeping until an absolute
+    // time avoids adding up the delay between reading the clock and going
+    // to sleep.
+    const auto since_epoch =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(since_epoch.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(since_epoch.count() % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+} // namespace mavsdk
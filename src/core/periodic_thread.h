@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mavsdk {
+
+// Calls a function periodically from a thread of its own.
+//
+// The thread sleeps until absolute deadlines, so the period does not drift
+// with the time the function takes. If it falls behind by whole periods,
+// these are skipped instead of being caught up in a burst.
+class PeriodicThread {
+public:
+    PeriodicThread() = default;
+    ~PeriodicThread();
+
+    struct Stats {
+        uint64_t num_calls{0};
+        // Deadlines that were skipped because we were too late.
+        uint64_t num_missed_deadlines{0};
+        // How late the function was called after its deadline.
+        double jitter_mean_us{0.0};
+        double jitter_stddev_us{0.0};
+        double jitter_max_us{0.0};
+    };
+
+    // Stops a running thread first, and resets the stats.
+    void start(double rate_hz, const std::function<void()>& callback);
+    void stop();
+    bool is_running() const;
+
+    Stats stats() const;
+
+    // Non-copyable
+    PeriodicThread(const PeriodicThread&) = delete;
+    const PeriodicThread& operator=(const PeriodicThread&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run(Clock::duration period);
+    void record(Clock::duration lateness, uint64_t num_missed);
+
+    static void sleep_until(Clock::time_point deadline);
+
+    std::function<void()> _callback{};
+    std::thread* _thread{nullptr};
+    std::atomic<bool> _should_exit{false};
+
+    mutable std::mutex _stats_mutex{};
+    Stats _stats{};
+    // Sum of squared differences from the mean, see Welford's algorithm.
+    double _jitter_m2_us2{0.0};
+};
+
+} // namespace mavsdk
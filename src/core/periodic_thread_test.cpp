@@ -0,0 +1,74 @@
+#include "periodic_thread.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace mavsdk;
+
+TEST(PeriodicThread, CallsAtRate)
+{
+    PeriodicThread periodic_thread{};
+    std::atomic<int> num_calls{0};
+
+    periodic_thread.start(100.0, [&num_calls]() { ++num_calls; });
+    EXPECT_TRUE(periodic_thread.is_running());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    periodic_thread.stop();
+    EXPECT_FALSE(periodic_thread.is_running());
+
+    // Generous because of loaded test machines.
+    EXPECT_GE(num_calls, 40);
+    EXPECT_LE(num_calls, 51);
+
+    const auto stats = periodic_thread.stats();
+    EXPECT_EQ(stats.num_calls, static_cast<uint64_t>(num_calls));
+    EXPECT_GE(stats.jitter_mean_us, 0.0);
+    EXPECT_GE(stats.jitter_max_us, stats.jitter_mean_us);
+    EXPECT_GE(stats.jitter_stddev_us, 0.0);
+
+    // Nothing is called anymore after stopping.
+    const int num_calls_stopped = num_calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(num_calls, num_calls_stopped);
+}
+
+TEST(PeriodicThread, SkipsMissedDeadlines)
+{
+    PeriodicThread periodic_thread{};
+    std::atomic<int> num_calls{0};
+
+    // Each call takes as long as three and a half periods.
+    periodic_thread.start(100.0, [&num_calls]() {
+        ++num_calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(35));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    periodic_thread.stop();
+
+    const auto stats = periodic_thread.stats();
+    EXPECT_LE(stats.num_calls, 12);
+    EXPECT_GE(stats.num_missed_deadlines, 2 * stats.num_calls);
+}
+
+TEST(PeriodicThread, RestartsWithNewRate)
+{
+    PeriodicThread periodic_thread{};
+    std::atomic<int> num_calls{0};
+
+    periodic_thread.start(1000.0, [&num_calls]() { ++num_calls; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    periodic_thread.start(10.0, [&num_calls]() { ++num_calls; });
+    EXPECT_EQ(periodic_thread.stats().num_calls, 0);
+
+    num_calls = 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(350));
+    periodic_thread.stop();
+    EXPECT_GE(num_calls, 2);
+    EXPECT_LE(num_calls, 4);
+
+    // Stopping twice is fine, and so is not starting with a rate of 0.
+    periodic_thread.stop();
+    periodic_thread.start(0.0, [&num_calls]() { ++num_calls; });
+    EXPECT_FALSE(periodic_thread.is_running());
+}
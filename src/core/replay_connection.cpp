@@ -0,0 +1,254 @@
+#include "replay_connection.h"
+#include "log.h"
+#include <fstream>
+
+namespace mavsdk {
+
+namespace {
+
+constexpr size_t TIMESTAMP_LEN = sizeof(uint64_t);
+
+// Handlers timed against the virtual time don't need to run for every
+// message, this is about how often the work thread runs them.
+constexpr uint64_t TIME_ADVANCED_INTERVAL_US = 10000;
+
+} // namespace
+
+ReplayConnection::ReplayConnection(
+    Connection::receiver_callback_t receiver_callback,
+    const std::string& path,
+    double speed,
+    VirtualTime& time,
+    TimeAdvancedCallback time_advanced_callback) :
+    Connection(receiver_callback),
+    _path(path),
+    _speed(speed),
+    _time(time),
+    _time_advanced_callback(time_advanced_callback)
+{}
+
+ReplayConnection::~ReplayConnection()
+{
+    // If no one explicitly called stop before, we should at least do it.
+    stop();
+}
+
+ConnectionResult ReplayConnection::start()
+{
+    if (!load_file()) {
+        return ConnectionResult::ConnectionError;
+    }
+
+    if (!start_mavlink_receiver()) {
+        return ConnectionResult::ConnectionsExhausted;
+    }
+
+    _replay_thread = new std::thread(&ReplayConnection::replay, this);
+
+    return ConnectionResult::Success;
+}
+
+ConnectionResult ReplayConnection::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _should_exit = true;
+    }
+    _cv.notify_all();
+
+    if (_replay_thread != nullptr) {
+        _replay_thread->join();
+        delete _replay_thread;
+        _replay_thread = nullptr;
+    }
+
+    // We need to stop this after stopping the replay thread, otherwise
+    // it can happen that we interfere with the parsing of a message.
+    stop_mavlink_receiver();
+
+    return ConnectionResult::Success;
+}
+
+bool ReplayConnection::send_message(const mavlink_message_t& message)
+{
+    UNUSED(message);
+    return true;
+}
+
+ReplayConnection::Stats ReplayConnection::stats() const
+{
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    return _stats;
+}
+
+bool ReplayConnection::wait_until_finished(double timeout_s)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _cv.wait_for(lock, std::chrono::duration<double>(timeout_s), [this]() {
+        std::lock_guard<std::mutex> stats_lock(_stats_mutex);
+        return _stats.finished;
+    });
+}
+
+bool ReplayConnection::load_file()
+{
+    // Read it all at once, so that the replay is not slowed down by the disk.
+    std::ifstream file(_path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        LogErr() << "Could not open replay file " << _path;
+        return false;
+    }
+
+    const auto size = file.tellg();
+    file.seekg(0);
+    _tlog.resize(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(_tlog.data()), size)) {
+        LogErr() << "Could not read replay file " << _path;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayConnection::next_frame(
+    const std::vector<uint8_t>& tlog, size_t& offset, Frame& frame, uint64_t& num_skipped)
+{
+    // Every frame is preceded by a big-endian timestamp in us.
+    while (offset + TIMESTAMP_LEN < tlog.size()) {
+        const size_t start = offset + TIMESTAMP_LEN;
+
+        size_t len = 0;
+        if (tlog[start] == MAVLINK_STX && start + 3 <= tlog.size()) {
+            const uint8_t payload_len = tlog[start + 1];
+            const uint8_t incompat_flags = tlog[start + 2];
+            len = 1 + MAVLINK_CORE_HEADER_LEN + payload_len + MAVLINK_NUM_CHECKSUM_BYTES;
+            if (incompat_flags & MAVLINK_IFLAG_SIGNED) {
+                len += MAVLINK_SIGNATURE_BLOCK_LEN;
+            }
+        } else if (tlog[start] == MAVLINK_STX_MAVLINK1 && start + 2 <= tlog.size()) {
+            const uint8_t payload_len = tlog[start + 1];
+            len = 1 + MAVLINK_CORE_HEADER_MAVLINK1_LEN + payload_len + MAVLINK_NUM_CHECKSUM_BYTES;
+        }
+
+        if (len == 0 || start + len > tlog.size()) {
+            // Out of sync, try again one byte later.
+            ++offset;
+            ++num_skipped;
+            continue;
+        }
+
+        frame.timestamp_us = 0;
+        for (size_t i = 0; i < TIMESTAMP_LEN; ++i) {
+            frame.timestamp_us = (frame.timestamp_us << 8) | tlog[offset + i];
+        }
+        frame.data = &tlog[start];
+        frame.len = len;
+
+        offset = start + len;
+        return true;
+    }
+
+    num_skipped += tlog.size() - offset;
+    offset = tlog.size();
+    return false;
+}
+
+void ReplayConnection::replay()
+{
+    const auto started = std::chrono::steady_clock::now();
+
+    size_t offset = 0;
+    Frame frame;
+    uint64_t num_skipped = 0;
+    uint64_t num_messages = 0;
+    uint64_t num_bad_frames = 0;
+    uint64_t last_time_advanced_us = 0;
+
+    while (next_frame(_tlog, offset, frame, num_skipped)) {
+        if (!wait_for_frame_time(frame.timestamp_us)) {
+            // Stopped.
+            break;
+        }
+
+        _time.set_system_time(dl_system_time_t(std::chrono::microseconds(frame.timestamp_us)));
+
+        // The parser only takes non-const data, the frame is not changed though.
+        _mavlink_receiver->set_new_datagram(
+            reinterpret_cast<char*>(const_cast<uint8_t*>(frame.data)),
+            static_cast<unsigned>(frame.len));
+
+        bool parsed = false;
+        while (_mavlink_receiver->parse_message()) {
+            parsed = true;
+            ++num_messages;
+            receive_message(_mavlink_receiver->get_last_message());
+        }
+        if (!parsed) {
+            ++num_bad_frames;
+        }
+
+        if (_time_advanced_callback &&
+            frame.timestamp_us >= last_time_advanced_us + TIME_ADVANCED_INTERVAL_US) {
+            last_time_advanced_us = frame.timestamp_us;
+            _time_advanced_callback();
+        }
+    }
+
+    // Whether finished or stopped, the time is real again, so that the work
+    // thread takes over running the handlers.
+    _time.set_real();
+
+    const double duration_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        _stats.num_messages = num_messages;
+        _stats.num_bad_frames = num_bad_frames;
+        _stats.num_skipped_bytes = num_skipped;
+        _stats.num_bytes = offset;
+        _stats.duration_s = duration_s;
+        _stats.finished = true;
+    }
+
+    if (num_skipped > 0) {
+        LogWarn() << "Skipped " << num_skipped << " bytes of replay file which are not MAVLink";
+    }
+    LogInfo() << "Replayed " << num_messages << " messages in " << duration_s << " s";
+
+    {
+        // Taken so that the notification is not lost between checking and
+        // waiting in wait_until_finished.
+        std::lock_guard<std::mutex> lock(_mutex);
+    }
+    _cv.notify_all();
+}
+
+bool ReplayConnection::wait_for_frame_time(uint64_t timestamp_us)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (_speed <= 0.0) {
+        // As fast as possible.
+        return !_should_exit;
+    }
+
+    if (_first_frame_time == std::chrono::steady_clock::time_point{}) {
+        _first_frame_time = std::chrono::steady_clock::now();
+        _first_timestamp_us = timestamp_us;
+        return !_should_exit;
+    }
+
+    // Recordings can jump back in time, these frames are replayed right away.
+    const double since_first_s =
+        (timestamp_us > _first_timestamp_us) ?
+            static_cast<double>(timestamp_us - _first_timestamp_us) * 1e-6 / _speed :
+            0.0;
+    const auto frame_time = _first_frame_time +
+                            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<double>(since_first_s));
+
+    _cv.wait_until(lock, frame_time, [this]() { return _should_exit; });
+    return !_should_exit;
+}
+
+} // namespace mavsdk
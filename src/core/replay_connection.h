@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "connection.h"
+#include "global_include.h"
+
+namespace mavsdk {
+
+// Feeds the messages of a telemetry log (tlog) file into the library as if
+// they were received, e.g. for regression tests and benchmarks without a
+// simulator.
+//
+// The messages are replayed at a multiple of the recorded speed, or as fast
+// as possible for a speed of 0. The virtual time is set to the timestamp of
+// every message, so that everything timed against it sees the recorded
+// time, no matter how fast the replay is. Once the replay is finished or
+// stopped, the time follows the real clock again.
+class ReplayConnection : public Connection {
+public:
+    // Called from the replay thread whenever the time has advanced.
+    using TimeAdvancedCallback = std::function<void()>;
+
+    explicit ReplayConnection(
+        Connection::receiver_callback_t receiver_callback,
+        const std::string& path,
+        double speed,
+        VirtualTime& time,
+        TimeAdvancedCallback time_advanced_callback);
+    ConnectionResult start() override;
+    ConnectionResult stop() override;
+    ~ReplayConnection();
+
+    // Nothing can be sent to a recording, so this does nothing.
+    bool send_message(const mavlink_message_t& message) override;
+
+    struct Stats {
+        uint64_t num_messages{0};
+        uint64_t num_bad_frames{0};
+        uint64_t num_skipped_bytes{0};
+        uint64_t num_bytes{0};
+        double duration_s{0.0};
+        bool finished{false};
+    };
+
+    Stats stats() const;
+
+    // Returns false if the replay has not finished within the timeout.
+    bool wait_until_finished(double timeout_s);
+
+    struct Frame {
+        uint64_t timestamp_us{0};
+        const uint8_t* data{nullptr};
+        size_t len{0};
+    };
+
+    // Returns the frame at offset and moves offset past it. Bytes which
+    // don't form a frame are skipped, num_skipped counts them.
+    static bool next_frame(
+        const std::vector<uint8_t>& tlog, size_t& offset, Frame& frame, uint64_t& num_skipped);
+
+    // Non-copyable
+    ReplayConnection(const ReplayConnection&) = delete;
+    const ReplayConnection& operator=(const ReplayConnection&) = delete;
+
+private:
+    bool load_file();
+    void replay();
+    bool wait_for_frame_time(uint64_t timestamp_us);
+
+    const std::string _path;
+    const double _speed;
+    VirtualTime& _time;
+    TimeAdvancedCallback _time_advanced_callback;
+
+    std::vector<uint8_t> _tlog{};
+
+    std::mutex _mutex{};
+    std::condition_variable _cv{};
+    bool _should_exit{false};
+
+    // Only used by the replay thread.
+    std::chrono::steady_clock::time_point _first_frame_time{};
+    uint64_t _first_timestamp_us{0};
+
+    mutable std::mutex _stats_mutex{};
+    Stats _stats{};
+
+    std::thread* _replay_thread{nullptr};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,92 @@
+#include "replay_connection.h"
+#include "log.h"
+#include "mavsdk_impl.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+namespace {
+
+void write_tlog(const std::string& path, unsigned num_messages)
+{
+    std::vector<uint8_t> tlog;
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint64_t start_us = 1500000000000000;
+
+    for (unsigned i = 0; i < num_messages; ++i) {
+        // 1 kHz, about what a fast telemetry link delivers.
+        const uint64_t timestamp_us = start_us + i * 1000;
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            tlog.push_back(static_cast<uint8_t>(timestamp_us >> shift));
+        }
+
+        mavlink_message_t message;
+        mavlink_msg_heartbeat_pack(
+            1, 1, &message, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+        const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+        tlog.insert(tlog.end(), buffer, buffer + len);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(
+        reinterpret_cast<const char*>(tlog.data()), static_cast<std::streamsize>(tlog.size()));
+}
+
+} // namespace
+
+// Parsing only, the messages are dropped right away.
+static void BM_ReplayConnectionParse(benchmark::State& state)
+{
+    const std::string path = "replay_connection_benchmark.tlog";
+    const auto num_messages = static_cast<unsigned>(state.range(0));
+    write_tlog(path, num_messages);
+    log::set_level(log::Level::Warn);
+
+    VirtualTime time;
+    for (auto _ : state) {
+        ReplayConnection connection([](mavlink_message_t&) {}, path, 0.0, time, nullptr);
+        if (connection.start() != ConnectionResult::Success ||
+            !connection.wait_until_finished(60.0)) {
+            state.SkipWithError("Replay failed");
+            break;
+        }
+        connection.stop();
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_ReplayConnectionParse)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Parsing and dispatching to the system and its message handlers.
+static void BM_ReplayConnectionDispatch(benchmark::State& state)
+{
+    const std::string path = "replay_connection_benchmark_dispatch.tlog";
+    const auto num_messages = static_cast<unsigned>(state.range(0));
+    write_tlog(path, num_messages);
+    log::set_level(log::Level::Warn);
+
+    MavsdkImpl mavsdk_impl;
+    VirtualTime time;
+    for (auto _ : state) {
+        ReplayConnection connection(
+            [&mavsdk_impl](mavlink_message_t& message) { mavsdk_impl.receive_message(message); },
+            path,
+            0.0,
+            time,
+            nullptr);
+        if (connection.start() != ConnectionResult::Success ||
+            !connection.wait_until_finished(60.0)) {
+            state.SkipWithError("Replay failed");
+            break;
+        }
+        connection.stop();
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_ReplayConnectionDispatch)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,184 @@
+#include "replay_connection.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+mavlink_message_t make_heartbeat(uint8_t sequence)
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        1, 1, &message, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+    message.seq = sequence;
+    return message;
+}
+
+void append_frame(
+    std::vector<uint8_t>& tlog, uint64_t timestamp_us, const mavlink_message_t& message)
+{
+    for (int i = 7; i >= 0; --i) {
+        tlog.push_back(static_cast<uint8_t>(timestamp_us >> (8 * i)));
+    }
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+    tlog.insert(tlog.end(), buffer, buffer + len);
+}
+
+void write_file(const std::string& path, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write(
+        reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+// Some time in the past, 10 messages 100 ms apart.
+constexpr uint64_t START_US = 1500000000000000;
+constexpr uint64_t INTERVAL_US = 100000;
+constexpr unsigned NUM_MESSAGES = 10;
+
+std::vector<uint8_t> make_tlog()
+{
+    std::vector<uint8_t> tlog;
+    for (unsigned i = 0; i < NUM_MESSAGES; ++i) {
+        append_frame(tlog, START_US + i * INTERVAL_US, make_heartbeat(static_cast<uint8_t>(i)));
+    }
+    return tlog;
+}
+
+} // namespace
+
+TEST(ReplayConnection, SplitsFrames)
+{
+    auto tlog = make_tlog();
+    // Garbage in the middle and a truncated frame at the end.
+    tlog.insert(tlog.begin() + static_cast<long>(tlog.size() / 2), {0x01, 0x02, 0x03});
+    tlog.push_back(0x00);
+
+    size_t offset = 0;
+    ReplayConnection::Frame frame;
+    uint64_t num_skipped = 0;
+    unsigned num_frames = 0;
+    while (ReplayConnection::next_frame(tlog, offset, frame, num_skipped)) {
+        EXPECT_EQ(frame.data[0], MAVLINK_STX);
+        ++num_frames;
+    }
+    // The frame with the garbage in its timestamp is lost.
+    EXPECT_GE(num_frames, NUM_MESSAGES - 1);
+    EXPECT_LE(num_frames, NUM_MESSAGES);
+    EXPECT_GT(num_skipped, 0);
+    EXPECT_EQ(offset, tlog.size());
+}
+
+TEST(ReplayConnection, ReplaysAsFastAsPossible)
+{
+    const std::string path = "replay_connection_test.tlog";
+    write_file(path, make_tlog());
+
+    std::mutex mutex;
+    std::vector<uint8_t> sequences;
+    std::vector<dl_system_time_t> times;
+
+    VirtualTime time;
+    std::atomic<unsigned> num_time_advanced{0};
+
+    ReplayConnection connection(
+        [&](mavlink_message_t& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            sequences.push_back(message.seq);
+            times.push_back(time.system_time());
+        },
+        path,
+        0.0,
+        time,
+        [&num_time_advanced]() { ++num_time_advanced; });
+
+    const auto before = std::chrono::steady_clock::now();
+    ASSERT_EQ(connection.start(), ConnectionResult::Success);
+    ASSERT_TRUE(connection.wait_until_finished(5.0));
+    const double duration_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count();
+    connection.stop();
+
+    // Much faster than the recording took.
+    EXPECT_LT(duration_s, 0.5);
+
+    const auto stats = connection.stats();
+    EXPECT_TRUE(stats.finished);
+    EXPECT_EQ(stats.num_messages, NUM_MESSAGES);
+    EXPECT_EQ(stats.num_bad_frames, 0);
+    EXPECT_EQ(stats.num_skipped_bytes, 0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(sequences.size(), NUM_MESSAGES);
+    for (unsigned i = 0; i < NUM_MESSAGES; ++i) {
+        EXPECT_EQ(sequences[i], i);
+        // The time seen while handling a message is the one it was recorded at.
+        EXPECT_EQ(
+            times[i],
+            dl_system_time_t(std::chrono::microseconds(START_US + i * INTERVAL_US)));
+    }
+    EXPECT_EQ(num_time_advanced, NUM_MESSAGES);
+
+    // Once finished, the time is real again.
+    EXPECT_FALSE(time.is_virtual());
+
+    std::remove(path.c_str());
+}
+
+TEST(ReplayConnection, ReplaysAtSpeed)
+{
+    const std::string path = "replay_connection_speed_test.tlog";
+    write_file(path, make_tlog());
+
+    VirtualTime time;
+    ReplayConnection connection([](mavlink_message_t&) {}, path, 5.0, time, nullptr);
+
+    // The recording spans 0.9 s, at 5 times the speed it should take 0.18 s.
+    const auto before = std::chrono::steady_clock::now();
+    ASSERT_EQ(connection.start(), ConnectionResult::Success);
+    ASSERT_TRUE(connection.wait_until_finished(5.0));
+    const double duration_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count();
+    connection.stop();
+
+    EXPECT_GT(duration_s, 0.17);
+    EXPECT_LT(duration_s, 0.5);
+    EXPECT_EQ(connection.stats().num_messages, NUM_MESSAGES);
+
+    std::remove(path.c_str());
+}
+
+TEST(ReplayConnection, CanBeStoppedEarly)
+{
+    const std::string path = "replay_connection_stop_test.tlog";
+    write_file(path, make_tlog());
+
+    VirtualTime time;
+    ReplayConnection connection([](mavlink_message_t&) {}, path, 0.1, time, nullptr);
+
+    ASSERT_EQ(connection.start(), ConnectionResult::Success);
+    EXPECT_FALSE(connection.wait_until_finished(0.05));
+
+    const auto before = std::chrono::steady_clock::now();
+    connection.stop();
+    EXPECT_LT(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count(), 0.5);
+    EXPECT_LT(connection.stats().num_messages, NUM_MESSAGES);
+    EXPECT_FALSE(time.is_virtual());
+
+    std::remove(path.c_str());
+}
+
+TEST(ReplayConnection, FailsForMissingFile)
+{
+    VirtualTime time;
+    ReplayConnection connection(
+        [](mavlink_message_t&) {}, "does_not_exist.tlog", 0.0, time, nullptr);
+    EXPECT_EQ(connection.start(), ConnectionResult::ConnectionError);
+}
@@ -0,0 +1,194 @@
+#include "resume_file.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+namespace mavsdk {
+
+static constexpr auto resume_file_header = "mavsdk-resume 1";
+
+ResumeFile::ResumeFile(const std::string& target_path) : _path(sidecar_path(target_path)) {}
+
+std::string ResumeFile::sidecar_path(const std::string& target_path)
+{
+    return target_path + ".resume";
+}
+
+void ResumeFile::reset(const std::string& identity, uint64_t size_bytes, uint32_t chunk_size)
+{
+    _identity = identity;
+    _size_bytes = size_bytes;
+    _chunk_size = chunk_size;
+    _crc32 = 0;
+    _received.assign(
+        (chunk_size > 0) ? (size_bytes / chunk_size + ((size_bytes % chunk_size) != 0)) : 0,
+        false);
+    _unsaved = true;
+}
+
+bool ResumeFile::load(const std::string& identity, uint64_t size_bytes, uint32_t chunk_size)
+{
+    reset(identity, size_bytes, chunk_size);
+
+    std::ifstream file(_path);
+    if (!file) {
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line) || line != resume_file_header) {
+        LogWarn() << "Ignoring invalid resume file " << _path;
+        return false;
+    }
+
+    std::string read_identity;
+    uint64_t read_size_bytes = 0;
+    uint32_t read_chunk_size = 0;
+    uint32_t read_crc32 = 0;
+    std::string read_received;
+
+    while (std::getline(file, line)) {
+        const auto separator = line.find(' ');
+        if (separator == std::string::npos) {
+            continue;
+        }
+        const auto key = line.substr(0, separator);
+        const auto value = line.substr(separator + 1);
+
+        if (key == "identity") {
+            read_identity = value;
+        } else if (key == "size") {
+            read_size_bytes = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "chunk_size") {
+            read_chunk_size = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (key == "crc32") {
+            read_crc32 = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (key == "received") {
+            read_received = value;
+        }
+    }
+
+    if (read_identity != identity || read_size_bytes != size_bytes ||
+        read_chunk_size != chunk_size) {
+        return false;
+    }
+
+    // Each hex digit holds 4 chunks, lowest bit first.
+    if (read_received.size() != (_received.size() + 3) / 4) {
+        LogWarn() << "Ignoring invalid resume file " << _path;
+        return false;
+    }
+
+    for (std::size_t i = 0; i < _received.size(); ++i) {
+        const char c = read_received[i / 4];
+        unsigned nibble;
+        if (c >= '0' && c <= '9') {
+            nibble = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            nibble = c - 'a' + 10;
+        } else {
+            LogWarn() << "Ignoring invalid resume file " << _path;
+            reset(identity, size_bytes, chunk_size);
+            return false;
+        }
+        _received[i] = (nibble & (1 << (i % 4))) != 0;
+    }
+
+    _crc32 = read_crc32;
+    _unsaved = false;
+    return true;
+}
+
+bool ResumeFile::save()
+{
+    std::string received;
+    received.reserve((_received.size() + 3) / 4);
+    for (std::size_t i = 0; i < _received.size(); i += 4) {
+        unsigned nibble = 0;
+        for (std::size_t j = 0; j < 4 && i + j < _received.size(); ++j) {
+            if (_received[i + j]) {
+                nibble |= (1 << j);
+            }
+        }
+        received.push_back("0123456789abcdef"[nibble]);
+    }
+
+    std::ofstream file(_path, std::ios::out | std::ios::trunc);
+    file << resume_file_header << '\n'
+         << "identity " << _identity << '\n'
+         << "size " << _size_bytes << '\n'
+         << "chunk_size " << _chunk_size << '\n'
+         << "crc32 " << _crc32 << '\n'
+         << "received " << received << '\n';
+    file.close();
+
+    if (file.fail()) {
+        return false;
+    }
+    _unsaved = false;
+    return true;
+}
+
+bool ResumeFile::save_if_due(dl_time_t now)
+{
+    if (!_unsaved || now - _last_save_time < std::chrono::duration<double>(SAVE_INTERVAL_S)) {
+        return true;
+    }
+    _last_save_time = now;
+    return save();
+}
+
+void ResumeFile::remove() const
+{
+    std::remove(_path.c_str());
+}
+
+void ResumeFile::mark_received(std::size_t chunk_index)
+{
+    if (chunk_index < _received.size() && !_received[chunk_index]) {
+        _received[chunk_index] = true;
+        _unsaved = true;
+    }
+}
+
+void ResumeFile::set_crc32(uint32_t crc32)
+{
+    if (crc32 != _crc32) {
+        _crc32 = crc32;
+        _unsaved = true;
+    }
+}
+
+bool ResumeFile::is_received(std::size_t chunk_index) const
+{
+    return chunk_index < _received.size() && _received[chunk_index];
+}
+
+std::size_t ResumeFile::first_missing(std::size_t from_index) const
+{
+    if (from_index >= _received.size()) {
+        return _received.size();
+    }
+    return std::distance(
+        _received.begin(), std::find(_received.begin() + from_index, _received.end(), false));
+}
+
+uint64_t ResumeFile::received_prefix_bytes() const
+{
+    return std::min(uint64_t(first_missing()) * _chunk_size, _size_bytes);
+}
+
+uint64_t ResumeFile::received_end_bytes() const
+{
+    for (std::size_t i = _received.size(); i > 0; --i) {
+        if (_received[i - 1]) {
+            return std::min(uint64_t(i) * _chunk_size, _size_bytes);
+        }
+    }
+    return 0;
+}
+
+} // namespace mavsdk
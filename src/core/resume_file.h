@@ -0,0 +1,75 @@
+#pragma once
+
+#include "global_include.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mavsdk {
+
+// Keeps track of which chunks of a download have already been written to disk,
+// so that an interrupted download can be picked up again later.
+//
+// The state is kept in a small sidecar file next to the (partial) output file.
+// It contains an identity string describing what is being downloaded (e.g. the
+// log id or the remote path), the total size, the chunk size, a bitmap of the
+// chunks received and a CRC32 which the user of this class can use to validate
+// the data already on disk.
+class ResumeFile {
+public:
+    explicit ResumeFile(const std::string& target_path);
+
+    static std::string sidecar_path(const std::string& target_path);
+
+    // Start over with an empty state for the given download.
+    void reset(const std::string& identity, uint64_t size_bytes, uint32_t chunk_size);
+
+    // Load the sidecar from disk, returns false if there is none or if it does
+    // not describe the same download.
+    bool load(const std::string& identity, uint64_t size_bytes, uint32_t chunk_size);
+
+    bool save();
+    void remove() const;
+
+    // Saves only if something changed and the last save by this is at least
+    // SAVE_INTERVAL_S ago. The bitmap grows with the download, so saving it
+    // for every chunk would add up to quadratic I/O. Whatever is left needs
+    // a save() once the download stops.
+    bool save_if_due(dl_time_t now);
+    bool has_unsaved_changes() const { return _unsaved; }
+
+    static constexpr double SAVE_INTERVAL_S = 1.0;
+
+    void mark_received(std::size_t chunk_index);
+    bool is_received(std::size_t chunk_index) const;
+
+    // Returns num_chunks() if there is no chunk missing after from_index.
+    std::size_t first_missing(std::size_t from_index = 0) const;
+    std::size_t num_chunks() const { return _received.size(); }
+    bool is_complete() const { return first_missing() == num_chunks(); }
+
+    // Number of bytes received contiguously from the beginning of the file.
+    uint64_t received_prefix_bytes() const;
+
+    // End of the last chunk received, which is the minimum size the partial
+    // file on disk needs to have.
+    uint64_t received_end_bytes() const;
+
+    void set_crc32(uint32_t crc32);
+    uint32_t crc32() const { return _crc32; }
+
+    uint64_t size_bytes() const { return _size_bytes; }
+    uint32_t chunk_size() const { return _chunk_size; }
+
+private:
+    std::string _path;
+    std::string _identity{};
+    uint64_t _size_bytes{0};
+    uint32_t _chunk_size{0};
+    uint32_t _crc32{0};
+    std::vector<bool> _received{};
+    bool _unsaved{false};
+    dl_time_t _last_save_time{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,135 @@
+#include "resume_file.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+static const std::string target_path = "resume_file_test.bin";
+
+TEST(ResumeFile, EmptyWithoutSidecar)
+{
+    ResumeFile(target_path).remove();
+
+    ResumeFile resume_file(target_path);
+    EXPECT_FALSE(resume_file.load("log 1", 1000, 100));
+    EXPECT_EQ(resume_file.num_chunks(), 10u);
+    EXPECT_EQ(resume_file.first_missing(), 0u);
+    EXPECT_EQ(resume_file.received_prefix_bytes(), 0u);
+    EXPECT_EQ(resume_file.received_end_bytes(), 0u);
+    EXPECT_FALSE(resume_file.is_complete());
+}
+
+TEST(ResumeFile, SaveAndLoad)
+{
+    {
+        ResumeFile resume_file(target_path);
+        resume_file.reset("log 1", 1050, 100);
+        EXPECT_EQ(resume_file.num_chunks(), 11u);
+        resume_file.mark_received(0);
+        resume_file.mark_received(1);
+        resume_file.mark_received(2);
+        resume_file.mark_received(5);
+        resume_file.mark_received(10);
+        resume_file.set_crc32(0xdeadbeef);
+        EXPECT_TRUE(resume_file.save());
+    }
+
+    ResumeFile resume_file(target_path);
+    EXPECT_TRUE(resume_file.load("log 1", 1050, 100));
+    EXPECT_EQ(resume_file.crc32(), 0xdeadbeefu);
+    EXPECT_TRUE(resume_file.is_received(0));
+    EXPECT_TRUE(resume_file.is_received(2));
+    EXPECT_FALSE(resume_file.is_received(3));
+    EXPECT_TRUE(resume_file.is_received(5));
+    EXPECT_TRUE(resume_file.is_received(10));
+    EXPECT_EQ(resume_file.first_missing(), 3u);
+    EXPECT_EQ(resume_file.first_missing(5), 6u);
+    EXPECT_EQ(resume_file.first_missing(10), 11u);
+    EXPECT_EQ(resume_file.received_prefix_bytes(), 300u);
+    EXPECT_EQ(resume_file.received_end_bytes(), 1050u);
+
+    resume_file.remove();
+}
+
+TEST(ResumeFile, DifferentDownloadIsIgnored)
+{
+    {
+        ResumeFile resume_file(target_path);
+        resume_file.reset("log 1", 1000, 100);
+        resume_file.mark_received(0);
+        EXPECT_TRUE(resume_file.save());
+    }
+
+    ResumeFile resume_file(target_path);
+    EXPECT_FALSE(resume_file.load("log 2", 1000, 100));
+    EXPECT_FALSE(resume_file.load("log 1", 2000, 100));
+    EXPECT_FALSE(resume_file.load("log 1", 1000, 200));
+    EXPECT_FALSE(resume_file.is_received(0));
+
+    EXPECT_TRUE(resume_file.load("log 1", 1000, 100));
+    EXPECT_TRUE(resume_file.is_received(0));
+
+    resume_file.remove();
+}
+
+TEST(ResumeFile, Complete)
+{
+    ResumeFile resume_file(target_path);
+    resume_file.reset("ftp /fs/microsd/log.ulg", 250, 100);
+    resume_file.mark_received(0);
+    resume_file.mark_received(1);
+    resume_file.mark_received(2);
+    EXPECT_TRUE(resume_file.is_complete());
+    EXPECT_EQ(resume_file.received_prefix_bytes(), 250u);
+}
+
+TEST(ResumeFile, SavesAtMostOncePerInterval)
+{
+    ResumeFile(target_path).remove();
+
+    const dl_time_t start{};
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(ResumeFile::SAVE_INTERVAL_S));
+
+    ResumeFile resume_file(target_path);
+    resume_file.reset("log 1", 1000, 100);
+    EXPECT_TRUE(resume_file.has_unsaved_changes());
+
+    // The first one is due right away.
+    resume_file.mark_received(0);
+    EXPECT_TRUE(resume_file.save_if_due(start + interval));
+    EXPECT_FALSE(resume_file.has_unsaved_changes());
+
+    resume_file.mark_received(1);
+    resume_file.mark_received(2);
+    EXPECT_TRUE(resume_file.save_if_due(start + interval + interval / 2));
+    EXPECT_TRUE(resume_file.has_unsaved_changes());
+    {
+        ResumeFile loaded(target_path);
+        EXPECT_TRUE(loaded.load("log 1", 1000, 100));
+        EXPECT_EQ(loaded.first_missing(), 1u);
+    }
+
+    EXPECT_TRUE(resume_file.save_if_due(start + 2 * interval));
+    EXPECT_FALSE(resume_file.has_unsaved_changes());
+    {
+        ResumeFile loaded(target_path);
+        EXPECT_TRUE(loaded.load("log 1", 1000, 100));
+        EXPECT_EQ(loaded.first_missing(), 3u);
+    }
+
+    // Nothing changed, nothing to save. What is left is saved on stop.
+    resume_file.mark_received(2);
+    EXPECT_FALSE(resume_file.has_unsaved_changes());
+    resume_file.mark_received(3);
+    EXPECT_TRUE(resume_file.save_if_due(start + 2 * interval + interval / 2));
+    EXPECT_TRUE(resume_file.save());
+    EXPECT_FALSE(resume_file.has_unsaved_changes());
+    {
+        ResumeFile loaded(target_path);
+        EXPECT_TRUE(loaded.load("log 1", 1000, 100));
+        EXPECT_EQ(loaded.first_missing(), 4u);
+    }
+
+    resume_file.remove();
+}
@@ -0,0 +1,46 @@
+#include "safe_queue.h"
+#include <functional>
+#include <thread>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+static void BM_SafeQueueEnqueueDequeue(benchmark::State& state)
+{
+    SafeQueue<int> queue;
+
+    for (auto _ : state) {
+        queue.enqueue(42);
+        benchmark::DoNotOptimize(queue.dequeue());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SafeQueueEnqueueDequeue);
+
+// Handing over callbacks to another thread, as done for user callbacks.
+static void BM_SafeQueueHandOver(benchmark::State& state)
+{
+    SafeQueue<std::function<void()>> queue;
+    unsigned num_called = 0;
+
+    std::thread consumer([&queue]() {
+        while (true) {
+            auto item = queue.dequeue();
+            if (!item.first) {
+                break;
+            }
+            item.second();
+        }
+    });
+
+    for (auto _ : state) {
+        queue.enqueue([&num_called]() { ++num_called; });
+    }
+
+    queue.stop();
+    consumer.join();
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SafeQueueHandOver)->UseRealTime();
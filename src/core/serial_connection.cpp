@@ -249,6 +249,24 @@ ConnectionResult SerialConnection::stop()
 }
 
 bool SerialConnection::send_message(const mavlink_message_t& message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
+
+    return send_buffer(buffer, buffer_len);
+}
+
+bool SerialConnection::send_messages(const std::vector<mavlink_message_t>& messages)
+{
+    std::vector<uint8_t> buffer;
+    for (const auto& message : messages) {
+        append_to_buffer(buffer, message);
+    }
+
+    return buffer.empty() || send_buffer(buffer.data(), buffer.size());
+}
+
+bool SerialConnection::send_buffer(const uint8_t* buffer, size_t buffer_len)
 {
     if (_serial_node.empty()) {
         LogErr() << "Dev Path unknown";
@@ -260,20 +278,17 @@ bool SerialConnection::send_message(const mavlink_message_t& message)
         return false;
     }
 
-    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-    uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
-
     int send_len;
 #if defined(LINUX) || defined(APPLE)
     send_len = static_cast<int>(write(_fd, buffer, buffer_len));
 #else
-    if (!WriteFile(_handle, buffer, buffer_len, LPDWORD(&send_len), NULL)) {
+    if (!WriteFile(_handle, buffer, DWORD(buffer_len), LPDWORD(&send_len), NULL)) {
         LogErr() << "WriteFile failure: " << GET_ERROR();
         return false;
     }
 #endif
 
-    if (send_len != buffer_len) {
+    if (send_len < 0 || static_cast<size_t>(send_len) != buffer_len) {
         LogErr() << "write failure: " << GET_ERROR();
         return false;
     }
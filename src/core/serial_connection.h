@@ -22,6 +22,7 @@ public:
     ~SerialConnection();
 
     bool send_message(const mavlink_message_t& message) override;
+    bool send_messages(const std::vector<mavlink_message_t>& messages) override;
 
     // Non-copyable
     SerialConnection(const SerialConnection&) = delete;
@@ -31,6 +32,7 @@ private:
     ConnectionResult setup_port();
     void start_recv_thread();
     void receive();
+    bool send_buffer(const uint8_t* buffer, size_t buffer_len);
 
 #if defined(LINUX)
     static int define_from_baudrate(int baudrate);
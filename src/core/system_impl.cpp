@@ -5,6 +5,7 @@
 #include "system_impl.h"
 #include "plugin_impl_base.h"
 #include "px4_custom_mode.h"
+#include "trace.h"
 #include <cstdlib>
 #include <functional>
 #include <algorithm>
@@ -25,7 +26,12 @@ SystemImpl::SystemImpl(MavsdkImpl& parent, uint8_t system_id, uint8_t comp_id, b
     _receive_commands(*this),
     _timesync(*this),
     _ping(*this),
-    _mission_transfer(*this, _message_handler, _parent.timeout_handler)
+    _mission_transfer(*this, _message_handler, _parent.timeout_handler),
+    _request_scheduler(
+        _time,
+        [this](
+            const MavlinkCommandSender::CommandLong& command,
+            const CommandResultCallback& callback) { send_command_async(command, callback); })
 {
     _target_address.system_id = system_id;
     // FIXME: for now use this as a default.
@@ -122,6 +128,7 @@ void SystemImpl::subscribe_is_connected(System::IsConnectedCallback callback)
 
 void SystemImpl::process_mavlink_message(mavlink_message_t& message)
 {
+    MAVSDK_TRACE_SCOPE("process_mavlink_message", message.msgid);
     // This is a low level interface where incoming messages can be tampered
     // with or even dropped.
     if (_incoming_messages_intercept_callback) {
@@ -132,6 +139,7 @@ void SystemImpl::process_mavlink_message(mavlink_message_t& message)
         }
     }
 
+    _request_scheduler.process_message(message);
     _message_handler.process_message(message);
 }
 
@@ -155,6 +163,23 @@ void SystemImpl::remove_call_every(const void* cookie)
     _parent.call_every_handler.remove(cookie);
 }
 
+void SystemImpl::add_message_request(
+    const MAVLinkRequestScheduler::Request& request, double interval_s, const void* cookie)
+{
+    _request_scheduler.add(request, interval_s, cookie);
+}
+
+void SystemImpl::remove_message_request(
+    uint16_t message_id, uint8_t component_id, const void* cookie)
+{
+    _request_scheduler.remove(message_id, component_id, cookie);
+}
+
+void SystemImpl::remove_all_message_requests(const void* cookie)
+{
+    _request_scheduler.remove_all(cookie);
+}
+
 void SystemImpl::process_heartbeat(const mavlink_message_t& message)
 {
     mavlink_heartbeat_t heartbeat;
@@ -246,6 +271,7 @@ void SystemImpl::system_thread()
         _send_commands.do_work();
         _timesync.do_work();
         _mission_transfer.do_work();
+        _request_scheduler.do_work();
 
         if (_time.elapsed_since_s(last_ping_time) >= SystemImpl::_ping_interval_s) {
             if (_connected) {
@@ -411,6 +437,35 @@ bool SystemImpl::send_message(mavlink_message_t& message)
     return _parent.send_message(message);
 }
 
+bool SystemImpl::send_messages(std::vector<mavlink_message_t>& messages)
+{
+    if (_outgoing_messages_intercept_callback) {
+        messages.erase(
+            std::remove_if(
+                messages.begin(),
+                messages.end(),
+                [this](mavlink_message_t& message) {
+                    const bool keep = _outgoing_messages_intercept_callback(message);
+                    if (!keep) {
+                        LogDebug() << "Dropped outgoing message: " << int(message.msgid);
+                    }
+                    return !keep;
+                }),
+            messages.end());
+    }
+
+    if (messages.empty()) {
+        return true;
+    }
+
+#if MESSAGE_DEBUGGING == 1
+    for (const auto& message : messages) {
+        LogDebug() << "Sending msg " << size_t(message.msgid);
+    }
+#endif
+    return _parent.send_messages(messages);
+}
+
 void SystemImpl::request_autopilot_version()
 {
     if (_uuid_initialized) {
@@ -1208,6 +1263,11 @@ void SystemImpl::unregister_param_changed_handler(const void* cookie)
     _param_changed_callbacks.erase(it);
 }
 
+HttpLoader& SystemImpl::http_loader()
+{
+    return _parent.http_loader;
+}
+
 void SystemImpl::intercept_incoming_messages(std::function<bool(mavlink_message_t&)> callback)
 {
     _incoming_messages_intercept_callback = callback;
@@ -7,6 +7,7 @@
 #include "mavlink_commands.h"
 #include "mavlink_message_handler.h"
 #include "mavlink_mission_transfer.h"
+#include "mavlink_request_scheduler.h"
 #include "mavlink_statustext_handler.h"
 #include "ping.h"
 #include "timeout_handler.h"
@@ -25,6 +26,7 @@
 
 namespace mavsdk {
 
+class HttpLoader;
 class MavsdkImpl;
 class PluginImplBase;
 
@@ -78,7 +80,15 @@ public:
     void reset_call_every(const void* cookie);
     void remove_call_every(const void* cookie);
 
+    // Requests a message periodically, duplicate requests are merged.
+    void add_message_request(
+        const MAVLinkRequestScheduler::Request& request, double interval_s, const void* cookie);
+    void remove_message_request(uint16_t message_id, uint8_t component_id, const void* cookie);
+    void remove_all_message_requests(const void* cookie);
+
     bool send_message(mavlink_message_t& message) override;
+    // Sends the messages together where the connection allows it.
+    bool send_messages(std::vector<mavlink_message_t>& messages);
 
     static FlightMode to_flight_mode_from_custom_mode(uint32_t custom_mode);
 
@@ -231,6 +241,8 @@ public:
 
     MAVLinkMissionTransfer& mission_transfer() { return _mission_transfer; };
 
+    HttpLoader& http_loader();
+
     void intercept_incoming_messages(std::function<bool(mavlink_message_t&)> callback);
     void intercept_outgoing_messages(std::function<bool(mavlink_message_t&)> callback);
 
@@ -336,6 +348,8 @@ private:
 
     MAVLinkMissionTransfer _mission_transfer;
 
+    MAVLinkRequestScheduler _request_scheduler;
+
     std::mutex _plugin_impls_mutex{};
     std::vector<PluginImplBase*> _plugin_impls{};
 
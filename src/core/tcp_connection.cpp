@@ -8,12 +8,16 @@
 #endif
 #else
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <unistd.h> // for close()
 #endif
 
+#include <algorithm>
 #include <cassert>
 
 #ifndef WINDOWS
@@ -24,6 +28,124 @@
 
 namespace mavsdk {
 
+namespace {
+
+// Waiting for data is interrupted this often to check whether to exit.
+constexpr int POLL_TIMEOUT_MS = 100;
+
+#ifndef WINDOWS
+using pollfd_t = struct pollfd;
+
+int poll_socket(pollfd_t* fds, int timeout_ms)
+{
+    return poll(fds, 1, timeout_ms);
+}
+
+bool would_block()
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+bool interrupted()
+{
+    return errno == EINTR;
+}
+
+bool connect_in_progress()
+{
+    return errno == EINPROGRESS;
+}
+
+bool set_non_blocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+void close_fd(int fd)
+{
+    shutdown(fd, SHUT_RDWR);
+    close(fd);
+}
+
+#if defined(MSG_NOSIGNAL)
+// A broken connection should not kill the process with SIGPIPE.
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+#else
+using pollfd_t = WSAPOLLFD;
+
+int poll_socket(pollfd_t* fds, int timeout_ms)
+{
+    return WSAPoll(fds, 1, timeout_ms);
+}
+
+bool would_block()
+{
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+bool interrupted()
+{
+    return WSAGetLastError() == WSAEINTR;
+}
+
+bool connect_in_progress()
+{
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
+bool set_non_blocking(int fd)
+{
+    u_long mode = 1;
+    return ioctlsocket(fd, FIONBIO, &mode) == 0;
+}
+
+void close_fd(int fd)
+{
+    shutdown(fd, SD_BOTH);
+    closesocket(fd);
+}
+
+constexpr int SEND_FLAGS = 0;
+#endif
+
+void set_option(int fd, int level, int name, int value)
+{
+    setsockopt(fd, level, name, reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void set_socket_options(int fd)
+{
+    // Frames are small and should go out right away rather than be collected.
+    set_option(fd, IPPROTO_TCP, TCP_NODELAY, 1);
+
+    // Notice a dead link even when there is nothing to send.
+    set_option(fd, SOL_SOCKET, SO_KEEPALIVE, 1);
+
+#if defined(TCP_KEEPIDLE) && defined(TCP_KEEPINTVL) && defined(TCP_KEEPCNT)
+    set_option(fd, IPPROTO_TCP, TCP_KEEPIDLE, TcpConnection::DEAD_LINK_TIMEOUT_S - 3);
+    set_option(fd, IPPROTO_TCP, TCP_KEEPINTVL, 1);
+    set_option(fd, IPPROTO_TCP, TCP_KEEPCNT, 3);
+#elif defined(TCP_KEEPALIVE)
+    set_option(fd, IPPROTO_TCP, TCP_KEEPALIVE, TcpConnection::DEAD_LINK_TIMEOUT_S - 3);
+#endif
+
+#if defined(TCP_USER_TIMEOUT)
+    // Give up if sent data is not acknowledged instead of retransmitting for minutes.
+    set_option(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, TcpConnection::DEAD_LINK_TIMEOUT_S * 1000);
+#endif
+
+#if defined(SO_NOSIGPIPE)
+    set_option(fd, SOL_SOCKET, SO_NOSIGPIPE, 1);
+#endif
+}
+
+} // namespace
+
 /* change to remote_ip and remote_port */
 TcpConnection::TcpConnection(
     Connection::receiver_callback_t receiver_callback,
@@ -47,8 +169,18 @@ ConnectionResult TcpConnection::start()
         return ConnectionResult::ConnectionsExhausted;
     }
 
+#ifdef WINDOWS
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        LogErr() << "Error: Winsock failed, error: " << WSAGetLastError();
+        return ConnectionResult::SocketError;
+    }
+#endif
+
     ConnectionResult ret = setup_port();
     if (ret != ConnectionResult::Success) {
+        LogErr() << "TCP connection to " << _remote_ip << ":" << _remote_port_number
+                 << " failed";
         return ret;
     }
 
@@ -59,20 +191,18 @@ ConnectionResult TcpConnection::start()
 
 ConnectionResult TcpConnection::setup_port()
 {
-#ifdef WINDOWS
-    WSADATA wsa;
-    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
-        LogErr() << "Error: Winsock failed, error: %d", WSAGetLastError();
-        _is_ok = false;
+    const int fd = static_cast<int>(socket(AF_INET, SOCK_STREAM, 0));
+
+    if (fd < 0) {
+        LogErr() << "socket error" << GET_ERROR(errno);
         return ConnectionResult::SocketError;
     }
-#endif
 
-    _socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+    set_socket_options(fd);
 
-    if (_socket_fd < 0) {
-        LogErr() << "socket error" << GET_ERROR(errno);
-        _is_ok = false;
+    if (!set_non_blocking(fd)) {
+        LogErr() << "Could not make socket non-blocking: " << GET_ERROR(errno);
+        close_fd(fd);
         return ConnectionResult::SocketError;
     }
 
@@ -81,14 +211,42 @@ ConnectionResult TcpConnection::setup_port()
     remote_addr.sin_port = htons(_remote_port_number);
     remote_addr.sin_addr.s_addr = inet_addr(_remote_ip.c_str());
 
-    if (connect(_socket_fd, reinterpret_cast<sockaddr*>(&remote_addr), sizeof(struct sockaddr_in)) <
-        0) {
-        LogErr() << "connect error: " << GET_ERROR(errno);
-        _is_ok = false;
-        return ConnectionResult::SocketConnectionError;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&remote_addr), sizeof(struct sockaddr_in)) < 0) {
+        if (!connect_in_progress()) {
+            LogDebug() << "connect error: " << GET_ERROR(errno);
+            close_fd(fd);
+            return ConnectionResult::SocketConnectionError;
+        }
+
+        // Wait in slices, so that stopping is not held up.
+        pollfd_t pfd{};
+        pfd.fd = fd;
+        pfd.events = POLLOUT;
+        int waited_ms = 0;
+        int ret = 0;
+        while (ret == 0 && waited_ms < CONNECT_TIMEOUT_MS && !_should_exit) {
+            ret = poll_socket(&pfd, POLL_TIMEOUT_MS);
+            waited_ms += POLL_TIMEOUT_MS;
+        }
+
+        int error = 0;
+        socklen_t error_len = sizeof(error);
+        if (ret <= 0 ||
+            getsockopt(
+                fd, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &error_len) != 0 ||
+            error != 0) {
+            LogDebug() << "connect error: " << (ret <= 0 ? "timeout" : GET_ERROR(error));
+            close_fd(fd);
+            return ConnectionResult::SocketConnectionError;
+        }
     }
 
+    std::lock_guard<std::mutex> lock(_mutex);
+    _socket_fd = fd;
     _is_ok = true;
+    // Whatever was queued while disconnected.
+    flush();
+
     return ConnectionResult::Success;
 }
 
@@ -101,26 +259,18 @@ ConnectionResult TcpConnection::stop()
 {
     _should_exit = true;
 
-#ifndef WINDOWS
-    // This should interrupt a recv/recvfrom call.
-    shutdown(_socket_fd, SHUT_RDWR);
-
-    // But on Mac, closing is also needed to stop blocking recv/recvfrom.
-    close(_socket_fd);
-#else
-    shutdown(_socket_fd, SD_BOTH);
-
-    closesocket(_socket_fd);
-
-    WSACleanup();
-#endif
-
     if (_recv_thread) {
         _recv_thread->join();
         delete _recv_thread;
         _recv_thread = nullptr;
     }
 
+    close_socket();
+
+#ifdef WINDOWS
+    WSACleanup();
+#endif
+
     // We need to stop this after stopping the receive thread, otherwise
     // it can happen that we interfere with the parsing of a message.
     stop_mavlink_receiver();
@@ -128,75 +278,132 @@ ConnectionResult TcpConnection::stop()
     return ConnectionResult::Success;
 }
 
-bool TcpConnection::send_message(const mavlink_message_t& message)
+void TcpConnection::close_socket()
 {
-    if (_remote_ip.empty()) {
-        LogErr() << "Remote IP unknown";
-        return false;
-    }
+    std::lock_guard<std::mutex> lock(_mutex);
 
-    if (_remote_port_number == 0) {
-        LogErr() << "Remote port unknown";
-        return false;
+    if (_socket_fd >= 0) {
+        close_fd(_socket_fd);
+        _socket_fd = -1;
     }
+    _is_ok = false;
+
+    // The next connection has to start with a whole frame.
+    _send_buffer.drop_partial_frame();
+}
 
-    struct sockaddr_in dest_addr {};
-    dest_addr.sin_family = AF_INET;
+bool TcpConnection::send_message(const mavlink_message_t& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
 
-    inet_pton(AF_INET, _remote_ip.c_str(), &dest_addr.sin_addr.s_addr);
+    const bool queued = queue_frame(message);
+    flush();
+    return queued;
+}
 
-    dest_addr.sin_port = htons(_remote_port_number);
+bool TcpConnection::send_messages(const std::vector<mavlink_message_t>& messages)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
 
+    bool queued = true;
+    for (const auto& message : messages) {
+        queued = queue_frame(message) && queued;
+    }
+    flush();
+    return queued;
+}
+
+bool TcpConnection::queue_frame(const mavlink_message_t& message)
+{
     uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
     uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
 
     // TODO: remove this assert again
     assert(buffer_len <= MAVLINK_MAX_PACKET_LEN);
 
-    const auto send_len = sendto(
-        _socket_fd,
-        reinterpret_cast<char*>(buffer),
-        buffer_len,
-        0,
-        reinterpret_cast<const sockaddr*>(&dest_addr),
-        sizeof(dest_addr));
-
-    if (send_len != buffer_len) {
-        LogErr() << "sendto failure: " << GET_ERROR(errno);
-        _is_ok = false;
+    if (!_send_buffer.push(buffer, buffer_len)) {
+        if (!_dropping) {
+            LogWarn() << "TCP send buffer full, dropping messages";
+            _dropping = true;
+        }
         return false;
     }
+
+    _dropping = false;
     return true;
 }
 
-void TcpConnection::receive()
+bool TcpConnection::flush()
 {
-    // Enough for MTU 1500 bytes.
-    char buffer[2048];
+    if (!_is_ok || _socket_fd < 0) {
+        // Sent once reconnected.
+        return false;
+    }
 
-    while (!_should_exit) {
-        if (!_is_ok) {
-            LogErr() << "TCP receive error, trying to reconnect...";
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-            setup_port();
+    while (!_send_buffer.empty()) {
+        const auto front = _send_buffer.front();
+        const auto send_len =
+            send(_socket_fd, reinterpret_cast<const char*>(front.first), front.second, SEND_FLAGS);
+
+        if (send_len > 0) {
+            _send_buffer.consume(static_cast<size_t>(send_len));
+        } else if (send_len < 0 && interrupted()) {
+            continue;
+        } else if (send_len < 0 && would_block()) {
+            // The rest is sent by the receive thread once the socket is writable.
+            break;
+        } else {
+            LogErr() << "send failure: " << GET_ERROR(errno);
+            _is_ok = false;
+            return false;
         }
+    }
+    return true;
+}
 
+void TcpConnection::reconnect()
+{
+    if (_reconnect_delay_ms == RECONNECT_DELAY_MIN_MS) {
+        LogWarn() << "TCP connection lost, trying to reconnect...";
+    }
+
+    close_socket();
+
+    for (int waited_ms = 0; waited_ms < _reconnect_delay_ms && !_should_exit;
+         waited_ms += RECONNECT_DELAY_MIN_MS) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(RECONNECT_DELAY_MIN_MS));
+    }
+
+    if (_should_exit) {
+        return;
+    }
+
+    if (setup_port() == ConnectionResult::Success) {
+        LogInfo() << "TCP connection re-established";
+        _reconnect_delay_ms = RECONNECT_DELAY_MIN_MS;
+    } else {
+        _reconnect_delay_ms = std::min(2 * _reconnect_delay_ms, RECONNECT_DELAY_MAX_MS);
+    }
+}
+
+bool TcpConnection::receive_available()
+{
+    // Enough for MTU 1500 bytes.
+    char buffer[2048];
+
+    while (true) {
         const auto recv_len = recv(_socket_fd, buffer, sizeof(buffer), 0);
 
         if (recv_len == 0) {
-            // This can happen when shutdown is called on the socket,
-            // therefore we check _should_exit again.
-            _is_ok = false;
-            continue;
+            // The other side has closed the connection.
+            return false;
         }
 
         if (recv_len < 0) {
-            // This happens on desctruction when close(_socket_fd) is called,
-            // therefore be quiet.
-            // LogErr() << "recvfrom error: " << GET_ERROR(errno);
-            // Something went wrong, we should try to re-connect in next iteration.
-            _is_ok = false;
-            continue;
+            if (interrupted()) {
+                continue;
+            }
+            return would_block();
         }
 
         _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
@@ -208,4 +415,44 @@ void TcpConnection::receive()
     }
 }
 
+void TcpConnection::receive()
+{
+    while (!_should_exit) {
+        if (!_is_ok) {
+            reconnect();
+            continue;
+        }
+
+        // Only this thread replaces the socket, so it can be used without lock here.
+        pollfd_t pfd{};
+        pfd.fd = _socket_fd;
+        pfd.events = POLLIN;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_send_buffer.empty()) {
+                pfd.events |= POLLOUT;
+            }
+        }
+
+        const int ret = poll_socket(&pfd, POLL_TIMEOUT_MS);
+        if (ret < 0 && !interrupted()) {
+            _is_ok = false;
+            continue;
+        }
+        if (ret <= 0) {
+            continue;
+        }
+
+        if ((pfd.revents & (POLLIN | POLLHUP | POLLERR)) != 0 && !receive_available()) {
+            _is_ok = false;
+            continue;
+        }
+
+        if ((pfd.revents & POLLOUT) != 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            flush();
+        }
+    }
+}
+
 } // namespace mavsdk
@@ -3,6 +3,7 @@
 #include <mutex>
 #include <atomic>
 #include "connection.h"
+#include "frame_ring_buffer.h"
 #include <sys/types.h>
 #ifndef WINDOWS
 #include <netdb.h>
@@ -15,6 +16,12 @@
 
 namespace mavsdk {
 
+// The socket is non-blocking, one thread receives, reconnects and sends
+// what could not be sent right away.
+//
+// Frames to send are queued up to SEND_BUFFER_SIZE, also while the
+// connection is down, so that they go out once it is back. Reconnecting
+// starts after a few ms and backs off exponentially.
 class TcpConnection : public Connection {
 public:
     explicit TcpConnection(
@@ -26,6 +33,15 @@ public:
     ConnectionResult stop() override;
 
     bool send_message(const mavlink_message_t& message) override;
+    bool send_messages(const std::vector<mavlink_message_t>& messages) override;
+
+    static constexpr size_t SEND_BUFFER_SIZE = 64 * 1024;
+    static constexpr int RECONNECT_DELAY_MIN_MS = 10;
+    static constexpr int RECONNECT_DELAY_MAX_MS = 2000;
+    static constexpr int CONNECT_TIMEOUT_MS = 2000;
+    // A link is considered dead if sent data is not acknowledged, or
+    // keepalive probes are not answered, within about this time.
+    static constexpr int DEAD_LINK_TIMEOUT_S = 5;
 
     // Non-copyable
     TcpConnection(const TcpConnection&) = delete;
@@ -34,14 +50,25 @@ public:
 private:
     ConnectionResult setup_port();
     void start_recv_thread();
-    int resolve_address(const std::string& ip_address, int port, struct sockaddr_in* addr);
     void receive();
+    bool receive_available();
+    void reconnect();
+    void close_socket();
+
+    bool queue_frame(const mavlink_message_t& message);
+    // Assumes to have the lock for _mutex.
+    bool flush();
 
     std::string _remote_ip = {};
     int _remote_port_number;
 
+    // Protects the socket and the send buffer.
     std::mutex _mutex = {};
     int _socket_fd = -1;
+    FrameRingBuffer _send_buffer{SEND_BUFFER_SIZE};
+    bool _dropping = false;
+
+    int _reconnect_delay_ms = RECONNECT_DELAY_MIN_MS;
 
     std::thread* _recv_thread = nullptr;
     std::atomic_bool _should_exit;
@@ -0,0 +1,192 @@
+#include "tcp_connection.h"
+#include <gtest/gtest.h>
+
+#if !defined(WINDOWS)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+mavlink_message_t make_heartbeat(uint8_t sequence)
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        1, 1, &message, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+    message.seq = sequence;
+    return message;
+}
+
+std::vector<uint8_t> to_bytes(const mavlink_message_t& message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+    return std::vector<uint8_t>(buffer, buffer + len);
+}
+
+// A server on localhost which accepts one client at a time.
+class Server {
+public:
+    explicit Server(int port_ = 0)
+    {
+        _listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(_listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        struct sockaddr_in addr {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<uint16_t>(port_));
+        bind(_listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(_listen_fd, 1);
+
+        socklen_t len = sizeof(addr);
+        getsockname(_listen_fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+    }
+
+    ~Server()
+    {
+        drop_client();
+        close(_listen_fd);
+    }
+
+    void accept_client() { _client_fd = accept(_listen_fd, nullptr, nullptr); }
+
+    void drop_client()
+    {
+        if (_client_fd >= 0) {
+            shutdown(_client_fd, SHUT_RDWR);
+            close(_client_fd);
+            _client_fd = -1;
+        }
+    }
+
+    std::vector<uint8_t> read(size_t len)
+    {
+        std::vector<uint8_t> data(len);
+        size_t received = 0;
+        while (received < len) {
+            const auto ret = recv(_client_fd, data.data() + received, len - received, 0);
+            if (ret <= 0) {
+                break;
+            }
+            received += static_cast<size_t>(ret);
+        }
+        data.resize(received);
+        return data;
+    }
+
+    void write(const std::vector<uint8_t>& data)
+    {
+        send(_client_fd, data.data(), data.size(), MSG_NOSIGNAL);
+    }
+
+    int port{0};
+
+private:
+    int _listen_fd{-1};
+    int _client_fd{-1};
+};
+
+} // namespace
+
+TEST(TcpConnection, SendsAndReceives)
+{
+    Server server;
+
+    std::atomic<unsigned> num_received{0};
+    TcpConnection connection(
+        [&num_received](mavlink_message_t&) { ++num_received; }, "127.0.0.1", server.port);
+    ASSERT_EQ(connection.start(), ConnectionResult::Success);
+    server.accept_client();
+
+    const auto heartbeat = make_heartbeat(0);
+    EXPECT_TRUE(connection.send_message(heartbeat));
+    EXPECT_EQ(server.read(to_bytes(heartbeat).size()), to_bytes(heartbeat));
+
+    server.write(to_bytes(make_heartbeat(1)));
+    for (unsigned i = 0; i < 100 && num_received == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(num_received, 1u);
+
+    connection.stop();
+}
+
+TEST(TcpConnection, StartFailsWithoutServer)
+{
+    int port;
+    {
+        // Nothing is listening on it anymore.
+        Server server;
+        port = server.port;
+    }
+
+    TcpConnection connection([](mavlink_message_t&) {}, "127.0.0.1", port);
+    EXPECT_EQ(connection.start(), ConnectionResult::SocketConnectionError);
+}
+
+TEST(TcpConnection, SendsQueuedFramesAfterReconnect)
+{
+    auto server = std::make_unique<Server>();
+    const int port = server->port;
+
+    TcpConnection connection([](mavlink_message_t&) {}, "127.0.0.1", port);
+    ASSERT_EQ(connection.start(), ConnectionResult::Success);
+    server->accept_client();
+
+    // Gone completely, so reconnecting fails for now.
+    server.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::vector<uint8_t> expected;
+    for (uint8_t i = 0; i < 10; ++i) {
+        const auto heartbeat = make_heartbeat(i);
+        EXPECT_TRUE(connection.send_message(heartbeat));
+        const auto bytes = to_bytes(heartbeat);
+        expected.insert(expected.end(), bytes.begin(), bytes.end());
+    }
+
+    server = std::make_unique<Server>(port);
+    const auto before = std::chrono::steady_clock::now();
+    server->accept_client();
+    // The backoff has not grown much yet.
+    EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::seconds(1));
+
+    EXPECT_EQ(server->read(expected.size()), expected);
+
+    connection.stop();
+}
+
+TEST(TcpConnection, DropsFramesBeyondBudget)
+{
+    auto server = std::make_unique<Server>();
+
+    TcpConnection connection([](mavlink_message_t&) {}, "127.0.0.1", server->port);
+    ASSERT_EQ(connection.start(), ConnectionResult::Success);
+    server->accept_client();
+    server.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const auto heartbeat = make_heartbeat(0);
+    const size_t frames_fitting = TcpConnection::SEND_BUFFER_SIZE / to_bytes(heartbeat).size();
+
+    size_t num_queued = 0;
+    for (size_t i = 0; i < frames_fitting + 10; ++i) {
+        num_queued += connection.send_message(heartbeat) ? 1 : 0;
+    }
+    EXPECT_EQ(num_queued, frames_fitting);
+
+    connection.stop();
+}
+
+#endif
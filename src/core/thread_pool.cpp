@@ -0,0 +1,46 @@
+#include "thread_pool.h"
+
+namespace mavsdk {
+
+ThreadPool::ThreadPool(unsigned num_threads) : _num_threads(num_threads > 0 ? num_threads : 1)
+{
+    _threads.reserve(_num_threads);
+    for (unsigned i = 0; i < _num_threads; ++i) {
+        _threads.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+void ThreadPool::post(const std::function<void()>& task)
+{
+    _tasks.enqueue(task);
+}
+
+void ThreadPool::stop()
+{
+    _tasks.stop();
+    for (auto& thread : _threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void ThreadPool::run()
+{
+    while (true) {
+        auto task = _tasks.dequeue();
+        if (!task.first) {
+            break;
+        }
+        if (task.second) {
+            task.second();
+        }
+    }
+}
+
+} // namespace mavsdk
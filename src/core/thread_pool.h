@@ -0,0 +1,43 @@
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "safe_queue.h"
+
+namespace mavsdk {
+
+// Runs tasks on a fixed number of threads.
+//
+// It is meant as the executor to continue on once an asynchronous call is
+// done (see AsyncResult), so that many pending calls don't each need a
+// thread of their own, and their continuations don't hold up each other or
+// the user callback thread.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned num_threads);
+    ~ThreadPool();
+
+    void post(const std::function<void()>& task);
+
+    // Waits for the tasks which are running, tasks not started yet are
+    // dropped. Tasks posted afterwards are not run anymore. Not to be called
+    // from one of the tasks.
+    void stop();
+
+    unsigned num_threads() const { return _num_threads; }
+
+    // Non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    const ThreadPool& operator=(const ThreadPool&) = delete;
+
+private:
+    void run();
+
+    const unsigned _num_threads;
+    SafeQueue<std::function<void()>> _tasks{};
+    std::vector<std::thread> _threads{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,66 @@
+#include "thread_pool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace mavsdk;
+
+TEST(ThreadPool, RunsTasks)
+{
+    ThreadPool thread_pool(4);
+    EXPECT_EQ(thread_pool.num_threads(), 4u);
+
+    std::atomic<int> num_done{0};
+    for (int i = 0; i < 1000; ++i) {
+        thread_pool.post([&num_done]() { ++num_done; });
+    }
+
+    for (int i = 0; i < 100 && num_done < 1000; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(num_done, 1000);
+}
+
+TEST(ThreadPool, RunsTasksConcurrently)
+{
+    ThreadPool thread_pool(2);
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::atomic<int> num_waiting{0};
+
+    // Each task waits until the other one has started.
+    for (int i = 0; i < 2; ++i) {
+        thread_pool.post([&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                thread_ids.insert(std::this_thread::get_id());
+            }
+            ++num_waiting;
+            for (int j = 0; j < 100 && num_waiting < 2; ++j) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        });
+    }
+
+    for (int i = 0; i < 100 && num_waiting < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    thread_pool.stop();
+    EXPECT_EQ(num_waiting, 2);
+    EXPECT_EQ(thread_ids.size(), 2u);
+}
+
+TEST(ThreadPool, DoesNotRunAfterStop)
+{
+    ThreadPool thread_pool(1);
+    thread_pool.stop();
+
+    std::atomic<bool> ran{false};
+    thread_pool.post([&ran]() { ran = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(ran);
+}
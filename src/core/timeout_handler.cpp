@@ -1,4 +1,5 @@
 #include "timeout_handler.h"
+#include "log.h"
 
 namespace mavsdk {
 
@@ -8,20 +9,19 @@ TimeoutHandler::~TimeoutHandler() {}
 
 void TimeoutHandler::add(std::function<void()> callback, double duration_s, void** cookie)
 {
-    auto new_timeout = std::make_shared<Timeout>();
-    new_timeout->callback = callback;
-    new_timeout->time = _time.steady_time_in_future(duration_s);
-    new_timeout->duration_s = duration_s;
-
-    void* new_cookie = static_cast<void*>(new_timeout.get());
-
+    TimerWheel<Timeout>::Handle handle;
     {
         std::lock_guard<std::mutex> lock(_timeouts_mutex);
-        _timeouts.insert(std::pair<void*, std::shared_ptr<Timeout>>(new_cookie, new_timeout));
+        handle = _timeouts.add(
+            Timeout{std::move(callback), duration_s}, _time.steady_time_in_future(duration_s));
+    }
+
+    if (handle == TimerWheel<Timeout>::INVALID_HANDLE) {
+        LogErr() << "Too many timeouts";
     }
 
     if (cookie != nullptr) {
-        *cookie = new_cookie;
+        *cookie = reinterpret_cast<void*>(handle);
     }
 }
 
@@ -29,10 +29,10 @@ void TimeoutHandler::refresh(const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_timeouts_mutex);
 
-    auto it = _timeouts.find(const_cast<void*>(cookie));
-    if (it != _timeouts.end()) {
-        dl_time_t future_time = _time.steady_time_in_future(it->second->duration_s);
-        it->second->time = future_time;
+    const auto handle = reinterpret_cast<TimerWheel<Timeout>::Handle>(cookie);
+    const Timeout* timeout = _timeouts.get(handle);
+    if (timeout != nullptr) {
+        _timeouts.reschedule(handle, _time.steady_time_in_future(timeout->duration_s));
     }
 }
 
@@ -40,46 +40,34 @@ void TimeoutHandler::remove(const void* cookie)
 {
     std::lock_guard<std::mutex> lock(_timeouts_mutex);
 
-    auto it = _timeouts.find(const_cast<void*>(cookie));
-    if (it != _timeouts.end()) {
-        _timeouts.erase(const_cast<void*>(cookie));
-        _iterator_invalidated = true;
-    }
+    _timeouts.remove(reinterpret_cast<TimerWheel<Timeout>::Handle>(cookie));
 }
 
 void TimeoutHandler::run_once()
 {
-    _timeouts_mutex.lock();
-
-    dl_time_t now = _time.steady_time();
+    std::vector<TimerWheel<Timeout>::Handle> expired;
 
-    for (auto it = _timeouts.begin(); it != _timeouts.end(); /* no ++it */) {
-        // If time is passed, call timeout callback.
-        if (it->second->time < now) {
-            if (it->second->callback) {
-                // Get a copy for the callback because we will remove it.
-                std::function<void()> callback = it->second->callback;
+    std::unique_lock<std::mutex> lock(_timeouts_mutex);
 
-                // Self-destruct before calling to avoid locking issues.
-                _timeouts.erase(it++);
+    _timeouts.collect_expired(_time.steady_time(), expired);
 
-                // Unlock while we callback because it might in turn want to add timeouts.
-                _timeouts_mutex.unlock();
-                callback();
-                _timeouts_mutex.lock();
-            }
-
-        } else {
-            ++it;
+    for (const auto handle : expired) {
+        // An earlier callback might have removed or refreshed it.
+        if (!_timeouts.is_expired(handle)) {
+            continue;
         }
 
-        // We start over if anyone has messed with this while we called the callback.
-        if (_iterator_invalidated) {
-            _iterator_invalidated = false;
-            it = _timeouts.begin();
+        // Self-destruct before calling to avoid locking issues.
+        std::function<void()> callback = std::move(_timeouts.get(handle)->callback);
+        _timeouts.remove(handle);
+
+        if (callback) {
+            // Unlock while we callback because it might in turn want to add timeouts.
+            lock.unlock();
+            callback();
+            lock.lock();
         }
     }
-    _timeouts_mutex.unlock();
 }
 
 } // namespace mavsdk
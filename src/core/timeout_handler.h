@@ -1,10 +1,9 @@
 #pragma once
 
 #include <mutex>
-#include <memory>
 #include <functional>
-#include <unordered_map>
 #include "global_include.h"
+#include "timer_wheel.h"
 
 namespace mavsdk {
 
@@ -19,6 +18,8 @@ public:
     TimeoutHandler& operator=(TimeoutHandler const&) = delete; // Copy assign
     TimeoutHandler& operator=(TimeoutHandler&&) = delete; // Move assign
 
+    // The cookie is a handle of the timer wheel, it stays invalid once the
+    // timeout has happened or has been removed.
     void add(std::function<void()> callback, double duration_s, void** cookie);
     void refresh(const void* cookie);
     void remove(const void* cookie);
@@ -28,15 +29,15 @@ public:
 private:
     struct Timeout {
         std::function<void()> callback{};
-        dl_time_t time{};
         double duration_s{0.0};
     };
 
-    std::unordered_map<void*, std::shared_ptr<Timeout>> _timeouts{};
-    std::mutex _timeouts_mutex{};
-    bool _iterator_invalidated{false};
-
     Time& _time;
+
+    // Started lazily, the time might not be usable yet while we are
+    // constructed.
+    TimerWheel<Timeout> _timeouts{};
+    std::mutex _timeouts_mutex{};
 };
 
 } // namespace mavsdk
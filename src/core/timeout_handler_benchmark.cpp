@@ -0,0 +1,44 @@
+#include "timeout_handler.h"
+#include <vector>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// Checking for timeouts while none is due, as happens on every loop of the
+// work thread.
+static void BM_TimeoutHandlerRunOnce(benchmark::State& state)
+{
+    Time time;
+    TimeoutHandler handler(time);
+
+    std::vector<void*> cookies(static_cast<size_t>(state.range(0)));
+    for (auto& cookie : cookies) {
+        handler.add([]() {}, 100.0, &cookie);
+    }
+
+    for (auto _ : state) {
+        handler.run_once();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TimeoutHandlerRunOnce)->Arg(1)->Arg(10)->Arg(100)->Arg(10000);
+
+// Refreshing a timeout, as done for every received heartbeat.
+static void BM_TimeoutHandlerRefresh(benchmark::State& state)
+{
+    Time time;
+    TimeoutHandler handler(time);
+
+    std::vector<void*> cookies(100);
+    for (auto& cookie : cookies) {
+        handler.add([]() {}, 100.0, &cookie);
+    }
+
+    for (auto _ : state) {
+        handler.refresh(cookies[50]);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimeoutHandlerRefresh);
@@ -169,3 +169,32 @@ TEST(TimeoutHandler, NextTimeoutRemovedDuringCallback)
     time.sleep_for(std::chrono::milliseconds(1000));
     th.run_once();
 }
+
+namespace {
+
+class CountingTime : public Time {
+public:
+    dl_time_t steady_time() override
+    {
+        ++num_calls;
+        return Time::steady_time();
+    }
+
+    unsigned num_calls{0};
+};
+
+} // namespace
+
+TEST(TimeoutHandler, DoesNotReadTimeWhenConstructed)
+{
+    // The owner might pass a time which is not constructed yet.
+    CountingTime time;
+    TimeoutHandler th(time);
+    EXPECT_EQ(time.num_calls, 0u);
+
+    bool timeout_happened = false;
+    th.add([&timeout_happened]() { timeout_happened = true; }, 0.01, nullptr);
+    time.sleep_for(std::chrono::milliseconds(20));
+    th.run_once();
+    EXPECT_TRUE(timeout_happened);
+}
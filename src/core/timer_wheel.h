@@ -0,0 +1,299 @@
+#pragma once
+
+#include "global_include.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace mavsdk {
+
+// A hierarchical timer wheel: adding, rescheduling and removing a timer
+// is O(1), and advancing only touches the timers which are due, or which
+// move one level closer to being due.
+//
+// There are 4 levels of 64 slots each. A tick is 1 ms, so level 0 covers
+// the next 64 ms, level 3 about 4.6 hours. Timers further out wait in the
+// last level and are placed again once they come into range.
+//
+// Timers are kept in a pool and identified by handles which carry a
+// generation, so a handle of a removed timer never matches a new one.
+// The handle is never 0 and fits into a pointer.
+//
+// Not thread-safe, the owner has to lock.
+template<typename T> class TimerWheel {
+public:
+    using Handle = uintptr_t;
+    static constexpr Handle INVALID_HANDLE = 0;
+
+    // Ticks are counted from start.
+    explicit TimerWheel(dl_time_t start) : _start(start), _started(true), _heads(DUE + 1, NONE)
+    {}
+
+    // Ticks are counted from the first time given to it, so that no clock
+    // needs to be read on construction.
+    TimerWheel() : _heads(DUE + 1, NONE) {}
+
+    ~TimerWheel() = default;
+
+    // A timer is expired once the time is past the deadline.
+    // Returns INVALID_HANDLE if there are too many timers.
+    Handle add(T&& payload, dl_time_t deadline)
+    {
+        uint32_t index;
+        if (_free_head != NONE) {
+            index = _free_head;
+            _free_head = _nodes[index].next;
+        } else {
+            if (_nodes.size() >= MAX_NODES) {
+                return INVALID_HANDLE;
+            }
+            index = static_cast<uint32_t>(_nodes.size());
+            _nodes.emplace_back();
+        }
+
+        start_at(deadline);
+        Node& node = _nodes[index];
+        node.payload = std::move(payload);
+        node.deadline = deadline;
+        node.expiry_tick = tick_of(deadline);
+        insert(index);
+        ++_size;
+
+        return (static_cast<Handle>(node.generation) << INDEX_BITS) | (index + 1);
+    }
+
+    // Returns nullptr if the timer has been removed.
+    T* get(Handle handle)
+    {
+        const uint32_t index = index_of(handle);
+        return index != NONE ? &_nodes[index].payload : nullptr;
+    }
+
+    bool reschedule(Handle handle, dl_time_t deadline)
+    {
+        const uint32_t index = index_of(handle);
+        if (index == NONE) {
+            return false;
+        }
+
+        start_at(deadline);
+        unlink(index);
+        _nodes[index].deadline = deadline;
+        _nodes[index].expiry_tick = tick_of(deadline);
+        insert(index);
+        return true;
+    }
+
+    bool remove(Handle handle)
+    {
+        const uint32_t index = index_of(handle);
+        if (index == NONE) {
+            return false;
+        }
+
+        unlink(index);
+        Node& node = _nodes[index];
+        // Releases whatever the payload holds on to.
+        node.payload = T{};
+        node.generation = (node.generation + 1) & GENERATION_MASK;
+        node.list = FREE;
+        node.next = _free_head;
+        _free_head = index;
+        --_size;
+        return true;
+    }
+
+    // Appends the timers which are expired at now to expired. They stay
+    // until they are removed, but won't expire again unless rescheduled.
+    void collect_expired(dl_time_t now, std::vector<Handle>& expired)
+    {
+        start_at(now);
+        advance(tick_of(now));
+
+        uint32_t index = _heads[DUE];
+        while (index != NONE) {
+            const uint32_t next = _nodes[index].next;
+            if (now > _nodes[index].deadline) {
+                unlink(index);
+                _nodes[index].list = EXPIRED;
+                expired.push_back(
+                    (static_cast<Handle>(_nodes[index].generation) << INDEX_BITS) | (index + 1));
+            }
+            index = next;
+        }
+    }
+
+    // Whether the timer was collected as expired and has not been
+    // rescheduled since.
+    bool is_expired(Handle handle) const
+    {
+        const uint32_t index = index_of(handle);
+        return index != NONE && _nodes[index].list == EXPIRED;
+    }
+
+    size_t size() const { return _size; }
+
+    // Non-copyable
+    TimerWheel(const TimerWheel&) = delete;
+    const TimerWheel& operator=(const TimerWheel&) = delete;
+
+private:
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr int64_t MAX_TICKS_AHEAD = int64_t(1) << (LEVELS * SLOT_BITS);
+
+    // Lists 0 to LEVELS * SLOTS - 1 are the slots, then the list of timers
+    // which are due within the current tick.
+    static constexpr uint16_t DUE = LEVELS * SLOTS;
+    static constexpr uint16_t EXPIRED = DUE + 1;
+    static constexpr uint16_t FREE = DUE + 2;
+
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    // Half of the handle is the index, the other half the generation.
+    static constexpr unsigned INDEX_BITS = sizeof(Handle) * 4;
+    static constexpr Handle GENERATION_MASK = (Handle(1) << (sizeof(Handle) * 8 - INDEX_BITS)) - 1;
+    static constexpr size_t MAX_NODES =
+        static_cast<size_t>(std::min<uint64_t>((uint64_t(1) << INDEX_BITS) - 1, NONE - 1));
+
+    struct Node {
+        T payload{};
+        dl_time_t deadline{};
+        int64_t expiry_tick{0};
+        Handle generation{0};
+        uint32_t prev{NONE};
+        uint32_t next{NONE};
+        uint16_t list{FREE};
+    };
+
+    void start_at(dl_time_t time)
+    {
+        if (!_started) {
+            _start = time;
+            _started = true;
+        }
+    }
+
+    int64_t tick_of(dl_time_t time) const
+    {
+        return std::chrono::floor<std::chrono::milliseconds>(time - _start).count();
+    }
+
+    uint32_t index_of(Handle handle) const
+    {
+        const Handle index_plus_one = handle & ((Handle(1) << INDEX_BITS) - 1);
+        if (index_plus_one == 0 || index_plus_one > _nodes.size()) {
+            return NONE;
+        }
+        const auto index = static_cast<uint32_t>(index_plus_one - 1);
+        const Node& node = _nodes[index];
+        if (node.list == FREE || node.generation != (handle >> INDEX_BITS)) {
+            return NONE;
+        }
+        return index;
+    }
+
+    void insert(uint32_t index)
+    {
+        Node& node = _nodes[index];
+
+        uint16_t list = DUE;
+        if (node.expiry_tick > _current_tick) {
+            // Too far out, it is placed again once the last level gets to it.
+            const int64_t tick = std::min(node.expiry_tick, _current_tick + MAX_TICKS_AHEAD - 1);
+            const int64_t ticks_ahead = tick - _current_tick;
+
+            unsigned level = 0;
+            while (ticks_ahead >= (int64_t(1) << ((level + 1) * SLOT_BITS))) {
+                ++level;
+            }
+            const auto slot = static_cast<unsigned>((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+            list = static_cast<uint16_t>(level * SLOTS + slot);
+            ++_num_in_slots;
+        }
+
+        node.list = list;
+        node.prev = NONE;
+        node.next = _heads[list];
+        if (node.next != NONE) {
+            _nodes[node.next].prev = index;
+        }
+        _heads[list] = index;
+    }
+
+    void unlink(uint32_t index)
+    {
+        Node& node = _nodes[index];
+        if (node.list >= EXPIRED) {
+            return;
+        }
+        if (node.list < DUE) {
+            --_num_in_slots;
+        }
+
+        if (node.prev != NONE) {
+            _nodes[node.prev].next = node.next;
+        } else {
+            _heads[node.list] = node.next;
+        }
+        if (node.next != NONE) {
+            _nodes[node.next].prev = node.prev;
+        }
+        node.prev = NONE;
+        node.next = NONE;
+        node.list = EXPIRED;
+    }
+
+    // Places all timers of a list again, relative to the current tick.
+    void replace_all(uint16_t list)
+    {
+        uint32_t index = _heads[list];
+        while (index != NONE) {
+            const uint32_t next = _nodes[index].next;
+            unlink(index);
+            insert(index);
+            index = next;
+        }
+    }
+
+    void advance(int64_t target_tick)
+    {
+        while (_current_tick < target_tick) {
+            if (_num_in_slots == 0) {
+                // Nothing to move, we can skip ahead.
+                _current_tick = target_tick;
+                return;
+            }
+
+            ++_current_tick;
+
+            // Whenever a level has gone round once, the next slot of the
+            // level above comes within range of it.
+            for (unsigned level = 1; level < LEVELS; ++level) {
+                if ((_current_tick & ((int64_t(1) << (level * SLOT_BITS)) - 1)) != 0) {
+                    break;
+                }
+                const auto slot =
+                    static_cast<unsigned>((_current_tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+                replace_all(static_cast<uint16_t>(level * SLOTS + slot));
+            }
+
+            replace_all(static_cast<uint16_t>(_current_tick & (SLOTS - 1)));
+        }
+    }
+
+    dl_time_t _start{};
+    bool _started{false};
+    int64_t _current_tick{0};
+
+    std::vector<Node> _nodes{};
+    std::vector<uint32_t> _heads;
+    uint32_t _free_head{NONE};
+
+    size_t _size{0};
+    size_t _num_in_slots{0};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,173 @@
+#include "timer_wheel.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace mavsdk;
+using namespace std::chrono_literals;
+
+using Wheel = TimerWheel<int>;
+
+static std::vector<int> expired_payloads(Wheel& wheel, dl_time_t now)
+{
+    std::vector<Wheel::Handle> handles;
+    wheel.collect_expired(now, handles);
+
+    std::vector<int> payloads;
+    for (const auto handle : handles) {
+        payloads.push_back(*wheel.get(handle));
+        wheel.remove(handle);
+    }
+    std::sort(payloads.begin(), payloads.end());
+    return payloads;
+}
+
+TEST(TimerWheel, ExpiresOncePastDeadline)
+{
+    const dl_time_t start{};
+    Wheel wheel(start);
+
+    wheel.add(1, start + 10ms);
+    wheel.add(2, start + 10ms + 500us);
+    wheel.add(3, start + 100ms);
+
+    EXPECT_TRUE(expired_payloads(wheel, start + 10ms).empty());
+    EXPECT_EQ(expired_payloads(wheel, start + 10ms + 1ns), std::vector<int>({1}));
+    EXPECT_TRUE(expired_payloads(wheel, start + 10ms + 500us).empty());
+    EXPECT_EQ(expired_payloads(wheel, start + 11ms), std::vector<int>({2}));
+    EXPECT_EQ(expired_payloads(wheel, start + 1s), std::vector<int>({3}));
+    EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheel, DeadlineInThePast)
+{
+    const dl_time_t start{};
+    Wheel wheel(start + 1s);
+
+    wheel.add(1, start);
+    EXPECT_EQ(expired_payloads(wheel, start + 1s), std::vector<int>({1}));
+}
+
+TEST(TimerWheel, StartsAtFirstTime)
+{
+    const dl_time_t start = dl_time_t{} + 10h;
+    Wheel wheel;
+
+    wheel.add(1, start + 10ms);
+    wheel.add(2, start + 2s);
+    wheel.add(3, start - 1s);
+
+    EXPECT_EQ(expired_payloads(wheel, start + 10ms), std::vector<int>({3}));
+    EXPECT_EQ(expired_payloads(wheel, start + 11ms), std::vector<int>({1}));
+    EXPECT_TRUE(expired_payloads(wheel, start + 2s).empty());
+    EXPECT_EQ(expired_payloads(wheel, start + 3s), std::vector<int>({2}));
+}
+
+TEST(TimerWheel, FarAway)
+{
+    const dl_time_t start{};
+    Wheel wheel(start);
+
+    // Beyond what the levels cover.
+    wheel.add(1, start + 10h);
+    wheel.add(2, start + 3h);
+
+    EXPECT_TRUE(expired_payloads(wheel, start + 3h).empty());
+    EXPECT_EQ(expired_payloads(wheel, start + 3h + 1ms), std::vector<int>({2}));
+    EXPECT_TRUE(expired_payloads(wheel, start + 10h).empty());
+    EXPECT_EQ(expired_payloads(wheel, start + 10h + 1ms), std::vector<int>({1}));
+}
+
+TEST(TimerWheel, RescheduleAndRemove)
+{
+    const dl_time_t start{};
+    Wheel wheel(start);
+
+    const auto handle1 = wheel.add(1, start + 100ms);
+    const auto handle2 = wheel.add(2, start + 100ms);
+
+    EXPECT_TRUE(wheel.reschedule(handle1, start + 300ms));
+    EXPECT_TRUE(wheel.remove(handle2));
+    EXPECT_FALSE(wheel.remove(handle2));
+    EXPECT_EQ(wheel.get(handle2), nullptr);
+
+    EXPECT_TRUE(expired_payloads(wheel, start + 200ms).empty());
+    EXPECT_EQ(expired_payloads(wheel, start + 301ms), std::vector<int>({1}));
+}
+
+TEST(TimerWheel, StaleHandleDoesNotMatchReusedTimer)
+{
+    const dl_time_t start{};
+    Wheel wheel(start);
+
+    const auto old_handle = wheel.add(1, start + 100ms);
+    wheel.remove(old_handle);
+
+    // Gets the same slot of the pool.
+    const auto new_handle = wheel.add(2, start + 100ms);
+    EXPECT_NE(new_handle, old_handle);
+    EXPECT_NE(new_handle, Wheel::INVALID_HANDLE);
+
+    EXPECT_FALSE(wheel.remove(old_handle));
+    EXPECT_FALSE(wheel.reschedule(old_handle, start + 1s));
+    EXPECT_EQ(*wheel.get(new_handle), 2);
+}
+
+TEST(TimerWheel, CollectedStaysUntilRescheduled)
+{
+    const dl_time_t start{};
+    Wheel wheel(start);
+
+    const auto handle = wheel.add(1, start + 10ms);
+
+    std::vector<Wheel::Handle> expired;
+    wheel.collect_expired(start + 20ms, expired);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_TRUE(wheel.is_expired(handle));
+
+    // Not collected twice.
+    expired.clear();
+    wheel.collect_expired(start + 30ms, expired);
+    EXPECT_TRUE(expired.empty());
+
+    wheel.reschedule(handle, start + 40ms);
+    EXPECT_FALSE(wheel.is_expired(handle));
+    EXPECT_EQ(expired_payloads(wheel, start + 41ms), std::vector<int>({1}));
+}
+
+TEST(TimerWheel, SameAsSortingByDeadline)
+{
+    const dl_time_t start{};
+    Wheel wheel(start);
+
+    std::mt19937 generator(42);
+    // Spread over all levels.
+    std::uniform_int_distribution<int64_t> deadline_ms(0, 20'000'000);
+
+    std::vector<std::pair<dl_time_t, int>> expected;
+    for (int i = 0; i < 2000; ++i) {
+        const auto deadline = start + std::chrono::milliseconds(deadline_ms(generator)) + 300us;
+        wheel.add(int{i}, deadline);
+        expected.emplace_back(deadline, i);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    // Steps of different size, so some ticks are skipped and others not.
+    std::uniform_int_distribution<int64_t> step_ms(0, 20'000);
+    dl_time_t now = start;
+    size_t num_expired = 0;
+    while (num_expired < expected.size()) {
+        now += std::chrono::milliseconds(step_ms(generator));
+
+        std::vector<int> expected_now;
+        while (num_expired < expected.size() && expected[num_expired].first < now) {
+            expected_now.push_back(expected[num_expired].second);
+            ++num_expired;
+        }
+        std::sort(expected_now.begin(), expected_now.end());
+
+        ASSERT_EQ(expired_payloads(wheel, now), expected_now);
+    }
+    EXPECT_EQ(wheel.size(), 0u);
+}
@@ -0,0 +1,339 @@
+#include "tlog_recorder.h"
+#include "log.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#if !defined(WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace mavsdk {
+
+namespace {
+
+// The writing thread wakes up this often, recording never signals it.
+constexpr auto WRITE_INTERVAL = std::chrono::milliseconds(10);
+
+constexpr size_t TIMESTAMP_LEN = sizeof(uint64_t);
+
+} // namespace
+
+// A file of a fixed maximum size which is written front to back. It is
+// truncated to what was actually written once closed.
+//
+// Its disk space is reserved up front, so that writing through the mapping
+// can't run out of space, which would raise SIGBUS. Where that is not
+// possible, it is written with write() instead, which fails gracefully.
+class TlogRecorder::File {
+public:
+    File() = default;
+
+    ~File()
+    {
+#if !defined(WINDOWS)
+        if (_mapped != nullptr) {
+            munmap(_mapped, static_cast<size_t>(_capacity));
+        }
+        if (_fd >= 0) {
+            if (ftruncate(_fd, static_cast<off_t>(_size)) != 0) {
+                LogWarn() << "Could not truncate tlog file";
+            }
+            close(_fd);
+        }
+#endif
+    }
+
+    bool open(const std::string& path, uint64_t capacity)
+    {
+        _capacity = capacity;
+#if !defined(WINDOWS)
+        _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (_fd < 0) {
+            return false;
+        }
+
+        if (!reserve()) {
+            LogWarn() << "Could not reserve space for tlog file, writing it without mapping";
+            return true;
+        }
+
+        void* mapped =
+            mmap(nullptr, static_cast<size_t>(_capacity), PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        _mapped = static_cast<uint8_t*>(mapped);
+        madvise(_mapped, static_cast<size_t>(_capacity), MADV_SEQUENTIAL);
+        return true;
+#else
+        // No mmap, write through a stream instead.
+        _stream.open(path, std::ios::binary | std::ios::trunc);
+        return _stream.is_open();
+#endif
+    }
+
+    bool fits(size_t len) const { return _size + len <= _capacity; }
+
+    // Assumes that the data fits. Only what was written completely counts.
+    bool write(const uint8_t* data, size_t len)
+    {
+#if !defined(WINDOWS)
+        if (_mapped != nullptr) {
+            std::memcpy(_mapped + _size, data, len);
+        } else {
+            size_t written = 0;
+            while (written < len) {
+                const ssize_t result = ::write(_fd, data + written, len - written);
+                if (result < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (result <= 0) {
+                    return false;
+                }
+                written += static_cast<size_t>(result);
+            }
+        }
+#else
+        _stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(len));
+        if (!_stream) {
+            return false;
+        }
+#endif
+        _size += len;
+        return true;
+    }
+
+    // Non-copyable
+    File(const File&) = delete;
+    const File& operator=(const File&) = delete;
+
+private:
+#if !defined(WINDOWS)
+    // Allocates the blocks of the whole file, unlike ftruncate which leaves
+    // a sparse file behind.
+    bool reserve()
+    {
+#if defined(LINUX)
+        return posix_fallocate(_fd, 0, static_cast<off_t>(_capacity)) == 0;
+#else
+        return false;
+#endif
+    }
+#endif
+
+    uint64_t _capacity{0};
+    uint64_t _size{0};
+#if !defined(WINDOWS)
+    int _fd{-1};
+    uint8_t* _mapped{nullptr};
+#else
+    std::ofstream _stream{};
+#endif
+};
+
+TlogRecorder::TlogRecorder() {}
+
+TlogRecorder::~TlogRecorder()
+{
+    stop();
+}
+
+bool TlogRecorder::start(const std::string& path, uint64_t max_file_size, unsigned max_files)
+{
+    std::lock_guard<std::mutex> lock(_start_stop_mutex);
+
+    if (_recording) {
+        LogWarn() << "Already recording tlog to " << _path;
+        return false;
+    }
+
+    _path = path;
+    // Every file needs to hold at least one frame.
+    _max_file_size = std::max<uint64_t>(max_file_size, TIMESTAMP_LEN + MAVLINK_MAX_PACKET_LEN);
+    _max_files = max_files;
+
+    // Left over from a previous recording.
+    Frame frame;
+    while (_queue.try_pop(frame)) {}
+    _num_dropped = 0;
+
+    {
+        std::lock_guard<std::mutex> stats_lock(_stats_mutex);
+        _stats = Stats{};
+    }
+
+    if (!open_next_file()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> wake_lock(_wake_mutex);
+        _should_exit = false;
+    }
+    _thread = new std::thread(&TlogRecorder::run, this);
+
+    _recording = true;
+    return true;
+}
+
+void TlogRecorder::stop()
+{
+    std::lock_guard<std::mutex> lock(_start_stop_mutex);
+
+    if (!_recording) {
+        return;
+    }
+    _recording = false;
+
+    {
+        std::lock_guard<std::mutex> wake_lock(_wake_mutex);
+        _should_exit = true;
+    }
+    _wake_cv.notify_one();
+
+    _thread->join();
+    delete _thread;
+    _thread = nullptr;
+
+    _file.reset();
+}
+
+void TlogRecorder::record(const mavlink_message_t& message)
+{
+    if (!_recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    Frame frame;
+    frame.timestamp_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    frame.len = mavlink_msg_to_send_buffer(frame.data, &message);
+
+    if (!_queue.try_push(frame)) {
+        _num_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+TlogRecorder::Stats TlogRecorder::stats() const
+{
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    Stats stats = _stats;
+    stats.num_dropped += _num_dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string TlogRecorder::numbered_path(const std::string& path, unsigned number)
+{
+    const auto separator = path.find_last_of("/\\");
+    const auto dot = path.find_last_of('.');
+    const bool has_extension =
+        dot != std::string::npos && dot != 0 &&
+        (separator == std::string::npos || (dot > separator + 1));
+
+    if (!has_extension) {
+        return path + "_" + std::to_string(number);
+    }
+    return path.substr(0, dot) + "_" + std::to_string(number) + path.substr(dot);
+}
+
+void TlogRecorder::run()
+{
+    while (true) {
+        uint64_t num_frames = 0;
+        uint64_t num_bytes = 0;
+        uint64_t num_failed = 0;
+
+        Frame frame;
+        while (_queue.try_pop(frame)) {
+            if (write_frame(frame)) {
+                ++num_frames;
+                num_bytes += TIMESTAMP_LEN + frame.len;
+            } else {
+                ++num_failed;
+            }
+        }
+
+        if (num_frames > 0 || num_failed > 0) {
+            std::lock_guard<std::mutex> lock(_stats_mutex);
+            _stats.num_frames += num_frames;
+            _stats.num_bytes += num_bytes;
+            _stats.num_dropped += num_failed;
+        }
+
+        std::unique_lock<std::mutex> lock(_wake_mutex);
+        if (_should_exit) {
+            break;
+        }
+        _wake_cv.wait_for(lock, WRITE_INTERVAL, [this]() { return _should_exit; });
+    }
+}
+
+bool TlogRecorder::write_frame(const Frame& frame)
+{
+    const size_t len = TIMESTAMP_LEN + frame.len;
+
+    if (!_file) {
+        // Creating the file failed before, don't keep trying for every frame.
+        return false;
+    }
+
+    if (!_file->fits(len) && !open_next_file()) {
+        return false;
+    }
+
+    // In one piece, so that a failed write doesn't leave half a frame.
+    uint8_t buffer[TIMESTAMP_LEN + MAVLINK_MAX_PACKET_LEN];
+    for (size_t i = 0; i < TIMESTAMP_LEN; ++i) {
+        buffer[i] = static_cast<uint8_t>(frame.timestamp_us >> (8 * (TIMESTAMP_LEN - 1 - i)));
+    }
+    std::memcpy(buffer + TIMESTAMP_LEN, frame.data, frame.len);
+
+    if (!_file->write(buffer, len)) {
+        LogErr() << "Could not write tlog file, e.g. because the disk is full, recording stopped";
+        // Like a file that could not be created, nothing is written anymore.
+        _file.reset();
+        return false;
+    }
+    return true;
+}
+
+bool TlogRecorder::open_next_file()
+{
+    // Closing the current file truncates it.
+    _file.reset();
+
+    unsigned number;
+    {
+        std::lock_guard<std::mutex> lock(_stats_mutex);
+        number = _stats.num_files;
+    }
+
+    const std::string path = (number == 0) ? _path : numbered_path(_path, number);
+
+    auto file = std::unique_ptr<File>(new File());
+    if (!file->open(path, _max_file_size)) {
+        LogErr() << "Could not create tlog file " << path;
+        return false;
+    }
+    _file = std::move(file);
+
+    if (_max_files > 0 && number >= _max_files) {
+        const unsigned oldest = number - _max_files;
+        const std::string oldest_path = (oldest == 0) ? _path : numbered_path(_path, oldest);
+        std::remove(oldest_path.c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(_stats_mutex);
+    ++_stats.num_files;
+    return true;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "bounded_queue.h"
+#include "mavlink_include.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace mavsdk {
+
+// Records MAVLink frames into telemetry log (tlog) files as used by
+// QGroundControl: every frame is preceded by the time it was seen, in us
+// since the epoch as big-endian uint64.
+//
+// Recording a frame only serializes it into a slot of a lock-free queue,
+// a thread of its own writes the frames into a file whose space is reserved
+// up front, memory-mapped where possible. Once the file is full, the
+// recording continues in a new file, and the oldest files are removed.
+//
+// Frames are dropped rather than holding up the caller if the queue is full.
+class TlogRecorder {
+public:
+    TlogRecorder();
+    ~TlogRecorder();
+
+    // The first file is at path, the following ones get a number appended
+    // to the name, e.g. flight_1.tlog. max_files of 0 keeps all files.
+    bool start(
+        const std::string& path,
+        uint64_t max_file_size = DEFAULT_MAX_FILE_SIZE,
+        unsigned max_files = DEFAULT_MAX_FILES);
+    void stop();
+
+    bool is_recording() const { return _recording.load(std::memory_order_relaxed); }
+
+    // Can be called from any thread, returns immediately if not recording.
+    void record(const mavlink_message_t& message);
+
+    struct Stats {
+        uint64_t num_frames{0};
+        uint64_t num_dropped{0};
+        uint64_t num_bytes{0};
+        unsigned num_files{0};
+    };
+
+    Stats stats() const;
+
+    // Adds a number before the extension of a path, e.g. flight_1.tlog.
+    static std::string numbered_path(const std::string& path, unsigned number);
+
+    static constexpr uint64_t DEFAULT_MAX_FILE_SIZE = 64 * 1024 * 1024;
+    static constexpr unsigned DEFAULT_MAX_FILES = 10;
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+    // Non-copyable
+    TlogRecorder(const TlogRecorder&) = delete;
+    const TlogRecorder& operator=(const TlogRecorder&) = delete;
+
+private:
+    struct Frame {
+        uint64_t timestamp_us;
+        uint16_t len;
+        uint8_t data[MAVLINK_MAX_PACKET_LEN];
+    };
+
+    class File;
+
+    void run();
+    bool write_frame(const Frame& frame);
+    bool open_next_file();
+
+    std::mutex _start_stop_mutex{};
+    std::atomic<bool> _recording{false};
+
+    BoundedQueue<Frame> _queue{QUEUE_CAPACITY};
+    std::atomic<uint64_t> _num_dropped{0};
+
+    std::mutex _wake_mutex{};
+    std::condition_variable _wake_cv{};
+    bool _should_exit{false};
+
+    // Only used by the writing thread while recording.
+    std::unique_ptr<File> _file{};
+    std::string _path{};
+    uint64_t _max_file_size{DEFAULT_MAX_FILE_SIZE};
+    unsigned _max_files{DEFAULT_MAX_FILES};
+
+    mutable std::mutex _stats_mutex{};
+    Stats _stats{};
+
+    std::thread* _thread{nullptr};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,68 @@
+#include "tlog_recorder.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// What recording adds to the receive path for every frame.
+static void BM_TlogRecorderRecord(benchmark::State& state)
+{
+    const std::string path = "tlog_recorder_benchmark.tlog";
+    const bool recording = state.range(0) != 0;
+
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        1, 1, &message, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+
+    TlogRecorder recorder;
+    if (recording && !recorder.start(path)) {
+        state.SkipWithError("Could not start recording");
+        return;
+    }
+
+    for (auto _ : state) {
+        recorder.record(message);
+        benchmark::ClobberMemory();
+    }
+
+    recorder.stop();
+    const auto stats = recorder.stats();
+    state.counters["dropped"] = static_cast<double>(stats.num_dropped);
+    state.SetLabel(recording ? "recording" : "not recording");
+
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_TlogRecorderRecord)->Arg(0)->Arg(1);
+
+// Frames at a typical telemetry rate, so that the writing thread keeps up.
+static void BM_TlogRecorderRecordPaced(benchmark::State& state)
+{
+    const std::string path = "tlog_recorder_benchmark_paced.tlog";
+
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        1, 1, &message, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+
+    TlogRecorder recorder;
+    if (!recorder.start(path)) {
+        state.SkipWithError("Could not start recording");
+        return;
+    }
+
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        recorder.record(message);
+        const auto end = std::chrono::steady_clock::now();
+        state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    recorder.stop();
+    state.counters["dropped"] = static_cast<double>(recorder.stats().num_dropped);
+
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_TlogRecorderRecordPaced)->UseManualTime()->Iterations(20000);
@@ -0,0 +1,171 @@
+#include "tlog_recorder.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+mavlink_message_t make_heartbeat(uint8_t sequence)
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        1, 1, &message, MAV_TYPE_GCS, MAV_AUTOPILOT_INVALID, 0, 0, MAV_STATE_ACTIVE);
+    message.seq = sequence;
+    return message;
+}
+
+std::vector<uint8_t> read_file(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+bool file_exists(const std::string& path)
+{
+    return std::ifstream(path).good();
+}
+
+} // namespace
+
+TEST(TlogRecorder, NumbersPaths)
+{
+    EXPECT_EQ(TlogRecorder::numbered_path("flight.tlog", 1), "flight_1.tlog");
+    EXPECT_EQ(TlogRecorder::numbered_path("logs/flight.tlog", 12), "logs/flight_12.tlog");
+    EXPECT_EQ(TlogRecorder::numbered_path("logs.d/flight", 2), "logs.d/flight_2");
+    EXPECT_EQ(TlogRecorder::numbered_path(".tlog", 3), ".tlog_3");
+}
+
+TEST(TlogRecorder, RecordsFramesWithTimestamps)
+{
+    const std::string path = "tlog_recorder_test.tlog";
+
+    TlogRecorder recorder;
+    // Not recording yet.
+    recorder.record(make_heartbeat(0));
+
+    ASSERT_TRUE(recorder.start(path));
+    EXPECT_TRUE(recorder.is_recording());
+
+    const int num_messages = 100;
+    for (int i = 0; i < num_messages; ++i) {
+        recorder.record(make_heartbeat(static_cast<uint8_t>(i)));
+    }
+    recorder.stop();
+    EXPECT_FALSE(recorder.is_recording());
+
+    const auto stats = recorder.stats();
+    EXPECT_EQ(stats.num_frames, num_messages);
+    EXPECT_EQ(stats.num_dropped, 0);
+    EXPECT_EQ(stats.num_files, 1);
+
+    const auto data = read_file(path);
+    ASSERT_EQ(data.size(), stats.num_bytes);
+
+    uint8_t expected[MAVLINK_MAX_PACKET_LEN];
+    uint64_t last_timestamp_us = 0;
+    size_t offset = 0;
+    for (int i = 0; i < num_messages; ++i) {
+        const auto message = make_heartbeat(static_cast<uint8_t>(i));
+        const uint16_t len = mavlink_msg_to_send_buffer(expected, &message);
+        ASSERT_LE(offset + 8 + len, data.size());
+
+        uint64_t timestamp_us = 0;
+        for (size_t j = 0; j < 8; ++j) {
+            timestamp_us = (timestamp_us << 8) | data[offset + j];
+        }
+        EXPECT_GE(timestamp_us, last_timestamp_us);
+        last_timestamp_us = timestamp_us;
+        offset += 8;
+
+        EXPECT_EQ(std::vector<uint8_t>(expected, expected + len),
+                  std::vector<uint8_t>(data.begin() + offset, data.begin() + offset + len));
+        offset += len;
+    }
+    EXPECT_EQ(offset, data.size());
+    EXPECT_GT(last_timestamp_us, 0);
+
+    std::remove(path.c_str());
+}
+
+TEST(TlogRecorder, RotatesFiles)
+{
+    const std::string path = "tlog_recorder_rotate.tlog";
+
+    mavlink_message_t message = make_heartbeat(0);
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const size_t frame_len = 8 + mavlink_msg_to_send_buffer(buffer, &message);
+
+    // Room for just one frame, at most 3 files kept.
+    const uint64_t max_file_size = 8 + MAVLINK_MAX_PACKET_LEN;
+    TlogRecorder recorder;
+    ASSERT_TRUE(recorder.start(path, max_file_size, 3));
+
+    const uint64_t frames_per_file = max_file_size / frame_len;
+    const uint64_t num_messages = 5 * frames_per_file;
+    for (uint64_t i = 0; i < num_messages; ++i) {
+        recorder.record(message);
+    }
+    recorder.stop();
+
+    const auto stats = recorder.stats();
+    EXPECT_EQ(stats.num_frames, num_messages);
+    EXPECT_EQ(stats.num_files, 5);
+
+    EXPECT_FALSE(file_exists(path));
+    EXPECT_FALSE(file_exists(TlogRecorder::numbered_path(path, 1)));
+    for (unsigned i = 2; i < 5; ++i) {
+        const auto numbered = TlogRecorder::numbered_path(path, i);
+        EXPECT_EQ(read_file(numbered).size(), frames_per_file * frame_len);
+        std::remove(numbered.c_str());
+    }
+}
+
+TEST(TlogRecorder, CanBeRestarted)
+{
+    const std::string path = "tlog_recorder_restart.tlog";
+
+    TlogRecorder recorder;
+    ASSERT_TRUE(recorder.start(path));
+    EXPECT_FALSE(recorder.start(path));
+    recorder.record(make_heartbeat(0));
+    recorder.stop();
+    EXPECT_EQ(recorder.stats().num_frames, 1);
+
+    ASSERT_TRUE(recorder.start(path));
+    recorder.record(make_heartbeat(1));
+    recorder.record(make_heartbeat(2));
+    recorder.stop();
+    EXPECT_EQ(recorder.stats().num_frames, 2);
+
+    std::remove(path.c_str());
+}
+
+TEST(TlogRecorder, FailsForInvalidPath)
+{
+    TlogRecorder recorder;
+    EXPECT_FALSE(recorder.start("does/not/exist/flight.tlog"));
+    EXPECT_FALSE(recorder.is_recording());
+}
+
+#if defined(LINUX)
+TEST(TlogRecorder, StopsWritingWhenDiskIsFull)
+{
+    // Space can't be reserved on it, and every write fails with ENOSPC.
+    TlogRecorder recorder;
+    ASSERT_TRUE(recorder.start("/dev/full"));
+
+    const int num_messages = 10;
+    for (int i = 0; i < num_messages; ++i) {
+        recorder.record(make_heartbeat(static_cast<uint8_t>(i)));
+    }
+    recorder.stop();
+
+    const auto stats = recorder.stats();
+    EXPECT_EQ(stats.num_frames, 0);
+    EXPECT_EQ(stats.num_dropped, num_messages);
+}
+#endif
@@ -0,0 +1,159 @@
+#include "trace.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+namespace mavsdk {
+
+std::atomic<bool> Trace::_enabled{false};
+std::atomic<uint64_t> Trace::_next_id{1};
+
+void Trace::start()
+{
+    _enabled.store(true, std::memory_order_relaxed);
+}
+
+void Trace::stop()
+{
+    _enabled.store(false, std::memory_order_relaxed);
+}
+
+uint64_t Trace::now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+void Trace::complete(const char* name, uint64_t start_ns, uint64_t end_ns, uint64_t arg)
+{
+    record(Event{name, start_ns, end_ns - start_ns, arg, 'X'});
+}
+
+void Trace::async_begin(const char* name, uint64_t id)
+{
+    if (is_enabled()) {
+        record(Event{name, now_ns(), 0, id, 'b'});
+    }
+}
+
+void Trace::async_end(const char* name, uint64_t id)
+{
+    if (is_enabled()) {
+        record(Event{name, now_ns(), 0, id, 'e'});
+    }
+}
+
+void Trace::record(const Event& event)
+{
+    ThreadBuffer& buffer = thread_buffer();
+
+    const size_t size = buffer.size.load(std::memory_order_relaxed);
+    if (size == EVENTS_PER_THREAD) {
+        buffer.num_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[size] = event;
+    // Publishes the event to to_json().
+    buffer.size.store(size + 1, std::memory_order_release);
+}
+
+Trace::ThreadBuffer& Trace::thread_buffer()
+{
+    static thread_local ThreadBuffer* buffer = nullptr;
+
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(buffers_mutex());
+        const auto thread_id = static_cast<unsigned>(buffers().size() + 1);
+        auto new_buffer = std::make_shared<ThreadBuffer>(thread_id);
+        buffers().push_back(new_buffer);
+        buffer = new_buffer.get();
+    }
+    return *buffer;
+}
+
+std::vector<std::shared_ptr<Trace::ThreadBuffer>>& Trace::buffers()
+{
+    // Leaked on purpose, threads might still record while the process exits.
+    static auto* buffers = new std::vector<std::shared_ptr<ThreadBuffer>>();
+    return *buffers;
+}
+
+std::mutex& Trace::buffers_mutex()
+{
+    static auto* mutex = new std::mutex();
+    return *mutex;
+}
+
+uint64_t Trace::num_dropped()
+{
+    std::lock_guard<std::mutex> lock(buffers_mutex());
+
+    uint64_t num_dropped = 0;
+    for (const auto& buffer : buffers()) {
+        num_dropped += buffer->num_dropped.load(std::memory_order_relaxed);
+    }
+    return num_dropped;
+}
+
+static void append_microseconds(std::ostringstream& out, uint64_t ns)
+{
+    // Chrome trace times are in us, the fraction keeps the ns.
+    out << ns / 1000 << '.';
+    const auto fraction = ns % 1000;
+    out << static_cast<char>('0' + fraction / 100) << static_cast<char>('0' + fraction / 10 % 10)
+        << static_cast<char>('0' + fraction % 10);
+}
+
+std::string Trace::to_json()
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_copy;
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex());
+        buffers_copy = buffers();
+    }
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto& buffer : buffers_copy) {
+        const size_t size = buffer->size.load(std::memory_order_acquire);
+        for (size_t i = 0; i < size; ++i) {
+            const Event& event = buffer->events[i];
+
+            out << (first ? "" : ",") << "\n{\"name\":\"" << event.name << "\",\"cat\":\"mavsdk\""
+                << ",\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << buffer->thread_id
+                << ",\"ts\":";
+            append_microseconds(out, event.time_ns);
+            first = false;
+
+            if (event.phase == 'X') {
+                out << ",\"dur\":";
+                append_microseconds(out, event.duration_ns);
+                if (event.value != NO_ARG) {
+                    out << ",\"args\":{\"value\":" << event.value << '}';
+                }
+            } else {
+                out << ",\"id\":" << event.value;
+            }
+            out << '}';
+        }
+    }
+
+    out << "\n]}\n";
+    return out.str();
+}
+
+bool Trace::write_json(const std::string& path)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << to_json();
+    return static_cast<bool>(file);
+}
+
+} // namespace mavsdk
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Trace points are compiled in with -DENABLE_TRACING (cmake -DENABLE_TRACING=ON)
+// and cost nothing otherwise. Set MAVSDK_TRACE_FILE to a path to record, the
+// trace is written there as Chrome trace JSON once Mavsdk is destroyed. It can
+// be viewed with chrome://tracing or https://ui.perfetto.dev.
+#if defined(ENABLE_TRACING)
+#define MAVSDK_TRACE_CONCAT_INNER(a, b) a##b
+#define MAVSDK_TRACE_CONCAT(a, b) MAVSDK_TRACE_CONCAT_INNER(a, b)
+// Records the time from here until the end of the scope.
+#define MAVSDK_TRACE_SCOPE(...) \
+    mavsdk::TraceScope MAVSDK_TRACE_CONCAT(_trace_scope_, __LINE__)(__VA_ARGS__)
+// Records the time between begin and end, which can be on different threads.
+#define MAVSDK_TRACE_ASYNC_BEGIN(name, id) mavsdk::Trace::async_begin(name, id)
+#define MAVSDK_TRACE_ASYNC_END(name, id) mavsdk::Trace::async_end(name, id)
+#else
+#define MAVSDK_TRACE_SCOPE(...) ((void)0)
+#define MAVSDK_TRACE_ASYNC_BEGIN(name, id) ((void)0)
+#define MAVSDK_TRACE_ASYNC_END(name, id) ((void)0)
+#endif
+
+namespace mavsdk {
+
+// Records trace events into a buffer per thread, without locking.
+//
+// Names need to be string literals which need no escaping in JSON, only the
+// pointer is kept. Once the buffer of a thread is full, its further events
+// are dropped.
+class Trace {
+public:
+    static void start();
+    static void stop();
+
+    static bool is_enabled() { return _enabled.load(std::memory_order_relaxed); }
+
+    static void complete(const char* name, uint64_t start_ns, uint64_t end_ns, uint64_t arg);
+    static void async_begin(const char* name, uint64_t id);
+    static void async_end(const char* name, uint64_t id);
+
+    // Unique ids to match async begin and end.
+    static uint64_t next_id() { return _next_id.fetch_add(1, std::memory_order_relaxed); }
+
+    static uint64_t now_ns();
+
+    // All events recorded so far as Chrome trace JSON. Can be called while
+    // recording, events which are just being recorded might be left out.
+    static std::string to_json();
+    static bool write_json(const std::string& path);
+
+    static uint64_t num_dropped();
+
+    static constexpr uint64_t NO_ARG = UINT64_MAX;
+    static constexpr size_t EVENTS_PER_THREAD = 64 * 1024;
+
+private:
+    struct Event {
+        const char* name;
+        uint64_t time_ns;
+        uint64_t duration_ns;
+        // The argument of complete events, the id of async events.
+        uint64_t value;
+        char phase;
+    };
+
+    struct ThreadBuffer {
+        explicit ThreadBuffer(unsigned thread_id_) :
+            thread_id(thread_id_),
+            events(new Event[EVENTS_PER_THREAD])
+        {}
+
+        const unsigned thread_id;
+        std::unique_ptr<Event[]> events;
+        // Written by the owning thread only.
+        std::atomic<size_t> size{0};
+        std::atomic<uint64_t> num_dropped{0};
+    };
+
+    static void record(const Event& event);
+    static ThreadBuffer& thread_buffer();
+
+    // Buffers are kept after their thread has finished, so that their events
+    // end up in the trace.
+    static std::vector<std::shared_ptr<ThreadBuffer>>& buffers();
+    static std::mutex& buffers_mutex();
+
+    static std::atomic<bool> _enabled;
+    static std::atomic<uint64_t> _next_id;
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, uint64_t arg = Trace::NO_ARG) :
+        _name(Trace::is_enabled() ? name : nullptr),
+        _arg(arg),
+        _start_ns(_name != nullptr ? Trace::now_ns() : 0)
+    {}
+
+    ~TraceScope()
+    {
+        if (_name != nullptr) {
+            Trace::complete(_name, _start_ns, Trace::now_ns(), _arg);
+        }
+    }
+
+    // Non-copyable
+    TraceScope(const TraceScope&) = delete;
+    const TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* const _name;
+    const uint64_t _arg;
+    const uint64_t _start_ns;
+};
+
+} // namespace mavsdk
@@ -0,0 +1,23 @@
+#include "trace.h"
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// What a trace point costs while recording, and while compiled in but not
+// recording. Every thread records at most EVENTS_PER_THREAD events, the
+// rest are dropped, which is about as cheap.
+static void BM_TraceScope(benchmark::State& state)
+{
+    if (state.range(0) != 0) {
+        Trace::start();
+    }
+
+    for (auto _ : state) {
+        TraceScope scope("trace_benchmark", 1);
+        benchmark::ClobberMemory();
+    }
+
+    Trace::stop();
+    state.SetLabel(state.range(0) != 0 ? "recording" : "not recording");
+}
+BENCHMARK(BM_TraceScope)->Arg(0)->Arg(1)->Iterations(Trace::EVENTS_PER_THREAD / 2);
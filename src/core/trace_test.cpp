@@ -0,0 +1,73 @@
+#include "trace.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace mavsdk;
+
+static size_t count(const std::string& haystack, const std::string& needle)
+{
+    size_t num = 0;
+    for (size_t pos = haystack.find(needle); pos != std::string::npos;
+         pos = haystack.find(needle, pos + needle.size())) {
+        ++num;
+    }
+    return num;
+}
+
+TEST(Trace, NothingRecordedWhenStopped)
+{
+    Trace::stop();
+    {
+        TraceScope scope("trace_test_stopped");
+    }
+    Trace::async_begin("trace_test_stopped", 1);
+
+    EXPECT_EQ(count(Trace::to_json(), "trace_test_stopped"), 0u);
+}
+
+TEST(Trace, RecordsScopesAndAsyncEvents)
+{
+    Trace::start();
+    {
+        TraceScope scope("trace_test_scope", 42);
+    }
+    const auto id = Trace::next_id();
+    Trace::async_begin("trace_test_async", id);
+    std::thread([id]() { Trace::async_end("trace_test_async", id); }).join();
+    Trace::stop();
+
+    const auto json = Trace::to_json();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+    EXPECT_EQ(count(json, "\"name\":\"trace_test_scope\""), 1u);
+    EXPECT_EQ(count(json, "\"ph\":\"X\""), count(json, "\"dur\":"));
+    EXPECT_EQ(count(json, "\"args\":{\"value\":42}"), 1u);
+    EXPECT_EQ(count(json, "\"name\":\"trace_test_async\""), 2u);
+    EXPECT_EQ(count(json, "\"id\":" + std::to_string(id) + "}"), 2u);
+}
+
+TEST(Trace, DropsEventsOnceFull)
+{
+    const auto num_dropped_before = Trace::num_dropped();
+
+    Trace::start();
+    // A thread of its own, so the buffer starts empty.
+    std::thread([]() {
+        for (size_t i = 0; i < Trace::EVENTS_PER_THREAD + 10; ++i) {
+            TraceScope scope("trace_test_full");
+        }
+    }).join();
+    Trace::stop();
+
+    EXPECT_EQ(Trace::num_dropped() - num_dropped_before, 10u);
+    EXPECT_EQ(count(Trace::to_json(), "trace_test_full"), Trace::EVENTS_PER_THREAD);
+}
+
+TEST(Trace, WritesJsonFile)
+{
+    const std::string path = "trace_test.json";
+    EXPECT_TRUE(Trace::write_json(path));
+    EXPECT_EQ(std::remove(path.c_str()), 0);
+    EXPECT_FALSE(Trace::write_json("/nonexistent/directory/trace.json"));
+}
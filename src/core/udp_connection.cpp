@@ -126,6 +126,38 @@ ConnectionResult UdpConnection::stop()
 }
 
 bool UdpConnection::send_message(const mavlink_message_t& message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
+
+    return send_buffer(buffer, buffer_len);
+}
+
+bool UdpConnection::send_messages(const std::vector<mavlink_message_t>& messages)
+{
+    // Messages are packed into as few datagrams as possible.
+    bool send_successful = true;
+    std::vector<uint8_t> datagram;
+    datagram.reserve(MAX_DATAGRAM_LEN);
+
+    for (const auto& message : messages) {
+        const size_t previous_len = datagram.size();
+        append_to_buffer(datagram, message);
+
+        if (datagram.size() > MAX_DATAGRAM_LEN && previous_len > 0) {
+            send_successful = send_buffer(datagram.data(), previous_len) && send_successful;
+            datagram.erase(datagram.begin(), datagram.begin() + previous_len);
+        }
+    }
+
+    if (!datagram.empty()) {
+        send_successful = send_buffer(datagram.data(), datagram.size()) && send_successful;
+    }
+
+    return send_successful;
+}
+
+bool UdpConnection::send_buffer(const uint8_t* buffer, size_t buffer_len)
 {
     std::lock_guard<std::mutex> lock(_remote_mutex);
 
@@ -147,18 +179,15 @@ bool UdpConnection::send_message(const mavlink_message_t& message)
         inet_pton(AF_INET, remote.ip.c_str(), &dest_addr.sin_addr.s_addr);
         dest_addr.sin_port = htons(remote.port_number);
 
-        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-        uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
-
         const auto send_len = sendto(
             _socket_fd,
-            reinterpret_cast<char*>(buffer),
+            reinterpret_cast<const char*>(buffer),
             buffer_len,
             0,
             reinterpret_cast<const sockaddr*>(&dest_addr),
             sizeof(dest_addr));
 
-        if (send_len != buffer_len) {
+        if (send_len < 0 || static_cast<size_t>(send_len) != buffer_len) {
             LogErr() << "sendto failure: " << GET_ERROR(errno);
             send_successful = false;
             continue;
@@ -21,6 +21,7 @@ public:
     ConnectionResult stop() override;
 
     bool send_message(const mavlink_message_t& message) override;
+    bool send_messages(const std::vector<mavlink_message_t>& messages) override;
 
     void add_remote(const std::string& remote_ip, const int remote_port);
 
@@ -29,10 +30,14 @@ public:
     const UdpConnection& operator=(const UdpConnection&) = delete;
 
 private:
+    // Up to the MTU of 1500 bytes, without IP and UDP headers.
+    static constexpr size_t MAX_DATAGRAM_LEN = 1472;
+
     ConnectionResult setup_port();
     void start_recv_thread();
 
     void receive();
+    bool send_buffer(const uint8_t* buffer, size_t buffer_len);
 
     void add_remote_with_remote_sysid(
         const std::string& remote_ip, const int remote_port, const uint8_t remote_sysid);
@@ -340,3 +340,103 @@ TEST(FtpTest, TestServer)
     result = test_remove_directory(ftp_client, "test");
     EXPECT_EQ(result, Ftp::Result::Success);
 }
+
+TEST(FtpTest, DownloadResumesAfterTimeout)
+{
+    ConnectionResult ret;
+
+    Mavsdk mavsdk_gcs;
+    Mavsdk::Configuration config_gcs(Mavsdk::Configuration::UsageType::GroundStation);
+    mavsdk_gcs.set_configuration(config_gcs);
+    ret = mavsdk_gcs.add_udp_connection(24552);
+    ASSERT_EQ(ret, ConnectionResult::Success);
+    auto system_gcs = mavsdk_gcs.systems().at(0);
+
+    Mavsdk mavsdk_cc;
+    Mavsdk::Configuration config_cc(Mavsdk::Configuration::UsageType::GroundStation);
+    mavsdk_cc.set_configuration(config_cc);
+    ret = mavsdk_cc.setup_udp_remote("127.0.0.1", 24552);
+    ASSERT_EQ(ret, ConnectionResult::Success);
+    auto system_cc = mavsdk_cc.systems().at(0);
+
+    auto ftp_server = std::make_shared<Ftp>(system_cc);
+    ftp_server->set_root_directory(".");
+    uint8_t server_comp_id = ftp_server->get_our_compid();
+
+    auto ftp_client = std::make_shared<Ftp>(system_gcs);
+    ftp_client->set_target_compid(server_comp_id);
+
+    // Lets us cut the link to the client in the middle of a download.
+    auto drop_incoming = std::make_shared<std::atomic<bool>>(false);
+    auto mavlink_passthrough_gcs = std::make_shared<MavlinkPassthrough>(system_gcs);
+    mavlink_passthrough_gcs->intercept_incoming_messages_async(
+        [drop_incoming](mavlink_message_t& message) {
+            return message.msgid != MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL || !*drop_incoming;
+        });
+
+    test_create_directory(ftp_client, "test_resume");
+
+    const std::string file_name = "ftp_resume_file";
+    const std::string resume_path = file_name + ".resume";
+    const uint32_t file_size = 200000;
+    create_test_file(file_name, file_size);
+    test_upload(ftp_client, file_name, "test_resume");
+    // The download must not end up on top of the file we uploaded.
+    remove(file_name.c_str());
+    remove(resume_path.c_str());
+
+    {
+        auto prom = std::make_shared<std::promise<Ftp::Result>>();
+        auto future_result = prom->get_future();
+        ftp_client->download_async(
+            "test_resume/" + file_name,
+            ".",
+            [prom, drop_incoming, file_size](Ftp::Result result, Ftp::ProgressData progress) {
+                if (result == Ftp::Result::Next) {
+                    if (progress.bytes_transferred >= file_size / 2) {
+                        *drop_incoming = true;
+                    }
+                } else {
+                    prom->set_value(result);
+                }
+            });
+
+        ASSERT_EQ(future_result.wait_for(std::chrono::seconds(20)), std::future_status::ready);
+        EXPECT_EQ(future_result.get(), Ftp::Result::Timeout);
+    }
+    // What was received before the timeout has to be kept.
+    EXPECT_TRUE(std::ifstream(resume_path).good());
+
+    *drop_incoming = false;
+    reset_server(ftp_client);
+
+    {
+        auto prom = std::make_shared<std::promise<Ftp::Result>>();
+        auto future_result = prom->get_future();
+        auto first_bytes = std::make_shared<std::atomic<int64_t>>(-1);
+        ftp_client->download_async(
+            "test_resume/" + file_name,
+            ".",
+            [prom, first_bytes](Ftp::Result result, Ftp::ProgressData progress) {
+                if (result == Ftp::Result::Next) {
+                    int64_t unset = -1;
+                    first_bytes->compare_exchange_strong(unset, progress.bytes_transferred);
+                } else {
+                    prom->set_value(result);
+                }
+            });
+
+        ASSERT_EQ(future_result.wait_for(std::chrono::seconds(20)), std::future_status::ready);
+        EXPECT_EQ(future_result.get(), Ftp::Result::Success);
+        EXPECT_GT(*first_bytes, 0);
+    }
+    EXPECT_FALSE(std::ifstream(resume_path).good());
+
+    compare(ftp_client, file_name, "test_resume/" + file_name);
+
+    Ftp::Result result = test_remove_file(ftp_client, "test_resume/" + file_name);
+    EXPECT_EQ(result, Ftp::Result::Success);
+    result = test_remove_directory(ftp_client, "test_resume");
+    EXPECT_EQ(result, Ftp::Result::Success);
+    remove(file_name.c_str());
+}
@@ -17,12 +17,12 @@ protected:
 #ifndef WINDOWS
         const int ret = system((std::string("./tools/start_px4_sitl.sh ") + model).c_str());
         if (ret != 0) {
-            mavsdk::LogErr() << "./tools/start_px4_sitl.sh failed, giving up.";
+            LogErr() << "./tools/start_px4_sitl.sh failed, giving up.";
             abort();
         }
 #else
         UNUSED(model);
-        mavsdk::LogErr() << "Auto-starting SITL not supported on Windows.";
+        LogErr() << "Auto-starting SITL not supported on Windows.";
 #endif
     }
 
@@ -31,11 +31,11 @@ protected:
 #ifndef WINDOWS
         const int ret = system("./tools/stop_px4_sitl.sh");
         if (ret != 0) {
-            mavsdk::LogErr() << "./tools/stop_px4_sitl.sh failed, giving up.";
+            LogErr() << "./tools/stop_px4_sitl.sh failed, giving up.";
             abort();
         }
 #else
-        mavsdk::LogErr() << "Auto-starting SITL not supported on Windows.";
+        LogErr() << "Auto-starting SITL not supported on Windows.";
 #endif
     }
 
@@ -56,7 +56,7 @@ private:
             model_name = test_name.substr(pos + 1, test_name.length() - pos - 1);
         }
 
-        mavsdk::LogDebug() << "Model chosen: '" << model_name << "'";
+        LogDebug() << "Model chosen: '" << model_name << "'";
         return model_name;
     }
 };
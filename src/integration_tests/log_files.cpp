@@ -1,12 +1,146 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <future>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include "mavsdk.h"
 #include "integration_test_helper.h"
 #include "plugins/log_files/log_files.h"
+#include "plugins/mavlink_passthrough/mavlink_passthrough.h"
 
 using namespace mavsdk;
 
+// Acts as an autopilot with a single log, so that downloads can be tested
+// without SITL.
+class FakeLogServer {
+public:
+    FakeLogServer(int remote_port, const std::vector<uint8_t>& log) : _log(log)
+    {
+        _mavsdk.set_configuration(
+            Mavsdk::Configuration(Mavsdk::Configuration::UsageType::Autopilot));
+        EXPECT_EQ(_mavsdk.setup_udp_remote("127.0.0.1", remote_port), ConnectionResult::Success);
+        _passthrough = std::make_shared<MavlinkPassthrough>(_mavsdk.systems().at(0));
+
+        _passthrough->subscribe_message_async(
+            MAVLINK_MSG_ID_LOG_REQUEST_LIST, [this](const mavlink_message_t&) {
+                mavlink_message_t message;
+                mavlink_msg_log_entry_pack(
+                    _passthrough->get_our_sysid(),
+                    _passthrough->get_our_compid(),
+                    &message,
+                    0,
+                    1,
+                    0,
+                    1600000000,
+                    static_cast<uint32_t>(_log.size()));
+                _passthrough->send_message(message);
+            });
+
+        _passthrough->subscribe_message_async(
+            MAVLINK_MSG_ID_LOG_REQUEST_DATA,
+            [this](const mavlink_message_t& request) { send_data(request); });
+    }
+
+    // Requests at or past this offset are not answered anymore.
+    void serve_up_to(uint32_t offset) { _serve_up_to = offset; }
+
+    uint32_t lowest_offset_requested() const { return _lowest_offset_requested; }
+
+    void reset_lowest_offset_requested() { _lowest_offset_requested = UINT32_MAX; }
+
+private:
+    void send_data(const mavlink_message_t& request)
+    {
+        mavlink_log_request_data_t log_request_data;
+        mavlink_msg_log_request_data_decode(&request, &log_request_data);
+
+        if (log_request_data.ofs < _lowest_offset_requested) {
+            _lowest_offset_requested = log_request_data.ofs;
+        }
+
+        const uint32_t end = std::min(
+            uint32_t(_log.size()), log_request_data.ofs + log_request_data.count);
+        for (uint32_t ofs = log_request_data.ofs; ofs < end && ofs < _serve_up_to;
+             ofs += MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) {
+            const auto count = static_cast<uint8_t>(
+                std::min(end - ofs, uint32_t(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN)));
+            mavlink_message_t message;
+            mavlink_msg_log_data_pack(
+                _passthrough->get_our_sysid(),
+                _passthrough->get_our_compid(),
+                &message,
+                0,
+                ofs,
+                count,
+                &_log[ofs]);
+            _passthrough->send_message(message);
+        }
+    }
+
+    const std::vector<uint8_t> _log;
+    std::atomic<uint32_t> _serve_up_to{UINT32_MAX};
+    std::atomic<uint32_t> _lowest_offset_requested{UINT32_MAX};
+    Mavsdk _mavsdk{};
+    std::shared_ptr<MavlinkPassthrough> _passthrough{};
+};
+
+static std::vector<uint8_t> make_log(size_t size)
+{
+    std::vector<uint8_t> log(size);
+    for (size_t i = 0; i < size; ++i) {
+        log[i] = static_cast<uint8_t>(i * 7 % 251);
+    }
+    return log;
+}
+
+static std::shared_ptr<System> wait_for_autopilot(Mavsdk& mavsdk)
+{
+    for (unsigned i = 0; i < 50; ++i) {
+        for (auto& system : mavsdk.systems()) {
+            if (system->has_autopilot()) {
+                return system;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return nullptr;
+}
+
+// Returns the final result of the download, or Unknown if it takes too long.
+static LogFiles::Result
+download(LogFiles& log_files, unsigned id, const std::string& path, float* first_progress)
+{
+    auto prom = std::make_shared<std::promise<LogFiles::Result>>();
+    auto fut = prom->get_future();
+    auto got_progress = std::make_shared<bool>(false);
+
+    log_files.download_log_file_async(
+        id,
+        path,
+        [prom, got_progress, first_progress](
+            LogFiles::Result result, LogFiles::ProgressData progress_data) {
+            if (result == LogFiles::Result::Next) {
+                if (!*got_progress && first_progress != nullptr) {
+                    *first_progress = progress_data.progress;
+                }
+                *got_progress = true;
+            } else {
+                prom->set_value(result);
+            }
+        });
+
+    if (fut.wait_for(std::chrono::seconds(20)) != std::future_status::ready) {
+        return LogFiles::Result::Unknown;
+    }
+    return fut.get();
+}
+
 TEST(HardwareTest, LogFiles)
 {
     Mavsdk mavsdk;
@@ -60,3 +194,84 @@ TEST(HardwareTest, LogFiles)
         }
     }
 }
+
+#if defined(LINUX)
+TEST(LogFilesTest, DownloadFailsIfItCannotBeWritten)
+{
+    FakeLogServer server(24560, make_log(100000));
+
+    Mavsdk mavsdk;
+    ASSERT_EQ(mavsdk.add_udp_connection(24560), ConnectionResult::Success);
+    auto system = wait_for_autopilot(mavsdk);
+    ASSERT_TRUE(system);
+    auto log_files = std::make_shared<LogFiles>(system);
+
+    const auto entries = log_files->get_entries();
+    ASSERT_EQ(entries.first, LogFiles::Result::Success);
+    ASSERT_EQ(entries.second.size(), 1u);
+
+    // Every write to /dev/full fails, like on a full disk. The download has
+    // to give up instead of asking for the same part over and over again.
+    EXPECT_EQ(download(*log_files, 0, "/dev/full", nullptr), LogFiles::Result::FileOpenFailed);
+}
+#endif
+
+#if defined(LINUX)
+TEST(LogFilesTest, DownloadResumesAfterInterruption)
+{
+    const auto log = make_log(200000);
+    FakeLogServer server(24561, log);
+    server.serve_up_to(100000);
+
+    Mavsdk mavsdk;
+    ASSERT_EQ(mavsdk.add_udp_connection(24561), ConnectionResult::Success);
+    auto system = wait_for_autopilot(mavsdk);
+    ASSERT_TRUE(system);
+
+    const std::string path = "/tmp/mavsdk_resumed_log.ulog";
+    const std::string resume_path = path + ".resume";
+    std::remove(path.c_str());
+    std::remove(resume_path.c_str());
+
+    {
+        auto log_files = std::make_shared<LogFiles>(system);
+        ASSERT_EQ(log_files->get_entries().first, LogFiles::Result::Success);
+
+        auto prom = std::make_shared<std::promise<void>>();
+        auto fut = prom->get_future();
+        auto halfway = std::make_shared<std::atomic<bool>>(false);
+
+        log_files->download_log_file_async(
+            0, path, [prom, halfway](LogFiles::Result result, LogFiles::ProgressData progress) {
+                if (result == LogFiles::Result::Next && progress.progress >= 0.4f &&
+                    !halfway->exchange(true)) {
+                    prom->set_value();
+                }
+            });
+
+        // The server stops answering in the middle, so the download gets stuck.
+        ASSERT_EQ(fut.wait_for(std::chrono::seconds(20)), std::future_status::ready);
+    }
+    // Destroying the plugin has to keep what was downloaded so far.
+    EXPECT_TRUE(std::ifstream(resume_path).good());
+
+    server.serve_up_to(UINT32_MAX);
+    server.reset_lowest_offset_requested();
+
+    auto log_files = std::make_shared<LogFiles>(system);
+    ASSERT_EQ(log_files->get_entries().first, LogFiles::Result::Success);
+
+    float first_progress = 0.0f;
+    EXPECT_EQ(download(*log_files, 0, path, &first_progress), LogFiles::Result::Success);
+    EXPECT_GT(first_progress, 0.0f);
+    EXPECT_GT(server.lowest_offset_requested(), 0u);
+
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<uint8_t> downloaded(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(downloaded, log);
+    EXPECT_FALSE(std::ifstream(resume_path).good());
+
+    std::remove(path.c_str());
+}
+#endif
@@ -1,33 +1,393 @@
 #include "global_include.h"
 #include "log.h"
 #include "camera_definition.h"
+#include <cstring>
+#include <limits>
 
 namespace mavsdk {
 
+namespace {
+
+// Format of the binary camera definition, bump this when it changes.
+constexpr uint16_t binary_format_version = 1;
+constexpr char binary_magic[4] = {'M', 'C', 'D', 'B'};
+
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::string& out) : _out(out) {}
+
+    void u8(uint8_t value) { _out.push_back(static_cast<char>(value)); }
+
+    void u16(uint16_t value)
+    {
+        u8(static_cast<uint8_t>(value));
+        u8(static_cast<uint8_t>(value >> 8));
+    }
+
+    void u32(uint32_t value)
+    {
+        u16(static_cast<uint16_t>(value));
+        u16(static_cast<uint16_t>(value >> 16));
+    }
+
+    void u64(uint64_t value)
+    {
+        u32(static_cast<uint32_t>(value));
+        u32(static_cast<uint32_t>(value >> 32));
+    }
+
+    void str(const std::string& value)
+    {
+        u32(static_cast<uint32_t>(value.size()));
+        _out.append(value);
+    }
+
+    void value(const MAVLinkParameters::ParamValue& value)
+    {
+        // The tag is the index into the types supported by ParamValue.
+        if (value.is<uint8_t>()) {
+            u8(0);
+            u64(value.get<uint8_t>());
+        } else if (value.is<int8_t>()) {
+            u8(1);
+            u64(static_cast<uint64_t>(static_cast<int64_t>(value.get<int8_t>())));
+        } else if (value.is<uint16_t>()) {
+            u8(2);
+            u64(value.get<uint16_t>());
+        } else if (value.is<int16_t>()) {
+            u8(3);
+            u64(static_cast<uint64_t>(static_cast<int64_t>(value.get<int16_t>())));
+        } else if (value.is<uint32_t>()) {
+            u8(4);
+            u64(value.get<uint32_t>());
+        } else if (value.is<int32_t>()) {
+            u8(5);
+            u64(static_cast<uint64_t>(static_cast<int64_t>(value.get<int32_t>())));
+        } else if (value.is<uint64_t>()) {
+            u8(6);
+            u64(value.get<uint64_t>());
+        } else if (value.is<int64_t>()) {
+            u8(7);
+            u64(static_cast<uint64_t>(value.get<int64_t>()));
+        } else if (value.is<float>()) {
+            u8(8);
+            const float temp = value.get<float>();
+            uint32_t bits;
+            memcpy(&bits, &temp, sizeof(bits));
+            u64(bits);
+        } else {
+            u8(9);
+            const double temp = value.get<double>();
+            uint64_t bits;
+            memcpy(&bits, &temp, sizeof(bits));
+            u64(bits);
+        }
+    }
+
+private:
+    std::string& _out;
+};
+
+class BinaryReader {
+public:
+    explicit BinaryReader(const std::string& in) : _in(in) {}
+
+    bool ok() const { return _ok; }
+    bool at_end() const { return _pos == _in.size(); }
+
+    uint8_t u8()
+    {
+        if (_pos >= _in.size()) {
+            _ok = false;
+            return 0;
+        }
+        return static_cast<uint8_t>(_in[_pos++]);
+    }
+
+    uint16_t u16()
+    {
+        const uint16_t low = u8();
+        return static_cast<uint16_t>(low | (u8() << 8));
+    }
+
+    uint32_t u32()
+    {
+        const uint32_t low = u16();
+        return low | (static_cast<uint32_t>(u16()) << 16);
+    }
+
+    uint64_t u64()
+    {
+        const uint64_t low = u32();
+        return low | (static_cast<uint64_t>(u32()) << 32);
+    }
+
+    std::string str()
+    {
+        const uint32_t len = u32();
+        if (!_ok || len > _in.size() - _pos) {
+            _ok = false;
+            return {};
+        }
+        std::string result = _in.substr(_pos, len);
+        _pos += len;
+        return result;
+    }
+
+    // Reads a count of elements which each take at least min_element_size bytes.
+    uint32_t count(std::size_t min_element_size = 1)
+    {
+        const uint32_t result = u32();
+        if (!_ok || result > (_in.size() - _pos) / min_element_size) {
+            _ok = false;
+            return 0;
+        }
+        return result;
+    }
+
+    MAVLinkParameters::ParamValue value()
+    {
+        MAVLinkParameters::ParamValue result;
+        const uint8_t tag = u8();
+        const uint64_t raw = u64();
+        switch (tag) {
+            case 0:
+                result.set(static_cast<uint8_t>(raw));
+                break;
+            case 1:
+                result.set(static_cast<int8_t>(raw));
+                break;
+            case 2:
+                result.set(static_cast<uint16_t>(raw));
+                break;
+            case 3:
+                result.set(static_cast<int16_t>(raw));
+                break;
+            case 4:
+                result.set(static_cast<uint32_t>(raw));
+                break;
+            case 5:
+                result.set(static_cast<int32_t>(raw));
+                break;
+            case 6:
+                result.set(raw);
+                break;
+            case 7:
+                result.set(static_cast<int64_t>(raw));
+                break;
+            case 8: {
+                const uint32_t bits = static_cast<uint32_t>(raw);
+                float temp;
+                memcpy(&temp, &bits, sizeof(temp));
+                result.set(temp);
+                break;
+            }
+            case 9: {
+                double temp;
+                memcpy(&temp, &raw, sizeof(temp));
+                result.set(temp);
+                break;
+            }
+            default:
+                _ok = false;
+                break;
+        }
+        return result;
+    }
+
+private:
+    const std::string& _in;
+    std::size_t _pos{0};
+    bool _ok{true};
+};
+
+} // namespace
+
 CameraDefinition::CameraDefinition() {}
 
 CameraDefinition::~CameraDefinition() {}
 
 bool CameraDefinition::load_file(const std::string& filepath)
 {
-    tinyxml2::XMLError xml_error = _doc.LoadFile(filepath.c_str());
+    tinyxml2::XMLDocument doc;
+    tinyxml2::XMLError xml_error = doc.LoadFile(filepath.c_str());
     if (xml_error != tinyxml2::XML_SUCCESS) {
-        LogErr() << "tinyxml2::LoadFile failed: " << _doc.ErrorStr();
+        LogErr() << "tinyxml2::LoadFile failed: " << doc.ErrorStr();
         return false;
     }
 
-    return parse_xml();
+    return parse_xml(doc);
 }
 
 bool CameraDefinition::load_string(const std::string& content)
 {
-    tinyxml2::XMLError xml_error = _doc.Parse(content.c_str());
+    tinyxml2::XMLDocument doc;
+    tinyxml2::XMLError xml_error = doc.Parse(content.c_str());
     if (xml_error != tinyxml2::XML_SUCCESS) {
-        LogErr() << "tinyxml2::Parse failed: " << _doc.ErrorStr();
+        LogErr() << "tinyxml2::Parse failed: " << doc.ErrorStr();
+        return false;
+    }
+
+    return parse_xml(doc);
+}
+
+bool CameraDefinition::save_binary(std::string& content) const
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    content.clear();
+    BinaryWriter writer(content);
+
+    content.append(binary_magic, sizeof(binary_magic));
+    writer.u16(binary_format_version);
+    writer.str(_vendor);
+    writer.str(_model);
+
+    auto write_option = [&writer](const Option& option) {
+        writer.str(option.name);
+        writer.value(option.value);
+        writer.u32(static_cast<uint32_t>(option.exclusions.size()));
+        for (const auto exclusion : option.exclusions) {
+            writer.u16(exclusion);
+        }
+        writer.u32(static_cast<uint32_t>(option.parameter_ranges.size()));
+        for (const auto& range : option.parameter_ranges) {
+            writer.u16(range.first);
+            writer.u32(static_cast<uint32_t>(range.second.size()));
+            for (const auto& value : range.second) {
+                writer.value(value);
+            }
+        }
+    };
+
+    writer.u32(static_cast<uint32_t>(_parameters.size()));
+    for (const auto& parameter : _parameters) {
+        writer.str(parameter.name);
+        writer.str(parameter.description);
+        writer.u8(
+            (parameter.is_control ? 1 : 0) | (parameter.is_readonly ? 2 : 0) |
+            (parameter.is_writeonly ? 4 : 0) | (parameter.is_range ? 8 : 0));
+        writer.value(parameter.type);
+        writer.u32(static_cast<uint32_t>(parameter.updates.size()));
+        for (const auto update : parameter.updates) {
+            writer.u16(update);
+        }
+        writer.u32(static_cast<uint32_t>(parameter.options.size()));
+        for (const auto& option : parameter.options) {
+            write_option(option);
+        }
+        write_option(parameter.default_option);
+    }
+
+    return true;
+}
+
+bool CameraDefinition::load_binary(const std::string& content)
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    clear();
+
+    if (content.size() < sizeof(binary_magic) ||
+        content.compare(0, sizeof(binary_magic), binary_magic, sizeof(binary_magic)) != 0) {
+        LogErr() << "Not a binary camera definition";
+        return false;
+    }
+
+    BinaryReader reader(content);
+    for (std::size_t i = 0; i < sizeof(binary_magic); ++i) {
+        reader.u8();
+    }
+
+    if (reader.u16() != binary_format_version) {
+        LogWarn() << "Binary camera definition has a different format version";
+        return false;
+    }
+
+    _vendor = reader.str();
+    _model = reader.str();
+
+    const uint32_t num_parameters = reader.count();
+    if (num_parameters > std::numeric_limits<setting_id_t>::max()) {
+        LogErr() << "Too many parameters in binary camera definition";
+        clear();
+        return false;
+    }
+
+    bool ids_valid = true;
+    auto read_id = [&reader, &ids_valid, num_parameters]() {
+        const setting_id_t id = reader.u16();
+        if (id >= num_parameters) {
+            ids_valid = false;
+        }
+        return id;
+    };
+
+    auto read_option = [&reader, &read_id](Option& option) {
+        option.name = reader.str();
+        option.value = reader.value();
+        option.exclusions.resize(reader.count(2));
+        for (auto& exclusion : option.exclusions) {
+            exclusion = read_id();
+        }
+        option.parameter_ranges.resize(reader.count(6));
+        for (auto& range : option.parameter_ranges) {
+            range.first = read_id();
+            range.second.resize(reader.count(9));
+            for (auto& value : range.second) {
+                value = reader.value();
+            }
+        }
+    };
+
+    _parameters.resize(num_parameters);
+    for (setting_id_t id = 0; id < num_parameters && reader.ok(); ++id) {
+        auto& parameter = _parameters[id];
+        parameter.name = reader.str();
+        parameter.description = reader.str();
+        const uint8_t flags = reader.u8();
+        parameter.is_control = (flags & 1) != 0;
+        parameter.is_readonly = (flags & 2) != 0;
+        parameter.is_writeonly = (flags & 4) != 0;
+        parameter.is_range = (flags & 8) != 0;
+        parameter.type = reader.value();
+        parameter.updates.resize(reader.count(2));
+        for (auto& update : parameter.updates) {
+            update = read_id();
+        }
+        parameter.options.resize(reader.count());
+        for (auto& option : parameter.options) {
+            read_option(option);
+        }
+        read_option(parameter.default_option);
+
+        _setting_ids[parameter.name] = id;
+    }
+
+    if (!reader.ok() || !reader.at_end() || !ids_valid ||
+        _setting_ids.size() != _parameters.size()) {
+        LogErr() << "Invalid binary camera definition";
+        clear();
         return false;
     }
 
-    return parse_xml();
+    _current_settings.assign(_parameters.size(), InternalCurrentSetting{});
+    for (auto& current_setting : _current_settings) {
+        current_setting.needs_updating = true;
+    }
+
+    return true;
+}
+
+void CameraDefinition::clear()
+{
+    // Assumes to have the lock for _mutex.
+
+    _parameters.clear();
+    _setting_ids.clear();
+    _current_settings.clear();
+    _model.clear();
+    _vendor.clear();
 }
 
 std::string CameraDefinition::get_model() const
@@ -44,11 +404,13 @@ std::string CameraDefinition::get_vendor() const
     return _vendor;
 }
 
-bool CameraDefinition::parse_xml()
+bool CameraDefinition::parse_xml(const tinyxml2::XMLDocument& doc)
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
-    auto e_mavlinkcamera = _doc.FirstChildElement("mavlinkcamera");
+    clear();
+
+    auto e_mavlinkcamera = doc.FirstChildElement("mavlinkcamera");
     if (!e_mavlinkcamera) {
         LogErr() << "Tag mavlinkcamera not found";
         return false;
@@ -83,6 +445,7 @@ bool CameraDefinition::parse_xml()
     }
 
     std::unordered_map<std::string, std::string> type_map{};
+    std::unordered_map<std::string, setting_id_t> xml_ids{};
     // We need all types first.
     for (auto e_parameter = e_parameters->FirstChildElement("parameter"); e_parameter != nullptr;
          e_parameter = e_parameter->NextSiblingElement("parameter")) {
@@ -99,11 +462,21 @@ bool CameraDefinition::parse_xml()
         }
 
         type_map[param_name] = type_str;
+        xml_ids.emplace(param_name, static_cast<setting_id_t>(xml_ids.size()));
+    }
+
+    if (xml_ids.size() > std::numeric_limits<setting_id_t>::max()) {
+        LogErr() << "Too many parameters";
+        return false;
     }
 
+    // Parsed parameters refer to each other using their position in the XML
+    // until we know which ones we actually keep.
+    std::vector<std::pair<setting_id_t, Parameter>> parsed{};
+
     for (auto e_parameter = e_parameters->FirstChildElement("parameter"); e_parameter != nullptr;
          e_parameter = e_parameter->NextSiblingElement("parameter")) {
-        auto new_parameter = std::make_shared<Parameter>();
+        Parameter new_parameter{};
 
         const char* param_name = e_parameter->Attribute("name");
         if (!param_name) {
@@ -127,44 +500,44 @@ bool CameraDefinition::parse_xml()
             continue;
         }
 
-        if (!new_parameter->type.set_empty_type_from_xml(type_str)) {
+        if (!new_parameter.type.set_empty_type_from_xml(type_str)) {
             LogErr() << "unknown type attribute";
             return false;
         }
 
         // By default control is on.
-        new_parameter->is_control = true;
+        new_parameter.is_control = true;
         const char* control_str = e_parameter->Attribute("control");
         if (control_str) {
             if (strcmp(control_str, "0") == 0) {
-                new_parameter->is_control = false;
+                new_parameter.is_control = false;
             }
         }
 
-        new_parameter->is_readonly = false;
+        new_parameter.is_readonly = false;
         const char* readonly_str = e_parameter->Attribute("readonly");
         if (readonly_str) {
             if (strcmp(readonly_str, "1") == 0) {
-                new_parameter->is_readonly = true;
+                new_parameter.is_readonly = true;
             }
         }
 
-        new_parameter->is_writeonly = false;
+        new_parameter.is_writeonly = false;
         const char* writeonly_str = e_parameter->Attribute("writeonly");
         if (writeonly_str) {
             if (strcmp(writeonly_str, "1") == 0) {
-                new_parameter->is_writeonly = true;
+                new_parameter.is_writeonly = true;
             }
         }
 
-        if (new_parameter->is_readonly && new_parameter->is_writeonly) {
+        if (new_parameter.is_readonly && new_parameter.is_writeonly) {
             LogErr() << "parameter can't be readonly and writeonly";
             return false;
         }
 
         // Be definition custom types do not have control.
         if (strcmp(type_map[param_name].c_str(), "custom") == 0) {
-            new_parameter->is_control = false;
+            new_parameter.is_control = false;
         }
 
         auto e_description = e_parameter->FirstChildElement("description");
@@ -173,13 +546,14 @@ bool CameraDefinition::parse_xml()
             return false;
         }
 
-        new_parameter->description = e_description->GetText();
+        new_parameter.name = param_name;
+        new_parameter.description = e_description->GetText();
 
-        // LogDebug() << "Found: " << new_parameter->description
+        // LogDebug() << "Found: " << new_parameter.description
         //            << " (" << param_name
-        //            << ", control: " << (new_parameter->is_control ? "yes" : "no")
-        //            << ", readonly: " << (new_parameter->is_readonly ? "yes" : "no")
-        //            << ", writeonly: " << (new_parameter->is_writeonly ? "yes" : "no")
+        //            << ", control: " << (new_parameter.is_control ? "yes" : "no")
+        //            << ", readonly: " << (new_parameter.is_readonly ? "yes" : "no")
+        //            << ", writeonly: " << (new_parameter.is_writeonly ? "yes" : "no")
         //            << ")";
 
         auto e_updates = e_parameter->FirstChildElement("updates");
@@ -187,7 +561,10 @@ bool CameraDefinition::parse_xml()
             for (auto e_update = e_updates->FirstChildElement("update"); e_update != nullptr;
                  e_update = e_update->NextSiblingElement("update")) {
                 // LogDebug() << "Updates: " << e_update->GetText();
-                new_parameter->updates.push_back(e_update->GetText());
+                const auto it = xml_ids.find(e_update->GetText());
+                if (it != xml_ids.end()) {
+                    new_parameter.updates.push_back(it->second);
+                }
             }
         }
 
@@ -199,20 +576,20 @@ bool CameraDefinition::parse_xml()
 
         auto e_options = e_parameter->FirstChildElement("options");
         if (e_options) {
-            auto maybe_options = parse_options(e_options, param_name, type_map);
+            auto maybe_options = parse_options(e_options, param_name, type_map, xml_ids);
             if (!maybe_options.first) {
                 continue;
             }
-            new_parameter->options = maybe_options.second;
+            new_parameter.options = maybe_options.second;
 
-            auto maybe_default = find_default(new_parameter->options, default_str);
+            auto maybe_default = find_default(new_parameter.options, default_str);
 
             if (!maybe_default.first) {
                 LogWarn() << "Default not found for " << param_name;
                 return false;
             }
 
-            new_parameter->default_option = maybe_default.second;
+            new_parameter.default_option = maybe_default.second;
 
         } else {
             auto maybe_range_options = parse_range_options(e_parameter, param_name, type_map);
@@ -221,28 +598,75 @@ bool CameraDefinition::parse_xml()
                 continue;
             }
 
-            new_parameter->options = std::get<1>(maybe_range_options);
-            new_parameter->is_range = true;
-            new_parameter->default_option = std::get<2>(maybe_range_options);
+            new_parameter.options = std::get<1>(maybe_range_options);
+            new_parameter.is_range = true;
+            new_parameter.default_option = std::get<2>(maybe_range_options);
         }
 
-        _parameter_map[param_name] = new_parameter;
+        parsed.emplace_back(xml_ids[param_name], std::move(new_parameter));
+    }
+
+    // Now assign the final setting ids and translate all references to them,
+    // dropping references to parameters that we skipped.
+    constexpr setting_id_t no_id = std::numeric_limits<setting_id_t>::max();
+    std::vector<setting_id_t> final_ids(xml_ids.size(), no_id);
 
-        InternalCurrentSetting empty_setting{};
-        empty_setting.needs_updating = true;
-        _current_settings[param_name] = empty_setting;
+    for (auto& entry : parsed) {
+        const auto it = _setting_ids.find(entry.second.name);
+        if (it != _setting_ids.end()) {
+            // A parameter defined twice replaces the earlier one.
+            _parameters[it->second] = std::move(entry.second);
+        } else {
+            final_ids[entry.first] = static_cast<setting_id_t>(_parameters.size());
+            _setting_ids[entry.second.name] = final_ids[entry.first];
+            _parameters.push_back(std::move(entry.second));
+        }
+    }
+
+    auto translate_ids = [&final_ids, no_id](std::vector<setting_id_t>& ids) {
+        std::vector<setting_id_t> translated{};
+        for (const auto id : ids) {
+            if (final_ids[id] != no_id) {
+                translated.push_back(final_ids[id]);
+            }
+        }
+        ids = translated;
+    };
+
+    auto translate_option = [&final_ids, no_id, &translate_ids](Option& option) {
+        translate_ids(option.exclusions);
+        decltype(option.parameter_ranges) translated{};
+        for (auto& range : option.parameter_ranges) {
+            if (final_ids[range.first] != no_id) {
+                translated.emplace_back(final_ids[range.first], std::move(range.second));
+            }
+        }
+        option.parameter_ranges = translated;
+    };
+
+    for (auto& parameter : _parameters) {
+        translate_ids(parameter.updates);
+        for (auto& option : parameter.options) {
+            translate_option(option);
+        }
+        translate_option(parameter.default_option);
+    }
+
+    _current_settings.assign(_parameters.size(), InternalCurrentSetting{});
+    for (auto& current_setting : _current_settings) {
+        current_setting.needs_updating = true;
     }
 
     return true;
 }
 
-std::pair<bool, std::vector<std::shared_ptr<CameraDefinition::Option>>>
-CameraDefinition::parse_options(
+std::pair<bool, std::vector<CameraDefinition::Option>> CameraDefinition::parse_options(
     const tinyxml2::XMLElement* options_handle,
     const std::string& param_name,
-    std::unordered_map<std::string, std::string>& type_map)
+    std::unordered_map<std::string, std::string>& type_map,
+    const std::unordered_map<std::string, setting_id_t>& xml_ids)
 {
-    std::vector<std::shared_ptr<Option>> options{};
+    std::vector<Option> options{};
 
     for (auto e_option = options_handle->FirstChildElement("option"); e_option != nullptr;
          e_option = e_option->NextSiblingElement("option")) {
@@ -258,11 +682,11 @@ CameraDefinition::parse_options(
             return std::make_pair<>(false, options);
         }
 
-        auto new_option = std::make_shared<Option>();
+        Option new_option{};
 
-        new_option->name = option_name;
+        new_option.name = option_name;
 
-        new_option->value.set_from_xml(type_map[param_name], option_value);
+        new_option.value.set_from_xml(type_map[param_name], option_value);
 
         // LogDebug() << "Type: " << type_map[param_name] << ", name: " << option_name;
 
@@ -271,7 +695,10 @@ CameraDefinition::parse_options(
             for (auto e_exclude = e_exclusions->FirstChildElement("exclude"); e_exclude != nullptr;
                  e_exclude = e_exclude->NextSiblingElement("exclude")) {
                 // LogDebug() << "Exclude: " << e_exclude->GetText();
-                new_option->exclusions.push_back(e_exclude->GetText());
+                const auto it = xml_ids.find(e_exclude->GetText());
+                if (it != xml_ids.end()) {
+                    new_option.exclusions.push_back(it->second);
+                }
             }
         }
 
@@ -286,7 +713,7 @@ CameraDefinition::parse_options(
                     return std::make_pair<>(false, options);
                 }
 
-                parameter_range_t new_parameter_range;
+                std::vector<MAVLinkParameters::ParamValue> new_parameter_range;
 
                 for (auto e_roption = e_parameterrange->FirstChildElement("roption");
                      e_roption != nullptr;
@@ -311,7 +738,7 @@ CameraDefinition::parse_options(
                     MAVLinkParameters::ParamValue new_param_value;
                     new_param_value.set_from_xml(
                         type_map[roption_parameter_str], roption_value_str);
-                    new_parameter_range[roption_name_str] = new_param_value;
+                    new_parameter_range.push_back(new_param_value);
 
                     // LogDebug() << "range option: "
                     //            << roption_name_str
@@ -320,7 +747,10 @@ CameraDefinition::parse_options(
                     //            << " (" << new_param_value.typestr() << ")";
                 }
 
-                new_option->parameter_ranges[roption_parameter_str] = new_parameter_range;
+                const auto it = xml_ids.find(roption_parameter_str);
+                if (it != xml_ids.end()) {
+                    new_option.parameter_ranges.emplace_back(it->second, new_parameter_range);
+                }
 
                 // LogDebug() << "adding to: " << roption_parameter_str;
             }
@@ -331,13 +761,13 @@ CameraDefinition::parse_options(
     return std::make_pair<>(true, options);
 }
 
-std::tuple<bool, std::vector<std::shared_ptr<CameraDefinition::Option>>, CameraDefinition::Option>
+std::tuple<bool, std::vector<CameraDefinition::Option>, CameraDefinition::Option>
 CameraDefinition::parse_range_options(
     const tinyxml2::XMLElement* param_handle,
     const std::string& param_name,
     std::unordered_map<std::string, std::string>& type_map)
 {
-    std::vector<std::shared_ptr<Option>> options{};
+    std::vector<Option> options{};
     Option default_option{};
 
     const char* min_str = param_handle->Attribute("min");
@@ -355,16 +785,16 @@ CameraDefinition::parse_range_options(
         return std::make_tuple<>(false, options, default_option);
     }
 
-    auto min_option = std::make_shared<Option>();
-    min_option->name = "min";
-    min_option->value = min_value;
+    Option min_option{};
+    min_option.name = "min";
+    min_option.value = min_value;
 
     MAVLinkParameters::ParamValue max_value;
     max_value.set_from_xml(type_map[param_name], max_str);
 
-    auto max_option = std::make_shared<Option>();
-    max_option->name = "max";
-    max_option->value = max_value;
+    Option max_option{};
+    max_option.name = "max";
+    max_option.value = max_value;
 
     const char* step_str = param_handle->Attribute("step");
     if (!step_str) {
@@ -375,9 +805,9 @@ CameraDefinition::parse_range_options(
         MAVLinkParameters::ParamValue step_value;
         step_value.set_from_xml(type_map[param_name], step_str);
 
-        auto step_option = std::make_shared<Option>();
-        step_option->name = "step";
-        step_option->value = step_value;
+        Option step_option{};
+        step_option.name = "step";
+        step_option.value = step_value;
 
         options.push_back(min_option);
         options.push_back(max_option);
@@ -402,16 +832,16 @@ CameraDefinition::parse_range_options(
     return std::make_tuple<>(true, options, default_option);
 }
 
-std::pair<bool, CameraDefinition::Option> CameraDefinition::find_default(
-    const std::vector<std::shared_ptr<Option>>& options, const std::string& default_str)
+std::pair<bool, CameraDefinition::Option>
+CameraDefinition::find_default(const std::vector<Option>& options, const std::string& default_str)
 {
     Option default_option{};
 
     bool found_default = false;
     for (auto& option : options) {
-        if (option->value == default_str) {
+        if (option.value == default_str) {
             if (!found_default) {
-                default_option = *option;
+                default_option = option;
                 found_default = true;
             } else {
                 LogErr() << "Found more than one default";
@@ -426,37 +856,49 @@ std::pair<bool, CameraDefinition::Option> CameraDefinition::find_default(
     return std::make_pair<>(true, default_option);
 }
 
-void CameraDefinition::assume_default_settings()
+bool CameraDefinition::find_setting(const std::string& name, setting_id_t& id) const
 {
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    const auto it = _setting_ids.find(name);
+    if (it == _setting_ids.end()) {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
 
-    _current_settings.clear();
+std::vector<bool> CameraDefinition::find_exclusions() const
+{
+    std::vector<bool> exclusions(_parameters.size(), false);
 
-    for (const auto& parameter : _parameter_map) {
-        // if (parameter.second->is_range) {
+    for (setting_id_t id = 0; id < _parameters.size(); ++id) {
+        if (_current_settings[id].needs_updating) {
+            continue;
+        }
+        for (const auto& option : _parameters[id].options) {
+            if (_current_settings[id].value == option.value) {
+                for (const auto exclusion : option.exclusions) {
+                    exclusions[exclusion] = true;
+                }
+            }
+        }
+    }
 
-        InternalCurrentSetting new_setting;
-        new_setting.value = parameter.second->default_option.value;
-        new_setting.needs_updating = false;
-        _current_settings[parameter.first] = new_setting;
+    return exclusions;
+}
 
-        //} else {
+bool CameraDefinition::is_possible_setting(
+    setting_id_t id, const std::vector<bool>& exclusions) const
+{
+    return _parameters[id].is_control && !exclusions[id];
+}
 
-        //    for (const auto &option : parameter.second->options) {
-        //        if (!option->is_default) {
-        //            //LogDebug() << option->name << " not default";
-        //            continue;
-        //        }
-        //        //LogDebug() << option->name << " default value: " << option->value << " (type: "
-        //        <<
-        //        // option->value.typestr() << ")";
+void CameraDefinition::assume_default_settings()
+{
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
 
-        //        InternalCurrentSetting new_setting;
-        //        new_setting.value = option->value;
-        //        new_setting.needs_updating = false;
-        //        _current_settings[parameter.first] = new_setting;
-        //    }
-        //}
+    for (setting_id_t id = 0; id < _parameters.size(); ++id) {
+        _current_settings[id].value = _parameters[id].default_option.value;
+        _current_settings[id].needs_updating = false;
     }
 }
 
@@ -466,8 +908,8 @@ bool CameraDefinition::get_all_settings(
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
     settings.clear();
-    for (const auto& current_setting : _current_settings) {
-        settings[current_setting.first] = current_setting.second.value;
+    for (setting_id_t id = 0; id < _parameters.size(); ++id) {
+        settings[_parameters[id].name] = _current_settings[id].value;
     }
 
     return (settings.size() > 0);
@@ -480,40 +922,13 @@ bool CameraDefinition::get_possible_settings(
 
     settings.clear();
 
-    // Find all exclusions
-    // TODO: use set instead of vector
-    std::vector<std::string> exclusions{};
-
-    for (const auto& parameter : _parameter_map) {
-        for (const auto& option : parameter.second->options) {
-            if (_current_settings[parameter.first].needs_updating) {
-                continue;
-            }
-            if (_current_settings[parameter.first].value == option->value) {
-                for (const auto& exclusion : option->exclusions) {
-                    // LogDebug() << "found exclusion for " << parameter.first
-                    //            << "(" << option->value << "): " << exclusion;
-                    exclusions.push_back(exclusion);
-                }
-            }
-        }
-    }
-
-    for (const auto& setting : _current_settings) {
-        bool excluded = false;
-        for (const auto& exclusion : exclusions) {
-            if (setting.first == exclusion) {
-                excluded = true;
-            }
-        }
-        if (!_parameter_map[setting.first]->is_control) {
-            continue;
-        }
+    const auto exclusions = find_exclusions();
 
-        if (excluded) {
+    for (setting_id_t id = 0; id < _parameters.size(); ++id) {
+        if (!is_possible_setting(id, exclusions)) {
             continue;
         }
-        settings[setting.first] = setting.second.value;
+        settings[_parameters[id].name] = _current_settings[id].value;
     }
 
     return (settings.size() > 0);
@@ -524,20 +939,23 @@ bool CameraDefinition::set_setting(
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    setting_id_t id;
+    if (!find_setting(name, id)) {
         LogErr() << "Unknown setting to set";
         return false;
     }
 
+    const auto& parameter = _parameters[id];
+
     // For range params, we need to verify the range.
-    if (_parameter_map[name]->is_range) {
+    if (parameter.is_range) {
         // Check against the minimum
-        if (value < _parameter_map[name]->options[0]->value) {
+        if (value < parameter.options[0].value) {
             LogErr() << "Chosen value smaller than minimum";
             return false;
         }
 
-        if (value > _parameter_map[name]->options[1]->value) {
+        if (value > parameter.options[1].value) {
             LogErr() << "Chosen value bigger than maximum";
             return false;
         }
@@ -545,17 +963,13 @@ bool CameraDefinition::set_setting(
         // TODO: Check step as well, until now we have only seen steps of 1 in the wild though.
     }
 
-    _current_settings[name].value = value;
-    _current_settings[name].needs_updating = false;
+    _current_settings[id].value = value;
+    _current_settings[id].needs_updating = false;
 
     // Some param changes cause other params to change, so they need to be updated.
     // The camera definition just keeps track of these params but the actual param fetching
     // needs to happen outside of this class.
-    for (const auto& update : _parameter_map[name]->updates) {
-        if (_current_settings.find(update) == _current_settings.end()) {
-            // LogDebug() << "Update to '" << update << "' not understood.";
-            continue;
-        }
+    for (const auto update : parameter.updates) {
         _current_settings[update].needs_updating = true;
     }
 
@@ -566,13 +980,14 @@ bool CameraDefinition::get_setting(const std::string& name, MAVLinkParameters::P
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
-    if (_current_settings.find(name) == _current_settings.end()) {
+    setting_id_t id;
+    if (!find_setting(name, id)) {
         LogErr() << "Unknown setting to get";
         return false;
     }
 
-    if (!_current_settings.at(name).needs_updating) {
-        value = _current_settings.at(name).value;
+    if (!_current_settings[id].needs_updating) {
+        value = _current_settings[id].value;
         return true;
     } else {
         return false;
@@ -586,14 +1001,15 @@ bool CameraDefinition::get_option_value(
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
-    if (_parameter_map.find(param_name) == _parameter_map.end()) {
+    setting_id_t id;
+    if (!find_setting(param_name, id)) {
         LogErr() << "Unknown parameter to get option: " << param_name;
         return false;
     }
 
-    for (const auto& option : _parameter_map[param_name]->options) {
-        if (option->value == option_value) {
-            value = option->value;
+    for (const auto& option : _parameters[id].options) {
+        if (option.value == option_value) {
+            value = option.value;
             return true;
         }
     }
@@ -608,13 +1024,14 @@ bool CameraDefinition::get_all_options(
 
     values.clear();
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    setting_id_t id;
+    if (!find_setting(name, id)) {
         LogErr() << "Unknown parameter to get all options";
         return false;
     }
 
-    for (const auto& option : _parameter_map[name]->options) {
-        values.push_back(option->value);
+    for (const auto& option : _parameters[id].options) {
+        values.push_back(option.value);
     }
 
     return true;
@@ -627,88 +1044,60 @@ bool CameraDefinition::get_possible_options(
 
     values.clear();
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    setting_id_t id;
+    if (!find_setting(name, id)) {
         LogErr() << "Unknown parameter to get possible options";
         return false;
     }
 
-    std::unordered_map<std::string, MAVLinkParameters::ParamValue> settings;
-    if (!get_possible_settings(settings)) {
-        return false;
-    }
-    if (settings.find(name) == settings.end()) {
+    // Excluded parameters need to be neglected for the range check below.
+    const auto exclusions = find_exclusions();
+
+    if (!is_possible_setting(id, exclusions)) {
         LogErr() << "Setting " << name << " currently not applicable";
         return false;
     }
 
-    // Find all exclusions because excluded parameters need to be neglected for range
-    // check below.
-    // TODO: use set instead of vector
-    std::vector<std::string> exclusions{};
-
-    for (const auto& parameter : _parameter_map) {
-        for (const auto& option : parameter.second->options) {
-            if (_current_settings[parameter.first].needs_updating) {
-                // LogWarn() << parameter.first << " needs updating";
-                continue;
-            }
-            if (_current_settings[parameter.first].value == option->value) {
-                for (const auto& exclusion : option->exclusions) {
-                    // LogDebug() << "found exclusion for " << parameter.first
-                    //            << "(" << option->value << "): " << exclusion;
-                    exclusions.push_back(exclusion);
-                }
-            }
-        }
-    }
-
-    // TODO: use set instead of vector for this
     std::vector<MAVLinkParameters::ParamValue> allowed_ranges{};
 
     // Check allowed ranges.
-    for (const auto& parameter : _parameter_map) {
-        if (!parameter.second->is_control) {
+    for (setting_id_t other_id = 0; other_id < _parameters.size(); ++other_id) {
+        if (!is_possible_setting(other_id, exclusions)) {
             continue;
         }
 
-        bool excluded = false;
-        for (const auto& exclusion : exclusions) {
-            if (parameter.first == exclusion) {
-                excluded = true;
-            }
-        }
-        if (excluded) {
+        if (_current_settings[other_id].needs_updating) {
+            // LogWarn() << _parameters[other_id].name << " needs updating";
             continue;
         }
 
-        for (const auto& option : parameter.second->options) {
-            if (_current_settings[parameter.first].needs_updating) {
-                // LogWarn() << parameter.first << " needs updating";
+        for (const auto& option : _parameters[other_id].options) {
+            // Only look at current set option.
+            if (!(_current_settings[other_id].value == option.value)) {
                 continue;
             }
-            // Only look at current set option.
-            if (_current_settings[parameter.first].value == option->value) {
-                // Go through parameter ranges but only concerning the parameter that
-                // we're interested in..
-                if (option->parameter_ranges.find(name) != option->parameter_ranges.end()) {
-                    for (const auto& range : option->parameter_ranges[name]) {
-                        allowed_ranges.push_back(range.second);
-                    }
+            // Go through parameter ranges but only concerning the parameter that
+            // we're interested in..
+            for (const auto& range : option.parameter_ranges) {
+                if (range.first == id) {
+                    allowed_ranges.insert(
+                        allowed_ranges.end(), range.second.begin(), range.second.end());
                 }
             }
         }
     }
 
     // Intersect
-    for (const auto& option : _parameter_map[name]->options) {
+    for (const auto& option : _parameters[id].options) {
         bool option_allowed = false;
         for (const auto& allowed_range : allowed_ranges) {
-            if (option->value == allowed_range) {
+            if (option.value == allowed_range) {
                 option_allowed = true;
+                break;
             }
         }
         if (option_allowed || allowed_ranges.size() == 0) {
-            values.push_back(option->value);
+            values.push_back(option.value);
         }
     }
 
@@ -722,9 +1111,9 @@ void CameraDefinition::get_unknown_params(
 
     params.clear();
 
-    for (const auto& parameter : _parameter_map) {
-        if (_current_settings[parameter.first].needs_updating) {
-            params.push_back(std::make_pair<>(parameter.first, parameter.second->type));
+    for (setting_id_t id = 0; id < _parameters.size(); ++id) {
+        if (_current_settings[id].needs_updating) {
+            params.push_back(std::make_pair<>(_parameters[id].name, _parameters[id].type));
         }
     }
 }
@@ -733,19 +1122,22 @@ void CameraDefinition::set_all_params_unknown()
 {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
-    for (auto& parameter : _parameter_map) {
-        _current_settings[parameter.first].needs_updating = true;
+    for (auto& current_setting : _current_settings) {
+        current_setting.needs_updating = true;
     }
 }
 
 bool CameraDefinition::is_setting_range(const std::string& name)
 {
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+
+    setting_id_t id;
+    if (!find_setting(name, id)) {
         LogWarn() << "Setting " << name << " not found.";
         return false;
     }
 
-    return _parameter_map[name]->is_range;
+    return _parameters[id].is_range;
 }
 
 bool CameraDefinition::get_setting_str(const std::string& name, std::string& description)
@@ -754,12 +1146,13 @@ bool CameraDefinition::get_setting_str(const std::string& name, std::string& des
 
     description.clear();
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    setting_id_t id;
+    if (!find_setting(name, id)) {
         LogWarn() << "Setting " << name << " not found.";
         return false;
     }
 
-    description = _parameter_map[name]->description;
+    description = _parameters[id].description;
     return true;
 }
 
@@ -770,16 +1163,15 @@ bool CameraDefinition::get_option_str(
 
     description.clear();
 
-    if (_parameter_map.find(setting_name) == _parameter_map.end()) {
+    setting_id_t id;
+    if (!find_setting(setting_name, id)) {
         LogWarn() << "Setting " << setting_name << " not found.";
         return false;
     }
 
-    for (const auto& option : _parameter_map[setting_name]->options) {
-        std::stringstream value_ss{};
-        value_ss << option->value;
-        if (option->value == option_name) {
-            description = option->name;
+    for (const auto& option : _parameters[id].options) {
+        if (option.value == option_name) {
+            description = option.name;
             return true;
         }
     }
@@ -20,6 +20,12 @@ public:
     bool load_file(const std::string& filepath);
     bool load_string(const std::string& content);
 
+    // Compact binary form of a loaded definition which can be loaded again
+    // without parsing the XML. Only the definition itself is stored, not the
+    // current settings.
+    bool load_binary(const std::string& content);
+    bool save_binary(std::string& content) const;
+
     std::string get_vendor() const;
     std::string get_model() const;
 
@@ -60,54 +66,66 @@ public:
     const CameraDefinition& operator=(const CameraDefinition&) = delete;
 
 private:
-    typedef std::unordered_map<std::string, MAVLinkParameters::ParamValue> parameter_range_t;
+    // Settings are referred to by their index into _parameters, so that
+    // lookups after the initial name lookup are plain array indexing.
+    typedef uint16_t setting_id_t;
 
     struct Option {
         std::string name{};
         MAVLinkParameters::ParamValue value{};
-        std::vector<std::string> exclusions{};
-        std::unordered_map<std::string, parameter_range_t> parameter_ranges{};
+        std::vector<setting_id_t> exclusions{};
+        // Values allowed for other settings while this option is selected.
+        std::vector<std::pair<setting_id_t, std::vector<MAVLinkParameters::ParamValue>>>
+            parameter_ranges{};
     };
 
     struct Parameter {
+        std::string name{};
         std::string description{};
         bool is_control{false};
         bool is_readonly{false};
         bool is_writeonly{false};
         MAVLinkParameters::ParamValue type{}; // for type only, doesn't hold a value
-        std::vector<std::string> updates{};
-        std::vector<std::shared_ptr<Option>> options{};
+        std::vector<setting_id_t> updates{};
+        std::vector<Option> options{};
         Option default_option{};
         bool is_range{false};
     };
 
-    bool parse_xml();
+    void clear();
+    bool parse_xml(const tinyxml2::XMLDocument& doc);
 
     // Until we have std::optional we need to use std::pair to return something that might be
     // nothing.
-    std::pair<bool, std::vector<std::shared_ptr<Option>>> parse_options(
+    std::pair<bool, std::vector<Option>> parse_options(
         const tinyxml2::XMLElement* options_handle,
         const std::string& param_name,
-        std::unordered_map<std::string, std::string>& type_map);
-    std::tuple<bool, std::vector<std::shared_ptr<Option>>, Option> parse_range_options(
+        std::unordered_map<std::string, std::string>& type_map,
+        const std::unordered_map<std::string, setting_id_t>& xml_ids);
+    std::tuple<bool, std::vector<Option>, Option> parse_range_options(
         const tinyxml2::XMLElement* param_handle,
         const std::string& param_name,
         std::unordered_map<std::string, std::string>& type_map);
-    std::pair<bool, Option> find_default(
-        const std::vector<std::shared_ptr<Option>>& options, const std::string& default_str);
+    std::pair<bool, Option>
+    find_default(const std::vector<Option>& options, const std::string& default_str);
 
-    mutable std::recursive_mutex _mutex{};
+    // Assumes to have the lock for _mutex.
+    bool find_setting(const std::string& name, setting_id_t& id) const;
+    std::vector<bool> find_exclusions() const;
+    bool is_possible_setting(setting_id_t id, const std::vector<bool>& exclusions) const;
 
-    tinyxml2::XMLDocument _doc{};
+    mutable std::recursive_mutex _mutex{};
 
-    std::unordered_map<std::string, std::shared_ptr<Parameter>> _parameter_map{};
+    std::vector<Parameter> _parameters{};
+    std::unordered_map<std::string, setting_id_t> _setting_ids{};
 
     struct InternalCurrentSetting {
         MAVLinkParameters::ParamValue value{};
         bool needs_updating{false};
     };
 
-    std::unordered_map<std::string, InternalCurrentSetting> _current_settings{};
+    // Indexed by setting id.
+    std::vector<InternalCurrentSetting> _current_settings{};
 
     std::string _model{};
     std::string _vendor{};
@@ -0,0 +1,62 @@
+#include "camera_definition.h"
+#include <fstream>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// Run this from root.
+static const std::string e90_unit_test_file = "src/plugins/camera/e90_unit_test.xml";
+
+static std::string read_e90_xml()
+{
+    std::ifstream file_stream(e90_unit_test_file);
+    std::string content;
+    std::getline(file_stream, content, '\0');
+    return content;
+}
+
+static void BM_CameraDefinitionLoadXml(benchmark::State& state)
+{
+    const auto content = read_e90_xml();
+
+    for (auto _ : state) {
+        CameraDefinition cd;
+        benchmark::DoNotOptimize(cd.load_string(content));
+    }
+}
+BENCHMARK(BM_CameraDefinitionLoadXml);
+
+static void BM_CameraDefinitionLoadBinary(benchmark::State& state)
+{
+    std::string binary;
+    {
+        CameraDefinition cd;
+        if (!cd.load_string(read_e90_xml()) || !cd.save_binary(binary)) {
+            state.SkipWithError("Could not load camera definition");
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        CameraDefinition cd;
+        benchmark::DoNotOptimize(cd.load_binary(binary));
+    }
+}
+BENCHMARK(BM_CameraDefinitionLoadBinary);
+
+static void BM_CameraDefinitionGetPossibleOptions(benchmark::State& state)
+{
+    CameraDefinition cd;
+    if (!cd.load_string(read_e90_xml())) {
+        state.SkipWithError("Could not load camera definition");
+        return;
+    }
+    cd.assume_default_settings();
+
+    std::vector<MAVLinkParameters::ParamValue> values;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cd.get_possible_options("CAM_VIDRES", values));
+        benchmark::DoNotOptimize(cd.is_setting_range("CAM_VIDRES"));
+    }
+}
+BENCHMARK(BM_CameraDefinitionGetPossibleOptions);
@@ -0,0 +1,102 @@
+#include "camera_definition_cache.h"
+#include "camera_definition.h"
+#include "cache_directory.h"
+#include "log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+namespace mavsdk {
+
+CameraDefinitionCache::CameraDefinitionCache(const std::string& directory) : _directory(directory)
+{}
+
+std::string CameraDefinitionCache::default_directory()
+{
+    if (const char* env_p = std::getenv("MAVSDK_CAMERA_DEFINITION_CACHE_DIR")) {
+        return env_p;
+    }
+
+    return default_cache_directory("camera_definitions");
+}
+
+std::string CameraDefinitionCache::path_for(const std::string& uri, uint32_t version) const
+{
+    // The URI itself is stored in the file and compared on load.
+    return _directory + "/" + cache_file_name(uri) + "-" + std::to_string(version) + ".mcdb";
+}
+
+bool CameraDefinitionCache::load(
+    const std::string& uri, uint32_t version, CameraDefinition& definition) const
+{
+    if (_directory.empty() || uri.empty()) {
+        return false;
+    }
+
+    std::ifstream file(path_for(uri, version), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    std::string stored_uri;
+    std::string stored_version;
+    if (!std::getline(file, stored_uri) || !std::getline(file, stored_version) ||
+        stored_uri != uri || stored_version != std::to_string(version)) {
+        return false;
+    }
+
+    const std::string content(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (!definition.load_binary(content)) {
+        LogWarn() << "Ignoring invalid cached camera definition for " << uri;
+        return false;
+    }
+
+    return true;
+}
+
+bool CameraDefinitionCache::store(
+    const std::string& uri, uint32_t version, const CameraDefinition& definition) const
+{
+    if (_directory.empty() || uri.empty() || uri.find('\n') != std::string::npos) {
+        return false;
+    }
+
+    if (!create_cache_directory(_directory)) {
+        LogWarn() << "Could not create camera definition cache in " << _directory;
+        return false;
+    }
+
+    std::string content;
+    if (!definition.save_binary(content)) {
+        return false;
+    }
+
+    // Write to a temporary file first so that other instances never see a
+    // partially written definition.
+    const auto path = path_for(uri, version);
+    const auto temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file << uri << '\n' << version << '\n';
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+        file.close();
+        if (file.fail()) {
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+
+    std::remove(path.c_str());
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace mavsdk {
+
+class CameraDefinition;
+
+// Keeps compiled camera definitions on disk, keyed by the definition URI and
+// version, so that the XML only needs to be downloaded and parsed once per
+// camera firmware rather than on every connect.
+//
+// An empty directory disables the cache.
+class CameraDefinitionCache {
+public:
+    explicit CameraDefinitionCache(const std::string& directory = default_directory());
+
+    // The directory can be set using the environment variable
+    // MAVSDK_CAMERA_DEFINITION_CACHE_DIR, otherwise the default cache
+    // directory is used if there is one.
+    static std::string default_directory();
+
+    bool load(const std::string& uri, uint32_t version, CameraDefinition& definition) const;
+    bool store(const std::string& uri, uint32_t version, const CameraDefinition& definition) const;
+
+    std::string path_for(const std::string& uri, uint32_t version) const;
+
+private:
+    std::string _directory;
+};
+
+} // namespace mavsdk
@@ -0,0 +1,82 @@
+#include "camera_definition_cache.h"
+#include "camera_definition.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+static const std::string e90_unit_test_file = "src/plugins/camera/e90_unit_test.xml";
+static const std::string cache_directory = "camera_definition_cache_test";
+static const std::string uri = "http://192.168.42.1/e90.xml";
+
+TEST(CameraDefinitionCache, StoreAndLoad)
+{
+    CameraDefinitionCache cache(cache_directory);
+    std::remove(cache.path_for(uri, 3).c_str());
+
+    {
+        CameraDefinition cd;
+        EXPECT_FALSE(cache.load(uri, 3, cd));
+    }
+
+    {
+        // Run this from root.
+        CameraDefinition cd;
+        ASSERT_TRUE(cd.load_file(e90_unit_test_file));
+        EXPECT_TRUE(cache.store(uri, 3, cd));
+    }
+
+    {
+        CameraDefinition cd;
+        EXPECT_TRUE(cache.load(uri, 3, cd));
+        EXPECT_STREQ(cd.get_model().c_str(), "E90");
+
+        cd.assume_default_settings();
+        std::unordered_map<std::string, MAVLinkParameters::ParamValue> settings{};
+        EXPECT_TRUE(cd.get_all_settings(settings));
+        EXPECT_EQ(settings.size(), 17);
+    }
+
+    {
+        // Other version or URI are not found.
+        CameraDefinition cd;
+        EXPECT_FALSE(cache.load(uri, 4, cd));
+        EXPECT_FALSE(cache.load("http://192.168.42.1/e50.xml", 3, cd));
+    }
+
+    std::remove(cache.path_for(uri, 3).c_str());
+    std::remove(cache_directory.c_str());
+}
+
+TEST(CameraDefinitionCache, CorruptFileIsIgnored)
+{
+    CameraDefinitionCache cache(cache_directory);
+
+    {
+        CameraDefinition cd;
+        ASSERT_TRUE(cd.load_file(e90_unit_test_file));
+        EXPECT_TRUE(cache.store(uri, 5, cd));
+    }
+
+    {
+        std::ofstream file(cache.path_for(uri, 5), std::ios::binary | std::ios::trunc);
+        file << uri << '\n' << 5 << '\n' << "garbage";
+    }
+
+    CameraDefinition cd;
+    EXPECT_FALSE(cache.load(uri, 5, cd));
+
+    std::remove(cache.path_for(uri, 5).c_str());
+    std::remove(cache_directory.c_str());
+}
+
+TEST(CameraDefinitionCache, Disabled)
+{
+    CameraDefinitionCache cache("");
+
+    CameraDefinition cd;
+    ASSERT_TRUE(cd.load_file(e90_unit_test_file));
+    EXPECT_FALSE(cache.store(uri, 1, cd));
+    EXPECT_FALSE(cache.load(uri, 1, cd));
+}
@@ -641,3 +641,108 @@ TEST(CameraDefinition, UVCCheckOptionHumanReadable)
     EXPECT_TRUE(cd.get_option_str("exp-priority", "1", description));
     EXPECT_STREQ(description.c_str(), "ON");
 }
+
+TEST(CameraDefinition, E90BinaryRoundTrip)
+{
+    // Run this from root.
+    CameraDefinition cd_xml;
+    ASSERT_TRUE(cd_xml.load_file(e90_unit_test_file));
+
+    std::string binary;
+    ASSERT_TRUE(cd_xml.save_binary(binary));
+
+    CameraDefinition cd;
+    ASSERT_TRUE(cd.load_binary(binary));
+    EXPECT_STREQ(cd.get_vendor().c_str(), "Yuneec");
+    EXPECT_STREQ(cd.get_model().c_str(), "E90");
+
+    // Saving again gives the same result.
+    std::string binary_again;
+    ASSERT_TRUE(cd.save_binary(binary_again));
+    EXPECT_EQ(binary, binary_again);
+
+    cd.assume_default_settings();
+
+    {
+        std::unordered_map<std::string, MAVLinkParameters::ParamValue> settings{};
+        EXPECT_TRUE(cd.get_all_settings(settings));
+        EXPECT_EQ(settings.size(), 17);
+        EXPECT_FLOAT_EQ(settings["CAM_SHUTTERSPD"].get<float>(), 0.016666f);
+        EXPECT_EQ(settings["CAM_PHOTORATIO"].get<uint8_t>(), 1);
+        EXPECT_EQ(settings["CAM_CUSTOMWB"].get<uint16_t>(), 5500);
+    }
+
+    {
+        // Currently not applicable because exposure mode is in Auto.
+        std::vector<MAVLinkParameters::ParamValue> values;
+        EXPECT_FALSE(cd.get_possible_options("CAM_SHUTTERSPD", values));
+    }
+
+    {
+        // Set exposure mode to manual
+        MAVLinkParameters::ParamValue value;
+        value.set<uint32_t>(1);
+        EXPECT_TRUE(cd.set_setting("CAM_EXPMODE", value));
+
+        std::vector<MAVLinkParameters::ParamValue> values;
+        EXPECT_TRUE(cd.get_possible_options("CAM_SHUTTERSPD", values));
+        EXPECT_EQ(values.size(), 12);
+    }
+
+    {
+        // Switching to HEVC restricts the video resolutions.
+        MAVLinkParameters::ParamValue value;
+        value.set<uint32_t>(3);
+        EXPECT_TRUE(cd.set_setting("CAM_VIDFMT", value));
+
+        std::vector<MAVLinkParameters::ParamValue> values;
+        EXPECT_TRUE(cd.get_possible_options("CAM_VIDRES", values));
+        EXPECT_EQ(values.size(), 26);
+    }
+
+    std::string description{};
+    EXPECT_TRUE(cd.get_option_str("CAM_WBMODE", "0", description));
+    EXPECT_STREQ(description.c_str(), "Auto");
+}
+
+TEST(CameraDefinition, UVCBinaryRoundTrip)
+{
+    // Run this from root.
+    CameraDefinition cd_xml;
+    ASSERT_TRUE(cd_xml.load_file(uvc_unit_test_file));
+
+    std::string binary;
+    ASSERT_TRUE(cd_xml.save_binary(binary));
+
+    CameraDefinition cd;
+    ASSERT_TRUE(cd.load_binary(binary));
+
+    EXPECT_TRUE(cd.is_setting_range("brightness"));
+    EXPECT_FALSE(cd.is_setting_range("wb-mode"));
+
+    MAVLinkParameters::ParamValue value;
+    value.set<int32_t>(200);
+    EXPECT_TRUE(cd.set_setting("brightness", value));
+    value.set<int32_t>(400);
+    EXPECT_FALSE(cd.set_setting("brightness", value));
+}
+
+TEST(CameraDefinition, InvalidBinary)
+{
+    CameraDefinition cd_xml;
+    ASSERT_TRUE(cd_xml.load_file(uvc_unit_test_file));
+
+    std::string binary;
+    ASSERT_TRUE(cd_xml.save_binary(binary));
+
+    CameraDefinition cd;
+    EXPECT_FALSE(cd.load_binary(""));
+    EXPECT_FALSE(cd.load_binary("not a camera definition"));
+
+    // Every truncation needs to be detected.
+    for (std::size_t len = 0; len < binary.size(); ++len) {
+        EXPECT_FALSE(cd.load_binary(binary.substr(0, len)));
+    }
+
+    EXPECT_TRUE(cd.load_binary(binary));
+}
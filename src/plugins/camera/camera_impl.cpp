@@ -4,6 +4,7 @@
 #include "global_include.h"
 #include "http_loader.h"
 #include "camera_definition_files.h"
+#include <cstddef>
 #include <functional>
 #include <cmath>
 #include <sstream>
@@ -72,8 +73,16 @@ void CameraImpl::init()
 
 void CameraImpl::deinit()
 {
+    _parent->http_loader().cancel(_camera_definition_download_cookie);
+    ++_camera_definition_generation;
+    _camera_definition_loading = false;
+
     _parent->remove_call_every(_check_connection_status_call_every_cookie);
-    _parent->remove_call_every(_status.call_every_cookie);
+    _parent->remove_all_message_requests(this);
+    _parent->remove_all_message_requests(&_status);
+    _parent->remove_all_message_requests(&_mode);
+    _parent->remove_all_message_requests(&_video_stream_info);
+    _parent->remove_all_message_requests(&_information);
     _parent->unregister_all_mavlink_message_handlers(this);
     _parent->cancel_all_param(this);
 
@@ -139,13 +148,8 @@ void CameraImpl::manual_enable()
 {
     refresh_params();
 
-    request_camera_information();
-    request_flight_information();
-
-    _parent->add_call_every(
-        [this]() { request_camera_information(); }, 10.0, &_camera_information_call_every_cookie);
-    _parent->add_call_every(
-        [this]() { request_flight_information(); }, 10.0, &_flight_information_call_every_cookie);
+    request_camera_information(this);
+    request_flight_information(this);
 }
 
 void CameraImpl::disable()
@@ -158,8 +162,7 @@ void CameraImpl::disable()
 void CameraImpl::manual_disable()
 {
     invalidate_params();
-    _parent->remove_call_every(_camera_information_call_every_cookie);
-    _parent->remove_call_every(_flight_information_call_every_cookie);
+    _parent->remove_all_message_requests(this);
 
     _camera_found = false;
 }
@@ -179,10 +182,47 @@ Camera::Result CameraImpl::select_camera(const size_t id)
     // correct  camera is initialized.
     manual_disable();
     manual_enable();
+    update_message_requests();
 
     return Camera::Result::Success;
 }
 
+void CameraImpl::update_message_requests()
+{
+    // The subscriptions now need the messages of the selected camera.
+    {
+        std::lock_guard<std::mutex> lock(_status.mutex);
+        _parent->remove_all_message_requests(&_status);
+        if (_status.subscription_callback) {
+            request_status(&_status);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_information.mutex);
+        _parent->remove_all_message_requests(&_information);
+        if (_information.subscription_callback) {
+            request_status(&_information);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mode.mutex);
+        _parent->remove_all_message_requests(&_mode);
+        if (_mode.subscription_callback) {
+            request_camera_settings(&_mode);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_video_stream_info.mutex);
+        _parent->remove_all_message_requests(&_video_stream_info);
+        if (_video_stream_info.subscription_callback) {
+            request_video_stream_info(&_video_stream_info);
+        }
+    }
+}
+
 MavlinkCommandSender::CommandLong CameraImpl::make_command_request_flight_information()
 {
     MavlinkCommandSender::CommandLong command_flight_information{};
@@ -463,9 +503,9 @@ void CameraImpl::information_async(const Camera::InformationCallback& callback)
     _information.subscription_callback = callback;
 
     if (callback) {
-        _parent->add_call_every([this]() { request_status(); }, 1.0, &_status.call_every_cookie);
+        request_status(&_information);
     } else {
-        _parent->remove_call_every(_status.call_every_cookie);
+        _parent->remove_all_message_requests(&_information);
     }
 }
 
@@ -506,9 +546,13 @@ Camera::Result CameraImpl::stop_video_streaming()
     return result;
 }
 
-void CameraImpl::request_video_stream_info()
+void CameraImpl::request_video_stream_info(const void* cookie)
 {
-    _parent->send_command_async(make_command_request_video_stream_info(), nullptr);
+    add_message_request(
+        MAVLINK_MSG_ID_VIDEO_STREAM_INFORMATION,
+        make_command_request_video_stream_info(),
+        1.0,
+        cookie);
 }
 
 Camera::VideoStreamInfo CameraImpl::video_stream_info()
@@ -525,10 +569,9 @@ void CameraImpl::video_stream_info_async(const Camera::VideoStreamInfoCallback c
     _video_stream_info.subscription_callback = callback;
 
     if (callback) {
-        _parent->add_call_every(
-            [this]() { request_video_stream_info(); }, 1.0, &_video_stream_info.call_every_cookie);
+        request_video_stream_info(&_video_stream_info);
     } else {
-        _parent->remove_call_every(_video_stream_info.call_every_cookie);
+        _parent->remove_all_message_requests(&_video_stream_info);
     }
 }
 
@@ -566,7 +609,7 @@ Camera::Result CameraImpl::set_mode(const Camera::Mode mode)
             _mode.data = mode;
         }
         notify_mode();
-        if (_camera_definition != nullptr) {
+        if (camera_definition() != nullptr) {
             save_camera_mode(mavlink_mode);
         }
     }
@@ -576,6 +619,11 @@ Camera::Result CameraImpl::set_mode(const Camera::Mode mode)
 
 void CameraImpl::save_camera_mode(const float mavlink_camera_mode)
 {
+    const auto definition = camera_definition();
+    if (!definition) {
+        return;
+    }
+
     if (!std::isfinite(mavlink_camera_mode)) {
         LogWarn() << "Can't save NAN as camera mode";
         return;
@@ -592,7 +640,7 @@ void CameraImpl::save_camera_mode(const float mavlink_camera_mode)
     // I am assuming here that in such a case, CAMERA_SETTINGS is
     // never sent by the camera.
     MAVLinkParameters::ParamValue value;
-    if (_camera_definition->get_setting("CAM_MODE", value)) {
+    if (definition->get_setting("CAM_MODE", value)) {
         if (value.is<uint8_t>()) {
             value.set<uint8_t>(static_cast<uint8_t>(mavlink_camera_mode));
         } else if (value.is<int8_t>()) {
@@ -618,7 +666,7 @@ void CameraImpl::save_camera_mode(const float mavlink_camera_mode)
         value.set<uint32_t>(static_cast<uint32_t>(mavlink_camera_mode));
     }
 
-    _camera_definition->set_setting("CAM_MODE", value);
+    definition->set_setting("CAM_MODE", value);
     refresh_params();
 }
 
@@ -664,10 +712,9 @@ void CameraImpl::mode_async(const Camera::ModeCallback callback)
     notify_mode();
 
     if (callback) {
-        _parent->add_call_every(
-            [this]() { request_camera_settings(); }, 1.0, &_mode.call_every_cookie);
+        request_camera_settings(&_mode);
     } else {
-        _parent->remove_call_every(_mode.call_every_cookie);
+        _parent->remove_all_message_requests(&_mode);
     }
 }
 
@@ -682,10 +729,20 @@ bool CameraImpl::interval_valid(float interval_s)
     }
 }
 
-void CameraImpl::request_status()
+void CameraImpl::request_status(const void* cookie)
 {
-    _parent->send_command_async(make_command_request_camera_capture_status(), nullptr);
-    _parent->send_command_async(make_command_request_storage_info(), nullptr);
+    add_message_request(
+        MAVLINK_MSG_ID_CAMERA_CAPTURE_STATUS,
+        make_command_request_camera_capture_status(),
+        1.0,
+        cookie,
+        offsetof(mavlink_camera_capture_status_t, time_boot_ms));
+    add_message_request(
+        MAVLINK_MSG_ID_STORAGE_INFORMATION,
+        make_command_request_storage_info(),
+        1.0,
+        cookie,
+        offsetof(mavlink_storage_information_t, time_boot_ms));
 }
 
 void CameraImpl::status_async(const Camera::StatusCallback callback)
@@ -695,9 +752,9 @@ void CameraImpl::status_async(const Camera::StatusCallback callback)
     _status.subscription_callback = callback;
 
     if (callback) {
-        _parent->add_call_every([this]() { request_status(); }, 1.0, &_status.call_every_cookie);
+        request_status(&_status);
     } else {
-        _parent->remove_call_every(_status.call_every_cookie);
+        _parent->remove_all_message_requests(&_status);
     }
 }
 
@@ -812,7 +869,7 @@ void CameraImpl::process_camera_settings(const mavlink_message_t& message)
     }
     notify_mode();
 
-    if (_camera_definition) {
+    if (camera_definition()) {
         // This "parameter" needs to be manually set.
         save_camera_mode(camera_settings.mode_id);
     }
@@ -848,45 +905,105 @@ void CameraImpl::process_camera_information(const mavlink_message_t& message)
         }
     }
 
-    if (!_camera_definition) {
-        std::string content{};
-        auto succeeded = fetch_camera_definition(camera_information, content);
-
-        if (succeeded) {
-            _camera_definition.reset(new CameraDefinition());
-            _camera_definition->load_string(content);
-            refresh_params();
-            LogDebug() << "Successfully loaded camera definition";
-        } else {
-            LogDebug() << "Failed to fetch camera definition!";
-        }
+    if (!camera_definition() && !_camera_definition_loading) {
+        load_camera_definition(camera_information);
     }
 }
 
-bool CameraImpl::fetch_camera_definition(
-    const mavlink_camera_information_t& camera_information, std::string& camera_definition_out)
+void CameraImpl::load_camera_definition(const mavlink_camera_information_t& camera_information)
 {
-    auto download_succeeded =
-        download_definition_file(camera_information.cam_definition_uri, camera_definition_out);
+    // The URI is not necessarily zero terminated.
+    const std::string uri(
+        camera_information.cam_definition_uri,
+        strnlen(
+            camera_information.cam_definition_uri,
+            sizeof(camera_information.cam_definition_uri)));
+    const uint32_t version = camera_information.cam_definition_version;
 
-    if (download_succeeded) {
-        return true;
+    std::unique_ptr<CameraDefinition> new_definition{new CameraDefinition()};
+
+    if (_camera_definition_cache.load(uri, version, *new_definition)) {
+        LogDebug() << "Using cached camera definition for " << uri << " (version " << version
+                   << ")";
+        install_camera_definition(std::move(new_definition));
+        return;
+    }
+
+    if (uri.empty()) {
+        load_fallback_definition(camera_information);
+        return;
     }
 
-    return load_stored_definition(camera_information, camera_definition_out);
+    // The download must not block the receive thread, the definition is
+    // parsed and installed once it arrives.
+    _camera_definition_loading = true;
+    LogInfo() << "Downloading camera definition from: " << uri;
+    const unsigned generation = _camera_definition_generation;
+    const auto parent = _parent;
+    _camera_definition_download_cookie = _parent->http_loader().download_text_async(
+        uri,
+        [this, parent, generation, camera_information, uri, version](
+            bool success, const std::string& content) {
+            // The loader doesn't wait for this when the download is
+            // cancelled, so the camera is only used from the user callback
+            // thread, like for any other callback.
+            parent->call_user_callback(
+                [this, generation, camera_information, uri, version, success, content]() {
+                    if (generation != _camera_definition_generation) {
+                        return;
+                    }
+
+                    std::unique_ptr<CameraDefinition> downloaded_definition{
+                        new CameraDefinition()};
+
+                    if (!success) {
+                        LogErr() << "Failed to download camera definition.";
+                        load_fallback_definition(camera_information);
+                    } else if (!downloaded_definition->load_string(content)) {
+                        LogErr() << "Could not parse camera definition";
+                    } else {
+                        _camera_definition_cache.store(uri, version, *downloaded_definition);
+                        install_camera_definition(std::move(downloaded_definition));
+                    }
+
+                    _camera_definition_loading = false;
+                });
+        });
+
+    if (_camera_definition_download_cookie == nullptr) {
+        _camera_definition_loading = false;
+        load_fallback_definition(camera_information);
+    }
 }
 
-bool CameraImpl::download_definition_file(
-    const std::string& uri, std::string& camera_definition_out)
+void CameraImpl::load_fallback_definition(const mavlink_camera_information_t& camera_information)
 {
-    HttpLoader http_loader;
-    LogInfo() << "Downloading camera definition from: " << uri;
-    if (!http_loader.download_text_sync(uri, camera_definition_out)) {
-        LogErr() << "Failed to download camera definition.";
-        return false;
+    // The definitions stored in the library are not cached on disk, they
+    // could otherwise outlive a library update.
+    std::string content{};
+    std::unique_ptr<CameraDefinition> new_definition{new CameraDefinition()};
+    if (load_stored_definition(camera_information, content) &&
+        new_definition->load_string(content)) {
+        install_camera_definition(std::move(new_definition));
+    } else {
+        LogDebug() << "Failed to fetch camera definition!";
+    }
+}
+
+void CameraImpl::install_camera_definition(std::unique_ptr<CameraDefinition> new_definition)
+{
+    {
+        std::lock_guard<std::mutex> lock(_camera_definition_mutex);
+        _camera_definition = std::move(new_definition);
     }
+    refresh_params();
+    LogDebug() << "Successfully loaded camera definition";
+}
 
-    return true;
+std::shared_ptr<CameraDefinition> CameraImpl::camera_definition() const
+{
+    std::lock_guard<std::mutex> lock(_camera_definition_mutex);
+    return _camera_definition;
 }
 
 bool CameraImpl::load_stored_definition(
@@ -1027,7 +1144,7 @@ void CameraImpl::receive_set_mode_command_result(
             [temp_callback, camera_result]() { temp_callback(camera_result); });
     }
 
-    if (command_result == MavlinkCommandSender::Result::Success && _camera_definition) {
+    if (command_result == MavlinkCommandSender::Result::Success && camera_definition()) {
         // This "parameter" needs to be manually set.
         {
             std::lock_guard<std::mutex> lock(_mode.mutex);
@@ -1062,15 +1179,17 @@ void CameraImpl::notify_mode()
 
 bool CameraImpl::get_possible_setting_options(std::vector<std::string>& settings)
 {
+    const auto definition = camera_definition();
+
     settings.clear();
 
-    if (!_camera_definition) {
+    if (!definition) {
         LogWarn() << "Error: no camera definition available yet";
         return false;
     }
 
     std::unordered_map<std::string, MAVLinkParameters::ParamValue> cd_settings{};
-    _camera_definition->get_possible_settings(cd_settings);
+    definition->get_possible_settings(cd_settings);
 
     for (const auto& cd_setting : cd_settings) {
         if (cd_setting.first == "CAM_MODE") {
@@ -1087,15 +1206,17 @@ bool CameraImpl::get_possible_setting_options(std::vector<std::string>& settings
 bool CameraImpl::get_possible_options(
     const std::string& setting_id, std::vector<Camera::Option>& options)
 {
+    const auto definition = camera_definition();
+
     options.clear();
 
-    if (!_camera_definition) {
+    if (!definition) {
         LogWarn() << "Error: no camera definition available yet";
         return false;
     }
 
     std::vector<MAVLinkParameters::ParamValue> values;
-    if (!_camera_definition->get_possible_options(setting_id, values)) {
+    if (!definition->get_possible_options(setting_id, values)) {
         return false;
     }
 
@@ -1115,7 +1236,9 @@ bool CameraImpl::get_possible_options(
 
 bool CameraImpl::is_setting_range(const std::string& setting_id)
 {
-    return _camera_definition->is_setting_range(setting_id);
+    const auto definition = camera_definition();
+
+    return definition && definition->is_setting_range(setting_id);
 }
 
 Camera::Result CameraImpl::set_setting(Camera::Setting setting)
@@ -1138,7 +1261,9 @@ void CameraImpl::set_option_async(
     const Camera::Option& option,
     const Camera::ResultCallback& callback)
 {
-    if (!_camera_definition) {
+    const auto definition = camera_definition();
+
+    if (!definition) {
         LogWarn() << "Error: no camera defnition available yet.";
         if (callback) {
             const auto temp_callback = callback;
@@ -1151,10 +1276,10 @@ void CameraImpl::set_option_async(
     // We get it first so that we have the type of the param value.
     MAVLinkParameters::ParamValue value;
 
-    if (_camera_definition->is_setting_range(setting_id)) {
+    if (definition->is_setting_range(setting_id)) {
         // TODO: Get type from minimum.
         std::vector<MAVLinkParameters::ParamValue> all_values;
-        if (!_camera_definition->get_all_options(setting_id, all_values)) {
+        if (!definition->get_all_options(setting_id, all_values)) {
             if (callback) {
                 LogErr() << "Could not get all options to get type for range param.";
                 const auto temp_callback = callback;
@@ -1187,7 +1312,7 @@ void CameraImpl::set_option_async(
         }
 
     } else {
-        if (!_camera_definition->get_option_value(setting_id, option.option_id, value)) {
+        if (!definition->get_option_value(setting_id, option.option_id, value)) {
             if (callback) {
                 LogErr() << "Could not get option value.";
                 const auto temp_callback = callback;
@@ -1198,7 +1323,7 @@ void CameraImpl::set_option_async(
         }
 
         std::vector<MAVLinkParameters::ParamValue> possible_values;
-        _camera_definition->get_possible_options(setting_id, possible_values);
+        definition->get_possible_options(setting_id, possible_values);
         bool allowed = false;
         for (const auto& possible_value : possible_values) {
             if (value == possible_value) {
@@ -1221,7 +1346,8 @@ void CameraImpl::set_option_async(
         value,
         [this, callback, setting_id, value](MAVLinkParameters::Result result) {
             if (result == MAVLinkParameters::Result::Success) {
-                if (!this->_camera_definition) {
+                const auto current_definition = camera_definition();
+                if (!current_definition) {
                     if (callback) {
                         const auto temp_callback = callback;
                         _parent->call_user_callback(
@@ -1230,7 +1356,7 @@ void CameraImpl::set_option_async(
                     return;
                 }
 
-                if (!_camera_definition->set_setting(setting_id, value)) {
+                if (!current_definition->set_setting(setting_id, value)) {
                     if (callback) {
                         const auto temp_callback = callback;
                         _parent->call_user_callback(
@@ -1309,7 +1435,9 @@ void CameraImpl::get_option_async(
     const std::string& setting_id,
     const std::function<void(Camera::Result, const Camera::Option&)>& callback)
 {
-    if (!_camera_definition) {
+    const auto definition = camera_definition();
+
+    if (!definition) {
         LogWarn() << "Error: no camera defnition available yet.";
         if (callback) {
             Camera::Option empty_option{};
@@ -1323,7 +1451,7 @@ void CameraImpl::get_option_async(
 
     MAVLinkParameters::ParamValue value;
     // We should have this cached and don't need to get the param.
-    if (_camera_definition->get_setting(setting_id, value)) {
+    if (definition->get_setting(setting_id, value)) {
         if (callback) {
             Camera::Option new_option{};
             new_option.option_id = value.get_string();
@@ -1368,13 +1496,15 @@ void CameraImpl::possible_setting_options_async(
 
 void CameraImpl::notify_current_settings()
 {
+    const auto definition = camera_definition();
+
     std::lock_guard<std::mutex> lock(_subscribe_current_settings.mutex);
 
     if (!_subscribe_current_settings.callback) {
         return;
     }
 
-    if (!_camera_definition) {
+    if (!definition) {
         LogErr() << "notify_current_settings has no camera definition";
         return;
     }
@@ -1389,7 +1519,7 @@ void CameraImpl::notify_current_settings()
     for (auto& possible_setting : possible_setting_options) {
         // use the cache for this, presumably we updated it right before.
         MAVLinkParameters::ParamValue value;
-        if (_camera_definition->get_setting(possible_setting, value)) {
+        if (definition->get_setting(possible_setting, value)) {
             Camera::Setting setting{};
             setting.setting_id = possible_setting;
             setting.is_range = is_setting_range(possible_setting);
@@ -1416,13 +1546,15 @@ void CameraImpl::notify_current_settings()
 
 void CameraImpl::notify_possible_setting_options()
 {
+    const auto definition = camera_definition();
+
     std::lock_guard<std::mutex> lock(_subscribe_possible_setting_options.mutex);
 
     if (!_subscribe_possible_setting_options.callback) {
         return;
     }
 
-    if (!_camera_definition) {
+    if (!definition) {
         LogErr() << "notify_possible_setting_options has no camera definition";
         return;
     }
@@ -1445,6 +1577,8 @@ void CameraImpl::notify_possible_setting_options()
 
 std::vector<Camera::SettingOptions> CameraImpl::possible_setting_options()
 {
+    const auto definition = camera_definition();
+
     std::vector<Camera::SettingOptions> results{};
 
     std::vector<std::string> possible_settings{};
@@ -1456,7 +1590,7 @@ std::vector<Camera::SettingOptions> CameraImpl::possible_setting_options()
     for (auto& possible_setting : possible_settings) {
         Camera::SettingOptions setting_options{};
         setting_options.setting_id = possible_setting;
-        setting_options.is_range = _camera_definition->is_setting_range(possible_setting);
+        setting_options.is_range = definition->is_setting_range(possible_setting);
         get_setting_str(setting_options.setting_id, setting_options.setting_description);
         get_possible_options(possible_setting, setting_options.options);
         results.push_back(setting_options);
@@ -1467,12 +1601,14 @@ std::vector<Camera::SettingOptions> CameraImpl::possible_setting_options()
 
 void CameraImpl::refresh_params()
 {
-    if (!_camera_definition) {
+    const auto definition = camera_definition();
+
+    if (!definition) {
         return;
     }
 
     std::vector<std::pair<std::string, MAVLinkParameters::ParamValue>> params;
-    _camera_definition->get_unknown_params(params);
+    definition->get_unknown_params(params);
     if (params.size() == 0) {
         // We're assuming that we changed one option and this did not cause
         // any other possible settings to change. However, we still would
@@ -1495,11 +1631,12 @@ void CameraImpl::refresh_params()
                     return;
                 }
                 // We need to check again by the time this callback runs
-                if (!this->_camera_definition) {
+                const auto current_definition = camera_definition();
+                if (!current_definition) {
                     return;
                 }
 
-                if (!this->_camera_definition->set_setting(param_name, value)) {
+                if (!current_definition->set_setting(param_name, value)) {
                     return;
                 }
 
@@ -1516,48 +1653,87 @@ void CameraImpl::refresh_params()
 
 void CameraImpl::invalidate_params()
 {
-    if (!_camera_definition) {
+    const auto definition = camera_definition();
+
+    if (!definition) {
         return;
     }
 
-    _camera_definition->set_all_params_unknown();
+    definition->set_all_params_unknown();
 }
 
 bool CameraImpl::get_setting_str(const std::string& setting_id, std::string& description)
 {
-    if (!_camera_definition) {
+    const auto definition = camera_definition();
+
+    if (!definition) {
         return false;
     }
 
-    return _camera_definition->get_setting_str(setting_id, description);
+    return definition->get_setting_str(setting_id, description);
 }
 
 bool CameraImpl::get_option_str(
     const std::string& setting_id, const std::string& option_id, std::string& description)
 {
-    if (!_camera_definition) {
+    const auto definition = camera_definition();
+
+    if (!definition) {
         return false;
     }
 
-    return _camera_definition->get_option_str(setting_id, option_id, description);
+    return definition->get_option_str(setting_id, option_id, description);
+}
+
+void CameraImpl::request_camera_settings(const void* cookie)
+{
+    add_message_request(
+        MAVLINK_MSG_ID_CAMERA_SETTINGS,
+        make_command_request_camera_settings(),
+        1.0,
+        cookie,
+        offsetof(mavlink_camera_settings_t, time_boot_ms));
 }
 
-void CameraImpl::request_camera_settings()
+void CameraImpl::request_flight_information(const void* cookie)
 {
-    auto command_camera_settings = make_command_request_camera_settings();
-    _parent->send_command_async(command_camera_settings, nullptr);
+    add_message_request(
+        MAVLINK_MSG_ID_FLIGHT_INFORMATION,
+        make_command_request_flight_information(),
+        10.0,
+        cookie,
+        offsetof(mavlink_flight_information_t, time_boot_ms));
 }
 
-void CameraImpl::request_flight_information()
+void CameraImpl::request_camera_information(const void* cookie)
 {
-    auto command_flight_information = make_command_request_flight_information();
-    _parent->send_command_async(command_flight_information, nullptr);
+    add_message_request(
+        MAVLINK_MSG_ID_CAMERA_INFORMATION,
+        make_command_request_camera_info(),
+        10.0,
+        cookie,
+        offsetof(mavlink_camera_information_t, time_boot_ms));
 }
 
-void CameraImpl::request_camera_information()
+void CameraImpl::add_message_request(
+    uint16_t message_id,
+    const MavlinkCommandSender::CommandLong& fallback_command,
+    double interval_s,
+    const void* cookie,
+    int time_boot_ms_offset)
 {
-    auto command_camera_info = make_command_request_camera_info();
-    _parent->send_command_async(command_camera_info, nullptr);
+    MAVLinkRequestScheduler::Request request{};
+    request.message_id = message_id;
+    request.component_id = fallback_command.target_component_id;
+    request.fallback_command = fallback_command;
+
+    // The timestamp changes with every message, but not the content.
+    if (time_boot_ms_offset >= 0) {
+        request.ignored_offset = static_cast<uint8_t>(time_boot_ms_offset);
+        request.ignored_size = sizeof(uint32_t);
+    }
+
+    _parent->add_message_request(request, interval_s, cookie);
 }
 
 Camera::Result CameraImpl::format_storage()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "camera_definition.h"
+#include "camera_definition_cache.h"
 #include "mavlink_include.h"
 #include "plugins/camera/camera.h"
 #include "plugin_impl_base.h"
@@ -129,9 +130,10 @@ private:
 
     void check_status();
 
-    bool fetch_camera_definition(
-        const mavlink_camera_information_t& camera_information, std::string& camera_definition_out);
-    bool download_definition_file(const std::string& uri, std::string& camera_definition_out);
+    void load_camera_definition(const mavlink_camera_information_t& camera_information);
+    void load_fallback_definition(const mavlink_camera_information_t& camera_information);
+    void install_camera_definition(std::unique_ptr<CameraDefinition> new_definition);
+    std::shared_ptr<CameraDefinition> camera_definition() const;
     bool
     load_stored_definition(const mavlink_camera_information_t&, std::string& camera_definition_out);
 
@@ -142,15 +144,21 @@ private:
     float to_mavlink_camera_mode(const Camera::Mode mode) const;
     Camera::Mode to_camera_mode(const uint8_t mavlink_camera_mode) const;
 
-    void* _camera_information_call_every_cookie{nullptr};
-    void* _flight_information_call_every_cookie{nullptr};
     void* _check_connection_status_call_every_cookie{nullptr};
 
-    void request_camera_settings();
-    void request_camera_information();
-    void request_video_stream_info();
-    void request_status();
-    void request_flight_information();
+    // Messages are requested until the requests with the cookie are removed.
+    void request_camera_settings(const void* cookie);
+    void request_camera_information(const void* cookie);
+    void request_video_stream_info(const void* cookie);
+    void request_status(const void* cookie);
+    void request_flight_information(const void* cookie);
+    void add_message_request(
+        uint16_t message_id,
+        const MavlinkCommandSender::CommandLong& fallback_command,
+        double interval_s,
+        const void* cookie,
+        int time_boot_ms_offset = -1);
+    void update_message_requests();
 
     MavlinkCommandSender::CommandLong make_command_take_photo(float interval_s, float no_of_photos);
     MavlinkCommandSender::CommandLong make_command_stop_photo();
@@ -170,7 +178,14 @@ private:
 
     MavlinkCommandSender::CommandLong make_command_request_video_stream_info();
 
-    std::unique_ptr<CameraDefinition> _camera_definition{};
+    // Replaced as a whole once loaded, users keep their own reference to it.
+    mutable std::mutex _camera_definition_mutex{};
+    std::shared_ptr<CameraDefinition> _camera_definition{};
+    CameraDefinitionCache _camera_definition_cache{};
+    std::atomic<bool> _camera_definition_loading{false};
+    void* _camera_definition_download_cookie{nullptr};
+    // Downloads started before this changed are dropped when they arrive.
+    std::atomic<unsigned> _camera_definition_generation{0};
 
     std::atomic<size_t> _camera_id{0};
     std::atomic<bool> _camera_found{false};
@@ -182,7 +197,6 @@ private:
         bool received_storage_information{false};
 
         Camera::StatusCallback subscription_callback{nullptr};
-        void* call_every_cookie{nullptr};
     } _status{};
 
     static constexpr double DEFAULT_TIMEOUT_S = 3.0;
@@ -191,7 +205,6 @@ private:
         std::mutex mutex{};
         Camera::Mode data{};
         Camera::ModeCallback subscription_callback{nullptr};
-        void* call_every_cookie{nullptr};
     } _mode{};
 
     struct {
@@ -208,7 +221,6 @@ private:
         std::mutex mutex{};
         Camera::VideoStreamInfo data{};
         bool available{false};
-        void* call_every_cookie{nullptr};
         Camera::VideoStreamInfoCallback subscription_callback{nullptr};
     } _video_stream_info{};
 
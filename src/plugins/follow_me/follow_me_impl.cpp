@@ -2,6 +2,7 @@
 #include "system.h"
 #include "global_include.h"
 #include "px4_custom_mode.h"
+#include <algorithm>
 #include <cmath>
 
 namespace mavsdk {
@@ -145,8 +146,7 @@ FollowMe::Result FollowMeImpl::set_target_location(const FollowMe::TargetLocatio
 {
     _mutex.lock();
     _target_location = location;
-    // We're interested only in lat, long.
-    _estimation_capabilities |= (1 << static_cast<int>(EstimationCapabilities::POS));
+    _predictor.update(location, _time.elapsed_s());
 
     if (_mode != Mode::ACTIVE) {
         _mutex.unlock();
@@ -157,8 +157,9 @@ FollowMe::Result FollowMeImpl::set_target_location(const FollowMe::TargetLocatio
         _parent->reset_call_every(_target_location_cookie);
     } else {
         // Register now for sending in the next cycle.
+        _send_interval_s = send_interval_s();
         _parent->add_call_every(
-            [this]() { send_target_location(); }, SENDER_RATE, &_target_location_cookie);
+            [this]() { send_target_location(); }, _send_interval_s, &_target_location_cookie);
     }
     _mutex.unlock();
 
@@ -190,8 +191,9 @@ FollowMe::Result FollowMeImpl::start()
         std::lock_guard<std::mutex> lock(
             _mutex); // locking is not necessary here but lets do it for integrity
         if (is_target_location_set()) {
+            _send_interval_s = send_interval_s();
             _parent->add_call_every(
-                [this]() { send_target_location(); }, SENDER_RATE, &_target_location_cookie);
+                [this]() { send_target_location(); }, _send_interval_s, &_target_location_cookie);
         }
     }
     return result;
@@ -265,22 +267,33 @@ void FollowMeImpl::send_target_location()
         return;
     }
 
-    dl_time_t now = _time.steady_time();
+    // The location is predicted for now, as it is sent, rather than when the
+    // timer was due or the target was located.
+    const double now_s = _time.elapsed_s();
     // needed by http://mavlink.org/messages/common#FOLLOW_TARGET
-    uint64_t elapsed_msec =
-        static_cast<uint64_t>(_time.elapsed_since_s(now) * 1000); // milliseconds
+    const uint64_t timestamp_ms = static_cast<uint64_t>(now_s * 1000);
 
     _mutex.lock();
-    //   LogDebug() << debug_str <<  "Lat: " << _target_location.latitude_deg << " Lon: " <<
-    //   _target_location.longitude_deg <<
-    //	" Alt: " << _target_location.absolute_altitude_m;
-    const int32_t lat_int = int32_t(std::round(_target_location.latitude_deg * 1e7));
-    const int32_t lon_int = int32_t(std::round(_target_location.longitude_deg * 1e7));
-    const float alt = static_cast<float>(_target_location.absolute_altitude_m);
+    const auto prediction = _predictor.predict(now_s);
+    uint8_t estimation_capabilities = 1 << static_cast<int>(EstimationCapabilities::POS);
+    if (_predictor.has_velocity()) {
+        estimation_capabilities |= 1 << static_cast<int>(EstimationCapabilities::VEL);
+    }
+
+    // Adapt to how fast the target moves now.
+    const float interval_s = send_interval_s();
+    if (_target_location_cookie && std::fabs(interval_s - _send_interval_s) > 0.01f) {
+        _send_interval_s = interval_s;
+        _parent->change_call_every(_send_interval_s, _target_location_cookie);
+    }
     _mutex.unlock();
 
-    const float pos_std_dev[] = {NAN, NAN, NAN};
-    const float vel[] = {NAN, NAN, NAN};
+    const auto& location = prediction.location;
+    const int32_t lat_int = int32_t(std::round(location.latitude_deg * 1e7));
+    const int32_t lon_int = int32_t(std::round(location.longitude_deg * 1e7));
+    const float alt = location.absolute_altitude_m;
+
+    const float vel[] = {location.velocity_x_m_s, location.velocity_y_m_s, location.velocity_z_m_s};
     const float accel_unknown[] = {NAN, NAN, NAN};
     const float attitude_q_unknown[] = {1.f, NAN, NAN, NAN};
     const float rates_unknown[] = {NAN, NAN, NAN};
@@ -291,8 +304,8 @@ void FollowMeImpl::send_target_location()
         _parent->get_own_system_id(),
         _parent->get_own_component_id(),
         &msg,
-        elapsed_msec,
-        _estimation_capabilities,
+        timestamp_ms,
+        estimation_capabilities,
         lat_int,
         lon_int,
         alt,
@@ -300,15 +313,25 @@ void FollowMeImpl::send_target_location()
         accel_unknown,
         attitude_q_unknown,
         rates_unknown,
-        pos_std_dev,
+        prediction.position_std_dev_m,
         custom_state);
 
     if (!_parent->send_message(msg)) {
         LogErr() << debug_str << "send_target_location() failed..";
     } else {
         std::lock_guard<std::mutex> lock(_mutex);
-        _last_location = _target_location;
+        _last_location = location;
+    }
+}
+
+float FollowMeImpl::send_interval_s() const
+{
+    // We assume that mutex was acquired by the caller
+    const auto speed_m_s = static_cast<float>(_predictor.ground_speed_m_s());
+    if (speed_m_s * MAX_SEND_INTERVAL_S <= DISTANCE_PER_SEND_M) {
+        return MAX_SEND_INTERVAL_S;
     }
+    return std::max(DISTANCE_PER_SEND_M / speed_m_s, MIN_SEND_INTERVAL_S);
 }
 
 void FollowMeImpl::stop_sending_target_location()
@@ -6,6 +6,7 @@
 #include "plugins/follow_me/follow_me.h"
 #include "plugin_impl_base.h"
 #include "system.h"
+#include "target_predictor.h"
 #include "timeout_handler.h"
 
 namespace mavsdk {
@@ -48,6 +49,7 @@ private:
     bool is_target_location_set() const;
     void send_target_location();
     void stop_sending_target_location();
+    float send_interval_s() const;
 
     enum class EstimationCapabilities { POS, VEL };
 
@@ -85,15 +87,20 @@ private:
     }
 
     mutable std::mutex _mutex{};
-    FollowMe::TargetLocation _target_location{}; // sent to vehicle
+    FollowMe::TargetLocation _target_location{}; // set by user
     FollowMe::TargetLocation _last_location{}; // sent to vehicle
+    TargetPredictor _predictor{}; // extrapolates the target to the time it is sent
     void* _target_location_cookie = nullptr;
+    float _send_interval_s = MAX_SEND_INTERVAL_S;
 
     Time _time{};
-    uint8_t _estimation_capabilities = 0; // sent to vehicle
     FollowMe::Config _config{}; // has FollowMe configuration settings
 
-    const float SENDER_RATE = 1.0f; // send location updates once in a second
+    // Locations are sent more often the faster the target is, so that it
+    // moves about the same distance in between.
+    constexpr static const float DISTANCE_PER_SEND_M = 1.0f;
+    constexpr static const float MIN_SEND_INTERVAL_S = 0.1f;
+    constexpr static const float MAX_SEND_INTERVAL_S = 1.0f;
 
     std::string debug_str = "FollowMe: ";
 };
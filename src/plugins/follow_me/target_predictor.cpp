@@ -0,0 +1,182 @@
+#include "target_predictor.h"
+#include "geometry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mavsdk {
+
+// A person walking or a car, located by a phone or a handheld GPS.
+static constexpr TargetPredictor::Config default_config{
+    3.0, // position_std_dev_m
+    0.5, // velocity_std_dev_m_s
+    2.0, // acceleration_std_dev_m_s2
+    2.0, // max_prediction_s
+};
+
+// Of the velocity before it is known, anything up to a fast car.
+static constexpr double unknown_velocity_variance = 30.0 * 30.0;
+
+TargetPredictor::TargetPredictor() : TargetPredictor(default_config) {}
+
+TargetPredictor::TargetPredictor(const Config& config) : _config(config) {}
+
+void TargetPredictor::reset()
+{
+    for (auto& axis : _axes) {
+        axis = Axis{};
+    }
+    _time_s = 0.0;
+    _num_updates = 0;
+    _has_velocity = false;
+}
+
+void TargetPredictor::update(const FollowMe::TargetLocation& location, double time_s)
+{
+    if (!std::isfinite(location.latitude_deg) || !std::isfinite(location.longitude_deg)) {
+        return;
+    }
+
+    if (_num_updates == 0) {
+        _reference_latitude_deg = location.latitude_deg;
+        _reference_longitude_deg = location.longitude_deg;
+    } else {
+        const double dt = time_s - _time_s;
+        if (dt > 0.0) {
+            for (auto& axis : _axes) {
+                predict_axis(axis, dt);
+            }
+        }
+    }
+    _time_s = std::max(_time_s, time_s);
+    ++_num_updates;
+    if (_num_updates > 1 ||
+        (std::isfinite(location.velocity_x_m_s) && std::isfinite(location.velocity_y_m_s))) {
+        _has_velocity = true;
+    }
+
+    const geometry::CoordinateTransformation transformation(
+        {_reference_latitude_deg, _reference_longitude_deg});
+    const auto local =
+        transformation.local_from_global({location.latitude_deg, location.longitude_deg});
+
+    update_axis(_axes[NORTH], local.north_m, location.velocity_x_m_s);
+    update_axis(_axes[EAST], local.east_m, location.velocity_y_m_s);
+    if (std::isfinite(location.absolute_altitude_m)) {
+        update_axis(
+            _axes[UP], double(location.absolute_altitude_m), -location.velocity_z_m_s);
+    }
+}
+
+TargetPredictor::Prediction TargetPredictor::predict(double time_s) const
+{
+    Prediction prediction{{}, {NAN, NAN, NAN}};
+    if (_num_updates == 0) {
+        return prediction;
+    }
+
+    const double dt = std::min(std::max(time_s - _time_s, 0.0), _config.max_prediction_s);
+
+    Axis axes[NUM_AXES];
+    for (int i = 0; i < NUM_AXES; ++i) {
+        axes[i] = _axes[i];
+        predict_axis(axes[i], dt);
+    }
+
+    const geometry::CoordinateTransformation transformation(
+        {_reference_latitude_deg, _reference_longitude_deg});
+    const auto global =
+        transformation.global_from_local({axes[NORTH].position, axes[EAST].position});
+
+    auto& location = prediction.location;
+    location.latitude_deg = global.latitude_deg;
+    location.longitude_deg = global.longitude_deg;
+    location.velocity_x_m_s = static_cast<float>(axes[NORTH].velocity);
+    location.velocity_y_m_s = static_cast<float>(axes[EAST].velocity);
+    prediction.position_std_dev_m[0] = static_cast<float>(std::sqrt(axes[NORTH].p00));
+    prediction.position_std_dev_m[1] = static_cast<float>(std::sqrt(axes[EAST].p00));
+
+    if (axes[UP].initialized) {
+        location.absolute_altitude_m = static_cast<float>(axes[UP].position);
+        location.velocity_z_m_s = static_cast<float>(-axes[UP].velocity);
+        prediction.position_std_dev_m[2] = static_cast<float>(std::sqrt(axes[UP].p00));
+    }
+
+    return prediction;
+}
+
+double TargetPredictor::ground_speed_m_s() const
+{
+    return std::hypot(_axes[NORTH].velocity, _axes[EAST].velocity);
+}
+
+void TargetPredictor::predict_axis(Axis& axis, double dt) const
+{
+    axis.position += axis.velocity * dt;
+
+    // Constant acceleration during dt, as process noise.
+    const double variance =
+        _config.acceleration_std_dev_m_s2 * _config.acceleration_std_dev_m_s2;
+    const double dt2 = dt * dt;
+
+    axis.p00 += 2.0 * dt * axis.p01 + dt2 * axis.p11 + variance * dt2 * dt2 / 4.0;
+    axis.p01 += dt * axis.p11 + variance * dt2 * dt / 2.0;
+    axis.p11 += variance * dt2;
+}
+
+void TargetPredictor::update_axis(Axis& axis, double position, float velocity)
+{
+    const double position_variance = _config.position_std_dev_m * _config.position_std_dev_m;
+    const double velocity_variance = _config.velocity_std_dev_m_s * _config.velocity_std_dev_m_s;
+
+    if (!axis.initialized) {
+        axis.initialized = true;
+        axis.position = position;
+        axis.p00 = position_variance;
+        axis.p01 = 0.0;
+        if (std::isfinite(velocity)) {
+            axis.velocity = double(velocity);
+            axis.p11 = velocity_variance;
+        } else {
+            axis.velocity = 0.0;
+            axis.p11 = unknown_velocity_variance;
+        }
+        return;
+    }
+
+    update_position(axis, position, position_variance);
+    if (std::isfinite(velocity)) {
+        update_velocity(axis, double(velocity), velocity_variance);
+    }
+}
+
+void TargetPredictor::update_position(Axis& axis, double position, double variance)
+{
+    const double s = axis.p00 + variance;
+    const double k0 = axis.p00 / s;
+    const double k1 = axis.p01 / s;
+    const double innovation = position - axis.position;
+
+    axis.position += k0 * innovation;
+    axis.velocity += k1 * innovation;
+
+    axis.p11 -= k1 * axis.p01;
+    axis.p00 *= (1.0 - k0);
+    axis.p01 *= (1.0 - k0);
+}
+
+void TargetPredictor::update_velocity(Axis& axis, double velocity, double variance)
+{
+    const double s = axis.p11 + variance;
+    const double k0 = axis.p01 / s;
+    const double k1 = axis.p11 / s;
+    const double innovation = velocity - axis.velocity;
+
+    axis.position += k0 * innovation;
+    axis.velocity += k1 * innovation;
+
+    axis.p00 -= k0 * axis.p01;
+    axis.p01 *= (1.0 - k1);
+    axis.p11 *= (1.0 - k1);
+}
+
+} // namespace mavsdk
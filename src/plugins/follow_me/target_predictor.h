@@ -0,0 +1,82 @@
+#pragma once
+
+#include "plugins/follow_me/follow_me.h"
+
+namespace mavsdk {
+
+// Estimates where the follow me target is at a given time from the locations
+// set for it so far, so that positions sent in between fixes are not stale.
+//
+// The target is assumed to move at constant velocity, with accelerations as
+// noise, and north, east and altitude are each tracked by a Kalman filter in
+// a local frame around the first location.
+//
+// Velocities of the target locations are in north, east, down, and only used
+// if they are finite. Predicting doesn't allocate, so it can be done from any
+// thread.
+class TargetPredictor {
+public:
+    struct Config {
+        double position_std_dev_m;
+        double velocity_std_dev_m_s;
+        double acceleration_std_dev_m_s2;
+        // Predictions further ahead than this after the last location are
+        // not extrapolated anymore.
+        double max_prediction_s;
+    };
+
+    struct Prediction {
+        // The velocities are set as well, as far as known.
+        FollowMe::TargetLocation location;
+        float position_std_dev_m[3];
+    };
+
+    TargetPredictor();
+    explicit TargetPredictor(const Config& config);
+    ~TargetPredictor() = default;
+
+    void reset();
+
+    void update(const FollowMe::TargetLocation& location, double time_s);
+
+    bool has_location() const { return _num_updates > 0; }
+
+    // Whether the velocity is known, from the target or from two locations.
+    bool has_velocity() const { return _has_velocity; }
+
+    // Before the first location, all of it is NAN.
+    Prediction predict(double time_s) const;
+
+    // Horizontal speed at the last location.
+    double ground_speed_m_s() const;
+
+private:
+    struct Axis {
+        bool initialized{false};
+        double position{0.0};
+        double velocity{0.0};
+        // Covariance, which is symmetric.
+        double p00{0.0};
+        double p01{0.0};
+        double p11{0.0};
+    };
+
+    enum { NORTH, EAST, UP, NUM_AXES };
+
+    void predict_axis(Axis& axis, double dt) const;
+    void update_axis(Axis& axis, double position, float velocity);
+    static void update_position(Axis& axis, double position, double variance);
+    static void update_velocity(Axis& axis, double velocity, double variance);
+
+    Config _config;
+
+    Axis _axes[NUM_AXES]{};
+    double _time_s{0.0};
+    unsigned _num_updates{0};
+    bool _has_velocity{false};
+
+    double _reference_latitude_deg{0.0};
+    double _reference_longitude_deg{0.0};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,137 @@
+#include "target_predictor.h"
+#include "geometry.h"
+#include <cmath>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+static const geometry::CoordinateTransformation::GlobalCoordinate reference{47.3977419, 8.5455938};
+
+static FollowMe::TargetLocation location_at(double north_m, double east_m, float altitude_m)
+{
+    const geometry::CoordinateTransformation transformation(reference);
+    const auto global = transformation.global_from_local({north_m, east_m});
+
+    FollowMe::TargetLocation location{};
+    location.latitude_deg = global.latitude_deg;
+    location.longitude_deg = global.longitude_deg;
+    location.absolute_altitude_m = altitude_m;
+    return location;
+}
+
+static double distance_m(const FollowMe::TargetLocation& lhs, const FollowMe::TargetLocation& rhs)
+{
+    const geometry::CoordinateTransformation transformation(reference);
+    const auto lhs_local = transformation.local_from_global({lhs.latitude_deg, lhs.longitude_deg});
+    const auto rhs_local = transformation.local_from_global({rhs.latitude_deg, rhs.longitude_deg});
+    return std::hypot(lhs_local.north_m - rhs_local.north_m, lhs_local.east_m - rhs_local.east_m);
+}
+
+TEST(TargetPredictor, KnowsNothingAtFirst)
+{
+    TargetPredictor predictor;
+    EXPECT_FALSE(predictor.has_location());
+    EXPECT_FALSE(predictor.has_velocity());
+
+    const auto prediction = predictor.predict(1.0);
+    EXPECT_TRUE(std::isnan(prediction.location.latitude_deg));
+    EXPECT_TRUE(std::isnan(prediction.location.absolute_altitude_m));
+}
+
+TEST(TargetPredictor, KeepsStationaryTarget)
+{
+    TargetPredictor predictor;
+    const auto location = location_at(0.0, 0.0, 500.0f);
+    for (int i = 0; i < 10; ++i) {
+        predictor.update(location, i * 1.0);
+    }
+
+    const auto prediction = predictor.predict(10.5);
+    EXPECT_LT(distance_m(prediction.location, location), 0.01);
+    EXPECT_NEAR(prediction.location.absolute_altitude_m, 500.0f, 0.01f);
+    EXPECT_NEAR(predictor.ground_speed_m_s(), 0.0, 0.01);
+}
+
+TEST(TargetPredictor, ReducesLagOfMovingTarget)
+{
+    // Driving north east at 10 m/s with a fix every second, sent at 10 Hz.
+    const double speed_north_m_s = 6.0;
+    const double speed_east_m_s = 8.0;
+
+    TargetPredictor predictor;
+
+    double lag_predicted_m = 0.0;
+    double lag_last_fix_m = 0.0;
+    int num_sent = 0;
+
+    FollowMe::TargetLocation last_fix{};
+    for (int step = 0; step < 200; ++step) {
+        const double time_s = step * 0.1;
+        const auto truth = location_at(speed_north_m_s * time_s, speed_east_m_s * time_s, 500.0f);
+
+        if (step % 10 == 0) {
+            last_fix = truth;
+            predictor.update(last_fix, time_s);
+        }
+
+        // Once it had some fixes to go by.
+        if (time_s >= 5.0) {
+            lag_predicted_m += distance_m(predictor.predict(time_s).location, truth);
+            lag_last_fix_m += distance_m(last_fix, truth);
+            ++num_sent;
+        }
+    }
+
+    EXPECT_TRUE(predictor.has_velocity());
+
+    lag_predicted_m /= num_sent;
+    lag_last_fix_m /= num_sent;
+
+    EXPECT_NEAR(lag_last_fix_m, 4.5, 0.1);
+    EXPECT_LT(lag_predicted_m, 0.5);
+    EXPECT_NEAR(predictor.ground_speed_m_s(), 10.0, 0.1);
+
+    const auto prediction = predictor.predict(20.0);
+    EXPECT_NEAR(prediction.location.velocity_x_m_s, 6.0f, 0.1f);
+    EXPECT_NEAR(prediction.location.velocity_y_m_s, 8.0f, 0.1f);
+    EXPECT_NEAR(prediction.location.velocity_z_m_s, 0.0f, 0.1f);
+}
+
+TEST(TargetPredictor, UsesVelocityOfTarget)
+{
+    TargetPredictor predictor;
+    auto location = location_at(0.0, 0.0, 500.0f);
+    location.velocity_x_m_s = 5.0f;
+    location.velocity_y_m_s = 0.0f;
+    location.velocity_z_m_s = -1.0f;
+    predictor.update(location, 0.0);
+    EXPECT_TRUE(predictor.has_velocity());
+
+    const auto prediction = predictor.predict(1.0);
+    EXPECT_NEAR(distance_m(prediction.location, location_at(5.0, 0.0, 500.0f)), 0.0, 0.01);
+    EXPECT_NEAR(prediction.location.absolute_altitude_m, 501.0f, 0.01f);
+    EXPECT_NEAR(prediction.location.velocity_z_m_s, -1.0f, 0.01f);
+}
+
+TEST(TargetPredictor, StopsExtrapolating)
+{
+    TargetPredictor::Config config{3.0, 0.5, 2.0, 2.0};
+    TargetPredictor predictor(config);
+    auto location = location_at(0.0, 0.0, 500.0f);
+    location.velocity_x_m_s = 5.0f;
+    location.velocity_y_m_s = 0.0f;
+    predictor.update(location, 0.0);
+
+    EXPECT_NEAR(
+        distance_m(predictor.predict(60.0).location, location_at(10.0, 0.0, 500.0f)), 0.0, 0.01);
+
+    // Not back in time either.
+    EXPECT_NEAR(distance_m(predictor.predict(-1.0).location, location), 0.0, 0.01);
+
+    const auto later = predictor.predict(1.0);
+    EXPECT_GT(later.position_std_dev_m[0], 3.0f);
+
+    predictor.reset();
+    EXPECT_FALSE(predictor.has_location());
+    EXPECT_FALSE(predictor.has_velocity());
+}
@@ -0,0 +1,87 @@
+#include "burst_pacer.h"
+#include <algorithm>
+
+namespace mavsdk {
+
+// Starts slow enough for a 57600 baud telemetry radio, and goes up to what a
+// network link on the same machine does.
+static constexpr BurstPacer::Config default_config{
+    5000.0, // initial_rate_bytes_s
+    1000.0, // min_rate_bytes_s
+    2000000.0, // max_rate_bytes_s
+    20000.0, // increase_bytes_s2
+    0.05, // bucket_duration_s
+    300.0, // min_bucket_bytes
+    0.5, // decrease_holdoff_s
+};
+
+BurstPacer::BurstPacer() : BurstPacer(default_config) {}
+
+BurstPacer::BurstPacer(const Config& config) :
+    _config(config),
+    _rate_bytes_s(config.initial_rate_bytes_s)
+{}
+
+void BurstPacer::reset()
+{
+    _rate_bytes_s = _config.initial_rate_bytes_s;
+    _tokens = 0.0;
+    _limited = false;
+    _refilled_before = false;
+    _decreased_before = false;
+}
+
+void BurstPacer::refill(Clock::time_point now)
+{
+    if (!_refilled_before) {
+        _refilled_before = true;
+        _last_refill = now;
+        return;
+    }
+
+    const double elapsed_s = std::chrono::duration<double>(now - _last_refill).count();
+    if (elapsed_s <= 0.0) {
+        return;
+    }
+    _last_refill = now;
+
+    if (_limited) {
+        _rate_bytes_s = std::min(
+            _rate_bytes_s + _config.increase_bytes_s2 * elapsed_s, _config.max_rate_bytes_s);
+        _limited = false;
+    }
+
+    _tokens = std::min(_tokens + _rate_bytes_s * elapsed_s, bucket_bytes());
+}
+
+bool BurstPacer::try_consume(size_t num_bytes)
+{
+    const auto bytes = static_cast<double>(num_bytes);
+    if (_tokens < bytes) {
+        _limited = true;
+        return false;
+    }
+    _tokens -= bytes;
+    return true;
+}
+
+void BurstPacer::congestion(Clock::time_point now)
+{
+    if (_decreased_before && std::chrono::duration<double>(now - _last_decrease).count() <
+                                 _config.decrease_holdoff_s) {
+        return;
+    }
+    _decreased_before = true;
+    _last_decrease = now;
+
+    _rate_bytes_s = std::max(_rate_bytes_s / 2.0, _config.min_rate_bytes_s);
+    _tokens = std::min(_tokens, bucket_bytes());
+    _limited = false;
+}
+
+double BurstPacer::bucket_bytes() const
+{
+    return std::max(_rate_bytes_s * _config.bucket_duration_s, _config.min_bucket_bytes);
+}
+
+} // namespace mavsdk
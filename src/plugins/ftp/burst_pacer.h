@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+namespace mavsdk {
+
+// Decides when the FTP server can send the next packet of a burst download.
+//
+// It is a token bucket: tokens, in bytes, are added at the current rate and
+// taken out again for every packet sent. The rate follows what the link can
+// carry: it grows linearly as long as there is more to send than it allows,
+// and it is halved when packets get lost or can't be sent.
+class BurstPacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        double initial_rate_bytes_s;
+        double min_rate_bytes_s;
+        double max_rate_bytes_s;
+        // How much the rate grows per second while we are limited by it.
+        double increase_bytes_s2;
+        // How long the link can be used at the full rate after a pause.
+        double bucket_duration_s;
+        // The bucket always holds at least this, so a packet can be sent.
+        double min_bucket_bytes;
+        // Losses this soon after a decrease belong to the same congestion.
+        double decrease_holdoff_s;
+    };
+
+    BurstPacer();
+    explicit BurstPacer(const Config& config);
+    ~BurstPacer() = default;
+
+    // Starts over at the initial rate with an empty bucket.
+    void reset();
+
+    // Adds the tokens for the time since the last refill.
+    void refill(Clock::time_point now);
+
+    // Takes the tokens for num_bytes out of the bucket if there are enough.
+    bool try_consume(size_t num_bytes);
+
+    // Packets were lost or could not be sent.
+    void congestion(Clock::time_point now);
+
+    double rate_bytes_s() const { return _rate_bytes_s; }
+    double tokens() const { return _tokens; }
+
+    // Non-copyable
+    BurstPacer(const BurstPacer&) = delete;
+    const BurstPacer& operator=(const BurstPacer&) = delete;
+
+private:
+    double bucket_bytes() const;
+
+    const Config _config;
+
+    double _rate_bytes_s;
+    double _tokens{0.0};
+    // Whether try_consume() had to say no since the last refill.
+    bool _limited{false};
+
+    bool _refilled_before{false};
+    Clock::time_point _last_refill{};
+    bool _decreased_before{false};
+    Clock::time_point _last_decrease{};
+};
+
+} // namespace mavsdk
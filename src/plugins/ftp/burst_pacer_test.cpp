@@ -0,0 +1,119 @@
+#include "burst_pacer.h"
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+using Clock = BurstPacer::Clock;
+
+static constexpr BurstPacer::Config test_config{
+    10000.0, // initial_rate_bytes_s
+    1000.0, // min_rate_bytes_s
+    40000.0, // max_rate_bytes_s
+    0.0, // increase_bytes_s2
+    0.1, // bucket_duration_s
+    300.0, // min_bucket_bytes
+    0.5, // decrease_holdoff_s
+};
+
+static constexpr size_t packet_bytes = 263;
+
+// Sends as many packets as allowed for duration_s with a tick every 10 ms,
+// returns the bytes sent.
+static size_t send_for(BurstPacer& pacer, Clock::time_point& now, double duration_s)
+{
+    size_t bytes_sent = 0;
+    const int num_ticks = static_cast<int>(duration_s / 0.01);
+    for (int i = 0; i < num_ticks; ++i) {
+        now += std::chrono::milliseconds(10);
+        pacer.refill(now);
+        while (pacer.try_consume(packet_bytes)) {
+            bytes_sent += packet_bytes;
+        }
+    }
+    return bytes_sent;
+}
+
+TEST(BurstPacer, StartsEmpty)
+{
+    BurstPacer pacer(test_config);
+    pacer.refill(Clock::now());
+    EXPECT_FALSE(pacer.try_consume(1));
+}
+
+TEST(BurstPacer, SendsAtRate)
+{
+    BurstPacer pacer(test_config);
+    auto now = Clock::now();
+    pacer.refill(now);
+
+    const size_t bytes_sent = send_for(pacer, now, 10.0);
+    EXPECT_NEAR(static_cast<double>(bytes_sent), 100000.0, packet_bytes);
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 10000.0);
+}
+
+TEST(BurstPacer, LimitsBucketAfterPause)
+{
+    BurstPacer pacer(test_config);
+    auto now = Clock::now();
+    pacer.refill(now);
+
+    now += std::chrono::seconds(10);
+    pacer.refill(now);
+    EXPECT_DOUBLE_EQ(pacer.tokens(), 1000.0);
+}
+
+TEST(BurstPacer, GrowsWhileLimited)
+{
+    auto config = test_config;
+    config.increase_bytes_s2 = 10000.0;
+    BurstPacer pacer(config);
+    auto now = Clock::now();
+    pacer.refill(now);
+
+    send_for(pacer, now, 1.0);
+    EXPECT_NEAR(pacer.rate_bytes_s(), 20000.0, 100.0);
+
+    send_for(pacer, now, 10.0);
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 40000.0);
+}
+
+TEST(BurstPacer, DoesNotGrowWithoutDemand)
+{
+    auto config = test_config;
+    config.increase_bytes_s2 = 10000.0;
+    BurstPacer pacer(config);
+    auto now = Clock::now();
+
+    for (int i = 0; i < 100; ++i) {
+        pacer.refill(now);
+        now += std::chrono::milliseconds(10);
+    }
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 10000.0);
+}
+
+TEST(BurstPacer, HalvesOnCongestion)
+{
+    BurstPacer pacer(test_config);
+    auto now = Clock::now();
+
+    pacer.congestion(now);
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 5000.0);
+
+    // Still the same congestion.
+    now += std::chrono::milliseconds(100);
+    pacer.congestion(now);
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 5000.0);
+
+    now += std::chrono::seconds(1);
+    pacer.congestion(now);
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 2500.0);
+
+    for (int i = 0; i < 10; ++i) {
+        now += std::chrono::seconds(1);
+        pacer.congestion(now);
+    }
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 1000.0);
+
+    pacer.reset();
+    EXPECT_DOUBLE_EQ(pacer.rate_bytes_s(), 10000.0);
+}
@@ -36,9 +36,29 @@
 
 #include "crc32.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+#if !defined(WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CRC32_PCLMUL 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CRC32_ARMV8 1
+#include <arm_acle.h>
+#endif
+
 namespace mavsdk {
 
-static const uint32_t crc32_tab[] = {
+static constexpr uint32_t crc32_tab[256] = {
     0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
     0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
     0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
@@ -72,12 +92,286 @@ static const uint32_t crc32_tab[] = {
     0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
     0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
 
-uint32_t Crc32::add(const uint8_t* src, uint32_t len)
+// For slicing-by-8 we need 8 tables, table n gives the CRC of a byte followed by n zero bytes.
+struct SliceTables {
+    uint32_t data[8][256];
+};
+
+static constexpr SliceTables make_slice_tables()
+{
+    SliceTables tables{};
+    for (unsigned i = 0; i < 256; ++i) {
+        tables.data[0][i] = crc32_tab[i];
+    }
+    for (unsigned n = 1; n < 8; ++n) {
+        for (unsigned i = 0; i < 256; ++i) {
+            const uint32_t previous = tables.data[n - 1][i];
+            tables.data[n][i] = (previous >> 8) ^ crc32_tab[previous & 0xff];
+        }
+    }
+    return tables;
+}
+
+static constexpr SliceTables slice_tables = make_slice_tables();
+
+static uint32_t update_bytewise(uint32_t crc, const uint8_t* src, std::size_t len)
+{
+    for (std::size_t i = 0; i < len; i++) {
+        crc = crc32_tab[(crc ^ src[i]) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static uint32_t update_slice_by_8(uint32_t crc, const uint8_t* src, std::size_t len)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    // The tables below assume little endian loads.
+    return update_bytewise(crc, src, len);
+#else
+    const auto& t = slice_tables.data;
+
+    while (len >= 8) {
+        uint32_t one;
+        uint32_t two;
+        std::memcpy(&one, src, sizeof(one));
+        std::memcpy(&two, src + 4, sizeof(two));
+        one ^= crc;
+
+        crc = t[7][one & 0xff] ^ t[6][(one >> 8) & 0xff] ^ t[5][(one >> 16) & 0xff] ^
+              t[4][one >> 24] ^ t[3][two & 0xff] ^ t[2][(two >> 8) & 0xff] ^
+              t[1][(two >> 16) & 0xff] ^ t[0][two >> 24];
+
+        src += 8;
+        len -= 8;
+    }
+
+    return update_bytewise(crc, src, len);
+#endif
+}
+
+#if defined(CRC32_PCLMUL)
+// Folding using carry-less multiplication as described in the Intel paper
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+// with the constants for the bit-reflected polynomial 0xEDB88320.
+//
+// Note that the SSE4.2 crc32 instruction can't be used here because it
+// implements the Castagnoli polynomial.
+//
+#define CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+
+CRC32_PCLMUL_TARGET static inline __m128i load_128(const uint8_t* src)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+
+CRC32_PCLMUL_TARGET static inline __m128i fold_128(__m128i x, __m128i k, __m128i next)
+{
+    const __m128i low = _mm_clmulepi64_si128(x, k, 0x00);
+    const __m128i high = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+// Requires len to be a multiple of 16 and at least 64.
+CRC32_PCLMUL_TARGET static uint32_t
+fold_pclmul(uint32_t crc, const uint8_t* src, std::size_t len)
+{
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    __m128i x1 = load_128(src + 0x00);
+    __m128i x2 = load_128(src + 0x10);
+    __m128i x3 = load_128(src + 0x20);
+    __m128i x4 = load_128(src + 0x30);
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+    __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+
+    src += 64;
+    len -= 64;
+
+    // Fold 4 x 128 bits in parallel.
+    while (len >= 64) {
+        x1 = fold_128(x1, x0, load_128(src + 0x00));
+        x2 = fold_128(x2, x0, load_128(src + 0x10));
+        x3 = fold_128(x3, x0, load_128(src + 0x20));
+        x4 = fold_128(x4, x0, load_128(src + 0x30));
+
+        src += 64;
+        len -= 64;
+    }
+
+    // Fold into 128 bits.
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+
+    x1 = fold_128(x1, x0, x2);
+    x1 = fold_128(x1, x0, x3);
+    x1 = fold_128(x1, x0, x4);
+
+    // Fold remaining blocks of 128 bits.
+    while (len >= 16) {
+        x1 = fold_128(x1, x0, load_128(src));
+        src += 16;
+        len -= 16;
+    }
+
+    // Fold 128 bits to 64 bits.
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits.
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+static uint32_t update_pclmul(uint32_t crc, const uint8_t* src, std::size_t len)
+{
+    if (len >= 64) {
+        const std::size_t folded = len & ~std::size_t(15);
+        crc = fold_pclmul(crc, src, folded);
+        src += folded;
+        len -= folded;
+    }
+    return update_slice_by_8(crc, src, len);
+}
+#endif
+
+#if defined(CRC32_ARMV8)
+static uint32_t update_armv8(uint32_t crc, const uint8_t* src, std::size_t len)
 {
-    for (uint32_t i = 0; i < len; i++) {
-        val = crc32_tab[(val ^ src[i]) & 0xff] ^ (val >> 8);
+    while (len >= 8) {
+        uint64_t value;
+        std::memcpy(&value, src, sizeof(value));
+        crc = __crc32d(crc, value);
+        src += 8;
+        len -= 8;
     }
+    while (len > 0) {
+        crc = __crc32b(crc, *src);
+        ++src;
+        --len;
+    }
+    return crc;
+}
+#endif
+
+namespace {
+
+struct Implementation {
+    uint32_t (*update)(uint32_t crc, const uint8_t* src, std::size_t len);
+    const char* name;
+};
+
+const Implementation& implementation_for_cpu()
+{
+    static const Implementation implementation = []() -> Implementation {
+#if defined(CRC32_PCLMUL)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+            return {update_pclmul, "pclmul"};
+        }
+#elif defined(CRC32_ARMV8)
+        return {update_armv8, "armv8"};
+#endif
+        return {update_slice_by_8, "slice-by-8"};
+    }();
+    return implementation;
+}
+
+} // namespace
+
+uint32_t Crc32::add(const uint8_t* src, uint32_t len)
+{
+    val = implementation_for_cpu().update(val, src, len);
     return val;
 }
 
-} // namespace mavsdk
\ No newline at end of file
+const char* Crc32::implementation()
+{
+    return implementation_for_cpu().name;
+}
+
+bool Crc32::add_file(const std::string& path, uint64_t max_bytes)
+{
+    // We hand the data over in steps so we don't overflow the 32 bit length of add().
+    static constexpr std::size_t step = 1024 * 1024;
+
+#if !defined(WINDOWS)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat stat_buf;
+    if (fstat(fd, &stat_buf) != 0) {
+        close(fd);
+        return false;
+    }
+
+    const uint64_t file_size = static_cast<uint64_t>(stat_buf.st_size);
+    const uint64_t length = std::min(max_bytes, file_size);
+
+    if (length == 0) {
+        close(fd);
+        return max_bytes == std::numeric_limits<uint64_t>::max() || max_bytes == 0;
+    }
+
+    // Map the whole file instead of copying it through a buffer.
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapped != MAP_FAILED) {
+        madvise(mapped, length, MADV_SEQUENTIAL);
+
+        const auto* data = static_cast<const uint8_t*>(mapped);
+        for (uint64_t offset = 0; offset < length; offset += step) {
+            add(data + offset, static_cast<uint32_t>(std::min<uint64_t>(step, length - offset)));
+        }
+
+        munmap(mapped, length);
+
+        return max_bytes == std::numeric_limits<uint64_t>::max() || length == max_bytes;
+    }
+#endif
+
+    // Fallback if mmap is not available: read in big aligned chunks.
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    struct alignas(64) Chunk {
+        char data[step];
+    };
+    std::unique_ptr<Chunk> buffer(new Chunk);
+
+    uint64_t remaining = max_bytes;
+    while (remaining > 0 && file) {
+        file.read(buffer->data, static_cast<std::streamsize>(std::min<uint64_t>(step, remaining)));
+        const auto bytes_read = file.gcount();
+        add(reinterpret_cast<const uint8_t*>(buffer->data), static_cast<uint32_t>(bytes_read));
+        remaining -= static_cast<uint64_t>(bytes_read);
+    }
+
+    return !file.bad() && (max_bytes == std::numeric_limits<uint64_t>::max() || remaining == 0);
+}
+
+} // namespace mavsdk
@@ -1,17 +1,32 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
+#include <string>
 
 namespace mavsdk {
 
+// CRC32 as used by MAVLink FTP (polynomial 0xEDB88320, initial value 0, no final XOR).
+//
+// Depending on what the CPU supports at runtime the checksum is calculated
+// using carry-less multiplication (PCLMULQDQ), the ARMv8 CRC32 instructions,
+// or slicing-by-8 tables.
 class Crc32 {
 public:
     uint32_t add(const uint8_t* src, uint32_t len);
 
+    // Adds the content of a file, or only its first max_bytes.
+    // Returns false if the file could not be read (or is shorter than max_bytes).
+    bool add_file(
+        const std::string& path, uint64_t max_bytes = std::numeric_limits<uint64_t>::max());
+
     int32_t get() { return val; }
 
+    // Name of the implementation selected for this CPU.
+    static const char* implementation();
+
 private:
     uint32_t val{0};
 };
 
-} // namespace mavsdk
\ No newline at end of file
+} // namespace mavsdk
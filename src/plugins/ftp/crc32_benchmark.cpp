@@ -0,0 +1,48 @@
+#include "crc32.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+static void BM_Crc32Add(benchmark::State& state)
+{
+    std::vector<uint8_t> data(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+
+    for (auto _ : state) {
+        Crc32 checksum;
+        checksum.add(data.data(), static_cast<uint32_t>(data.size()));
+        benchmark::DoNotOptimize(checksum.get());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+    state.SetLabel(Crc32::implementation());
+}
+// Sizes: one MAVLink FTP payload, a typical burst and a large file block.
+BENCHMARK(BM_Crc32Add)->Arg(239)->Arg(4 * 1024)->Arg(1024 * 1024);
+
+static void BM_Crc32AddFile(benchmark::State& state)
+{
+    const std::string path = "crc32_benchmark.bin";
+    {
+        std::vector<char> data(static_cast<std::size_t>(state.range(0)), 'x');
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    for (auto _ : state) {
+        Crc32 checksum;
+        checksum.add_file(path);
+        benchmark::DoNotOptimize(checksum.get());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+    state.SetLabel(Crc32::implementation());
+
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_Crc32AddFile)->Arg(16 * 1024 * 1024);
@@ -0,0 +1,105 @@
+#include "crc32.h"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+// Bit by bit reference implementation.
+static uint32_t reference_crc32(uint32_t crc, const uint8_t* src, std::size_t len)
+{
+    for (std::size_t i = 0; i < len; ++i) {
+        crc ^= src[i];
+        for (unsigned bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static std::vector<uint8_t> random_bytes(std::size_t len)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 255);
+
+    std::vector<uint8_t> data(len);
+    for (auto& byte : data) {
+        byte = static_cast<uint8_t>(distribution(generator));
+    }
+    return data;
+}
+
+TEST(FtpCrc32, KnownValue)
+{
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    Crc32 checksum;
+    checksum.add(check, sizeof(check));
+    EXPECT_EQ(static_cast<uint32_t>(checksum.get()), 0x2dfd2d88u);
+}
+
+TEST(FtpCrc32, MatchesReferenceForAllLengthsAndAlignments)
+{
+    const auto data = random_bytes(1024 + 16);
+
+    for (std::size_t offset = 0; offset < 16; ++offset) {
+        for (std::size_t len = 0; len <= 1024; ++len) {
+            Crc32 checksum;
+            checksum.add(&data[offset], static_cast<uint32_t>(len));
+            ASSERT_EQ(
+                static_cast<uint32_t>(checksum.get()), reference_crc32(0, &data[offset], len))
+                << "offset: " << offset << ", len: " << len << " (" << Crc32::implementation()
+                << ")";
+        }
+    }
+}
+
+TEST(FtpCrc32, IncrementalEqualsAtOnce)
+{
+    const auto data = random_bytes(100000);
+
+    Crc32 at_once;
+    at_once.add(data.data(), static_cast<uint32_t>(data.size()));
+
+    Crc32 incremental;
+    std::size_t offset = 0;
+    std::size_t step = 1;
+    while (offset < data.size()) {
+        const auto len = std::min(step, data.size() - offset);
+        incremental.add(&data[offset], static_cast<uint32_t>(len));
+        offset += len;
+        step = step * 3 + 1;
+    }
+
+    EXPECT_EQ(at_once.get(), incremental.get());
+    EXPECT_EQ(
+        static_cast<uint32_t>(at_once.get()), reference_crc32(0, data.data(), data.size()));
+}
+
+TEST(FtpCrc32, File)
+{
+    const auto data = random_bytes(3 * 1024 * 1024 + 17);
+    const std::string path = "crc32_test.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    Crc32 whole;
+    EXPECT_TRUE(whole.add_file(path));
+    EXPECT_EQ(static_cast<uint32_t>(whole.get()), reference_crc32(0, data.data(), data.size()));
+
+    Crc32 part;
+    EXPECT_TRUE(part.add_file(path, 1000));
+    EXPECT_EQ(static_cast<uint32_t>(part.get()), reference_crc32(0, data.data(), 1000));
+
+    Crc32 too_long;
+    EXPECT_FALSE(too_long.add_file(path, data.size() + 1));
+
+    Crc32 missing;
+    EXPECT_FALSE(missing.add_file("crc32_test_does_not_exist.bin"));
+
+    std::remove(path.c_str());
+}
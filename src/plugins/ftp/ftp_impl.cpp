@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <functional>
 #include <iostream>
 
@@ -44,7 +45,22 @@ void FtpImpl::init()
         this);
 }
 
-void FtpImpl::deinit() {}
+void FtpImpl::deinit()
+{
+    {
+        std::lock_guard<std::mutex> lock(_curr_op_mutex);
+        // Keep what we have so far, so the download can be resumed.
+        if (_download_resume) {
+            _download_resume->save();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+    _stop_burst_timer();
+    for (auto& session_info : _sessions) {
+        _close_session(session_info);
+    }
+}
 
 void FtpImpl::enable() {}
 
@@ -68,8 +84,12 @@ void FtpImpl::_process_ack(PayloadHeader* payload)
             _curr_op = CMD_NONE;
             _session_valid = true;
             _session = payload->session;
-            _bytes_transferred = 0;
             _file_size = *(reinterpret_cast<uint32_t*>(payload->data));
+            if (!_setup_download_resume()) {
+                _session_result = ServerResult::ERR_FILE_IO_ERROR;
+                _end_read_session();
+                return;
+            }
             _call_op_progress_callback(_bytes_transferred, _file_size);
             _read();
             break;
@@ -81,6 +101,7 @@ void FtpImpl::_process_ack(PayloadHeader* payload)
                 _end_read_session();
                 return;
             }
+            _update_download_resume(payload->data, payload->size);
             _bytes_transferred += payload->size;
             _call_op_progress_callback(_bytes_transferred, _file_size);
             _read();
@@ -104,7 +125,11 @@ void FtpImpl::_process_ack(PayloadHeader* payload)
             _curr_op = CMD_NONE;
             _session_valid = false;
             _stop_timer();
-            _call_op_result_callback(_session_result);
+            if (_download_verify_pending) {
+                _verify_resumed_download();
+            } else {
+                _call_op_result_callback(_session_result);
+            }
             break;
 
         case CMD_RESET_SESSIONS:
@@ -182,6 +207,10 @@ void FtpImpl::_process_nak(ServerResult result)
                 const bool delete_file = (result == ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST);
                 _end_read_session(delete_file);
             } else {
+                // The session timed out, keep what we have for a later resume.
+                if (_download_resume) {
+                    _download_resume->save();
+                }
                 _stop_timer();
                 _call_op_result_callback(_session_result);
             }
@@ -201,6 +230,11 @@ void FtpImpl::_process_nak(ServerResult result)
         case CMD_TERMINATE_SESSION:
             _session_valid = false;
             _stop_timer();
+            if (_download_verify_pending) {
+                _curr_op = CMD_NONE;
+                _verify_resumed_download();
+                return;
+            }
             _call_op_result_callback(_session_result);
             break;
 
@@ -319,7 +353,27 @@ void FtpImpl::download_async(
 
     std::string local_path = local_folder + path_separator + fs_filename(remote_path);
 
-    _ofstream.stream.open(local_path, std::fstream::trunc | std::fstream::binary);
+    // A download which timed out might have left the file open.
+    if (_ofstream.stream.is_open()) {
+        _ofstream.stream.close();
+    }
+
+    if (_download_resume) {
+        _download_resume->save();
+        _download_resume.reset();
+    }
+    _download_remote_path = remote_path;
+    _download_resumed = false;
+    _download_verify_pending = false;
+
+    // If an earlier download of this file got interrupted we keep what's there already.
+    // Whether it can actually be resumed is decided once we know the remote file size.
+    if (fs_exists(ResumeFile::sidecar_path(local_path)) && fs_exists(local_path)) {
+        _ofstream.stream.open(
+            local_path, std::fstream::in | std::fstream::out | std::fstream::binary);
+    } else {
+        _ofstream.stream.open(local_path, std::fstream::trunc | std::fstream::binary);
+    }
     _ofstream.path = local_path;
     if (!_ofstream.stream) {
         _end_read_session();
@@ -348,9 +402,140 @@ void FtpImpl::_end_read_session(bool delete_file)
             fs_remove(_ofstream.path);
         }
     }
+
+    if (_download_resume) {
+        if (delete_file) {
+            _download_resume->remove();
+        } else if (_session_result == ServerResult::SUCCESS) {
+            if (_download_resumed) {
+                // We only drop the resume information once the CRC matches.
+                _download_verify_pending = true;
+            } else {
+                _download_resume->remove();
+            }
+        } else {
+            // We keep the resume information, so the download can be
+            // continued later.
+            _download_resume->save();
+        }
+        _download_resume.reset();
+    }
+
     _terminate_session();
 }
 
+bool FtpImpl::_setup_download_resume()
+{
+    // Assumes to have the lock for _curr_op_mutex.
+
+    const std::string identity = "ftp " + _download_remote_path;
+
+    _bytes_transferred = 0;
+    _download_crc32 = Crc32{};
+    _download_resumed = false;
+    _download_resume.reset(new ResumeFile(_ofstream.path));
+
+    if (_download_resume->load(identity, _file_size, resume_chunk_size)) {
+        // Make sure what we have on disk is still what we wrote there.
+        const uint32_t offset = _download_resume->received_prefix_bytes();
+        Crc32 checksum;
+        if (_calc_local_file_crc32(_ofstream.path, offset, checksum) == Ftp::Result::Success &&
+            uint32_t(checksum.get()) == _download_resume->crc32()) {
+            LogDebug() << "Resuming download of " << _download_remote_path << " at " << offset
+                       << " B of " << _file_size << " B";
+            _bytes_transferred = offset;
+            _download_crc32 = checksum;
+            _download_resumed = true;
+        } else {
+            LogWarn() << "Partial download of " << _download_remote_path
+                      << " does not match, starting over";
+        }
+    }
+
+    if (!_download_resumed) {
+        _download_resume->reset(identity, _file_size, resume_chunk_size);
+
+        // Throw away whatever was there before.
+        _ofstream.stream.close();
+        _ofstream.stream.open(_ofstream.path, std::fstream::trunc | std::fstream::binary);
+        if (!_ofstream.stream) {
+            return false;
+        }
+        _download_resume->save();
+    }
+
+    _ofstream.stream.seekp(_bytes_transferred);
+    return bool(_ofstream.stream);
+}
+
+void FtpImpl::_update_download_resume(const uint8_t* data, uint32_t size)
+{
+    // Assumes to have the lock for _curr_op_mutex.
+
+    if (!_download_resume) {
+        return;
+    }
+
+    uint32_t offset = _bytes_transferred;
+    while (size > 0 && offset < _file_size) {
+        const uint32_t chunk_end =
+            std::min((offset / resume_chunk_size + 1) * resume_chunk_size, _file_size);
+        const uint32_t len = std::min(size, chunk_end - offset);
+
+        _download_crc32.add(data, len);
+        data += len;
+        size -= len;
+        offset += len;
+
+        if (offset == chunk_end) {
+            // The data needs to be on disk before we claim we have it.
+            _ofstream.stream.flush();
+            _download_resume->mark_received((chunk_end - 1) / resume_chunk_size);
+            _download_resume->set_crc32(_download_crc32.get());
+            _download_resume->save_if_due(_parent->get_time().steady_time());
+        }
+    }
+}
+
+void FtpImpl::_verify_resumed_download()
+{
+    // Assumes to have the lock for _curr_op_mutex.
+
+    _download_verify_pending = false;
+
+    const auto result_callback = _curr_op_result_callback;
+    const auto local_path = _ofstream.path;
+    const auto remote_path = _download_remote_path;
+
+    _request_file_crc32(
+        remote_path,
+        [this, result_callback, local_path, remote_path](Ftp::Result result, uint32_t crc_remote) {
+            if (result == Ftp::Result::Unsupported) {
+                LogWarn() << "Could not verify resumed download of " << remote_path;
+                result = Ftp::Result::Success;
+
+            } else if (result == Ftp::Result::Success) {
+                uint32_t crc_local = 0;
+                result = _calc_local_file_crc32(local_path, crc_local);
+                if (result == Ftp::Result::Success && crc_local != crc_remote) {
+                    LogErr() << "CRC32 of resumed download of " << remote_path
+                             << " does not match";
+                    fs_remove(local_path);
+                    ResumeFile(local_path).remove();
+                    result = Ftp::Result::ProtocolError;
+                }
+            }
+
+            if (result == Ftp::Result::Success) {
+                ResumeFile(local_path).remove();
+            }
+
+            if (result_callback) {
+                result_callback(result);
+            }
+        });
+}
+
 void FtpImpl::_read()
 {
     if (_bytes_transferred >= _file_size) {
@@ -678,6 +863,13 @@ void FtpImpl::_calc_file_crc32_async(const std::string& path, file_crc32_ResultC
         return;
     }
 
+    _request_file_crc32(path, callback);
+}
+
+void FtpImpl::_request_file_crc32(const std::string& path, file_crc32_ResultCallback callback)
+{
+    // Assumes to have the lock for _curr_op_mutex.
+
     uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
     PayloadHeader* payload = reinterpret_cast<PayloadHeader*>(raw_payload);
     payload->seq_number = _seq_number++;
@@ -833,7 +1025,7 @@ void FtpImpl::process_mavlink_ftp_message(const mavlink_message_t& msg)
 
             case CMD_BURST_READ_FILE:
                 LogInfo() << "OPC:CMD_BURST_READ_FILE";
-                error_code = _work_burst(payload);
+                error_code = _work_burst(payload, msg.sysid, msg.compid);
                 stream_send = true;
                 break;
 
@@ -1033,40 +1225,61 @@ FtpImpl::ServerResult FtpImpl::_work_list(PayloadHeader* payload, bool list_hidd
 
 FtpImpl::ServerResult FtpImpl::_work_open(PayloadHeader* payload, int oflag)
 {
-    if (_session_info.fd >= 0) {
-        return ServerResult::ERR_NO_SESSIONS_AVAILABLE;
-    }
-
     std::string path = _get_path(payload);
     if (path.rfind(_root_dir, 0) != 0) {
         LogWarn() << "FTP: invalid path " << path;
         return ServerResult::ERR_FAIL;
     }
 
-    // fail only if requested open for read
-    if ((oflag & O_RDONLY) && !fs_exists(path)) {
-        LogWarn() << "FTP: Open failed - file not found";
-        return ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST;
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+
+    uint8_t session = 0;
+    while (session < max_sessions && _sessions[session].in_use) {
+        ++session;
     }
+    if (session == max_sessions) {
+        return ServerResult::ERR_NO_SESSIONS_AVAILABLE;
+    }
+    auto& session_info = _sessions[session];
 
-    uint32_t file_size = fs_file_size(path);
+    uint32_t file_size = 0;
 
-    LogInfo() << "Open: " << path << " FS: " << file_size;
+    if (oflag == O_RDONLY) {
+        if (!session_info.file.open(path)) {
+            LogWarn() << "FTP: Open failed";
+            return fs_exists(path) ? ServerResult::ERR_FAIL :
+                                     ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST;
+        }
+        if (session_info.file.size() != static_cast<uint32_t>(session_info.file.size())) {
+            LogWarn() << "FTP: File too big for offsets of 32 bits";
+            session_info.file.close();
+            return ServerResult::ERR_FAIL;
+        }
+        file_size = static_cast<uint32_t>(session_info.file.size());
 
-    // Set mode to 666 incase oflag has O_CREAT
-    int fd = ::open(path.c_str(), oflag, 0666);
+    } else {
+        file_size = fs_file_size(path);
 
-    if (fd < 0) {
-        LogWarn() << "FTP: Open failed";
-        return (errno == ENOENT) ? ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST :
-                                   ServerResult::ERR_FAIL;
+        // Set mode to 666 incase oflag has O_CREAT
+        int fd = ::open(path.c_str(), oflag, 0666);
+
+        if (fd < 0) {
+            LogWarn() << "FTP: Open failed";
+            return (errno == ENOENT) ? ServerResult::ERR_FAIL_FILE_DOES_NOT_EXIST :
+                                       ServerResult::ERR_FAIL;
+        }
+        session_info.fd = fd;
     }
 
-    _session_info.fd = fd;
-    _session_info.file_size = file_size;
-    _session_info.stream_download = false;
+    LogInfo() << "Open: " << path << " FS: " << file_size;
 
-    payload->session = 0;
+    session_info.in_use = true;
+    session_info.file_size = file_size;
+    session_info.stream_download = false;
+    session_info.stream_offset = 0;
+    session_info.stream_chunk_transmitted = 0;
+
+    payload->session = session;
     payload->size = sizeof(uint32_t);
     memcpy(payload->data, &file_size, payload->size);
 
@@ -1075,59 +1288,79 @@ FtpImpl::ServerResult FtpImpl::_work_open(PayloadHeader* payload, int oflag)
 
 FtpImpl::ServerResult FtpImpl::_work_read(PayloadHeader* payload)
 {
-    if (payload->session != 0 || _session_info.fd < 0) {
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+
+    auto session_info = _get_session(payload->session);
+    if (session_info == nullptr || session_info->fd >= 0) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
-    // We have to test seek past EOF ourselves, lseek will allow seek past EOF
-    if (payload->offset >= _session_info.file_size) {
+    if (payload->offset >= session_info->file_size) {
         return ServerResult::ERR_EOF;
     }
 
-    if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-        return ServerResult::ERR_FAIL;
-    }
-
-    int bytes_read = ::read(_session_info.fd, &payload->data[0], max_data_length);
-
-    if (bytes_read < 0) {
-        // Negative return indicates error other than eof
-        return ServerResult::ERR_FAIL;
-    }
+    const uint32_t bytes_read =
+        std::min(session_info->file_size - payload->offset, uint32_t(max_data_length));
+    memcpy(&payload->data[0], session_info->file.data() + payload->offset, bytes_read);
 
     payload->size = bytes_read;
 
     return ServerResult::SUCCESS;
 }
 
-FtpImpl::ServerResult FtpImpl::_work_burst(PayloadHeader* payload)
+FtpImpl::ServerResult FtpImpl::_work_burst(
+    PayloadHeader* payload, uint8_t target_system_id, uint8_t target_component_id)
 {
-    if (payload->session != 0 && _session_info.fd < 0) {
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+
+    auto session_info = _get_session(payload->session);
+    if (session_info == nullptr || session_info->fd >= 0) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
+    if (payload->offset >= session_info->file_size) {
+        session_info->stream_download = false;
+        return ServerResult::ERR_EOF;
+    }
+
+    // The client asks again for what we have already sent, so some of it
+    // got lost on the way.
+    if (payload->offset < session_info->stream_offset) {
+        _burst_pacer.congestion(BurstPacer::Clock::now());
+    }
+
     // Setup for streaming sends
-    _session_info.stream_download = true;
-    _session_info.stream_offset = payload->offset;
-    _session_info.stream_chunk_transmitted = 0;
-    _session_info.stream_seq_number = payload->seq_number + 1;
-    _session_info.stream_target_system_id = _parent->get_system_id();
+    session_info->stream_download = true;
+    session_info->stream_offset = payload->offset;
+    session_info->stream_chunk_transmitted = 0;
+    session_info->stream_seq_number = payload->seq_number + 1;
+    session_info->stream_target_system_id = target_system_id;
+    session_info->stream_target_component_id = target_component_id;
+
+    if (!_burst_call_every_running) {
+        _burst_call_every_running = true;
+        _parent->add_call_every(
+            std::bind(&FtpImpl::send, this), burst_interval_s, &_burst_call_every_cookie);
+    }
 
     return ServerResult::SUCCESS;
 }
 
 FtpImpl::ServerResult FtpImpl::_work_write(PayloadHeader* payload)
 {
-    if (payload->session != 0 && _session_info.fd < 0) {
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+
+    auto session_info = _get_session(payload->session);
+    if (session_info == nullptr || session_info->fd < 0) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
-    if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
+    if (lseek(session_info->fd, payload->offset, SEEK_SET) < 0) {
         // Unable to see to the specified location
         return ServerResult::ERR_FAIL;
     }
 
-    int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
+    int bytes_written = ::write(session_info->fd, &payload->data[0], payload->size);
 
     if (bytes_written < 0) {
         // Negative return indicates error other than eof
@@ -1142,13 +1375,14 @@ FtpImpl::ServerResult FtpImpl::_work_write(PayloadHeader* payload)
 
 FtpImpl::ServerResult FtpImpl::_work_terminate(PayloadHeader* payload)
 {
-    if (payload->session != 0 || _session_info.fd < 0) {
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+
+    auto session_info = _get_session(payload->session);
+    if (session_info == nullptr) {
         return ServerResult::ERR_INVALID_SESSION;
     }
 
-    close(_session_info.fd);
-    _session_info.fd = -1;
-    _session_info.stream_download = false;
+    _close_session(*session_info);
 
     payload->size = 0;
 
@@ -1157,10 +1391,10 @@ FtpImpl::ServerResult FtpImpl::_work_terminate(PayloadHeader* payload)
 
 FtpImpl::ServerResult FtpImpl::_work_reset(PayloadHeader* payload)
 {
-    if (_session_info.fd != -1) {
-        close(_session_info.fd);
-        _session_info.fd = -1;
-        _session_info.stream_download = false;
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+
+    for (auto& session_info : _sessions) {
+        _close_session(session_info);
     }
 
     payload->size = 0;
@@ -1168,6 +1402,25 @@ FtpImpl::ServerResult FtpImpl::_work_reset(PayloadHeader* payload)
     return ServerResult::SUCCESS;
 }
 
+FtpImpl::SessionInfo* FtpImpl::_get_session(uint8_t session)
+{
+    if (session >= max_sessions || !_sessions[session].in_use) {
+        return nullptr;
+    }
+    return &_sessions[session];
+}
+
+void FtpImpl::_close_session(SessionInfo& session_info)
+{
+    if (session_info.fd >= 0) {
+        close(session_info.fd);
+        session_info.fd = -1;
+    }
+    session_info.file.close();
+    session_info.in_use = false;
+    session_info.stream_download = false;
+}
+
 FtpImpl::ServerResult FtpImpl::_work_remove_directory(PayloadHeader* payload)
 {
     std::string path = _get_path(payload);
@@ -1255,31 +1508,23 @@ Ftp::Result FtpImpl::_calc_local_file_crc32(const std::string& path, uint32_t& c
         return Ftp::Result::FileDoesNotExist;
     }
 
-    int fd = ::open(path.c_str(), O_RDONLY);
-    if (fd < 0) {
+    Crc32 checksum;
+    if (!checksum.add_file(path)) {
         return Ftp::Result::FileIoError;
     }
 
-    // Read whole file in buffer size chunks
-    Crc32 checksum;
-    char buffer[18392];
-    ssize_t bytes_read;
-    do {
-        bytes_read = ::read(fd, buffer, sizeof(buffer));
-
-        if (bytes_read < 0) {
-            int r_errno = errno;
-            close(fd);
-            errno = r_errno;
-            return Ftp::Result::FileIoError;
-        }
-
-        checksum.add((uint8_t*)buffer, bytes_read);
-    } while (bytes_read == sizeof(buffer));
+    csum = checksum.get();
 
-    close(fd);
+    return Ftp::Result::Success;
+}
 
-    csum = checksum.get();
+Ftp::Result
+FtpImpl::_calc_local_file_crc32(const std::string& path, uint32_t length, Crc32& checksum)
+{
+    // Only the first length bytes.
+    if (!checksum.add_file(path, length)) {
+        return Ftp::Result::FileIoError;
+    }
 
     return Ftp::Result::Success;
 }
@@ -1309,9 +1554,84 @@ FtpImpl::ServerResult FtpImpl::_work_calc_file_CRC32(PayloadHeader* payload)
 
 void FtpImpl::send()
 {
-    // Anything to stream?
-    if (!_session_info.stream_download) {
-        return;
+    std::lock_guard<std::mutex> lock(_sessions_mutex);
+
+    const auto now = BurstPacer::Clock::now();
+    _burst_pacer.refill(now);
+
+    // Sessions take turns packet by packet, so they share the link equally.
+    bool any_streaming = true;
+    while (any_streaming) {
+        any_streaming = false;
+        for (unsigned i = 0; i < max_sessions; ++i) {
+            const auto session = static_cast<uint8_t>((_next_burst_session + i) % max_sessions);
+            if (!_sessions[session].stream_download) {
+                continue;
+            }
+            if (!_burst_pacer.try_consume(burst_packet_bytes)) {
+                // Continue with this one next time.
+                _next_burst_session = session;
+                return;
+            }
+            _send_burst_packet(session, now);
+            any_streaming = true;
+        }
+    }
+
+    _stop_burst_timer();
+}
+
+void FtpImpl::_send_burst_packet(uint8_t session, BurstPacer::Clock::time_point now)
+{
+    auto& session_info = _sessions[session];
+
+    uint8_t raw_payload[MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN];
+    auto payload = reinterpret_cast<PayloadHeader*>(&raw_payload[0]);
+
+    payload->seq_number = session_info.stream_seq_number++;
+    payload->session = session;
+    payload->opcode = RSP_ACK;
+    payload->req_opcode = CMD_BURST_READ_FILE;
+    payload->padding = 0;
+    payload->offset = session_info.stream_offset;
+
+    // The data goes straight from the mapped file into the message.
+    const uint32_t size = std::min(
+        session_info.file_size - session_info.stream_offset, uint32_t(max_data_length));
+    memcpy(&payload->data[0], session_info.file.data() + session_info.stream_offset, size);
+    payload->size = static_cast<uint8_t>(size);
+
+    session_info.stream_offset += size;
+    session_info.stream_chunk_transmitted += size;
+
+    if (session_info.stream_offset >= session_info.file_size ||
+        session_info.stream_chunk_transmitted >= burst_max_bytes) {
+        payload->burst_complete = 1;
+        session_info.stream_download = false;
+    } else {
+        payload->burst_complete = 0;
+    }
+
+    mavlink_message_t message;
+    mavlink_msg_file_transfer_protocol_pack(
+        _parent->get_own_system_id(),
+        _parent->get_own_component_id(),
+        &message,
+        _network_id,
+        session_info.stream_target_system_id,
+        session_info.stream_target_component_id,
+        raw_payload);
+
+    if (!_parent->send_message(message)) {
+        _burst_pacer.congestion(now);
+    }
+}
+
+void FtpImpl::_stop_burst_timer()
+{
+    if (_burst_call_every_running) {
+        _burst_call_every_running = false;
+        _parent->remove_call_every(_burst_call_every_cookie);
     }
 }
 
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <array>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
 
+#include "burst_pacer.h"
+#include "crc32.h"
+#include "mapped_file.h"
 #include "mavlink_include.h"
 #include "plugins/ftp/ftp.h"
 #include "plugin_impl_base.h"
+#include "resume_file.h"
 
 // As found in
 // https://stackoverflow.com/questions/1537964#answer-3312896
@@ -144,12 +150,17 @@ private:
     });
 
     struct SessionInfo {
+        bool in_use{false};
+        // Only for files opened for writing.
         int fd{-1};
+        // Files opened for reading are served from memory.
+        MappedFile file{};
         uint32_t file_size{0};
         bool stream_download{false};
         uint32_t stream_offset{0};
         uint16_t stream_seq_number{0};
         uint8_t stream_target_system_id{0};
+        uint8_t stream_target_component_id{0};
         unsigned stream_chunk_transmitted{0};
     };
 
@@ -158,7 +169,33 @@ private:
         std::string path;
     };
 
-    struct SessionInfo _session_info {}; ///< Session info, fd=-1 for no active session
+    static constexpr unsigned max_sessions = 4;
+
+    /// @brief The session id is the index.
+    std::array<SessionInfo, max_sessions> _sessions{};
+    std::mutex _sessions_mutex{};
+
+    /// @brief Bytes of a burst after which the client needs to ask for more.
+    static constexpr unsigned burst_max_bytes = max_data_length * 64;
+    /// @brief What a burst packet takes on the link.
+    static constexpr size_t burst_packet_bytes =
+        MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN;
+    /// @brief How often burst packets are sent while bursts are going on.
+    static constexpr float burst_interval_s = 0.01f;
+
+    BurstPacer _burst_pacer{};
+    unsigned _next_burst_session{0};
+    void* _burst_call_every_cookie{nullptr};
+    bool _burst_call_every_running{false};
+
+    /// @brief Granularity in which the progress of a download is stored to be resumed later.
+    static constexpr uint32_t resume_chunk_size = max_data_length * 64;
+
+    std::unique_ptr<ResumeFile> _download_resume{};
+    std::string _download_remote_path{};
+    Crc32 _download_crc32{};
+    bool _download_resumed{false};
+    bool _download_verify_pending{false};
 
     uint8_t _network_id = 0;
     uint8_t _target_component_id = 0;
@@ -194,7 +231,14 @@ private:
     file_crc32_ResultCallback _current_crc32_result_callback{};
 
     void _calc_file_crc32_async(const std::string& path, file_crc32_ResultCallback callback);
+    void _request_file_crc32(const std::string& path, file_crc32_ResultCallback callback);
     Ftp::Result _calc_local_file_crc32(const std::string& path, uint32_t& csum);
+    Ftp::Result
+    _calc_local_file_crc32(const std::string& path, uint32_t length, Crc32& checksum);
+
+    bool _setup_download_resume();
+    void _update_download_resume(const uint8_t* data, uint32_t size);
+    void _verify_resumed_download();
 
     void _process_ack(PayloadHeader* payload);
     void _process_nak(PayloadHeader* payload);
@@ -238,7 +282,8 @@ private:
     ServerResult _work_list(PayloadHeader* payload, bool list_hidden = false);
     ServerResult _work_open(PayloadHeader* payload, int oflag);
     ServerResult _work_read(PayloadHeader* payload);
-    ServerResult _work_burst(PayloadHeader* payload);
+    ServerResult _work_burst(
+        PayloadHeader* payload, uint8_t target_system_id, uint8_t target_component_id);
     ServerResult _work_write(PayloadHeader* payload);
     ServerResult _work_terminate(PayloadHeader* payload);
     ServerResult _work_reset(PayloadHeader* payload);
@@ -247,6 +292,15 @@ private:
     ServerResult _work_remove_file(PayloadHeader* payload);
     ServerResult _work_rename(PayloadHeader* payload);
     ServerResult _work_calc_file_CRC32(PayloadHeader* payload);
+
+    // Assumes to have the lock for _sessions_mutex.
+    SessionInfo* _get_session(uint8_t session);
+    // Assumes to have the lock for _sessions_mutex.
+    void _close_session(SessionInfo& session_info);
+    // Assumes to have the lock for _sessions_mutex.
+    void _send_burst_packet(uint8_t session, BurstPacer::Clock::time_point now);
+    // Assumes to have the lock for _sessions_mutex.
+    void _stop_burst_timer();
 };
 
 } // namespace mavsdk
@@ -29,6 +29,21 @@ Geofence::Result Geofence::upload_geofence(std::vector<Polygon> polygons) const
     return _impl->upload_geofence(polygons);
 }
 
+bool Geofence::contains(Point point) const
+{
+    return _impl->contains(point);
+}
+
+bool Geofence::contains_segment(Point start, Point end) const
+{
+    return _impl->contains_segment(start, end);
+}
+
+std::vector<uint32_t> Geofence::check_path(std::vector<Point> points) const
+{
+    return _impl->check_path(points);
+}
+
 bool operator==(const Geofence::Point& lhs, const Geofence::Point& rhs)
 {
     return ((std::isnan(rhs.latitude_deg) && std::isnan(lhs.latitude_deg)) ||
@@ -1,4 +1,5 @@
 #include "geofence_impl.h"
+#include "async_result.h"
 #include "global_include.h"
 #include "log.h"
 #include <cmath>
@@ -30,35 +31,77 @@ void GeofenceImpl::disable() {}
 
 Geofence::Result GeofenceImpl::upload_geofence(const std::vector<Geofence::Polygon>& polygons)
 {
-    auto prom = std::promise<Geofence::Result>();
-    auto fut = prom.get_future();
-
-    upload_geofence_async(polygons, [&prom](Geofence::Result result) { prom.set_value(result); });
-    return fut.get();
+    return async_call<Geofence::Result>([&](const Geofence::ResultCallback& callback) {
+               upload_geofence_async(polygons, callback);
+           })
+        .get();
 }
 
 void GeofenceImpl::upload_geofence_async(
     const std::vector<Geofence::Polygon>& polygons, const Geofence::ResultCallback& callback)
 {
-    // We can just create these items on the stack because they get copied
-    // later in the MAVLinkMissionTransfer constructor.
     const auto items = assemble_items(polygons);
 
+    // Built up front, it is only used once the upload has succeeded.
+    auto index = std::make_shared<const GeofenceIndex>(polygons);
+
     _parent->mission_transfer().upload_items_async(
-        MAV_MISSION_TYPE_FENCE, items, [this, callback](MAVLinkMissionTransfer::Result result) {
+        MAV_MISSION_TYPE_FENCE,
+        items,
+        [this, callback, index](MAVLinkMissionTransfer::Result result) {
             auto converted_result = convert_result(result);
+            if (converted_result == Geofence::Result::Success) {
+                std::lock_guard<std::mutex> lock(_index_mutex);
+                _index = index;
+            }
             _parent->call_user_callback(
                 [callback, converted_result]() { callback(converted_result); });
         });
 }
 
-std::vector<MAVLinkMissionTransfer::ItemInt>
+bool GeofenceImpl::contains(const Geofence::Point& point) const
+{
+    const auto current_index = index();
+    return !current_index || current_index->contains(point);
+}
+
+bool GeofenceImpl::contains_segment(
+    const Geofence::Point& start, const Geofence::Point& end) const
+{
+    const auto current_index = index();
+    return !current_index || current_index->contains_segment(start, end);
+}
+
+std::vector<uint32_t> GeofenceImpl::check_path(const std::vector<Geofence::Point>& points) const
+{
+    const auto current_index = index();
+    if (!current_index) {
+        return {};
+    }
+    return current_index->check_path(points);
+}
+
+std::shared_ptr<const GeofenceIndex> GeofenceImpl::index() const
+{
+    std::lock_guard<std::mutex> lock(_index_mutex);
+    return _index;
+}
+
+std::shared_ptr<const MAVLinkMissionItems>
 GeofenceImpl::assemble_items(const std::vector<Geofence::Polygon>& polygons)
 {
-    std::vector<MAVLinkMissionTransfer::ItemInt> items;
+    auto items = std::make_shared<MAVLinkMissionItems>();
+
+    size_t num_points = 0;
+    for (const auto& polygon : polygons) {
+        num_points += polygon.points.size();
+    }
+    items->reserve(num_points);
 
+    // The polygons are the user items.
     uint16_t sequence = 0;
-    for (auto& polygon : polygons) {
+    for (size_t polygon_i = 0; polygon_i < polygons.size(); ++polygon_i) {
+        const auto& polygon = polygons[polygon_i];
         uint16_t command;
         switch (polygon.fence_type) {
             case Geofence::Polygon::FenceType::Inclusion:
@@ -78,7 +121,7 @@ GeofenceImpl::assemble_items(const std::vector<Geofence::Polygon>& polygons)
             const uint8_t autocontinue = 0;
             const float param1 = float(polygon.points.size());
 
-            items.push_back(MAVLinkMissionTransfer::ItemInt{
+            const MAVLinkMissionTransfer::ItemInt item{
                 sequence,
                 MAV_FRAME_GLOBAL_INT,
                 command,
@@ -91,7 +134,9 @@ GeofenceImpl::assemble_items(const std::vector<Geofence::Polygon>& polygons)
                 int32_t(std::round(point.latitude_deg * 1e7)),
                 int32_t(std::round(point.longitude_deg * 1e7)),
                 0.0f,
-                MAV_MISSION_TYPE_FENCE});
+                MAV_MISSION_TYPE_FENCE};
+
+            items->push_back(item, static_cast<int>(polygon_i));
             ++sequence;
         }
     }
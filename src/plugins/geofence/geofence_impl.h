@@ -3,7 +3,9 @@
 #include <memory>
 #include <map>
 #include <atomic>
+#include <mutex>
 
+#include "geofence_index.h"
 #include "mavlink_include.h"
 #include "plugins/geofence/geofence.h"
 #include "plugin_impl_base.h"
@@ -28,15 +30,26 @@ public:
     void upload_geofence_async(
         const std::vector<Geofence::Polygon>& polygons, const Geofence::ResultCallback& callback);
 
+    bool contains(const Geofence::Point& point) const;
+    bool contains_segment(const Geofence::Point& start, const Geofence::Point& end) const;
+    std::vector<uint32_t> check_path(const std::vector<Geofence::Point>& points) const;
+
     // Non-copyable
     GeofenceImpl(const GeofenceImpl&) = delete;
     const GeofenceImpl& operator=(const GeofenceImpl&) = delete;
 
 private:
-    std::vector<MAVLinkMissionTransfer::ItemInt>
+    std::shared_ptr<const MAVLinkMissionItems>
     assemble_items(const std::vector<Geofence::Polygon>& polygons);
 
     static Geofence::Result convert_result(MAVLinkMissionTransfer::Result result);
+
+    std::shared_ptr<const GeofenceIndex> index() const;
+
+    // Of the geofence last uploaded successfully, queries take a reference
+    // so that they don't need to hold the lock.
+    mutable std::mutex _index_mutex{};
+    std::shared_ptr<const GeofenceIndex> _index{};
 };
 
 } // namespace mavsdk
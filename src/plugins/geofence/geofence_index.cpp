@@ -0,0 +1,383 @@
+#include "geofence_index.h"
+#include "global_include.h"
+#include <algorithm>
+#include <cmath>
+
+namespace mavsdk {
+
+GeofenceIndex::GeofenceIndex(const std::vector<Geofence::Polygon>& polygons) :
+    _transformation(center_of(polygons))
+{
+    for (const auto& polygon : polygons) {
+        add_polygon(polygon);
+    }
+    build_grid();
+}
+
+geometry::CoordinateTransformation::GlobalCoordinate
+GeofenceIndex::center_of(const std::vector<Geofence::Polygon>& polygons)
+{
+    // Averaged as unit vectors so that polygons across the antimeridian
+    // don't end up centered on the other side of the globe.
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    for (const auto& polygon : polygons) {
+        for (const auto& point : polygon.points) {
+            const double lat_rad = to_rad_from_deg(point.latitude_deg);
+            const double lon_rad = to_rad_from_deg(point.longitude_deg);
+            x += std::cos(lat_rad) * std::cos(lon_rad);
+            y += std::cos(lat_rad) * std::sin(lon_rad);
+            z += std::sin(lat_rad);
+        }
+    }
+
+    if (x == 0.0 && y == 0.0 && z == 0.0) {
+        return {0.0, 0.0};
+    }
+    return {
+        to_deg_from_rad(std::atan2(z, std::sqrt(x * x + y * y))),
+        to_deg_from_rad(std::atan2(y, x))};
+}
+
+void GeofenceIndex::add_polygon(const Geofence::Polygon& polygon)
+{
+    const size_t num_vertices = polygon.points.size();
+    if (num_vertices < 3) {
+        return;
+    }
+
+    Polygon local{};
+    local.is_exclusion = (polygon.fence_type == Geofence::Polygon::FenceType::Exclusion);
+
+    std::vector<double> latitudes_deg(num_vertices);
+    std::vector<double> longitudes_deg(num_vertices);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        latitudes_deg[i] = polygon.points[i].latitude_deg;
+        longitudes_deg[i] = polygon.points[i].longitude_deg;
+    }
+    std::vector<double> norths_m(num_vertices);
+    std::vector<double> easts_m(num_vertices);
+    _transformation.local_from_global(
+        latitudes_deg.data(), longitudes_deg.data(), norths_m.data(), easts_m.data(), num_vertices);
+
+    local.vertices.resize(num_vertices);
+    local.box = {norths_m[0], easts_m[0], norths_m[0], easts_m[0]};
+    for (size_t i = 0; i < num_vertices; ++i) {
+        local.vertices[i] = {norths_m[i], easts_m[i]};
+        local.box.min_north_m = std::min(local.box.min_north_m, norths_m[i]);
+        local.box.min_east_m = std::min(local.box.min_east_m, easts_m[i]);
+        local.box.max_north_m = std::max(local.box.max_north_m, norths_m[i]);
+        local.box.max_east_m = std::max(local.box.max_east_m, easts_m[i]);
+    }
+
+    // About one edge per band for evenly spread vertices.
+    const auto num_bands = static_cast<unsigned>(std::min<size_t>(num_vertices, 1024));
+    local.band_height_m =
+        std::max((local.box.max_north_m - local.box.min_north_m) / num_bands, 1e-6);
+
+    // First count the edges per band, then fill them in.
+    local.band_offsets.assign(num_bands + 1, 0);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        const auto& a = local.vertices[i];
+        const auto& b = local.vertices[(i + 1) % num_vertices];
+        const unsigned first = band_of(local, std::min(a.north_m, b.north_m));
+        const unsigned last = band_of(local, std::max(a.north_m, b.north_m));
+        for (unsigned band = first; band <= last; ++band) {
+            ++local.band_offsets[band + 1];
+        }
+    }
+    for (unsigned band = 0; band < num_bands; ++band) {
+        local.band_offsets[band + 1] += local.band_offsets[band];
+    }
+
+    local.band_edges.resize(local.band_offsets[num_bands]);
+    std::vector<uint32_t> next(local.band_offsets.begin(), local.band_offsets.end() - 1);
+    for (size_t i = 0; i < num_vertices; ++i) {
+        const auto& a = local.vertices[i];
+        const auto& b = local.vertices[(i + 1) % num_vertices];
+        const unsigned first = band_of(local, std::min(a.north_m, b.north_m));
+        const unsigned last = band_of(local, std::max(a.north_m, b.north_m));
+        for (unsigned band = first; band <= last; ++band) {
+            local.band_edges[next[band]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    _has_inclusion = _has_inclusion || !local.is_exclusion;
+    _polygons.push_back(std::move(local));
+}
+
+void GeofenceIndex::build_grid()
+{
+    if (_polygons.empty()) {
+        return;
+    }
+
+    _bounds = _polygons[0].box;
+    for (const auto& polygon : _polygons) {
+        _bounds.min_north_m = std::min(_bounds.min_north_m, polygon.box.min_north_m);
+        _bounds.min_east_m = std::min(_bounds.min_east_m, polygon.box.min_east_m);
+        _bounds.max_north_m = std::max(_bounds.max_north_m, polygon.box.max_north_m);
+        _bounds.max_east_m = std::max(_bounds.max_east_m, polygon.box.max_east_m);
+    }
+
+    // A few polygons per cell for evenly spread polygons.
+    const auto side = static_cast<unsigned>(std::ceil(std::sqrt(_polygons.size())));
+    _grid_size = std::min(2 * side, 256u);
+    _cell_height_m = std::max((_bounds.max_north_m - _bounds.min_north_m) / _grid_size, 1e-6);
+    _cell_width_m = std::max((_bounds.max_east_m - _bounds.min_east_m) / _grid_size, 1e-6);
+
+    // First count the polygons per cell, then fill them in.
+    _cell_offsets.assign(_grid_size * _grid_size + 1, 0);
+    for (const auto& polygon : _polygons) {
+        for (unsigned n = cell_north_of(polygon.box.min_north_m);
+             n <= cell_north_of(polygon.box.max_north_m);
+             ++n) {
+            for (unsigned e = cell_east_of(polygon.box.min_east_m);
+                 e <= cell_east_of(polygon.box.max_east_m);
+                 ++e) {
+                ++_cell_offsets[n * _grid_size + e + 1];
+            }
+        }
+    }
+    for (size_t i = 0; i + 1 < _cell_offsets.size(); ++i) {
+        _cell_offsets[i + 1] += _cell_offsets[i];
+    }
+
+    _cell_polygons.resize(_cell_offsets.back());
+    std::vector<uint32_t> next(_cell_offsets.begin(), _cell_offsets.end() - 1);
+    for (size_t i = 0; i < _polygons.size(); ++i) {
+        const auto& polygon = _polygons[i];
+        for (unsigned n = cell_north_of(polygon.box.min_north_m);
+             n <= cell_north_of(polygon.box.max_north_m);
+             ++n) {
+            for (unsigned e = cell_east_of(polygon.box.min_east_m);
+                 e <= cell_east_of(polygon.box.max_east_m);
+                 ++e) {
+                _cell_polygons[next[n * _grid_size + e]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+bool GeofenceIndex::contains(const Geofence::Point& point) const
+{
+    const auto local = _transformation.local_from_global({point.latitude_deg, point.longitude_deg});
+    return contains_local({local.north_m, local.east_m});
+}
+
+bool GeofenceIndex::contains_segment(
+    const Geofence::Point& start, const Geofence::Point& end) const
+{
+    const auto local_start =
+        _transformation.local_from_global({start.latitude_deg, start.longitude_deg});
+    const auto local_end = _transformation.local_from_global({end.latitude_deg, end.longitude_deg});
+    return contains_segment_local(
+        {local_start.north_m, local_start.east_m}, {local_end.north_m, local_end.east_m});
+}
+
+std::vector<uint32_t> GeofenceIndex::check_path(const std::vector<Geofence::Point>& points) const
+{
+    std::vector<uint32_t> outside;
+    if (points.empty()) {
+        return outside;
+    }
+
+    const size_t num_points = points.size();
+    std::vector<double> latitudes_deg(num_points);
+    std::vector<double> longitudes_deg(num_points);
+    for (size_t i = 0; i < num_points; ++i) {
+        latitudes_deg[i] = points[i].latitude_deg;
+        longitudes_deg[i] = points[i].longitude_deg;
+    }
+    std::vector<double> norths_m(num_points);
+    std::vector<double> easts_m(num_points);
+    _transformation.local_from_global(
+        latitudes_deg.data(), longitudes_deg.data(), norths_m.data(), easts_m.data(), num_points);
+
+    if (num_points == 1) {
+        if (!contains_local({norths_m[0], easts_m[0]})) {
+            outside.push_back(0);
+        }
+        return outside;
+    }
+
+    for (size_t i = 0; i + 1 < num_points; ++i) {
+        if (!contains_segment_local(
+                {norths_m[i], easts_m[i]}, {norths_m[i + 1], easts_m[i + 1]})) {
+            outside.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return outside;
+}
+
+bool GeofenceIndex::contains_local(const LocalPoint& point) const
+{
+    if (!_bounds.contains(point) || _polygons.empty()) {
+        return !_has_inclusion;
+    }
+
+    bool inside_inclusion = false;
+
+    const unsigned cell = cell_north_of(point.north_m) * _grid_size + cell_east_of(point.east_m);
+    for (uint32_t i = _cell_offsets[cell]; i < _cell_offsets[cell + 1]; ++i) {
+        const auto& polygon = _polygons[_cell_polygons[i]];
+        if (polygon.is_exclusion || !inside_inclusion) {
+            if (polygon.box.contains(point) && polygon_contains(polygon, point)) {
+                if (polygon.is_exclusion) {
+                    return false;
+                }
+                inside_inclusion = true;
+            }
+        }
+    }
+
+    return inside_inclusion || !_has_inclusion;
+}
+
+bool GeofenceIndex::contains_segment_local(const LocalPoint& start, const LocalPoint& end) const
+{
+    const Box box{
+        std::min(start.north_m, end.north_m),
+        std::min(start.east_m, end.east_m),
+        std::max(start.north_m, end.north_m),
+        std::max(start.east_m, end.east_m)};
+
+    if (_polygons.empty() || !_bounds.overlaps(box)) {
+        return !_has_inclusion;
+    }
+
+    // The segment can only go in or out where it crosses an edge, so it is
+    // enough to check one point between each two crossings.
+    std::vector<uint32_t> candidates;
+    for (unsigned n = cell_north_of(box.min_north_m); n <= cell_north_of(box.max_north_m); ++n) {
+        for (unsigned e = cell_east_of(box.min_east_m); e <= cell_east_of(box.max_east_m); ++e) {
+            const unsigned cell = n * _grid_size + e;
+            candidates.insert(
+                candidates.end(),
+                _cell_polygons.begin() + _cell_offsets[cell],
+                _cell_polygons.begin() + _cell_offsets[cell + 1]);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<double> crossings{0.0, 1.0};
+    for (const auto index : candidates) {
+        if (_polygons[index].box.overlaps(box)) {
+            add_crossings(_polygons[index], start, end, crossings);
+        }
+    }
+    std::sort(crossings.begin(), crossings.end());
+
+    const double d_north_m = end.north_m - start.north_m;
+    const double d_east_m = end.east_m - start.east_m;
+    for (size_t i = 0; i + 1 < crossings.size(); ++i) {
+        if (crossings[i + 1] <= crossings[i]) {
+            continue;
+        }
+        const double t = 0.5 * (crossings[i] + crossings[i + 1]);
+        if (!contains_local({start.north_m + t * d_north_m, start.east_m + t * d_east_m})) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GeofenceIndex::polygon_contains(const Polygon& polygon, const LocalPoint& point)
+{
+    // Counts the edges crossed by a ray from the point towards east. Only
+    // the edges in the band of the point can be crossed.
+    const size_t num_vertices = polygon.vertices.size();
+    const unsigned band = band_of(polygon, point.north_m);
+
+    bool inside = false;
+    for (uint32_t i = polygon.band_offsets[band]; i < polygon.band_offsets[band + 1]; ++i) {
+        const uint32_t edge = polygon.band_edges[i];
+        const auto& a = polygon.vertices[edge];
+        const auto& b = polygon.vertices[(edge + 1) % num_vertices];
+
+        if ((a.north_m > point.north_m) != (b.north_m > point.north_m)) {
+            const double east_crossing_m = a.east_m + (point.north_m - a.north_m) *
+                                                          (b.east_m - a.east_m) /
+                                                          (b.north_m - a.north_m);
+            if (point.east_m < east_crossing_m) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+void GeofenceIndex::add_crossings(
+    const Polygon& polygon,
+    const LocalPoint& start,
+    const LocalPoint& end,
+    std::vector<double>& crossings)
+{
+    const size_t num_vertices = polygon.vertices.size();
+    const double d_north_m = end.north_m - start.north_m;
+    const double d_east_m = end.east_m - start.east_m;
+
+    // Edges spanning several bands are found more than once, which only
+    // adds the same crossing again.
+    const unsigned first = band_of(polygon, std::min(start.north_m, end.north_m));
+    const unsigned last = band_of(polygon, std::max(start.north_m, end.north_m));
+    for (uint32_t i = polygon.band_offsets[first]; i < polygon.band_offsets[last + 1]; ++i) {
+        const uint32_t edge = polygon.band_edges[i];
+        const auto& a = polygon.vertices[edge];
+        const auto& b = polygon.vertices[(edge + 1) % num_vertices];
+
+        const double e_north_m = b.north_m - a.north_m;
+        const double e_east_m = b.east_m - a.east_m;
+        const double denominator = d_north_m * e_east_m - d_east_m * e_north_m;
+        if (denominator == 0.0) {
+            // Parallel, the points between the crossings with the other
+            // edges tell whether it is inside.
+            continue;
+        }
+
+        const double w_north_m = a.north_m - start.north_m;
+        const double w_east_m = a.east_m - start.east_m;
+        const double t = (w_north_m * e_east_m - w_east_m * e_north_m) / denominator;
+        const double u = (w_north_m * d_east_m - w_east_m * d_north_m) / denominator;
+        if (t >= 0.0 && t <= 1.0 && u >= 0.0 && u <= 1.0) {
+            crossings.push_back(t);
+        }
+    }
+}
+
+unsigned GeofenceIndex::band_of(const Polygon& polygon, double north_m)
+{
+    const double band = std::floor((north_m - polygon.box.min_north_m) / polygon.band_height_m);
+    const auto last = static_cast<double>(polygon.band_offsets.size() - 2);
+    return static_cast<unsigned>(std::min(std::max(band, 0.0), last));
+}
+
+unsigned GeofenceIndex::cell_north_of(double north_m) const
+{
+    const double cell = std::floor((north_m - _bounds.min_north_m) / _cell_height_m);
+    const auto last = static_cast<double>(_grid_size - 1);
+    return static_cast<unsigned>(std::min(std::max(cell, 0.0), last));
+}
+
+unsigned GeofenceIndex::cell_east_of(double east_m) const
+{
+    const double cell = std::floor((east_m - _bounds.min_east_m) / _cell_width_m);
+    const auto last = static_cast<double>(_grid_size - 1);
+    return static_cast<unsigned>(std::min(std::max(cell, 0.0), last));
+}
+
+bool GeofenceIndex::Box::contains(const LocalPoint& point) const
+{
+    return point.north_m >= min_north_m && point.north_m <= max_north_m &&
+           point.east_m >= min_east_m && point.east_m <= max_east_m;
+}
+
+bool GeofenceIndex::Box::overlaps(const Box& other) const
+{
+    return other.min_north_m <= max_north_m && other.max_north_m >= min_north_m &&
+           other.min_east_m <= max_east_m && other.max_east_m >= min_east_m;
+}
+
+} // namespace mavsdk
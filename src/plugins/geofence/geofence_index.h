@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry.h"
+#include "plugins/geofence/geofence.h"
+
+namespace mavsdk {
+
+// Answers whether points and paths are inside a geofence without going
+// through all polygons and edges for every query.
+//
+// The polygons are projected into a local frame around their center, edges
+// are straight lines in that frame. A grid over the whole area lists the
+// polygons overlapping each cell. Each polygon is cut into bands along north
+// which list the edges reaching into them, so a point only needs to be
+// checked against the few edges in its band.
+//
+// A point is inside the geofence if it is inside any inclusion polygon, or
+// there are none, and not inside any exclusion polygon. Polygons with fewer
+// than 3 points are ignored.
+//
+// Not changed once built, so it can be queried from several threads at once.
+class GeofenceIndex {
+public:
+    explicit GeofenceIndex(const std::vector<Geofence::Polygon>& polygons);
+    ~GeofenceIndex() = default;
+
+    bool contains(const Geofence::Point& point) const;
+    bool contains_segment(const Geofence::Point& start, const Geofence::Point& end) const;
+
+    // Returns the indices of the legs from points[i] to points[i + 1] which
+    // are not entirely inside. A single point is checked as one leg.
+    std::vector<uint32_t> check_path(const std::vector<Geofence::Point>& points) const;
+
+    // Non-copyable
+    GeofenceIndex(const GeofenceIndex&) = delete;
+    const GeofenceIndex& operator=(const GeofenceIndex&) = delete;
+
+private:
+    struct LocalPoint {
+        double north_m;
+        double east_m;
+    };
+
+    struct Box {
+        double min_north_m;
+        double min_east_m;
+        double max_north_m;
+        double max_east_m;
+
+        bool contains(const LocalPoint& point) const;
+        bool overlaps(const Box& other) const;
+    };
+
+    struct Polygon {
+        bool is_exclusion{false};
+        Box box{};
+        std::vector<LocalPoint> vertices{};
+
+        // Edge i goes from vertex i to the next one. The edges reaching into
+        // band b are band_edges[band_offsets[b]] to band_edges[band_offsets[b + 1]].
+        double band_height_m{0.0};
+        std::vector<uint32_t> band_offsets{};
+        std::vector<uint32_t> band_edges{};
+    };
+
+    static geometry::CoordinateTransformation::GlobalCoordinate
+    center_of(const std::vector<Geofence::Polygon>& polygons);
+
+    void add_polygon(const Geofence::Polygon& polygon);
+    void build_grid();
+
+    bool contains_local(const LocalPoint& point) const;
+    bool contains_segment_local(const LocalPoint& start, const LocalPoint& end) const;
+
+    static bool polygon_contains(const Polygon& polygon, const LocalPoint& point);
+    static void add_crossings(
+        const Polygon& polygon,
+        const LocalPoint& start,
+        const LocalPoint& end,
+        std::vector<double>& crossings);
+    static unsigned band_of(const Polygon& polygon, double north_m);
+
+    unsigned cell_north_of(double north_m) const;
+    unsigned cell_east_of(double east_m) const;
+
+    const geometry::CoordinateTransformation _transformation;
+
+    std::vector<Polygon> _polygons{};
+    bool _has_inclusion{false};
+
+    // The polygons overlapping cell (n, e) are
+    // _cell_polygons[_cell_offsets[i]] to _cell_polygons[_cell_offsets[i + 1]],
+    // with i = n * _grid_size + e.
+    Box _bounds{};
+    unsigned _grid_size{1};
+    double _cell_height_m{1.0};
+    double _cell_width_m{1.0};
+    std::vector<uint32_t> _cell_offsets{};
+    std::vector<uint32_t> _cell_polygons{};
+};
+
+} // namespace mavsdk
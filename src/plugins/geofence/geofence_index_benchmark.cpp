@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+
+#include "geofence_index.h"
+
+using namespace mavsdk;
+
+using Point = Geofence::Point;
+using Polygon = Geofence::Polygon;
+
+// A fence of about 2 by 2 km with one inclusion and the given number of
+// exclusions with 16 points each in it.
+static std::vector<Polygon> make_fence(unsigned num_exclusions)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0.001, 0.019);
+
+    std::vector<Polygon> polygons;
+
+    Polygon inclusion;
+    inclusion.fence_type = Polygon::FenceType::Inclusion;
+    inclusion.points = {{47.39, 8.54}, {47.41, 8.54}, {47.41, 8.56}, {47.39, 8.56}};
+    polygons.push_back(inclusion);
+
+    for (unsigned i = 0; i < num_exclusions; ++i) {
+        Polygon exclusion;
+        exclusion.fence_type = Polygon::FenceType::Exclusion;
+        const double latitude_deg = 47.39 + position(generator);
+        const double longitude_deg = 8.54 + position(generator);
+        for (unsigned j = 0; j < 16; ++j) {
+            const double angle = 2.0 * M_PI * j / 16;
+            exclusion.points.push_back(
+                {latitude_deg + 0.0003 * std::cos(angle),
+                 longitude_deg + 0.0003 * std::sin(angle)});
+        }
+        polygons.push_back(exclusion);
+    }
+    return polygons;
+}
+
+static std::vector<Point> make_points(size_t count)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> position(-0.001, 0.021);
+
+    std::vector<Point> points(count);
+    for (auto& point : points) {
+        point = {47.39 + position(generator), 8.54 + position(generator)};
+    }
+    return points;
+}
+
+static void BM_GeofenceIndexBuild(benchmark::State& state)
+{
+    const auto polygons = make_fence(static_cast<unsigned>(state.range(0)));
+
+    for (auto _ : state) {
+        GeofenceIndex index(polygons);
+        benchmark::DoNotOptimize(&index);
+    }
+}
+BENCHMARK(BM_GeofenceIndexBuild)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_GeofenceIndexContains(benchmark::State& state)
+{
+    const GeofenceIndex index(make_fence(static_cast<unsigned>(state.range(0))));
+    const auto points = make_points(1024);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.contains(points[i++ % points.size()]));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_GeofenceIndexContains)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_GeofenceIndexContainsSegment(benchmark::State& state)
+{
+    const GeofenceIndex index(make_fence(static_cast<unsigned>(state.range(0))));
+    const auto points = make_points(1024);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        // Legs of a few hundred meters.
+        const auto& start = points[i++ % points.size()];
+        const Point end{start.latitude_deg + 0.002, start.longitude_deg + 0.001};
+        benchmark::DoNotOptimize(index.contains_segment(start, end));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_GeofenceIndexContainsSegment)->Arg(10)->Arg(100)->Arg(1000);
+
+static void BM_GeofenceIndexCheckPath(benchmark::State& state)
+{
+    const GeofenceIndex index(make_fence(100));
+    const auto points = make_points(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.check_path(points));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_GeofenceIndexCheckPath)->Arg(100)->Arg(1000);
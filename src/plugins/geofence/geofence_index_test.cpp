@@ -0,0 +1,197 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+
+#include "geofence_index.h"
+
+using namespace mavsdk;
+
+using Point = Geofence::Point;
+using Polygon = Geofence::Polygon;
+
+// Roughly 111 m per 0.001 deg latitude, and 75 m per 0.001 deg longitude here.
+static const Point origin{47.397, 8.545};
+
+static Point offset(double north, double east)
+{
+    return Point{origin.latitude_deg + north * 0.001, origin.longitude_deg + east * 0.001};
+}
+
+static Polygon square(double north, double east, double size, Polygon::FenceType fence_type)
+{
+    Polygon polygon;
+    polygon.fence_type = fence_type;
+    polygon.points = {
+        offset(north, east),
+        offset(north + size, east),
+        offset(north + size, east + size),
+        offset(north, east + size)};
+    return polygon;
+}
+
+// Point in polygon without any index, straight in latitude and longitude.
+static bool naive_polygon_contains(const Polygon& polygon, const Point& point)
+{
+    bool inside = false;
+    const size_t num_points = polygon.points.size();
+    for (size_t i = 0; i < num_points; ++i) {
+        const auto& a = polygon.points[i];
+        const auto& b = polygon.points[(i + 1) % num_points];
+        if ((a.latitude_deg > point.latitude_deg) != (b.latitude_deg > point.latitude_deg)) {
+            const double crossing = a.longitude_deg + (point.latitude_deg - a.latitude_deg) *
+                                                          (b.longitude_deg - a.longitude_deg) /
+                                                          (b.latitude_deg - a.latitude_deg);
+            if (point.longitude_deg < crossing) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+static bool naive_contains(const std::vector<Polygon>& polygons, const Point& point)
+{
+    bool has_inclusion = false;
+    bool inside_inclusion = false;
+    for (const auto& polygon : polygons) {
+        const bool inside = naive_polygon_contains(polygon, point);
+        if (polygon.fence_type == Polygon::FenceType::Exclusion) {
+            if (inside) {
+                return false;
+            }
+        } else {
+            has_inclusion = true;
+            inside_inclusion = inside_inclusion || inside;
+        }
+    }
+    return inside_inclusion || !has_inclusion;
+}
+
+TEST(GeofenceIndex, EverythingIsInsideWithoutPolygons)
+{
+    GeofenceIndex index({});
+
+    EXPECT_TRUE(index.contains(origin));
+    EXPECT_TRUE(index.contains_segment(offset(-10, -10), offset(10, 10)));
+    EXPECT_TRUE(index.check_path({origin, offset(1, 1)}).empty());
+}
+
+TEST(GeofenceIndex, InclusionAndExclusion)
+{
+    GeofenceIndex index(
+        {square(0, 0, 10, Polygon::FenceType::Inclusion),
+         square(4, 4, 2, Polygon::FenceType::Exclusion)});
+
+    EXPECT_TRUE(index.contains(offset(1, 1)));
+    EXPECT_TRUE(index.contains(offset(9, 3)));
+    EXPECT_FALSE(index.contains(offset(5, 5)));
+    EXPECT_FALSE(index.contains(offset(11, 5)));
+    EXPECT_FALSE(index.contains(offset(-1, -1)));
+}
+
+TEST(GeofenceIndex, OnlyExclusion)
+{
+    GeofenceIndex index({square(0, 0, 1, Polygon::FenceType::Exclusion)});
+
+    EXPECT_FALSE(index.contains(offset(0.5, 0.5)));
+    EXPECT_TRUE(index.contains(offset(1.5, 0.5)));
+    EXPECT_TRUE(index.contains(offset(-100, 100)));
+}
+
+TEST(GeofenceIndex, PolygonsWithTooFewPointsAreIgnored)
+{
+    Polygon line;
+    line.fence_type = Polygon::FenceType::Inclusion;
+    line.points = {offset(0, 0), offset(1, 1)};
+
+    GeofenceIndex index({line});
+
+    EXPECT_TRUE(index.contains(offset(5, 5)));
+}
+
+TEST(GeofenceIndex, Segments)
+{
+    GeofenceIndex index(
+        {square(0, 0, 10, Polygon::FenceType::Inclusion),
+         square(4, 4, 2, Polygon::FenceType::Exclusion)});
+
+    // Going around the exclusion.
+    EXPECT_TRUE(index.contains_segment(offset(1, 1), offset(1, 9)));
+    EXPECT_TRUE(index.contains_segment(offset(1, 1), offset(3, 9)));
+    // Through the exclusion, with both ends inside.
+    EXPECT_FALSE(index.contains_segment(offset(5, 1), offset(5, 9)));
+    EXPECT_FALSE(index.contains_segment(offset(1, 1), offset(9, 9)));
+    // Leaving the inclusion.
+    EXPECT_FALSE(index.contains_segment(offset(5, 1), offset(5, 11)));
+    // Out and back in.
+    EXPECT_FALSE(index.contains_segment(offset(-1, 1), offset(1, -1)));
+    // A single point.
+    EXPECT_TRUE(index.contains_segment(offset(1, 1), offset(1, 1)));
+    EXPECT_FALSE(index.contains_segment(offset(5, 5), offset(5, 5)));
+}
+
+TEST(GeofenceIndex, SegmentAcrossOverlappingInclusions)
+{
+    GeofenceIndex index(
+        {square(0, 0, 2, Polygon::FenceType::Inclusion),
+         square(1, 1, 2, Polygon::FenceType::Inclusion)});
+
+    EXPECT_TRUE(index.contains_segment(offset(0.5, 0.5), offset(2.5, 2.5)));
+    EXPECT_FALSE(index.contains_segment(offset(0.5, 2.5), offset(2.5, 0.5)));
+}
+
+TEST(GeofenceIndex, CheckPath)
+{
+    GeofenceIndex index(
+        {square(0, 0, 10, Polygon::FenceType::Inclusion),
+         square(4, 4, 2, Polygon::FenceType::Exclusion)});
+
+    const std::vector<Point> path{
+        offset(1, 1), offset(1, 9), offset(9, 9), offset(1, 1), offset(11, 1)};
+
+    EXPECT_EQ(index.check_path(path), (std::vector<uint32_t>{2, 3}));
+    EXPECT_TRUE(index.check_path({offset(1, 1)}).empty());
+    EXPECT_EQ(index.check_path({offset(5, 5)}), (std::vector<uint32_t>{0}));
+    EXPECT_TRUE(index.check_path({}).empty());
+}
+
+TEST(GeofenceIndex, MatchesNaiveCheck)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position(0.0, 20.0);
+    std::uniform_real_distribution<double> radius(0.2, 2.0);
+
+    // Irregular, partly overlapping polygons.
+    std::vector<Polygon> polygons;
+    for (unsigned i = 0; i < 200; ++i) {
+        Polygon polygon;
+        polygon.fence_type = (i % 4 == 0) ? Polygon::FenceType::Exclusion :
+                                            Polygon::FenceType::Inclusion;
+        const double north = position(generator);
+        const double east = position(generator);
+        const unsigned num_points = 3 + i % 20;
+        for (unsigned j = 0; j < num_points; ++j) {
+            const double angle = 2.0 * M_PI * j / num_points;
+            const double r = radius(generator);
+            polygon.points.push_back(
+                offset(north + r * std::cos(angle), east + r * std::sin(angle)));
+        }
+        polygons.push_back(polygon);
+    }
+
+    GeofenceIndex index(polygons);
+
+    std::uniform_real_distribution<double> query(-2.0, 22.0);
+    unsigned num_inside = 0;
+    for (unsigned i = 0; i < 20000; ++i) {
+        const Point point = offset(query(generator), query(generator));
+        const bool expected = naive_contains(polygons, point);
+        EXPECT_EQ(index.contains(point), expected)
+            << point.latitude_deg << ", " << point.longitude_deg;
+        num_inside += expected ? 1 : 0;
+    }
+
+    // Make sure both cases are covered.
+    EXPECT_GT(num_inside, 1000u);
+    EXPECT_LT(num_inside, 19000u);
+}
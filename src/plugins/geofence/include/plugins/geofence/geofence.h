@@ -163,6 +163,43 @@ public:
      */
     Result upload_geofence(std::vector<Polygon> polygons) const;
 
+    /**
+     * @brief Check whether a point is inside the geofence.
+     *
+     * A point is inside if it is inside any of the inclusion polygons, or there are none,
+     * and not inside any of the exclusion polygons. This is checked locally against the
+     * geofence last uploaded successfully, without uploading everything is inside.
+     *
+     * This function is non-blocking.
+     *
+     * @return `true` if the point is inside.
+     */
+    bool contains(Point point) const;
+
+    /**
+     * @brief Check whether the straight line between two points is entirely inside the
+     * geofence.
+     *
+     * See 'contains' for what counts as inside.
+     *
+     * This function is non-blocking.
+     *
+     * @return `true` if the line is inside.
+     */
+    bool contains_segment(Point start, Point end) const;
+
+    /**
+     * @brief Check a path, such as the waypoints of a mission, against the geofence.
+     *
+     * Leg i is the straight line from point i to point i + 1, a path of a single point is
+     * checked as one leg. See 'contains' for what counts as inside.
+     *
+     * This function is non-blocking.
+     *
+     * @return Indices of the legs which are not entirely inside, empty if the whole path is.
+     */
+    std::vector<uint32_t> check_path(std::vector<Point> points) const;
+
     /**
      * @brief Copy constructor.
      */
@@ -47,6 +47,11 @@ Gimbal::set_roi_location(double latitude_deg, double longitude_deg, float altitu
     return _impl->set_roi_location(latitude_deg, longitude_deg, altitude_m);
 }
 
+Gimbal::Result Gimbal::set_streaming_rate(double rate_hz) const
+{
+    return _impl->set_streaming_rate(rate_hz);
+}
+
 std::ostream& operator<<(std::ostream& str, Gimbal::Result const& result)
 {
     switch (result) {
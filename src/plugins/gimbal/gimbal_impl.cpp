@@ -113,6 +113,12 @@ void GimbalImpl::set_roi_location_async(
     });
 }
 
+Gimbal::Result GimbalImpl::set_streaming_rate(double rate_hz)
+{
+    wait_for_protocol();
+    return _gimbal_protocol->set_streaming_rate(rate_hz);
+}
+
 void GimbalImpl::wait_for_protocol()
 {
     while (_gimbal_protocol == nullptr) {
@@ -35,6 +35,8 @@ public:
         float altitude_m,
         Gimbal::ResultCallback callback);
 
+    Gimbal::Result set_streaming_rate(double rate_hz);
+
     static Gimbal::Result
     gimbal_result_from_command_result(MavlinkCommandSender::Result command_result);
 
@@ -30,6 +30,8 @@ public:
         float altitude_m,
         Gimbal::ResultCallback callback) = 0;
 
+    virtual Gimbal::Result set_streaming_rate(double rate_hz) = 0;
+
 protected:
     SystemImpl& _system_impl;
 };
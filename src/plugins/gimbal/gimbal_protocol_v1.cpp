@@ -135,4 +135,12 @@ void GimbalProtocolV1::set_roi_location_async(
         });
 }
 
+Gimbal::Result GimbalProtocolV1::set_streaming_rate(double rate_hz)
+{
+    UNUSED(rate_hz);
+
+    // Every target is a command which needs to be acknowledged, these can't be streamed.
+    return Gimbal::Result::Unsupported;
+}
+
 } // namespace mavsdk
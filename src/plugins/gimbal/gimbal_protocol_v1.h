@@ -29,6 +29,8 @@ public:
         float altitude_m,
         Gimbal::ResultCallback callback) override;
 
+    Gimbal::Result set_streaming_rate(double rate_hz) override;
+
 private:
     static float to_float_gimbal_mode(const Gimbal::GimbalMode gimbal_mode);
 };
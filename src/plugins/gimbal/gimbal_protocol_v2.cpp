@@ -20,17 +20,35 @@ void GimbalProtocolV2::set_gimbal_information(
 }
 
 Gimbal::Result GimbalProtocolV2::set_pitch_and_yaw(float pitch_deg, float yaw_deg)
+{
+    Target target{pitch_deg, yaw_deg, Gimbal::GimbalMode::YawFollow};
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        target.gimbal_mode = _gimbal_mode;
+
+        if (_streaming_rate_hz > 0.0) {
+            // The streaming thread sends it at its next deadline, unless
+            // another target comes first.
+            _target_mailbox.write(target);
+            return Gimbal::Result::Success;
+        }
+    }
+
+    return send_target(target);
+}
+
+Gimbal::Result GimbalProtocolV2::send_target(const Target& target)
 {
     const float roll_rad = 0.0f;
-    const float pitch_rad = to_rad_from_deg(pitch_deg);
-    const float yaw_rad = to_rad_from_deg(yaw_deg);
+    const float pitch_rad = to_rad_from_deg(target.pitch_deg);
+    const float yaw_rad = to_rad_from_deg(target.yaw_deg);
 
     float quaternion[4];
     mavlink_euler_to_quaternion(roll_rad, pitch_rad, yaw_rad, quaternion);
 
     const uint32_t flags =
         GIMBAL_MANAGER_FLAGS_ROLL_LOCK | GIMBAL_MANAGER_FLAGS_PITCH_LOCK |
-        ((_gimbal_mode == Gimbal::GimbalMode::YawLock) ? GIMBAL_MANAGER_FLAGS_YAW_LOCK : 0);
+        ((target.gimbal_mode == Gimbal::GimbalMode::YawLock) ? GIMBAL_MANAGER_FLAGS_YAW_LOCK : 0);
 
     mavlink_message_t message;
     mavlink_msg_gimbal_manager_set_attitude_pack(
@@ -63,6 +81,7 @@ void GimbalProtocolV2::set_pitch_and_yaw_async(
 
 Gimbal::Result GimbalProtocolV2::set_mode(const Gimbal::GimbalMode gimbal_mode)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     _gimbal_mode = gimbal_mode;
     return Gimbal::Result::Success;
 }
@@ -70,7 +89,7 @@ Gimbal::Result GimbalProtocolV2::set_mode(const Gimbal::GimbalMode gimbal_mode)
 void GimbalProtocolV2::set_mode_async(
     const Gimbal::GimbalMode gimbal_mode, Gimbal::ResultCallback callback)
 {
-    _gimbal_mode = gimbal_mode;
+    set_mode(gimbal_mode);
 
     if (callback) {
         auto temp_callback = callback;
@@ -103,4 +122,39 @@ void GimbalProtocolV2::set_roi_location_async(
     }
 }
 
+Gimbal::Result GimbalProtocolV2::set_streaming_rate(double rate_hz)
+{
+    if (!(rate_hz > 0.0)) {
+        rate_hz = 0.0;
+    } else if (rate_hz > MAX_STREAMING_RATE_HZ) {
+        LogWarn() << "Gimbal streaming rate limited to " << MAX_STREAMING_RATE_HZ << " Hz";
+        rate_hz = MAX_STREAMING_RATE_HZ;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // The streaming thread never takes the lock, so we can wait for it here.
+    // Once it is stopped, a target it had not sent yet is sent from here.
+    _streaming_thread.stop();
+    stream_target();
+
+    _streaming_rate_hz = rate_hz;
+
+    if (_streaming_rate_hz > 0.0) {
+        _streaming_thread.start(_streaming_rate_hz, [this]() { stream_target(); });
+    }
+
+    return Gimbal::Result::Success;
+}
+
+void GimbalProtocolV2::stream_target()
+{
+    // Called from the streaming thread, or with the thread stopped.
+    // Unlike offboard setpoints, the gimbal manager keeps the last target,
+    // so nothing is sent unless there is a new one.
+    if (_target_mailbox.read(_streamed_target)) {
+        send_target(_streamed_target);
+    }
+}
+
 } // namespace mavsdk
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <mutex>
+
 #include "plugins/gimbal/gimbal.h"
 #include "gimbal_protocol_base.h"
+#include "mailbox.h"
+#include "periodic_thread.h"
 
 namespace mavsdk {
 
@@ -11,6 +15,10 @@ public:
         SystemImpl& system_impl, const mavlink_gimbal_manager_information_t& information);
     ~GimbalProtocolV2() = default;
 
+    // Non-copyable
+    GimbalProtocolV2(const GimbalProtocolV2&) = delete;
+    const GimbalProtocolV2& operator=(const GimbalProtocolV2&) = delete;
+
     Gimbal::Result set_pitch_and_yaw(float pitch_deg, float yaw_deg) override;
 
     void set_pitch_and_yaw_async(
@@ -30,11 +38,36 @@ public:
         float altitude_m,
         Gimbal::ResultCallback callback) override;
 
+    Gimbal::Result set_streaming_rate(double rate_hz) override;
+
 private:
+    struct Target {
+        float pitch_deg{0.0f};
+        float yaw_deg{0.0f};
+        Gimbal::GimbalMode gimbal_mode{Gimbal::GimbalMode::YawFollow};
+    };
+
     void set_gimbal_information(const mavlink_gimbal_manager_information_t& information);
 
+    Gimbal::Result send_target(const Target& target);
+    void stream_target();
+
+    static constexpr double MAX_STREAMING_RATE_HZ = 200.0;
+
     uint8_t _gimbal_device_id{0};
+
+    // Only taken by the callers, never by the streaming thread.
+    std::mutex _mutex{};
     Gimbal::GimbalMode _gimbal_mode{Gimbal::GimbalMode::YawFollow};
+    double _streaming_rate_hz{0.0};
+
+    // Targets which are superseded before the next deadline are never sent.
+    Mailbox<Target> _target_mailbox{};
+    // Only used by the streaming thread.
+    Target _streamed_target{};
+
+    // Last, so that it is stopped before anything it uses is destroyed.
+    PeriodicThread _streaming_thread{};
 };
 
 } // namespace mavsdk
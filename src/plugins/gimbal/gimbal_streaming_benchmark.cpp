@@ -0,0 +1,75 @@
+#include "mailbox.h"
+#include "mavlink_include.h"
+#include <cmath>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+namespace {
+
+struct Target {
+    float pitch_deg{0.0f};
+    float yaw_deg{0.0f};
+    double time_s{0.0};
+};
+
+constexpr double input_rate_hz = 250.0;
+constexpr double duration_s = 10.0;
+constexpr double message_bytes =
+    MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_GIMBAL_MANAGER_SET_ATTITUDE_LEN;
+
+} // namespace
+
+// A joystick moving the gimbal at 250 Hz, with targets streamed at the rate
+// given (or each sent right away for 0), in simulated time.
+//
+// Reports the messages sent per second, the share of the link this saves
+// compared to sending every target, and how long it takes on average until
+// a target, or a newer one, is sent.
+static void BM_GimbalStreaming(benchmark::State& state)
+{
+    const auto rate_hz = static_cast<double>(state.range(0));
+    const int num_inputs = static_cast<int>(duration_s * input_rate_hz);
+
+    uint64_t num_sent = 0;
+    double delay_sum_s = 0.0;
+
+    for (auto _ : state) {
+        Mailbox<Target> mailbox;
+        Target sent{};
+        num_sent = 0;
+        delay_sum_s = 0.0;
+
+        double next_deadline_s = 0.0;
+        for (int i = 0; i < num_inputs; ++i) {
+            const double time_s = i / input_rate_hz;
+
+            // The streaming thread, for the deadlines before this input.
+            while (rate_hz > 0.0 && next_deadline_s <= time_s) {
+                if (mailbox.read(sent)) {
+                    ++num_sent;
+                }
+                next_deadline_s += 1.0 / rate_hz;
+            }
+
+            const Target target{
+                static_cast<float>(std::sin(time_s)), static_cast<float>(time_s), time_s};
+            if (rate_hz > 0.0) {
+                mailbox.write(target);
+                delay_sum_s += next_deadline_s - time_s;
+            } else {
+                sent = target;
+                ++num_sent;
+            }
+        }
+        benchmark::DoNotOptimize(sent);
+    }
+
+    const double messages_per_s = static_cast<double>(num_sent) / duration_s;
+    state.counters["msgs_per_s"] = messages_per_s;
+    state.counters["bytes_per_s"] = messages_per_s * message_bytes;
+    state.counters["saved_percent"] = 100.0 * (1.0 - messages_per_s / input_rate_hz);
+    state.counters["mean_delay_ms"] = 1000.0 * delay_sum_s / num_inputs;
+    state.SetItemsProcessed(state.iterations() * num_inputs);
+}
+BENCHMARK(BM_GimbalStreaming)->Arg(0)->Arg(10)->Arg(25)->Arg(50)->Arg(100);
@@ -171,6 +171,22 @@ public:
      */
     Result set_roi_location(double latitude_deg, double longitude_deg, float altitude_m) const;
 
+    /**
+     * @brief Send pitch and yaw targets from a thread of their own at the given rate.
+     *
+     * Instead of sending a message for every call to 'set_pitch_and_yaw', the latest target is
+     * sent at the next deadline, and targets superseded before are dropped. This is meant for
+     * inputs faster than the link should carry, such as a joystick. A rate of 0 goes back to
+     * sending every target right away. The rate is limited to 200 Hz.
+     *
+     * Streaming is only supported by gimbals using the gimbal protocol v2.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    Result set_streaming_rate(double rate_hz) const;
+
     /**
      * @brief Copy constructor.
      */
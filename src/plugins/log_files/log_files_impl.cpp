@@ -1,4 +1,5 @@
 #include "global_include.h"
+#include "async_result.h"
 #include "log_files_impl.h"
 #include "mavsdk_impl.h"
 #include <algorithm>
@@ -49,6 +50,10 @@ void LogFilesImpl::deinit()
     {
         std::lock_guard<std::mutex> lock(_data.mutex);
         _parent->unregister_timeout_handler(_data.cookie);
+        // Keep what we have so far, so the download can be resumed.
+        if (_data.resume_file) {
+            _data.resume_file->save();
+        }
     }
     _parent->unregister_all_mavlink_message_handlers(this);
 }
@@ -71,14 +76,12 @@ void LogFilesImpl::request_end()
 
 std::pair<LogFiles::Result, std::vector<LogFiles::Entry>> LogFilesImpl::get_entries()
 {
-    auto prom =
-        std::make_shared<std::promise<std::pair<LogFiles::Result, std::vector<LogFiles::Entry>>>>();
-    auto future_result = prom->get_future();
-
-    get_entries_async([prom](LogFiles::Result result, std::vector<LogFiles::Entry> entries) {
-        prom->set_value(std::make_pair<>(result, entries));
-    });
-    return future_result.get();
+    auto result = async_call<LogFiles::Result, std::vector<LogFiles::Entry>>(
+                      [this](const LogFiles::GetEntriesCallback& callback) {
+                          get_entries_async(callback);
+                      })
+                      .get();
+    return std::make_pair<>(std::get<0>(result), std::move(std::get<1>(result)));
 }
 
 void LogFilesImpl::get_entries_async(LogFiles::GetEntriesCallback callback)
@@ -205,6 +208,7 @@ void LogFilesImpl::download_log_file_async(
     unsigned id, const std::string& file_path, LogFiles::DownloadLogFileCallback callback)
 {
     unsigned bytes_to_get;
+    std::string identity;
     {
         std::lock_guard<std::mutex> lock(_entries.mutex);
 
@@ -222,29 +226,75 @@ void LogFilesImpl::download_log_file_async(
             return;
         }
 
-        bytes_to_get = _entries.entry_map[id].size_bytes;
+        bytes_to_get = it->second.size_bytes;
+
+        // The id alone is not enough because ids get reused once logs are
+        // deleted on the vehicle.
+        identity = "log " + std::to_string(id) + " " + std::to_string(bytes_to_get) + " " +
+                   it->second.date;
     }
 
     {
         std::lock_guard<std::mutex> lock(_data.mutex);
 
-        if (!start_logfile(file_path)) {
-            if (callback) {
-                const auto tmp_callback = callback;
-                _parent->call_user_callback([tmp_callback]() {
-                    LogFiles::ProgressData progress;
-                    progress.progress = NAN;
-                    tmp_callback(LogFiles::Result::FileOpenFailed, progress);
-                });
+        // In case a previous download got stuck, stop it before starting over.
+        _parent->unregister_timeout_handler(_data.cookie);
+        finish_logfile();
+        if (_data.resume_file) {
+            _data.resume_file->save();
+        }
+
+        _data.resume_file.reset(new ResumeFile(file_path));
+        bool resume = _data.resume_file->load(identity, bytes_to_get, PART_BYTES);
+
+        if (!start_logfile(file_path, resume)) {
+            if (!resume || !start_logfile(file_path, false)) {
+                _data.resume_file.reset();
+                if (callback) {
+                    const auto tmp_callback = callback;
+                    _parent->call_user_callback([tmp_callback]() {
+                        LogFiles::ProgressData progress;
+                        progress.progress = NAN;
+                        tmp_callback(LogFiles::Result::FileOpenFailed, progress);
+                    });
+                }
+                return;
             }
-            return;
+            resume = false;
+        }
+
+        if (!resume) {
+            _data.resume_file->reset(identity, bytes_to_get, PART_BYTES);
         }
 
         _data.id = id;
         _data.callback = callback;
         _data.time_started = _time.steady_time();
         _data.bytes_to_get = bytes_to_get;
-        _data.part_start = 0;
+        _data.part_start = _data.resume_file->first_missing() * PART_BYTES;
+        _data.bytes_resumed = _data.part_start;
+
+        if (_data.resume_file->is_complete()) {
+            LogDebug() << "Log " << id << " already downloaded completely";
+            finish_logfile();
+            _data.resume_file->remove();
+            if (_data.callback) {
+                const auto tmp_callback = _data.callback;
+                _parent->call_user_callback([tmp_callback]() {
+                    LogFiles::ProgressData progress_data;
+                    progress_data.progress = 1.0f;
+                    tmp_callback(LogFiles::Result::Success, progress_data);
+                });
+            }
+            reset_data();
+            return;
+        }
+
+        if (resume) {
+            LogDebug() << "Resuming download of log " << id << " at " << _data.part_start
+                       << " B of " << _data.bytes_to_get << " B";
+        }
+
         const auto part_size = determine_part_end() - _data.part_start;
         _data.bytes.resize(part_size);
         _data.chunks_received.resize(
@@ -258,9 +308,10 @@ void LogFilesImpl::download_log_file_async(
 
         if (_data.callback) {
             const auto tmp_callback = _data.callback;
-            _parent->call_user_callback([tmp_callback]() {
+            const float progress_start = float(_data.part_start) / float(_data.bytes_to_get);
+            _parent->call_user_callback([tmp_callback, progress_start]() {
                 LogFiles::ProgressData progress;
-                progress.progress = 0.0f;
+                progress.progress = progress_start;
                 tmp_callback(LogFiles::Result::Next, progress);
             });
         }
@@ -271,9 +322,7 @@ std::size_t LogFilesImpl::determine_part_end()
 {
     // Assumes to have the lock for _data.mutex.
 
-    return std::min(
-        _data.part_start + PART_SIZE * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
-        std::size_t(_data.bytes_to_get));
+    return std::min(_data.part_start + PART_BYTES, std::size_t(_data.bytes_to_get));
 }
 
 void LogFilesImpl::process_log_data(const mavlink_message_t& message)
@@ -353,20 +402,41 @@ void LogFilesImpl::check_part()
     } else {
         _data.rerequesting = false;
 
-        write_part_to_disk();
+        if (!write_part_to_disk()) {
+            // Asking for the same part again would not help, e.g. if the disk
+            // is full. What is on disk already can be resumed later.
+            _parent->unregister_timeout_handler(_data.cookie);
+            finish_logfile();
+            _data.resume_file->save();
+
+            if (_data.callback) {
+                const auto tmp_callback = _data.callback;
+                _parent->call_user_callback([tmp_callback]() {
+                    LogFiles::ProgressData progress_data;
+                    progress_data.progress = NAN;
+                    tmp_callback(LogFiles::Result::FileOpenFailed, progress_data);
+                });
+            }
+
+            reset_data();
+            return;
+        }
 
         report_progress(_data.part_start + _data.bytes.size(), _data.bytes_to_get);
 
-        const float kib_s = float(_data.part_start + _data.bytes.size()) /
+        const float kib_s = float(_data.part_start + _data.bytes.size() - _data.bytes_resumed) /
                             float(_time.elapsed_since_s(_data.time_started)) / 1024.0f;
 
         LogDebug() << _data.part_start + _data.bytes.size() << " B of " << _data.bytes_to_get
                    << " B (" << kib_s << " kiB/s)";
 
-        if (_data.part_start + _data.bytes.size() == _data.bytes_to_get) {
+        const auto next_part = _data.resume_file->first_missing(_data.part_start / PART_BYTES);
+
+        if (next_part == _data.resume_file->num_chunks()) {
             _parent->unregister_timeout_handler(_data.cookie);
 
             finish_logfile();
+            _data.resume_file->remove();
 
             if (_data.callback) {
                 const auto tmp_callback = _data.callback;
@@ -379,7 +449,7 @@ void LogFilesImpl::check_part()
 
             reset_data();
         } else {
-            _data.part_start = _data.part_start + _data.bytes.size();
+            _data.part_start = next_part * PART_BYTES;
 
             const auto part_size = determine_part_end() - _data.part_start;
             _data.bytes.resize(part_size);
@@ -416,31 +486,67 @@ void LogFilesImpl::data_timeout()
         _parent->register_timeout_handler(
             std::bind(&LogFilesImpl::data_timeout, this), DATA_TIMEOUT_S, &_data.cookie);
         _data.rerequesting = true;
+        // The transfer stalls, keep what we have until it is resumed.
+        if (_data.resume_file && _data.resume_file->has_unsaved_changes()) {
+            _data.resume_file->save();
+        }
         check_part();
     }
 }
 
-bool LogFilesImpl::start_logfile(const std::string& path)
+bool LogFilesImpl::start_logfile(const std::string& path, bool resume)
 {
     // Assumes to have the lock for _data.mutex.
 
-    _data.file.open(path, std::ios::out | std::ios::binary);
+    if (!resume) {
+        _data.file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        return ((_data.file.rdstate() & std::ofstream::failbit) == 0);
+    }
+
+    // Opening with in and out keeps the existing content which only works if the
+    // file is still there.
+    _data.file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if ((_data.file.rdstate() & std::ofstream::failbit) != 0) {
+        _data.file.clear();
+        return false;
+    }
 
-    return ((_data.file.rdstate() & std::ofstream::failbit) == 0);
+    _data.file.seekp(0, std::ios::end);
+    if (uint64_t(_data.file.tellp()) < _data.resume_file->received_end_bytes()) {
+        LogWarn() << "Partial log file " << path << " too short, starting over";
+        _data.file.close();
+        return false;
+    }
+
+    return true;
 }
 
-void LogFilesImpl::write_part_to_disk()
+bool LogFilesImpl::write_part_to_disk()
 {
     // Assumes to have the lock for _data.mutex.
 
+    _data.file.seekp(_data.part_start);
     _data.file.write(reinterpret_cast<char*>(_data.bytes.data()), _data.bytes.size());
+    _data.file.flush();
+
+    if (!_data.file) {
+        LogErr() << "Could not write log part to disk";
+        _data.file.clear();
+        return false;
+    }
+
+    _data.resume_file->mark_received(_data.part_start / PART_BYTES);
+    _data.resume_file->save_if_due(_time.steady_time());
+    return true;
 }
 
 void LogFilesImpl::finish_logfile()
 {
     // Assumes to have the lock for _data.mutex.
 
-    _data.file.close();
+    if (_data.file.is_open()) {
+        _data.file.close();
+    }
 }
 
 void LogFilesImpl::reset_data()
@@ -454,6 +560,8 @@ void LogFilesImpl::reset_data()
     _data.retries = 0;
     _data.rerequesting = false;
     _data.last_ofs_rerequested = -1;
+    _data.bytes_resumed = 0;
+    _data.resume_file.reset();
     _data.callback = nullptr;
 }
 
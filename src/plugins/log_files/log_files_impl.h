@@ -3,8 +3,10 @@
 #include "mavlink_include.h"
 #include "plugins/log_files/log_files.h"
 #include "plugin_impl_base.h"
+#include "resume_file.h"
 #include "system.h"
 #include <fstream>
+#include <memory>
 
 namespace mavsdk {
 
@@ -39,8 +41,8 @@ private:
     void request_log_data(unsigned id, unsigned start, unsigned count);
     void data_timeout();
 
-    bool start_logfile(const std::string& path);
-    void write_part_to_disk();
+    bool start_logfile(const std::string& path, bool resume);
+    bool write_part_to_disk();
     void finish_logfile();
     void report_progress(unsigned transferred, unsigned total);
 
@@ -69,7 +71,7 @@ private:
     //
     // This is very much inspired from how QGroundControl does it.
     static constexpr unsigned PART_SIZE = 512;
-    // A part refers to the
+    static constexpr unsigned PART_BYTES = PART_SIZE * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
 
     struct {
         std::mutex mutex{};
@@ -83,7 +85,10 @@ private:
         bool rerequesting{false};
         int last_ofs_rerequested{-1};
         dl_time_t time_started{};
+        std::size_t bytes_resumed{0};
         std::ofstream file{};
+        // Parts already on disk, so an interrupted download can be resumed.
+        std::unique_ptr<ResumeFile> resume_file{};
         LogFiles::DownloadLogFileCallback callback{nullptr};
     } _data{};
 };
@@ -57,6 +57,43 @@ public:
      */
     ~ManualControl();
 
+    /**
+     * @brief Statistics of the thread streaming manual control input.
+     */
+    struct StreamingStats {
+        double rate_hz{}; /**< @brief Streaming rate (in Hz), 0 if input is sent right away */
+        uint64_t num_periods{}; /**< @brief Number of periods the streaming thread woke up for */
+        uint64_t num_missed_deadlines{}; /**< @brief Number of periods skipped because the streaming
+                                            thread was too late */
+        double jitter_mean_us{}; /**< @brief Mean delay after the deadline (in microseconds) */
+        double jitter_stddev_us{}; /**< @brief Standard deviation of the delay after the deadline
+                                      (in microseconds) */
+        double jitter_max_us{}; /**< @brief Maximum delay after the deadline (in microseconds) */
+        uint64_t num_sent{}; /**< @brief Number of messages sent */
+        uint64_t num_skipped{}; /**< @brief Number of periods in which nothing was sent because the
+                                   input was within the deadband of the one sent last */
+        double latency_mean_us{}; /**< @brief Mean time from setting an input until it is sent
+                                     (in microseconds) */
+        double latency_max_us{}; /**< @brief Maximum time from setting an input until it is sent
+                                    (in microseconds) */
+    };
+
+    /**
+     * @brief Equal operator to compare two `ManualControl::StreamingStats` objects.
+     *
+     * @return `true` if items are equal.
+     */
+    friend bool operator==(
+        const ManualControl::StreamingStats& lhs, const ManualControl::StreamingStats& rhs);
+
+    /**
+     * @brief Stream operator to print information about a `ManualControl::StreamingStats`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream&
+    operator<<(std::ostream& str, ManualControl::StreamingStats const& streaming_stats);
+
     /**
      * @brief Possible results returned for manual control requests.
      */
@@ -142,6 +179,43 @@ public:
      */
     Result set_manual_control_input(float x, float y, float z, float r) const;
 
+    /**
+     * @brief Send manual control input from a thread of their own at the given rate.
+     *
+     * The thread wakes up at fixed deadlines and sends the latest input set, so input set
+     * irregularly or from several threads reaches the vehicle at a steady rate. Input which
+     * did not change since it was last sent is only repeated every 100 ms (at 10 Hz), enough
+     * to not trigger RC loss. A rate of 0 goes back to sending input right away when it is
+     * set. The rate is limited to 1000 Hz.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    Result set_streaming_rate(double rate_hz) const;
+
+    /**
+     * @brief Set by how much the streamed input has to change to be sent before the next repeat.
+     *
+     * Input within the deadband of the input sent last, on all axes, is not sent until it is
+     * repeated. The deadband is in the units of the input, from 0 (default, any change is
+     * sent) to 1.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    Result set_streaming_deadband(float deadband) const;
+
+    /**
+     * @brief Get the statistics of the thread streaming manual control input.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    std::pair<Result, ManualControl::StreamingStats> get_streaming_stats() const;
+
     /**
      * @brief Copy constructor.
      */
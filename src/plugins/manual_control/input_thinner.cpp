@@ -0,0 +1,37 @@
+#include "input_thinner.h"
+#include <cstdlib>
+
+namespace mavsdk {
+
+InputThinner::InputThinner(Clock::duration keepalive_interval) :
+    _keepalive_interval(keepalive_interval)
+{}
+
+void InputThinner::reset()
+{
+    _has_sent = false;
+}
+
+bool InputThinner::should_send(const Input& input, int16_t deadband, Clock::time_point now)
+{
+    const bool unchanged = _has_sent && within_deadband(input.x, _last_sent.x, deadband) &&
+                           within_deadband(input.y, _last_sent.y, deadband) &&
+                           within_deadband(input.z, _last_sent.z, deadband) &&
+                           within_deadband(input.r, _last_sent.r, deadband);
+
+    if (unchanged && now - _last_sent_time < _keepalive_interval) {
+        return false;
+    }
+
+    _has_sent = true;
+    _last_sent = input;
+    _last_sent_time = now;
+    return true;
+}
+
+bool InputThinner::within_deadband(int16_t lhs, int16_t rhs, int16_t deadband)
+{
+    return std::abs(int(lhs) - int(rhs)) <= int(deadband);
+}
+
+} // namespace mavsdk
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace mavsdk {
+
+// Decides which manual control inputs the streaming thread has to send.
+//
+// An input which is within the deadband of the last one sent, on all axes,
+// doesn't change anything for the vehicle and is skipped. Still, the last
+// input is repeated after the keepalive interval, so the vehicle doesn't
+// consider manual control as lost.
+class InputThinner {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // As in MANUAL_CONTROL, from -1000 to 1000.
+    struct Input {
+        int16_t x{0};
+        int16_t y{0};
+        int16_t z{0};
+        int16_t r{0};
+    };
+
+    explicit InputThinner(Clock::duration keepalive_interval);
+    ~InputThinner() = default;
+
+    // Forgets what was sent last, so the next input is sent.
+    void reset();
+
+    // Returns whether the input is to be sent at now, and if so remembers
+    // it as the last one sent. A deadband of 0 only skips inputs which are
+    // the same.
+    bool should_send(const Input& input, int16_t deadband, Clock::time_point now);
+
+private:
+    static bool within_deadband(int16_t lhs, int16_t rhs, int16_t deadband);
+
+    const Clock::duration _keepalive_interval;
+
+    bool _has_sent{false};
+    Input _last_sent{};
+    Clock::time_point _last_sent_time{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,78 @@
+#include "input_thinner.h"
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+using Clock = InputThinner::Clock;
+
+static constexpr auto keepalive_interval = std::chrono::milliseconds(100);
+
+TEST(InputThinner, SendsFirstInput)
+{
+    InputThinner thinner(keepalive_interval);
+    EXPECT_TRUE(thinner.should_send({0, 0, 500, 0}, 0, Clock::now()));
+}
+
+TEST(InputThinner, SkipsSameInputUntilKeepalive)
+{
+    InputThinner thinner(keepalive_interval);
+    auto now = Clock::now();
+    const InputThinner::Input input{100, -200, 500, 0};
+    EXPECT_TRUE(thinner.should_send(input, 0, now));
+
+    // At 200 Hz, for 1 second.
+    int num_sent = 0;
+    for (int i = 0; i < 200; ++i) {
+        now += std::chrono::milliseconds(5);
+        if (thinner.should_send(input, 0, now)) {
+            ++num_sent;
+        }
+    }
+    EXPECT_EQ(num_sent, 10);
+}
+
+TEST(InputThinner, SendsChangedInput)
+{
+    InputThinner thinner(keepalive_interval);
+    auto now = Clock::now();
+    EXPECT_TRUE(thinner.should_send({0, 0, 500, 0}, 0, now));
+
+    now += std::chrono::milliseconds(5);
+    EXPECT_TRUE(thinner.should_send({1, 0, 500, 0}, 0, now));
+
+    now += std::chrono::milliseconds(5);
+    EXPECT_TRUE(thinner.should_send({1, 0, 500, -1}, 0, now));
+}
+
+TEST(InputThinner, SkipsInputWithinDeadband)
+{
+    InputThinner thinner(keepalive_interval);
+    auto now = Clock::now();
+    EXPECT_TRUE(thinner.should_send({0, 0, 500, 0}, 10, now));
+
+    // Drifting slowly, compared to what was sent, not to the input before.
+    now += std::chrono::milliseconds(5);
+    EXPECT_FALSE(thinner.should_send({5, 0, 500, 0}, 10, now));
+    now += std::chrono::milliseconds(5);
+    EXPECT_FALSE(thinner.should_send({10, -10, 510, 10}, 10, now));
+    now += std::chrono::milliseconds(5);
+    EXPECT_TRUE(thinner.should_send({11, 0, 500, 0}, 10, now));
+
+    now += std::chrono::milliseconds(5);
+    EXPECT_FALSE(thinner.should_send({11, 0, 500, 0}, 10, now));
+
+    // The latest input is repeated.
+    now += keepalive_interval;
+    EXPECT_TRUE(thinner.should_send({12, 0, 500, 0}, 10, now));
+}
+
+TEST(InputThinner, SendsAgainAfterReset)
+{
+    InputThinner thinner(keepalive_interval);
+    const auto now = Clock::now();
+    EXPECT_TRUE(thinner.should_send({0, 0, 500, 0}, 0, now));
+    EXPECT_FALSE(thinner.should_send({0, 0, 500, 0}, 0, now));
+
+    thinner.reset();
+    EXPECT_TRUE(thinner.should_send({0, 0, 500, 0}, 0, now));
+}
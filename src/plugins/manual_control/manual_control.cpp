@@ -10,6 +10,8 @@
 
 namespace mavsdk {
 
+using StreamingStats = ManualControl::StreamingStats;
+
 ManualControl::ManualControl(System& system) : PluginBase(), _impl{new ManualControlImpl(system)} {}
 
 ManualControl::ManualControl(std::shared_ptr<System> system) :
@@ -45,6 +47,58 @@ ManualControl::set_manual_control_input(float x, float y, float z, float r) cons
     return _impl->set_manual_control_input(x, y, z, r);
 }
 
+ManualControl::Result ManualControl::set_streaming_rate(double rate_hz) const
+{
+    return _impl->set_streaming_rate(rate_hz);
+}
+
+ManualControl::Result ManualControl::set_streaming_deadband(float deadband) const
+{
+    return _impl->set_streaming_deadband(deadband);
+}
+
+std::pair<ManualControl::Result, ManualControl::StreamingStats>
+ManualControl::get_streaming_stats() const
+{
+    return _impl->get_streaming_stats();
+}
+
+bool operator==(const ManualControl::StreamingStats& lhs, const ManualControl::StreamingStats& rhs)
+{
+    return ((std::isnan(rhs.rate_hz) && std::isnan(lhs.rate_hz)) || rhs.rate_hz == lhs.rate_hz) &&
+           (rhs.num_periods == lhs.num_periods) &&
+           (rhs.num_missed_deadlines == lhs.num_missed_deadlines) &&
+           ((std::isnan(rhs.jitter_mean_us) && std::isnan(lhs.jitter_mean_us)) ||
+            rhs.jitter_mean_us == lhs.jitter_mean_us) &&
+           ((std::isnan(rhs.jitter_stddev_us) && std::isnan(lhs.jitter_stddev_us)) ||
+            rhs.jitter_stddev_us == lhs.jitter_stddev_us) &&
+           ((std::isnan(rhs.jitter_max_us) && std::isnan(lhs.jitter_max_us)) ||
+            rhs.jitter_max_us == lhs.jitter_max_us) &&
+           (rhs.num_sent == lhs.num_sent) && (rhs.num_skipped == lhs.num_skipped) &&
+           ((std::isnan(rhs.latency_mean_us) && std::isnan(lhs.latency_mean_us)) ||
+            rhs.latency_mean_us == lhs.latency_mean_us) &&
+           ((std::isnan(rhs.latency_max_us) && std::isnan(lhs.latency_max_us)) ||
+            rhs.latency_max_us == lhs.latency_max_us);
+}
+
+std::ostream& operator<<(std::ostream& str, ManualControl::StreamingStats const& streaming_stats)
+{
+    str << std::setprecision(15);
+    str << "streaming_stats:" << '\n' << "{\n";
+    str << "    rate_hz: " << streaming_stats.rate_hz << '\n';
+    str << "    num_periods: " << streaming_stats.num_periods << '\n';
+    str << "    num_missed_deadlines: " << streaming_stats.num_missed_deadlines << '\n';
+    str << "    jitter_mean_us: " << streaming_stats.jitter_mean_us << '\n';
+    str << "    jitter_stddev_us: " << streaming_stats.jitter_stddev_us << '\n';
+    str << "    jitter_max_us: " << streaming_stats.jitter_max_us << '\n';
+    str << "    num_sent: " << streaming_stats.num_sent << '\n';
+    str << "    num_skipped: " << streaming_stats.num_skipped << '\n';
+    str << "    latency_mean_us: " << streaming_stats.latency_mean_us << '\n';
+    str << "    latency_max_us: " << streaming_stats.latency_max_us << '\n';
+    str << '}';
+    return str;
+}
+
 std::ostream& operator<<(std::ostream& str, ManualControl::Result const& result)
 {
     switch (result) {
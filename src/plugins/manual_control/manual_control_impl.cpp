@@ -1,4 +1,6 @@
 #include "manual_control_impl.h"
+#include "log.h"
+#include <algorithm>
 #include <future>
 
 namespace mavsdk {
@@ -20,7 +22,11 @@ ManualControlImpl::~ManualControlImpl()
 
 void ManualControlImpl::init() {}
 
-void ManualControlImpl::deinit() {}
+void ManualControlImpl::deinit()
+{
+    _streaming_thread.stop();
+    _streaming_rate_hz = 0.0;
+}
 
 void ManualControlImpl::enable() {}
 
@@ -95,10 +101,154 @@ ManualControlImpl::set_manual_control_input(float x, float y, float z, float r)
         return ManualControl::Result::InputOutOfRange;
     }
 
+    const InputThinner::Input input{
+        static_cast<int16_t>(x * 1000),
+        static_cast<int16_t>(y * 1000),
+        static_cast<int16_t>(z * 1000),
+        static_cast<int16_t>(r * 1000)};
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
     if (_input == Input::NotSet) {
         _input = Input::Set;
     }
 
+    _latest_input = {input, InputThinner::Clock::now()};
+
+    if (_streaming_rate_hz > 0.0) {
+        // The streaming thread sends it at its next deadline.
+        _input_mailbox.write(_latest_input);
+        return ManualControl::Result::Success;
+    }
+
+    return send_input(input) ? ManualControl::Result::Success :
+                               ManualControl::Result::ConnectionError;
+}
+
+ManualControl::Result ManualControlImpl::set_streaming_rate(double rate_hz)
+{
+    if (!(rate_hz > 0.0)) {
+        rate_hz = 0.0;
+    } else if (rate_hz > MAX_STREAMING_RATE_HZ) {
+        LogWarn() << "Manual control streaming rate limited to " << MAX_STREAMING_RATE_HZ
+                  << " Hz";
+        rate_hz = MAX_STREAMING_RATE_HZ;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // The streaming thread never takes the lock, so we can wait for it here.
+    _streaming_thread.stop();
+
+    _streaming_rate_hz = rate_hz;
+
+    if (_streaming_rate_hz > 0.0) {
+        _has_streamed_input = false;
+        _thinner.reset();
+        reset_streaming_stats();
+        if (_input == Input::Set) {
+            _input_mailbox.write(_latest_input);
+        }
+        _streaming_thread.start(_streaming_rate_hz, [this]() { stream_input(); });
+    }
+
+    return ManualControl::Result::Success;
+}
+
+ManualControl::Result ManualControlImpl::set_streaming_deadband(float deadband)
+{
+    if (!(deadband >= 0.f && deadband <= 1.f)) {
+        return ManualControl::Result::InputOutOfRange;
+    }
+
+    _streaming_deadband.store(static_cast<int16_t>(deadband * 1000), std::memory_order_relaxed);
+    return ManualControl::Result::Success;
+}
+
+std::pair<ManualControl::Result, ManualControl::StreamingStats>
+ManualControlImpl::get_streaming_stats()
+{
+    const auto thread_stats = _streaming_thread.stats();
+
+    ManualControl::StreamingStats stats{};
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stats.rate_hz = _streaming_rate_hz;
+    }
+    stats.num_periods = thread_stats.num_calls;
+    stats.num_missed_deadlines = thread_stats.num_missed_deadlines;
+    stats.jitter_mean_us = thread_stats.jitter_mean_us;
+    stats.jitter_stddev_us = thread_stats.jitter_stddev_us;
+    stats.jitter_max_us = thread_stats.jitter_max_us;
+
+    stats.num_sent = _num_sent.load(std::memory_order_relaxed);
+    stats.num_skipped = _num_skipped.load(std::memory_order_relaxed);
+    const uint64_t num_latencies = _num_latencies.load(std::memory_order_relaxed);
+    if (num_latencies > 0) {
+        const auto latency_sum_ns = _latency_sum_ns.load(std::memory_order_relaxed);
+        stats.latency_mean_us =
+            static_cast<double>(latency_sum_ns) / static_cast<double>(num_latencies) / 1e3;
+    }
+    stats.latency_max_us =
+        static_cast<double>(_latency_max_ns.load(std::memory_order_relaxed)) / 1e3;
+
+    return std::make_pair<>(ManualControl::Result::Success, stats);
+}
+
+void ManualControlImpl::reset_streaming_stats()
+{
+    _num_sent.store(0, std::memory_order_relaxed);
+    _num_skipped.store(0, std::memory_order_relaxed);
+    _num_latencies.store(0, std::memory_order_relaxed);
+    _latency_sum_ns.store(0, std::memory_order_relaxed);
+    _latency_max_ns.store(0, std::memory_order_relaxed);
+}
+
+void ManualControlImpl::stream_input()
+{
+    // Called from the streaming thread only, without locking.
+    if (_input_mailbox.read(_streamed_input)) {
+        _has_streamed_input = true;
+        _streamed_input_sent = false;
+    }
+
+    if (!_has_streamed_input) {
+        return;
+    }
+
+    const auto deadband = _streaming_deadband.load(std::memory_order_relaxed);
+    if (!_thinner.should_send(_streamed_input.input, deadband, InputThinner::Clock::now())) {
+        _num_skipped.store(
+            _num_skipped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!send_input(_streamed_input.input)) {
+        return;
+    }
+    _num_sent.store(_num_sent.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // Repeats of the same input don't tell how long it took to get out.
+    if (!_streamed_input_sent) {
+        _streamed_input_sent = true;
+
+        const auto latency_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                InputThinner::Clock::now() - _streamed_input.time)
+                .count());
+        _num_latencies.store(
+            _num_latencies.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        _latency_sum_ns.store(
+            _latency_sum_ns.load(std::memory_order_relaxed) + latency_ns,
+            std::memory_order_relaxed);
+        _latency_max_ns.store(
+            std::max(_latency_max_ns.load(std::memory_order_relaxed), latency_ns),
+            std::memory_order_relaxed);
+    }
+}
+
+bool ManualControlImpl::send_input(const InputThinner::Input& input)
+{
     // No buttons supported yet.
     const uint16_t buttons = 0;
 
@@ -108,13 +258,12 @@ ManualControlImpl::set_manual_control_input(float x, float y, float z, float r)
         _parent->get_own_component_id(),
         &message,
         _parent->get_system_id(),
-        static_cast<int16_t>(x * 1000),
-        static_cast<int16_t>(y * 1000),
-        static_cast<int16_t>(z * 1000),
-        static_cast<int16_t>(r * 1000),
+        input.x,
+        input.y,
+        input.z,
+        input.r,
         buttons);
-    return _parent->send_message(message) ? ManualControl::Result::Success :
-                                            ManualControl::Result::ConnectionError;
+    return _parent->send_message(message);
 }
 
 ManualControl::Result
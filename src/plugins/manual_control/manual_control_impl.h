@@ -1,5 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
+#include "input_thinner.h"
+#include "mailbox.h"
+#include "periodic_thread.h"
 #include "plugins/manual_control/manual_control.h"
 #include "plugin_impl_base.h"
 
@@ -27,13 +33,54 @@ public:
 
     ManualControl::Result set_manual_control_input(float x, float y, float z, float r);
 
+    ManualControl::Result set_streaming_rate(double rate_hz);
+    ManualControl::Result set_streaming_deadband(float deadband);
+    std::pair<ManualControl::Result, ManualControl::StreamingStats> get_streaming_stats();
+
 private:
+    struct StreamedInput {
+        InputThinner::Input input{};
+        // When it was set, to measure how long it takes until it is sent.
+        InputThinner::Clock::time_point time{};
+    };
+
+    bool send_input(const InputThinner::Input& input);
+    void stream_input();
+    void reset_streaming_stats();
+
     ManualControl::Result
     manual_control_result_from_command_result(MavlinkCommandSender::Result result);
     void command_result_callback(
         MavlinkCommandSender::Result command_result, const ManualControl::ResultCallback& callback);
 
     enum class Input { NotSet, Set } _input{Input::NotSet};
+
+    std::mutex _mutex{};
+    StreamedInput _latest_input{};
+
+    // Instead of sending each input right away, the latest one can be sent
+    // from a thread of their own, at a steady rate.
+    double _streaming_rate_hz{0.0};
+    std::atomic<int16_t> _streaming_deadband{0};
+    Mailbox<StreamedInput> _input_mailbox{};
+
+    // Only used by the streaming thread.
+    StreamedInput _streamed_input{};
+    bool _has_streamed_input{false};
+    bool _streamed_input_sent{false};
+    InputThinner _thinner{std::chrono::milliseconds(100)};
+
+    // Only written by the streaming thread.
+    std::atomic<uint64_t> _num_sent{0};
+    std::atomic<uint64_t> _num_skipped{0};
+    std::atomic<uint64_t> _num_latencies{0};
+    std::atomic<uint64_t> _latency_sum_ns{0};
+    std::atomic<uint64_t> _latency_max_ns{0};
+
+    // Declared last, so it is stopped before what it uses is destroyed.
+    PeriodicThread _streaming_thread{};
+
+    static constexpr double MAX_STREAMING_RATE_HZ = 1000.0;
 };
 
 } // namespace mavsdk
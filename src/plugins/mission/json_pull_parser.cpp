@@ -0,0 +1,272 @@
+#include "json_pull_parser.h"
+#include <cstdint>
+#include <cstring>
+#include <locale>
+#include <sstream>
+#include <string>
+
+namespace mavsdk {
+
+JsonPullParser::JsonPullParser(const char* data, size_t size) :
+    _begin(data),
+    _end(data + size),
+    _pos(data),
+    _token_start(data)
+{}
+
+JsonPullParser::Token JsonPullParser::next()
+{
+    if (_failed) {
+        return Token::Error;
+    }
+
+    while (_pos < _end &&
+           (*_pos == ' ' || *_pos == '\n' || *_pos == '\r' || *_pos == '\t' || *_pos == ',' ||
+            *_pos == ':')) {
+        ++_pos;
+    }
+    _token_start = _pos;
+
+    if (_in_object.empty() && _had_value) {
+        // There is only one value at the top.
+        return (_pos == _end) ? Token::End : error();
+    }
+    if (_pos == _end) {
+        return error();
+    }
+
+    const char c = *_pos;
+
+    if (_expect_key) {
+        if (c == '}') {
+            ++_pos;
+            _in_object.pop_back();
+            return value_done(Token::EndObject);
+        }
+        if (c != '"') {
+            return error();
+        }
+        ++_pos;
+        _expect_key = false;
+        return parse_string(Token::Key);
+    }
+
+    switch (c) {
+        case '{':
+        case '[':
+            if (_in_object.size() >= MAX_DEPTH) {
+                return error();
+            }
+            ++_pos;
+            _in_object.push_back(c == '{');
+            _expect_key = (c == '{');
+            return (c == '{') ? Token::BeginObject : Token::BeginArray;
+        case ']':
+            if (_in_object.empty() || _in_object.back()) {
+                return error();
+            }
+            ++_pos;
+            _in_object.pop_back();
+            return value_done(Token::EndArray);
+        case '"':
+            ++_pos;
+            return value_done(parse_string(Token::String));
+        case 't':
+            return value_done(parse_literal("true", Token::True));
+        case 'f':
+            return value_done(parse_literal("false", Token::False));
+        case 'n':
+            return value_done(parse_literal("null", Token::Null));
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                return value_done(parse_number());
+            }
+            return error();
+    }
+}
+
+bool JsonPullParser::skip_value()
+{
+    int depth = 0;
+    while (true) {
+        switch (next()) {
+            case Token::BeginObject:
+            case Token::BeginArray:
+                ++depth;
+                break;
+            case Token::EndObject:
+            case Token::EndArray:
+                if (--depth < 0) {
+                    return false;
+                }
+                break;
+            case Token::Key:
+                if (depth == 0) {
+                    return false;
+                }
+                continue;
+            case Token::End:
+            case Token::Error:
+                return false;
+            default:
+                break;
+        }
+        if (depth == 0) {
+            return true;
+        }
+    }
+}
+
+JsonPullParser::Token JsonPullParser::value_done(Token token)
+{
+    if (token == Token::Error) {
+        return token;
+    }
+    if (_in_object.empty()) {
+        _had_value = true;
+    } else {
+        _expect_key = _in_object.back();
+    }
+    return token;
+}
+
+JsonPullParser::Token JsonPullParser::error()
+{
+    _failed = true;
+    return Token::Error;
+}
+
+JsonPullParser::Token JsonPullParser::parse_string(Token token)
+{
+    const char* start = _pos;
+    while (_pos < _end) {
+        const char c = *_pos;
+        if (c == '"') {
+            _string = std::string_view(start, static_cast<size_t>(_pos - start));
+            ++_pos;
+            return token;
+        }
+        if (c == '\\') {
+            if (_end - _pos < 2) {
+                break;
+            }
+            _pos += 2;
+            continue;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            break;
+        }
+        ++_pos;
+    }
+    return error();
+}
+
+JsonPullParser::Token JsonPullParser::parse_number()
+{
+    const char* start = _pos;
+
+    const bool negative = (*_pos == '-');
+    if (negative) {
+        ++_pos;
+    }
+
+    // Up to 19 digits fit into the mantissa.
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+
+    const char* int_start = _pos;
+    while (_pos < _end && *_pos >= '0' && *_pos <= '9') {
+        if (num_digits < 19) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*_pos - '0');
+            if (mantissa != 0) {
+                ++num_digits;
+            }
+        } else {
+            ++exponent;
+            ++num_digits;
+        }
+        ++_pos;
+    }
+    if (_pos == int_start || (*int_start == '0' && _pos - int_start > 1)) {
+        return error();
+    }
+
+    if (_pos < _end && *_pos == '.') {
+        ++_pos;
+        const char* frac_start = _pos;
+        while (_pos < _end && *_pos >= '0' && *_pos <= '9') {
+            if (num_digits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*_pos - '0');
+                if (mantissa != 0) {
+                    ++num_digits;
+                }
+                --exponent;
+            } else {
+                ++num_digits;
+            }
+            ++_pos;
+        }
+        if (_pos == frac_start) {
+            return error();
+        }
+    }
+
+    if (_pos < _end && (*_pos == 'e' || *_pos == 'E')) {
+        ++_pos;
+        bool negative_exponent = false;
+        if (_pos < _end && (*_pos == '+' || *_pos == '-')) {
+            negative_exponent = (*_pos == '-');
+            ++_pos;
+        }
+        const char* exp_start = _pos;
+        int explicit_exponent = 0;
+        while (_pos < _end && *_pos >= '0' && *_pos <= '9') {
+            if (explicit_exponent < 100000) {
+                explicit_exponent = explicit_exponent * 10 + (*_pos - '0');
+            }
+            ++_pos;
+        }
+        if (_pos == exp_start) {
+            return error();
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    // Exact if the mantissa and the power of ten are exact as doubles,
+    // which is the case for most numbers in practice.
+    static constexpr double powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                               1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                               1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (num_digits <= 19 && mantissa <= (uint64_t(1) << 53) && exponent >= -22 &&
+        exponent <= 22) {
+        const auto value = static_cast<double>(mantissa);
+        _number = (exponent < 0) ? value / powers_of_ten[-exponent] :
+                                   value * powers_of_ten[exponent];
+    } else {
+        // Rare, so it doesn't matter that this is slow.
+        std::istringstream stream(std::string(start, static_cast<size_t>(_pos - start)));
+        stream.imbue(std::locale::classic());
+        double value = 0.0;
+        stream >> value;
+        _number = value;
+        return Token::Number;
+    }
+
+    if (negative) {
+        _number = -_number;
+    }
+    return Token::Number;
+}
+
+JsonPullParser::Token JsonPullParser::parse_literal(std::string_view literal, Token token)
+{
+    if (static_cast<size_t>(_end - _pos) < literal.size() ||
+        std::memcmp(_pos, literal.data(), literal.size()) != 0) {
+        return error();
+    }
+    _pos += literal.size();
+    return token;
+}
+
+} // namespace mavsdk
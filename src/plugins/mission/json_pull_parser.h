@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace mavsdk {
+
+// Reads JSON token by token from a buffer, without building a tree of it.
+//
+// It is meant for big files of which only parts are needed: the caller
+// walks the structure with next() and skips what it doesn't need with
+// skip_value(). Strings are not copied or unescaped, they point into the
+// buffer, so the buffer needs to outlive them.
+//
+// Separators are not checked strictly, input which is not valid JSON is
+// not always rejected.
+class JsonPullParser {
+public:
+    enum class Token {
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Key,
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        End,
+        Error,
+    };
+
+    JsonPullParser(const char* data, size_t size);
+    ~JsonPullParser() = default;
+
+    Token next();
+
+    // Skips the value starting with the next token, including all it contains.
+    // Returns false on errors.
+    bool skip_value();
+
+    // Of the last Key or String token, as in the file, escape sequences included.
+    std::string_view string() const { return _string; }
+
+    // Of the last Number token.
+    double number() const { return _number; }
+
+    // Where the last token, or the error, is.
+    size_t offset() const { return static_cast<size_t>(_token_start - _begin); }
+
+    static constexpr size_t MAX_DEPTH = 512;
+
+    // Non-copyable
+    JsonPullParser(const JsonPullParser&) = delete;
+    const JsonPullParser& operator=(const JsonPullParser&) = delete;
+
+private:
+    Token value_done(Token token);
+    Token error();
+    Token parse_string(Token token);
+    Token parse_number();
+    Token parse_literal(std::string_view literal, Token token);
+
+    const char* const _begin;
+    const char* const _end;
+    const char* _pos;
+    const char* _token_start;
+
+    // Whether we are in an object (true) or array (false) at each level.
+    std::vector<bool> _in_object{};
+    bool _expect_key{false};
+    bool _had_value{false};
+    bool _failed{false};
+
+    std::string_view _string{};
+    double _number{0.0};
+};
+
+} // namespace mavsdk
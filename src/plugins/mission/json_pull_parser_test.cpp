@@ -0,0 +1,123 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+#include "json_pull_parser.h"
+
+using namespace mavsdk;
+using Token = JsonPullParser::Token;
+
+TEST(JsonPullParser, Tokens)
+{
+    const std::string json =
+        R"({"a": [1, -2.5, "x\"y", true, false, null], "b": {}, "c": []})";
+    JsonPullParser parser(json.data(), json.size());
+
+    EXPECT_EQ(parser.next(), Token::BeginObject);
+    EXPECT_EQ(parser.next(), Token::Key);
+    EXPECT_EQ(parser.string(), "a");
+    EXPECT_EQ(parser.next(), Token::BeginArray);
+    EXPECT_EQ(parser.next(), Token::Number);
+    EXPECT_EQ(parser.number(), 1.0);
+    EXPECT_EQ(parser.next(), Token::Number);
+    EXPECT_EQ(parser.number(), -2.5);
+    EXPECT_EQ(parser.next(), Token::String);
+    EXPECT_EQ(parser.string(), "x\\\"y");
+    EXPECT_EQ(parser.next(), Token::True);
+    EXPECT_EQ(parser.next(), Token::False);
+    EXPECT_EQ(parser.next(), Token::Null);
+    EXPECT_EQ(parser.next(), Token::EndArray);
+    EXPECT_EQ(parser.next(), Token::Key);
+    EXPECT_EQ(parser.string(), "b");
+    EXPECT_EQ(parser.next(), Token::BeginObject);
+    EXPECT_EQ(parser.next(), Token::EndObject);
+    EXPECT_EQ(parser.next(), Token::Key);
+    EXPECT_EQ(parser.string(), "c");
+    EXPECT_EQ(parser.next(), Token::BeginArray);
+    EXPECT_EQ(parser.next(), Token::EndArray);
+    EXPECT_EQ(parser.next(), Token::EndObject);
+    EXPECT_EQ(parser.next(), Token::End);
+}
+
+TEST(JsonPullParser, SkipsValues)
+{
+    const std::string json = R"({"skip": {"x": [1, {"y": [2, 3]}], "z": "}"}, "keep": 42})";
+    JsonPullParser parser(json.data(), json.size());
+
+    EXPECT_EQ(parser.next(), Token::BeginObject);
+    EXPECT_EQ(parser.next(), Token::Key);
+    EXPECT_TRUE(parser.skip_value());
+    EXPECT_EQ(parser.next(), Token::Key);
+    EXPECT_EQ(parser.string(), "keep");
+    EXPECT_EQ(parser.next(), Token::Number);
+    EXPECT_EQ(parser.number(), 42.0);
+    EXPECT_EQ(parser.next(), Token::EndObject);
+    EXPECT_EQ(parser.next(), Token::End);
+}
+
+TEST(JsonPullParser, NumbersMatchStrtod)
+{
+    const char* numbers[] = {
+        "0",
+        "-0",
+        "47.39784192965106",
+        "8.545413449078293",
+        "-117.25103300000001",
+        "0.000123",
+        "1e3",
+        "2.5E-7",
+        "-1.7976931348623157e308",
+        "123456789012345678901234567890",
+        "4.9e-324",
+        "0.1",
+        "9007199254740993"};
+
+    for (const char* number : numbers) {
+        JsonPullParser parser(number, std::strlen(number));
+        ASSERT_EQ(parser.next(), Token::Number) << number;
+        EXPECT_EQ(parser.number(), std::strtod(number, nullptr)) << number;
+        EXPECT_EQ(parser.next(), Token::End) << number;
+    }
+}
+
+TEST(JsonPullParser, Errors)
+{
+    const char* invalid[] = {
+        "",
+        "{",
+        "[1, 2",
+        "{\"a\" 1",
+        "{\"a\": tru}",
+        "[1}",
+        "{1: 2}",
+        "\"unterminated",
+        "01",
+        "1.",
+        "-",
+        "1e",
+        "[1] 2",
+    };
+
+    for (const char* json : invalid) {
+        JsonPullParser parser(json, std::strlen(json));
+        Token token;
+        do {
+            token = parser.next();
+        } while (token != Token::Error && token != Token::End);
+        EXPECT_EQ(token, Token::Error) << json;
+        EXPECT_EQ(parser.next(), Token::Error) << json;
+    }
+}
+
+TEST(JsonPullParser, LimitsDepth)
+{
+    const std::string json(JsonPullParser::MAX_DEPTH + 1, '[');
+    JsonPullParser parser(json.data(), json.size());
+
+    for (size_t i = 0; i < JsonPullParser::MAX_DEPTH; ++i) {
+        ASSERT_EQ(parser.next(), Token::BeginArray);
+    }
+    EXPECT_EQ(parser.next(), Token::Error);
+}
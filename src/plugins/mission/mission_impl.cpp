@@ -1,9 +1,9 @@
 #include "mission_impl.h"
+#include "async_result.h"
 #include "system.h"
 #include "global_include.h"
+#include "mapped_file.h"
 #include <algorithm>
-#include <fstream> // for `std::ifstream`
-#include <sstream> // for `std::stringstream`
 #include <cmath>
 
 namespace mavsdk {
@@ -74,8 +74,7 @@ void MissionImpl::reset_mission_progress()
     std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
     _mission_data.last_current_mavlink_mission_item = -1;
     _mission_data.last_reached_mavlink_mission_item = -1;
-    _mission_data.last_current_reported_mission_item = -1;
-    _mission_data.last_total_reported_mission_item = -1;
+    update_progress();
 }
 
 void MissionImpl::process_mission_current(const mavlink_message_t& message)
@@ -83,12 +82,9 @@ void MissionImpl::process_mission_current(const mavlink_message_t& message)
     mavlink_mission_current_t mission_current;
     mavlink_msg_mission_current_decode(&message, &mission_current);
 
-    {
-        std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-        _mission_data.last_current_mavlink_mission_item = mission_current.seq;
-    }
-
-    report_progress();
+    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
+    _mission_data.last_current_mavlink_mission_item = mission_current.seq;
+    update_progress();
 }
 
 void MissionImpl::process_mission_item_reached(const mavlink_message_t& message)
@@ -96,12 +92,9 @@ void MissionImpl::process_mission_item_reached(const mavlink_message_t& message)
     mavlink_mission_item_reached_t mission_item_reached;
     mavlink_msg_mission_item_reached_decode(&message, &mission_item_reached);
 
-    {
-        std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-        _mission_data.last_reached_mavlink_mission_item = mission_item_reached.seq;
-    }
-
-    report_progress();
+    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
+    _mission_data.last_reached_mavlink_mission_item = mission_item_reached.seq;
+    update_progress();
 }
 
 void MissionImpl::process_gimbal_manager_information(const mavlink_message_t& message)
@@ -133,11 +126,10 @@ void MissionImpl::receive_protocol_timeout()
 
 Mission::Result MissionImpl::upload_mission(const Mission::MissionPlan& mission_plan)
 {
-    auto prom = std::promise<Mission::Result>();
-    auto fut = prom.get_future();
-
-    upload_mission_async(mission_plan, [&prom](Mission::Result result) { prom.set_value(result); });
-    return fut.get();
+    return async_call<Mission::Result>([&](const Mission::ResultCallback& callback) {
+               upload_mission_async(mission_plan, callback);
+           })
+        .get();
 }
 
 void MissionImpl::upload_mission_async(
@@ -160,6 +152,11 @@ void MissionImpl::upload_mission_async(
 
     wait_for_protocol_async([callback, mission_plan, this]() {
         const auto int_items = convert_to_int_items(mission_plan.mission_items);
+        {
+            std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
+            _mission_data.mavlink_mission_items = int_items;
+            update_progress();
+        }
 
         _mission_data.last_upload = _parent->mission_transfer().upload_items_async(
             MAV_MISSION_TYPE_MISSION,
@@ -188,13 +185,12 @@ Mission::Result MissionImpl::cancel_mission_upload()
 
 std::pair<Mission::Result, Mission::MissionPlan> MissionImpl::download_mission()
 {
-    auto prom = std::promise<std::pair<Mission::Result, Mission::MissionPlan>>();
-    auto fut = prom.get_future();
-
-    download_mission_async([&prom](Mission::Result result, Mission::MissionPlan mission_plan) {
-        prom.set_value(std::make_pair<>(result, mission_plan));
-    });
-    return fut.get();
+    auto result = async_call<Mission::Result, Mission::MissionPlan>(
+                      [this](const Mission::DownloadMissionCallback& callback) {
+                          download_mission_async(callback);
+                      })
+                      .get();
+    return std::make_pair<>(std::get<0>(result), std::move(std::get<1>(result)));
 }
 
 void MissionImpl::download_mission_async(const Mission::DownloadMissionCallback& callback)
@@ -212,8 +208,7 @@ void MissionImpl::download_mission_async(const Mission::DownloadMissionCallback&
     _mission_data.last_download = _parent->mission_transfer().download_items_async(
         MAV_MISSION_TYPE_MISSION,
         [this, callback](
-            MAVLinkMissionTransfer::Result result,
-            std::vector<MAVLinkMissionTransfer::ItemInt> items) {
+            MAVLinkMissionTransfer::Result result, std::shared_ptr<MAVLinkMissionItems> items) {
             auto result_and_items = convert_to_result_and_mission_items(result, items);
             _parent->call_user_callback([callback, result_and_items]() {
                 callback(result_and_items.first, result_and_items.second);
@@ -275,20 +270,33 @@ float MissionImpl::acceptance_radius(const MissionItem& item)
     return acceptance_radius_m;
 }
 
-std::vector<MAVLinkMissionTransfer::ItemInt>
+std::shared_ptr<const MAVLinkMissionItems>
 MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
 {
-    std::vector<MAVLinkMissionTransfer::ItemInt> int_items;
+    auto int_items_ptr = std::make_shared<MAVLinkMissionItems>();
+    auto& int_items = *int_items_ptr;
+
+    // Counted up front so that each column is only allocated once,
+    // possibly a few too many.
+    size_t max_int_items = 1; // RTL
+    for (const auto& item : mission_items) {
+        max_int_items += has_valid_position(item) ? 1 : 0;
+        max_int_items += std::isfinite(item.speed_m_s) ? 1 : 0;
+        max_int_items +=
+            (std::isfinite(item.gimbal_yaw_deg) || std::isfinite(item.gimbal_pitch_deg)) ? 2 : 0;
+        max_int_items += (std::isfinite(item.loiter_time_s) && item.loiter_time_s > 0.0f) ? 1 : 0;
+        max_int_items += (item.camera_action != CameraAction::None) ? 1 : 0;
+    }
+    int_items.reserve(max_int_items);
 
     bool last_position_valid = false; // This flag is to protect us from using an invalid x/y.
 
-    unsigned item_i = 0;
-    _mission_data.mavlink_mission_item_to_mission_item_indices.clear();
+    int item_i = 0;
 
     for (const auto& item : mission_items) {
         if (has_valid_position(item)) {
             // Current is the 0th waypoint
-            const uint8_t current = ((int_items.size() == 0) ? 1 : 0);
+            const uint8_t current = (int_items.empty() ? 1 : 0);
 
             const int32_t x = int32_t(std::round(item.latitude_deg * 1e7));
             const int32_t y = int32_t(std::round(item.longitude_deg * 1e7));
@@ -311,15 +319,14 @@ MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
 
             last_position_valid = true; // because we checked has_valid_position
 
-            _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-            int_items.push_back(next_item);
+            int_items.push_back(next_item, item_i);
         }
 
         if (std::isfinite(item.speed_m_s)) {
             // The speed has changed, we need to add a speed command.
 
             // Current is the 0th waypoint
-            uint8_t current = ((int_items.size() == 0) ? 1 : 0);
+            uint8_t current = (int_items.empty() ? 1 : 0);
 
             uint8_t autocontinue = 1;
 
@@ -338,8 +345,7 @@ MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
                 NAN,
                 MAV_MISSION_TYPE_MISSION};
 
-            _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-            int_items.push_back(next_item);
+            int_items.push_back(next_item, item_i);
         }
 
         if (std::isfinite(item.gimbal_yaw_deg) || std::isfinite(item.gimbal_pitch_deg)) {
@@ -371,7 +377,7 @@ MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
 
             } else {
                 // Current is the 0th waypoint
-                uint8_t current = ((int_items.size() == 0) ? 1 : 0);
+                uint8_t current = (int_items.empty() ? 1 : 0);
 
                 uint8_t autocontinue = 1;
 
@@ -390,8 +396,7 @@ MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
                     0,
                     MAV_MISSION_TYPE_MISSION};
 
-                _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-                int_items.push_back(next_item);
+                int_items.push_back(next_item, item_i);
             }
 
             if (item.is_fly_through) {
@@ -403,7 +408,7 @@ MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
             // There is a camera action that we need to send.
 
             // Current is the 0th waypoint
-            uint8_t current = ((int_items.size() == 0) ? 1 : 0);
+            uint8_t current = (int_items.empty() ? 1 : 0);
 
             uint8_t autocontinue = 1;
 
@@ -456,8 +461,7 @@ MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
                 NAN,
                 MAV_MISSION_TYPE_MISSION};
 
-            _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-            int_items.push_back(next_item);
+            int_items.push_back(next_item, item_i);
         }
 
         ++item_i;
@@ -483,15 +487,13 @@ MissionImpl::convert_to_int_items(const std::vector<MissionItem>& mission_items)
             0,
             MAV_MISSION_TYPE_MISSION};
 
-        _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-        int_items.push_back(next_item);
+        int_items.push_back(next_item, item_i);
     }
-    return int_items;
+    return int_items_ptr;
 }
 
 std::pair<Mission::Result, Mission::MissionPlan> MissionImpl::convert_to_result_and_mission_items(
-    MAVLinkMissionTransfer::Result result,
-    const std::vector<MAVLinkMissionTransfer::ItemInt>& int_items)
+    MAVLinkMissionTransfer::Result result, const std::shared_ptr<MAVLinkMissionItems>& int_items)
 {
     std::pair<Mission::Result, Mission::MissionPlan> result_pair;
 
@@ -500,8 +502,6 @@ std::pair<Mission::Result, Mission::MissionPlan> MissionImpl::convert_to_result_
         return result_pair;
     }
 
-    _mission_data.mavlink_mission_item_to_mission_item_indices.clear();
-
     Mission::DownloadMissionCallback callback;
     {
         _enable_return_to_launch_after_mission = false;
@@ -509,7 +509,8 @@ std::pair<Mission::Result, Mission::MissionPlan> MissionImpl::convert_to_result_
         MissionItem new_mission_item{};
         bool have_set_position = false;
 
-        for (const auto& int_item : int_items) {
+        for (size_t seq = 0; seq < int_items->size(); ++seq) {
+            const auto int_item = int_items->at(seq);
             LogDebug() << "Assembling Message: " << int(int_item.seq);
 
             if (int_item.command == MAV_CMD_NAV_WAYPOINT) {
@@ -626,13 +627,18 @@ std::pair<Mission::Result, Mission::MissionPlan> MissionImpl::convert_to_result_
                 break;
             }
 
-            _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(
-                result_pair.second.mission_items.size());
+            int_items->set_user_index(
+                seq, static_cast<int>(result_pair.second.mission_items.size()));
         }
 
         // Don't forget to add last mission item.
         result_pair.second.mission_items.push_back(new_mission_item);
     }
+
+    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
+    _mission_data.mavlink_mission_items = int_items;
+    update_progress();
+
     return result_pair;
 }
 
@@ -745,13 +751,8 @@ void MissionImpl::set_current_mission_item_async(
     {
         std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
         // We need to find the first mavlink item which maps to the current mission item.
-        int i = 0;
-        for (auto index : _mission_data.mavlink_mission_item_to_mission_item_indices) {
-            if (index == current) {
-                mavlink_index = i;
-                break;
-            }
-            ++i;
+        if (_mission_data.mavlink_mission_items) {
+            mavlink_index = _mission_data.mavlink_mission_items->first_sequence(current);
         }
     }
 
@@ -780,55 +781,75 @@ void MissionImpl::set_current_mission_item_async(
         });
 }
 
-void MissionImpl::report_progress()
+void MissionImpl::update_progress()
 {
+    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
+
+    const auto progress = calculate_progress();
+    const auto last_progress = _progress.exchange(progress);
+
+    const bool changed =
+        (progress.current != last_progress.current || progress.total != last_progress.total);
+    if (!changed && !_mission_data.report_next_progress) {
+        return;
+    }
+
     const auto temp_callback = _mission_data.mission_progress_callback;
     if (temp_callback == nullptr) {
         return;
     }
+    _mission_data.report_next_progress = false;
+
+    _parent->call_user_callback([temp_callback, progress]() {
+        LogDebug() << "current: " << progress.current << ", total: " << progress.total;
+        Mission::MissionProgress mission_progress;
+        mission_progress.current = progress.current;
+        mission_progress.total = progress.total;
+        temp_callback(mission_progress);
+    });
+}
 
-    int current = current_mission_item();
-    int total = total_mission_items();
+MissionImpl::Progress MissionImpl::calculate_progress() const
+{
+    Progress progress{-1, 0};
 
-    bool should_report = false;
-    {
-        std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-        if (_mission_data.last_current_reported_mission_item != current) {
-            _mission_data.last_current_reported_mission_item = current;
-            should_report = true;
-        }
-        if (_mission_data.last_total_reported_mission_item != total) {
-            _mission_data.last_total_reported_mission_item = total;
-            should_report = true;
-        }
+    const auto& items = _mission_data.mavlink_mission_items;
+    if (!items) {
+        return progress;
     }
 
-    if (should_report) {
-        std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-        _parent->call_user_callback([temp_callback, current, total]() {
-            LogDebug() << "current: " << current << ", total: " << total;
-            Mission::MissionProgress mission_progress;
-            mission_progress.current = current;
-            mission_progress.total = total;
-            temp_callback(mission_progress);
-        });
+    progress.total = items->num_user_items();
+
+    // If the mission is finished, let's return the total as the current
+    // to signal this.
+    if (is_mission_finished_locked()) {
+        progress.current = progress.total;
+        return progress;
+    }
+
+    // We want to return the current mission item and not the underlying
+    // mavlink mission item.
+    if (_mission_data.last_current_mavlink_mission_item >= 0 &&
+        _mission_data.last_current_mavlink_mission_item < static_cast<int>(items->size())) {
+        progress.current =
+            items->user_index(static_cast<size_t>(_mission_data.last_current_mavlink_mission_item));
     }
+
+    return progress;
 }
 
-std::pair<Mission::Result, bool> MissionImpl::is_mission_finished() const
+bool MissionImpl::is_mission_finished_locked() const
 {
-    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-
     if (_mission_data.last_current_mavlink_mission_item < 0) {
-        return std::make_pair<Mission::Result, bool>(Mission::Result::Success, false);
+        return false;
     }
 
     if (_mission_data.last_reached_mavlink_mission_item < 0) {
-        return std::make_pair<Mission::Result, bool>(Mission::Result::Success, false);
+        return false;
     }
 
-    if (_mission_data.mavlink_mission_item_to_mission_item_indices.size() == 0) {
-        return std::make_pair<Mission::Result, bool>(Mission::Result::Success, false);
+    if (!_mission_data.mavlink_mission_items || _mission_data.mavlink_mission_items->empty()) {
+        return false;
     }
 
     // It is not straightforward to look at "current" because it jumps to 0
@@ -838,48 +859,35 @@ std::pair<Mission::Result, bool> MissionImpl::is_mission_finished() const
     // a mission, and we need to account for that.
     const unsigned rtl_correction = _enable_return_to_launch_after_mission ? 2 : 1;
 
+    return unsigned(_mission_data.last_reached_mavlink_mission_item + rtl_correction) ==
+           _mission_data.mavlink_mission_items->size();
+}
+
+std::pair<Mission::Result, bool> MissionImpl::is_mission_finished() const
+{
+    // The current item is only ever the total once the mission is finished.
+    const auto progress = _progress.load();
     return std::make_pair<Mission::Result, bool>(
-        Mission::Result::Success,
-        unsigned(_mission_data.last_reached_mavlink_mission_item + rtl_correction) ==
-            _mission_data.mavlink_mission_item_to_mission_item_indices.size());
+        Mission::Result::Success, progress.current == progress.total);
 }
 
 int MissionImpl::current_mission_item() const
 {
-    // If the mission is finished, let's return the total as the current
-    // to signal this.
-    if (is_mission_finished().second) {
-        return total_mission_items();
-    }
-
-    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-
-    // We want to return the current mission item and not the underlying
-    // mavlink mission item.
-    if (_mission_data.last_current_mavlink_mission_item >=
-            static_cast<int>(_mission_data.mavlink_mission_item_to_mission_item_indices.size()) ||
-        _mission_data.last_current_mavlink_mission_item < 0) {
-        return -1;
-    }
-
-    return _mission_data.mavlink_mission_item_to_mission_item_indices[static_cast<unsigned>(
-        _mission_data.last_current_mavlink_mission_item)];
+    return _progress.load().current;
 }
 
 int MissionImpl::total_mission_items() const
 {
-    std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
-    if (_mission_data.mavlink_mission_item_to_mission_item_indices.size() == 0) {
-        return 0;
-    }
-    return _mission_data.mavlink_mission_item_to_mission_item_indices.back() + 1;
+    return _progress.load().total;
 }
 
 Mission::MissionProgress MissionImpl::mission_progress()
 {
+    const auto progress = _progress.load();
+
     Mission::MissionProgress mission_progress;
-    mission_progress.current = current_mission_item();
-    mission_progress.total = total_mission_items();
+    mission_progress.current = progress.current;
+    mission_progress.total = progress.total;
 
     return mission_progress;
 }
@@ -888,6 +896,7 @@ void MissionImpl::mission_progress_async(Mission::MissionProgressCallback callba
 {
     std::lock_guard<std::recursive_mutex> lock(_mission_data.mutex);
     _mission_data.mission_progress_callback = callback;
+    _mission_data.report_next_progress = true;
 }
 
 Mission::Result MissionImpl::convert_result(MAVLinkMissionTransfer::Result result)
@@ -933,30 +942,32 @@ MissionImpl::import_qgroundcontrol_mission(const std::string& qgc_plan_file)
     auto result =
         std::pair<Mission::Result, Mission::MissionPlan>(Mission::Result::Unknown, mission_plan);
 
-    std::ifstream file(qgc_plan_file);
-    if (!file) {
+    // The plan is read straight from the file as it is parsed, without
+    // copying it or building a tree of it first.
+    MappedFile file;
+    if (!file.open(qgc_plan_file)) {
         result.first = Mission::Result::FailedToOpenQgcPlan;
         return result;
     }
 
-    std::stringstream ss;
-    ss << file.rdbuf();
-    file.close();
-    const auto raw_json = ss.str();
-
-    Json::CharReaderBuilder builder;
-    const std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
-    Json::Value root;
-    JSONCPP_STRING err;
-    const bool ok =
-        reader->parse(raw_json.c_str(), raw_json.c_str() + raw_json.length(), &root, &err);
-    if (!ok) {
-        LogErr() << "Parse error: " << err;
+    // Every command ends up in at most one mission item.
+    const std::string_view content(file.data(), file.size());
+    size_t num_commands = 0;
+    for (size_t pos = content.find("\"command\""); pos != std::string_view::npos;
+         pos = content.find("\"command\"", pos + 1)) {
+        ++num_commands;
+    }
+    result.second.mission_items.reserve(num_commands + 1);
+
+    JsonPullParser parser(file.data(), file.size());
+    if (!import_mission_items(result.second.mission_items, parser)) {
+        LogErr() << "Parse error at offset " << parser.offset();
+        result.second.mission_items.clear();
         result.first = Mission::Result::FailedToParseQgcPlan;
         return result;
     }
 
-    result.first = import_mission_items(result.second.mission_items, root);
+    result.first = Mission::Result::Success;
     return result;
 }
 
@@ -978,7 +989,7 @@ void MissionImpl::import_qgroundcontrol_mission_async(
 // Build a mission item out of command, params and add them to the mission vector.
 Mission::Result MissionImpl::build_mission_items(
     MAV_CMD command,
-    std::vector<double> params,
+    const std::vector<double>& params,
     MissionItem& new_mission_item,
     std::vector<Mission::MissionItem>& all_mission_items)
 {
@@ -1063,96 +1074,192 @@ Mission::Result MissionImpl::build_mission_items(
     return result;
 }
 
-Mission::Result MissionImpl::import_simple_mission_item(
-    std::vector<Mission::MissionItem>& all_mission_items,
-    const Json::Value& json_mission_item,
-    MissionItem& new_mission_item)
+bool MissionImpl::import_mission_items(
+    std::vector<Mission::MissionItem>& all_mission_items, JsonPullParser& parser)
 {
-    // Parameters of Mission item & MAV command of it.
-    MAV_CMD command = static_cast<MAV_CMD>(json_mission_item["command"].asInt());
+    using Token = JsonPullParser::Token;
 
-    // Extract parameters of each mission item
+    MissionItem new_mission_item{};
     std::vector<double> params;
-    for (auto& p : json_mission_item["params"]) {
-        if (p.type() == Json::nullValue) {
-            // QGC sets params as `null` if they should be unchanged.
-            params.push_back(double(NAN));
-        } else {
-            params.push_back(p.asDouble());
-        }
-    }
-    return build_mission_items(command, params, new_mission_item, all_mission_items);
-}
+    Mission::Result result = Mission::Result::Success;
 
-Mission::Result MissionImpl::import_complex_mission_item(
-    std::vector<Mission::MissionItem>& all_mission_items,
-    const Json::Value& json_complex_mission_item,
-    MissionItem& new_mission_item)
-{
-    if (json_complex_mission_item["TransectStyleComplexItem"].isNull()) {
-        LogWarn() << "Unknown complex item type (" << json_complex_mission_item["complexItemType"]
-                  << ")";
-        return Mission::Result::UnsupportedMissionCmd;
+    if (parser.next() != Token::BeginObject) {
+        return false;
     }
 
-    // QGC supports more complex mission items than simple waypoints.
-    // Surveys and coridor scans (NOT structure scans) are stored in a so called
-    // "TransectStyleComplexItem" item inside the mission_items array. These ComplexItems also
-    // contain an array ("Items") which contains waypoints. It is used by GQC to keep survey
-    // parameters so one can edit it as a survey after importing. Structure scans are not supported
-    // as thes do not contain simple mission items.
-    Json::Value complex_item = json_complex_mission_item["TransectStyleComplexItem"];
-    for (auto& json_mission_item : complex_item["Items"]) {
-        Mission::Result result =
-            import_simple_mission_item(all_mission_items, json_mission_item, new_mission_item);
-        if (result != Mission::Result::Success) {
-            return result;
+    // Only plan.mission.items is used.
+    for (Token token = parser.next(); token != Token::EndObject; token = parser.next()) {
+        if (token != Token::Key) {
+            return false;
+        }
+        if (parser.string() != "mission") {
+            if (!parser.skip_value()) {
+                return false;
+            }
+            continue;
+        }
+
+        if (parser.next() != Token::BeginObject) {
+            return false;
+        }
+        for (token = parser.next(); token != Token::EndObject; token = parser.next()) {
+            if (token != Token::Key) {
+                return false;
+            }
+            if (parser.string() != "items") {
+                if (!parser.skip_value()) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (parser.next() != Token::BeginArray) {
+                return false;
+            }
+            for (token = parser.next(); token != Token::EndArray; token = parser.next()) {
+                if (token != Token::BeginObject ||
+                    !import_mission_item(
+                        parser, all_mission_items, new_mission_item, params, result)) {
+                    return false;
+                }
+            }
         }
     }
-    return Mission::Result::Success;
+
+    if (parser.next() != Token::End) {
+        return false;
+    }
+
+    // Don't forget to add the last mission which possibly didn't have position set.
+    all_mission_items.push_back(new_mission_item);
+    return true;
 }
 
-Mission::Result MissionImpl::import_mission_items(
-    std::vector<Mission::MissionItem>& all_mission_items, const Json::Value& qgc_plan_json)
+bool MissionImpl::import_mission_item(
+    JsonPullParser& parser,
+    std::vector<Mission::MissionItem>& all_mission_items,
+    MissionItem& new_mission_item,
+    std::vector<double>& params,
+    Mission::Result& result)
 {
-    const auto json_mission_items = qgc_plan_json["mission"];
-    MissionItem new_mission_item{};
+    using Token = JsonPullParser::Token;
+
+    // Once an item could not be imported, the rest is only parsed.
+    MAV_CMD command{};
+    params.clear();
+    bool is_complex = false;
+    bool has_transect_items = false;
+    std::string_view complex_item_type;
+
+    // The object has been started by the caller.
+    for (Token token = parser.next(); token != Token::EndObject; token = parser.next()) {
+        if (token != Token::Key) {
+            return false;
+        }
+        const std::string_view key = parser.string();
+
+        if (key == "command") {
+            if (parser.next() != Token::Number) {
+                return false;
+            }
+            command = static_cast<MAV_CMD>(static_cast<int>(parser.number()));
 
-    // Iterate mission items and build Mavsdk mission items.
-    for (auto& json_mission_item : json_mission_items["items"]) {
-        Mission::Result result;
+        } else if (key == "params") {
+            if (parser.next() != Token::BeginArray) {
+                return false;
+            }
+            for (token = parser.next(); token != Token::EndArray; token = parser.next()) {
+                if (token == Token::Number) {
+                    params.push_back(parser.number());
+                } else if (token == Token::True || token == Token::False) {
+                    params.push_back(token == Token::True ? 1.0 : 0.0);
+                } else if (token == Token::Null || token == Token::String) {
+                    // QGC sets params as `null` if they should be unchanged.
+                    params.push_back(double(NAN));
+                } else {
+                    return false;
+                }
+            }
 
-        // Check if mission item is complex (like a survey from qgc) or a simple item
-        Json::Value type = json_mission_item["type"];
+        } else if (key == "type") {
+            if (parser.next() != Token::String) {
+                return false;
+            }
+            is_complex = (parser.string() == "ComplexItem");
 
-        if (!type.isNull() && type.asString() == "ComplexItem") {
-            result =
-                import_complex_mission_item(all_mission_items, json_mission_item, new_mission_item);
-        } else {
-            result =
-                import_simple_mission_item(all_mission_items, json_mission_item, new_mission_item);
+        } else if (key == "complexItemType") {
+            if (parser.next() != Token::String) {
+                return false;
+            }
+            complex_item_type = parser.string();
+
+        } else if (key == "TransectStyleComplexItem") {
+            // QGC supports more complex mission items than simple waypoints.
+            // Surveys and coridor scans (NOT structure scans) are stored in a so called
+            // "TransectStyleComplexItem" item inside the mission_items array. These
+            // ComplexItems also contain an array ("Items") which contains waypoints. It is
+            // used by GQC to keep survey parameters so one can edit it as a survey after
+            // importing. Structure scans are not supported as thes do not contain simple
+            // mission items.
+            has_transect_items = true;
+            if (parser.next() != Token::BeginObject) {
+                return false;
+            }
+            for (token = parser.next(); token != Token::EndObject; token = parser.next()) {
+                if (token != Token::Key) {
+                    return false;
+                }
+                if (parser.string() != "Items") {
+                    if (!parser.skip_value()) {
+                        return false;
+                    }
+                    continue;
+                }
+                if (parser.next() != Token::BeginArray) {
+                    return false;
+                }
+                for (token = parser.next(); token != Token::EndArray; token = parser.next()) {
+                    if (token != Token::BeginObject ||
+                        !import_mission_item(
+                            parser, all_mission_items, new_mission_item, params, result)) {
+                        return false;
+                    }
+                }
+            }
+
+        } else if (!parser.skip_value()) {
+            return false;
         }
+    }
+
+    if (result != Mission::Result::Success) {
+        return true;
+    }
 
-        if (result != Mission::Result::Success) {
-            break;
+    if (is_complex) {
+        if (!has_transect_items) {
+            LogWarn() << "Unknown complex item type (" << complex_item_type << ")";
+            result = Mission::Result::UnsupportedMissionCmd;
         }
+        return true;
     }
-    // Don't forget to add the last mission which possibly didn't have position set.
-    all_mission_items.push_back(new_mission_item);
-    return Mission::Result::Success;
+
+    // Any params missing are left unchanged.
+    if (params.size() < 7) {
+        params.resize(7, double(NAN));
+    }
+    result = build_mission_items(command, params, new_mission_item, all_mission_items);
+    return true;
 }
 
 void MissionImpl::add_gimbal_items_v1(
-    std::vector<MAVLinkMissionTransfer::ItemInt>& int_items,
-    unsigned item_i,
-    float pitch_deg,
-    float yaw_deg)
+    MAVLinkMissionItems& int_items, int item_i, float pitch_deg, float yaw_deg)
 {
     if (_enable_absolute_gimbal_yaw_angle) {
         // We need to configure the gimbal to use an absolute angle.
 
         // Current is the 0th waypoint
-        uint8_t current = ((int_items.size() == 0) ? 1 : 0);
+        uint8_t current = (int_items.empty() ? 1 : 0);
 
         uint8_t autocontinue = 1;
 
@@ -1172,14 +1279,13 @@ void MissionImpl::add_gimbal_items_v1(
             2.0f, // eventually this is the correct flag to set absolute yaw angle.
             MAV_MISSION_TYPE_MISSION};
 
-        _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-        int_items.push_back(next_item);
+        int_items.push_back(next_item, item_i);
     }
 
     // The gimbal has changed, we need to add a gimbal command.
 
     // Current is the 0th waypoint
-    uint8_t current = ((int_items.size() == 0) ? 1 : 0);
+    uint8_t current = (int_items.empty() ? 1 : 0);
 
     uint8_t autocontinue = 1;
 
@@ -1198,17 +1304,13 @@ void MissionImpl::add_gimbal_items_v1(
         MAV_MOUNT_MODE_MAVLINK_TARGETING,
         MAV_MISSION_TYPE_MISSION};
 
-    _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-    int_items.push_back(next_item);
+    int_items.push_back(next_item, item_i);
 }
 
 void MissionImpl::add_gimbal_items_v2(
-    std::vector<MAVLinkMissionTransfer::ItemInt>& int_items,
-    unsigned item_i,
-    float pitch_deg,
-    float yaw_deg)
+    MAVLinkMissionItems& int_items, int item_i, float pitch_deg, float yaw_deg)
 {
-    uint8_t current = ((int_items.size() == 0) ? 1 : 0);
+    uint8_t current = (int_items.empty() ? 1 : 0);
 
     uint8_t autocontinue = 1;
 
@@ -1230,8 +1332,7 @@ void MissionImpl::add_gimbal_items_v2(
         0, // all devices
         MAV_MISSION_TYPE_MISSION};
 
-    _mission_data.mavlink_mission_item_to_mission_item_indices.push_back(item_i);
-    int_items.push_back(next_item);
+    int_items.push_back(next_item, item_i);
 }
 
 } // namespace mavsdk
@@ -1,11 +1,11 @@
 #pragma once
 
 #include <atomic>
-#include <json/json.h>
 #include <vector>
 #include <memory>
 #include <mutex>
 
+#include "json_pull_parser.h"
 #include "mavlink_include.h"
 #include "plugins/mission/mission.h"
 #include "plugin_impl_base.h"
@@ -87,10 +87,21 @@ private:
     static float hold_time(const Mission::MissionItem& item);
     static float acceptance_radius(const Mission::MissionItem& item);
 
-    std::vector<MAVLinkMissionTransfer::ItemInt>
+    std::shared_ptr<const MAVLinkMissionItems>
     convert_to_int_items(const std::vector<Mission::MissionItem>& mission_items);
 
-    void report_progress();
+    struct Progress {
+        int32_t current;
+        int32_t total;
+    };
+
+    // Only notifies if the progress has changed.
+    void update_progress();
+    // Assumes to have the lock for _mission_data.
+    Progress calculate_progress() const;
+    // Assumes to have the lock for _mission_data.
+    bool is_mission_finished_locked() const;
+
     void reset_mission_progress();
 
     void report_flight_mode_change(
@@ -100,57 +111,53 @@ private:
     // FIXME: make static
     std::pair<Mission::Result, Mission::MissionPlan> convert_to_result_and_mission_items(
         MAVLinkMissionTransfer::Result result,
-        const std::vector<MAVLinkMissionTransfer::ItemInt>& int_items);
+        const std::shared_ptr<MAVLinkMissionItems>& int_items);
 
     static Mission::Result convert_result(MAVLinkMissionTransfer::Result result);
 
-    static Mission::Result import_simple_mission_item(
-        std::vector<Mission::MissionItem>& all_mission_items,
-        const Json::Value& json_mission_item,
-        Mission::MissionItem& new_mission_item);
+    // Both return false if the plan can't be parsed.
+    static bool import_mission_items(
+        std::vector<Mission::MissionItem>& all_mission_items, JsonPullParser& parser);
 
-    static Mission::Result import_complex_mission_item(
+    static bool import_mission_item(
+        JsonPullParser& parser,
         std::vector<Mission::MissionItem>& all_mission_items,
-        const Json::Value& json_mission_item,
-        Mission::MissionItem& new_mission_item);
-
-    static Mission::Result import_mission_items(
-        std::vector<Mission::MissionItem>& all_mission_items, const Json::Value& qgc_plan_json);
+        Mission::MissionItem& new_mission_item,
+        std::vector<double>& params,
+        Mission::Result& result);
 
     static Mission::Result build_mission_items(
         MAV_CMD command,
-        std::vector<double> params,
+        const std::vector<double>& params,
         Mission::MissionItem& new_mission_item,
         std::vector<Mission::MissionItem>& all_mission_items);
 
     void add_gimbal_items_v1(
-        std::vector<MAVLinkMissionTransfer::ItemInt>& int_items,
-        unsigned item_i,
-        float pitch_deg,
-        float yaw_deg);
+        MAVLinkMissionItems& int_items, int item_i, float pitch_deg, float yaw_deg);
     void add_gimbal_items_v2(
-        std::vector<MAVLinkMissionTransfer::ItemInt>& int_items,
-        unsigned item_i,
-        float pitch_deg,
-        float yaw_deg);
+        MAVLinkMissionItems& int_items, int item_i, float pitch_deg, float yaw_deg);
 
     struct MissionData {
         mutable std::recursive_mutex mutex{};
         int last_current_mavlink_mission_item{-1};
         int last_reached_mavlink_mission_item{-1};
-        std::vector<int> mavlink_mission_item_to_mission_item_indices{};
+        // Of the last upload or download, not changed once set.
+        std::shared_ptr<const MAVLinkMissionItems> mavlink_mission_items{};
         int num_mission_items_to_download{-1};
         int next_mission_item_to_download{-1};
         int last_mission_item_to_upload{-1};
         Mission::ResultCallback result_callback{nullptr};
         Mission::DownloadMissionCallback download_mission_callback{nullptr};
         Mission::MissionProgressCallback mission_progress_callback{nullptr};
-        int last_current_reported_mission_item{-1};
-        int last_total_reported_mission_item{-1};
+        bool report_next_progress{false};
         std::weak_ptr<MAVLinkMissionTransfer::WorkItem> last_upload{};
         std::weak_ptr<MAVLinkMissionTransfer::WorkItem> last_download{};
     } _mission_data{};
 
+    // Updated whenever a message about the progress comes in, so it can be
+    // read without taking the lock.
+    std::atomic<Progress> _progress{Progress{-1, 0}};
+
     void* _timeout_cookie{nullptr};
 
     bool _enable_return_to_launch_after_mission{false};
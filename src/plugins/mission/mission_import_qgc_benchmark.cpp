@@ -0,0 +1,78 @@
+#include "mission_impl.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+
+using namespace mavsdk;
+
+// Run this from root.
+static const std::string QGC_SAMPLE_PLAN = "src/plugins/mission/qgroundcontrol_sample.plan";
+static const std::string QGC_COMPLEX_SAMPLE_PLAN =
+    "src/plugins/mission/qgroundcontrol_sample_with_survey.plan";
+
+static void import_plan(benchmark::State& state, const std::string& path)
+{
+    size_t num_items = 0;
+
+    for (auto _ : state) {
+        const auto result = MissionImpl::import_qgroundcontrol_mission(path);
+        if (result.first != Mission::Result::Success) {
+            state.SkipWithError("Could not import plan");
+            return;
+        }
+        num_items = result.second.mission_items.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_items));
+}
+
+static void BM_MissionImportQgcSimple(benchmark::State& state)
+{
+    import_plan(state, QGC_SAMPLE_PLAN);
+}
+BENCHMARK(BM_MissionImportQgcSimple);
+
+static void BM_MissionImportQgcWithSurvey(benchmark::State& state)
+{
+    import_plan(state, QGC_COMPLEX_SAMPLE_PLAN);
+}
+BENCHMARK(BM_MissionImportQgcWithSurvey);
+
+// A survey with as many waypoints as given, written the way QGC does it.
+static void write_survey_plan(const std::string& path, int num_waypoints)
+{
+    std::ofstream file(path);
+    file << "{\n    \"fileType\": \"Plan\",\n    \"mission\": {\n"
+         << "        \"items\": [\n            {\n"
+         << "                \"TransectStyleComplexItem\": {\n"
+         << "                    \"Items\": [\n";
+    for (int i = 0; i < num_waypoints; ++i) {
+        file << "                        {\n"
+             << "                            \"autoContinue\": true,\n"
+             << "                            \"command\": 16,\n"
+             << "                            \"doJumpId\": " << i + 1 << ",\n"
+             << "                            \"frame\": 3,\n"
+             << "                            \"params\": [\n"
+             << "                                0,\n                                0,\n"
+             << "                                0,\n                                null,\n"
+             << "                                " << 47.39 + i * 1e-5 << ",\n"
+             << "                                " << 8.54 + (i % 2) * 1e-3 << ",\n"
+             << "                                50\n"
+             << "                            ],\n"
+             << "                            \"type\": \"SimpleItem\"\n"
+             << "                        }" << (i + 1 < num_waypoints ? "," : "") << "\n";
+    }
+    file << "                    ]\n                },\n"
+         << "                \"complexItemType\": \"survey\",\n"
+         << "                \"type\": \"ComplexItem\"\n"
+         << "            }\n        ]\n    }\n}\n";
+}
+
+static void BM_MissionImportQgcLargeSurvey(benchmark::State& state)
+{
+    const std::string path = "mission_import_qgc_benchmark.plan";
+    write_survey_plan(path, static_cast<int>(state.range(0)));
+    import_plan(state, path);
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_MissionImportQgcLargeSurvey)->Arg(1000)->Arg(100000);
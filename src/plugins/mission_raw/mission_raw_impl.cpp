@@ -143,10 +143,9 @@ void MissionRawImpl::upload_mission_async(
     _last_upload = _parent->mission_transfer().upload_items_async(
         MAV_MISSION_TYPE_MISSION,
         int_items,
-        [this, callback, int_items](MAVLinkMissionTransfer::Result result) {
+        [this, callback](MAVLinkMissionTransfer::Result result) {
             auto converted_result = convert_result(result);
-            auto converted_items = convert_items(int_items);
-            _parent->call_user_callback([callback, converted_result, converted_items]() {
+            _parent->call_user_callback([callback, converted_result]() {
                 if (callback) {
                     callback(converted_result);
                 }
@@ -193,10 +192,9 @@ void MissionRawImpl::download_mission_async(const MissionRaw::DownloadMissionCal
     _last_download = _parent->mission_transfer().download_items_async(
         MAV_MISSION_TYPE_MISSION,
         [this, callback](
-            MAVLinkMissionTransfer::Result result,
-            std::vector<MAVLinkMissionTransfer::ItemInt> items) {
+            MAVLinkMissionTransfer::Result result, std::shared_ptr<MAVLinkMissionItems> items) {
             auto converted_result = convert_result(result);
-            auto converted_items = convert_items(items);
+            auto converted_items = convert_items(*items);
             _parent->call_user_callback([callback, converted_result, converted_items]() {
                 callback(converted_result, converted_items);
             });
@@ -236,17 +234,20 @@ MissionRawImpl::convert_mission_raw(const MissionRaw::MissionItem transfer_missi
     return new_item_int;
 }
 
-std::vector<MAVLinkMissionTransfer::ItemInt>
+std::shared_ptr<const MAVLinkMissionItems>
 MissionRawImpl::convert_to_int_items(const std::vector<MissionRaw::MissionItem>& mission_raw)
 {
-    std::vector<MAVLinkMissionTransfer::ItemInt> int_items;
+    auto int_items = std::make_shared<MAVLinkMissionItems>();
+    int_items->reserve(mission_raw.size());
 
+    // Each item is its own user item.
+    int item_i = 0;
     for (const auto& item : mission_raw) {
-        int_items.push_back(convert_mission_raw(item));
+        int_items->push_back(convert_mission_raw(item), item_i++);
     }
 
     std::lock_guard<std::mutex> lock(_mission_progress.mutex);
-    _mission_progress.last.total = int_items.size();
+    _mission_progress.last.total = int_items->size();
 
     return int_items;
 }
@@ -274,13 +275,13 @@ MissionRawImpl::convert_item(const MAVLinkMissionTransfer::ItemInt& transfer_ite
 }
 
 std::vector<MissionRaw::MissionItem>
-MissionRawImpl::convert_items(const std::vector<MAVLinkMissionTransfer::ItemInt>& transfer_items)
+MissionRawImpl::convert_items(const MAVLinkMissionItems& transfer_items)
 {
     std::vector<MissionRaw::MissionItem> new_items;
     new_items.reserve(transfer_items.size());
 
-    for (const auto& transfer_item : transfer_items) {
-        new_items.push_back(convert_item(transfer_item));
+    for (size_t seq = 0; seq < transfer_items.size(); ++seq) {
+        new_items.push_back(convert_item(transfer_items.at(seq)));
     }
 
     std::lock_guard<std::mutex> lock(_mission_progress.mutex);
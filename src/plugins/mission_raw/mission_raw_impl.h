@@ -65,7 +65,7 @@ private:
         MissionRaw::ResultCallback callback, MavlinkCommandSender::Result result);
     static MissionRaw::Result command_result_to_mission_result(MavlinkCommandSender::Result result);
 
-    std::vector<MAVLinkMissionTransfer::ItemInt>
+    std::shared_ptr<const MAVLinkMissionItems>
     convert_to_int_items(const std::vector<MissionRaw::MissionItem>& mission_raw);
 
     MAVLinkMissionTransfer::ItemInt
@@ -74,8 +74,7 @@ private:
     static MissionRaw::Result convert_result(MAVLinkMissionTransfer::Result result);
     MissionRaw::MissionItem static convert_item(
         const MAVLinkMissionTransfer::ItemInt& transfer_item);
-    std::vector<MissionRaw::MissionItem>
-    convert_items(const std::vector<MAVLinkMissionTransfer::ItemInt>& transfer_items);
+    std::vector<MissionRaw::MissionItem> convert_items(const MAVLinkMissionItems& transfer_items);
 
     // TODO: check if these need a mutex as well.
     std::weak_ptr<MAVLinkMissionTransfer::WorkItem> _last_upload{};
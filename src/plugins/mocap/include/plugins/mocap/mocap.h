@@ -312,6 +312,35 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& str, Mocap::Odometry const& odometry);
 
+    /**
+     * @brief Statistics of sending asynchronously.
+     */
+    struct SendingStats {
+        uint64_t num_sent{}; /**< @brief Number of messages sent */
+        uint64_t num_dropped{}; /**< @brief Number of messages dropped because newer ones were
+                                   pending or the queue was full */
+        uint64_t num_batches{}; /**< @brief Number of batches the messages were sent in */
+        uint64_t num_send_failures{}; /**< @brief Number of batches which could not be sent */
+        double latency_mean_us{}; /**< @brief Mean time from setting until sending (in
+                                     microseconds) */
+        double latency_max_us{}; /**< @brief Maximum time from setting until sending (in
+                                    microseconds) */
+    };
+
+    /**
+     * @brief Equal operator to compare two `Mocap::SendingStats` objects.
+     *
+     * @return `true` if items are equal.
+     */
+    friend bool operator==(const Mocap::SendingStats& lhs, const Mocap::SendingStats& rhs);
+
+    /**
+     * @brief Stream operator to print information about a `Mocap::SendingStats`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream& operator<<(std::ostream& str, Mocap::SendingStats const& sending_stats);
+
     /**
      * @brief Possible results returned for mocap requests
      */
@@ -362,6 +391,28 @@ public:
      */
     Result set_odometry(Odometry odometry) const;
 
+    /**
+     * @brief Send estimates from a thread of their own instead of the caller's thread.
+     *
+     * The setters then return right away. Estimates pending at the same time are sent together,
+     * ordered by their timestamps, and only the newest of each type is sent. Errors of the
+     * connections are not reported back to the setters anymore.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    Result set_async_sending(bool enabled) const;
+
+    /**
+     * @brief Get the statistics of sending asynchronously.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    std::pair<Result, Mocap::SendingStats> get_sending_stats() const;
+
     /**
      * @brief Copy constructor.
      */
@@ -18,6 +18,7 @@ using Quaternion = Mocap::Quaternion;
 using VisionPositionEstimate = Mocap::VisionPositionEstimate;
 using AttitudePositionMocap = Mocap::AttitudePositionMocap;
 using Odometry = Mocap::Odometry;
+using SendingStats = Mocap::SendingStats;
 
 Mocap::Mocap(System& system) : PluginBase(), _impl{new MocapImpl(system)} {}
 
@@ -42,6 +43,16 @@ Mocap::Result Mocap::set_odometry(Odometry odometry) const
     return _impl->set_odometry(odometry);
 }
 
+Mocap::Result Mocap::set_async_sending(bool enabled) const
+{
+    return _impl->set_async_sending(enabled);
+}
+
+std::pair<Mocap::Result, Mocap::SendingStats> Mocap::get_sending_stats() const
+{
+    return _impl->get_sending_stats();
+}
+
 bool operator==(const Mocap::PositionBody& lhs, const Mocap::PositionBody& rhs)
 {
     return ((std::isnan(rhs.x_m) && std::isnan(lhs.x_m)) || rhs.x_m == lhs.x_m) &&
@@ -233,6 +244,31 @@ std::ostream& operator<<(std::ostream& str, Mocap::Odometry const& odometry)
     return str;
 }
 
+bool operator==(const Mocap::SendingStats& lhs, const Mocap::SendingStats& rhs)
+{
+    return (rhs.num_sent == lhs.num_sent) && (rhs.num_dropped == lhs.num_dropped) &&
+           (rhs.num_batches == lhs.num_batches) &&
+           (rhs.num_send_failures == lhs.num_send_failures) &&
+           ((std::isnan(rhs.latency_mean_us) && std::isnan(lhs.latency_mean_us)) ||
+            rhs.latency_mean_us == lhs.latency_mean_us) &&
+           ((std::isnan(rhs.latency_max_us) && std::isnan(lhs.latency_max_us)) ||
+            rhs.latency_max_us == lhs.latency_max_us);
+}
+
+std::ostream& operator<<(std::ostream& str, Mocap::SendingStats const& sending_stats)
+{
+    str << std::setprecision(15);
+    str << "sending_stats:" << '\n' << "{\n";
+    str << "    num_sent: " << sending_stats.num_sent << '\n';
+    str << "    num_dropped: " << sending_stats.num_dropped << '\n';
+    str << "    num_batches: " << sending_stats.num_batches << '\n';
+    str << "    num_send_failures: " << sending_stats.num_send_failures << '\n';
+    str << "    latency_mean_us: " << sending_stats.latency_mean_us << '\n';
+    str << "    latency_max_us: " << sending_stats.latency_max_us << '\n';
+    str << '}';
+    return str;
+}
+
 std::ostream& operator<<(std::ostream& str, Mocap::Result const& result)
 {
     switch (result) {
@@ -59,6 +59,51 @@ Mocap::Result MocapImpl::set_odometry(const Mocap::Odometry& odometry)
     return send_odometry(odometry);
 }
 
+Mocap::Result MocapImpl::set_async_sending(bool enabled)
+{
+    if (enabled) {
+        std::lock_guard<std::mutex> lock(_async_sender_mutex);
+        if (!_async_sender) {
+            _async_sender.reset(
+                new AsyncMessageSender([this](std::vector<mavlink_message_t>& messages) {
+                    return _parent->send_messages(messages);
+                }));
+        }
+    }
+
+    _async_sending = enabled;
+    return Mocap::Result::Success;
+}
+
+std::pair<Mocap::Result, Mocap::SendingStats> MocapImpl::get_sending_stats()
+{
+    Mocap::SendingStats stats{};
+
+    std::lock_guard<std::mutex> lock(_async_sender_mutex);
+    if (_async_sender) {
+        const auto sender_stats = _async_sender->stats();
+        stats.num_sent = sender_stats.num_sent;
+        stats.num_dropped = sender_stats.num_dropped;
+        stats.num_batches = sender_stats.num_batches;
+        stats.num_send_failures = sender_stats.num_send_failures;
+        stats.latency_mean_us = sender_stats.latency_mean_us;
+        stats.latency_max_us = sender_stats.latency_max_us;
+    }
+
+    return std::make_pair<>(Mocap::Result::Success, stats);
+}
+
+Mocap::Result MocapImpl::send(mavlink_message_t& message, uint64_t timestamp_us)
+{
+    if (_async_sending) {
+        // The sender is set before sending is enabled, and never reset.
+        _async_sender->send_message(message, timestamp_us);
+        return Mocap::Result::Success;
+    }
+
+    return _parent->send_message(message) ? Mocap::Result::Success : Mocap::Result::ConnectionError;
+}
+
 Mocap::Result MocapImpl::send_vision_position_estimate(
     const Mocap::VisionPositionEstimate& vision_position_estimate)
 {
@@ -106,7 +151,7 @@ Mocap::Result MocapImpl::send_vision_position_estimate(
         covariance.data(),
         0); // FIXME: reset_counter not set
 
-    return _parent->send_message(message) ? Mocap::Result::Success : Mocap::Result::ConnectionError;
+    return send(message, autopilot_time_usec);
 }
 
 Mocap::Result
@@ -160,7 +205,7 @@ MocapImpl::send_attitude_position_mocap(const Mocap::AttitudePositionMocap& atti
         attitude_position_mocap.position_body.z_m,
         covariance.data());
 
-    return _parent->send_message(message) ? Mocap::Result::Success : Mocap::Result::ConnectionError;
+    return send(message, autopilot_time_usec);
 }
 
 Mocap::Result MocapImpl::send_odometry(const Mocap::Odometry& odometry)
@@ -237,7 +282,7 @@ Mocap::Result MocapImpl::send_odometry(const Mocap::Odometry& odometry)
         0,
         MAV_ESTIMATOR_TYPE_MOCAP);
 
-    return _parent->send_message(message) ? Mocap::Result::Success : Mocap::Result::ConnectionError;
+    return send(message, autopilot_time_usec);
 }
 
 } // namespace mavsdk
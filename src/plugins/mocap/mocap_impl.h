@@ -1,6 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include "plugins/mocap/mocap.h"
+#include "async_message_sender.h"
 #include "mavlink_include.h"
 #include "plugin_impl_base.h"
 #include "system.h"
@@ -27,6 +32,9 @@ public:
     set_attitude_position_mocap(const Mocap::AttitudePositionMocap& attitude_position_mocap);
     Mocap::Result set_odometry(const Mocap::Odometry& odometry);
 
+    Mocap::Result set_async_sending(bool enabled);
+    std::pair<Mocap::Result, Mocap::SendingStats> get_sending_stats();
+
     MocapImpl(const MocapImpl&) = delete;
     MocapImpl& operator=(const MocapImpl&) = delete;
 
@@ -36,5 +44,13 @@ private:
     Mocap::Result
     send_attitude_position_mocap(const Mocap::AttitudePositionMocap& attitude_position_mocap);
     Mocap::Result send_odometry(const Mocap::Odometry& odometry);
+
+    Mocap::Result send(mavlink_message_t& message, uint64_t timestamp_us);
+
+    // Created once it is enabled, and kept until the plugin is destroyed,
+    // so that setters don't need a lock to use it.
+    std::mutex _async_sender_mutex{};
+    std::unique_ptr<AsyncMessageSender> _async_sender{};
+    std::atomic<bool> _async_sending{false};
 };
 } // namespace mavsdk
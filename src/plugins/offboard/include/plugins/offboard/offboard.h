@@ -258,6 +258,37 @@ public:
     friend std::ostream&
     operator<<(std::ostream& str, Offboard::VelocityNedYaw const& velocity_ned_yaw);
 
+    /**
+     * @brief Timing statistics of the thread streaming setpoints.
+     */
+    struct StreamingStats {
+        double rate_hz{}; /**< @brief Streaming rate (in Hz), 0 if setpoints are not streamed from a
+                             thread of their own */
+        uint64_t num_periods{}; /**< @brief Number of periods the streaming thread woke up for */
+        uint64_t num_missed_deadlines{}; /**< @brief Number of periods skipped because the streaming
+                                            thread was too late */
+        double jitter_mean_us{}; /**< @brief Mean delay after the deadline (in microseconds) */
+        double jitter_stddev_us{}; /**< @brief Standard deviation of the delay after the deadline
+                                      (in microseconds) */
+        double jitter_max_us{}; /**< @brief Maximum delay after the deadline (in microseconds) */
+    };
+
+    /**
+     * @brief Equal operator to compare two `Offboard::StreamingStats` objects.
+     *
+     * @return `true` if items are equal.
+     */
+    friend bool
+    operator==(const Offboard::StreamingStats& lhs, const Offboard::StreamingStats& rhs);
+
+    /**
+     * @brief Stream operator to print information about a `Offboard::StreamingStats`.
+     *
+     * @return A reference to the stream.
+     */
+    friend std::ostream&
+    operator<<(std::ostream& str, Offboard::StreamingStats const& streaming_stats);
+
     /**
      * @brief Possible results returned for offboard requests
      */
@@ -400,6 +431,28 @@ public:
     Result set_position_velocity_ned(
         PositionNedYaw position_ned_yaw, VelocityNedYaw velocity_ned_yaw) const;
 
+    /**
+     * @brief Send setpoints from a thread of their own at the given rate.
+     *
+     * The thread wakes up at fixed deadlines, independent of other work done by the library.
+     * Setpoints set while streaming are sent at the next deadline. A rate of 0 goes back to
+     * sending setpoints at the default rate of 20 Hz. The rate is limited to 1000 Hz.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    Result set_streaming_rate(double rate_hz) const;
+
+    /**
+     * @brief Get the timing statistics of the thread streaming setpoints.
+     *
+     * This function is blocking.
+     *
+     * @return Result of request.
+     */
+    std::pair<Result, Offboard::StreamingStats> get_streaming_stats() const;
+
     /**
      * @brief Copy constructor.
      */
@@ -19,6 +19,9 @@ public:
         set_position_velocity_ned,
         Offboard::Result(Offboard::PositionNedYaw, Offboard::VelocityNedYaw)){};
     MOCK_CONST_METHOD1(set_actuator_control, Offboard::Result(Offboard::ActuatorControl)){};
+    MOCK_CONST_METHOD1(set_streaming_rate, Offboard::Result(double)){};
+    MOCK_CONST_METHOD0(
+        get_streaming_stats, std::pair<Offboard::Result, Offboard::StreamingStats>()){};
 };
 
 } // namespace testing
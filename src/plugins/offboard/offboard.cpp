@@ -16,6 +16,7 @@ using AttitudeRate = Offboard::AttitudeRate;
 using PositionNedYaw = Offboard::PositionNedYaw;
 using VelocityBodyYawspeed = Offboard::VelocityBodyYawspeed;
 using VelocityNedYaw = Offboard::VelocityNedYaw;
+using StreamingStats = Offboard::StreamingStats;
 
 Offboard::Offboard(System& system) : PluginBase(), _impl{new OffboardImpl(system)} {}
 
@@ -85,6 +86,16 @@ Offboard::Result Offboard::set_position_velocity_ned(
     return _impl->set_position_velocity_ned(position_ned_yaw, velocity_ned_yaw);
 }
 
+Offboard::Result Offboard::set_streaming_rate(double rate_hz) const
+{
+    return _impl->set_streaming_rate(rate_hz);
+}
+
+std::pair<Offboard::Result, Offboard::StreamingStats> Offboard::get_streaming_stats() const
+{
+    return _impl->get_streaming_stats();
+}
+
 bool operator==(const Offboard::Attitude& lhs, const Offboard::Attitude& rhs)
 {
     return ((std::isnan(rhs.roll_deg) && std::isnan(lhs.roll_deg)) ||
@@ -241,6 +252,33 @@ std::ostream& operator<<(std::ostream& str, Offboard::VelocityNedYaw const& velo
     return str;
 }
 
+bool operator==(const Offboard::StreamingStats& lhs, const Offboard::StreamingStats& rhs)
+{
+    return ((std::isnan(rhs.rate_hz) && std::isnan(lhs.rate_hz)) || rhs.rate_hz == lhs.rate_hz) &&
+           (rhs.num_periods == lhs.num_periods) &&
+           (rhs.num_missed_deadlines == lhs.num_missed_deadlines) &&
+           ((std::isnan(rhs.jitter_mean_us) && std::isnan(lhs.jitter_mean_us)) ||
+            rhs.jitter_mean_us == lhs.jitter_mean_us) &&
+           ((std::isnan(rhs.jitter_stddev_us) && std::isnan(lhs.jitter_stddev_us)) ||
+            rhs.jitter_stddev_us == lhs.jitter_stddev_us) &&
+           ((std::isnan(rhs.jitter_max_us) && std::isnan(lhs.jitter_max_us)) ||
+            rhs.jitter_max_us == lhs.jitter_max_us);
+}
+
+std::ostream& operator<<(std::ostream& str, Offboard::StreamingStats const& streaming_stats)
+{
+    str << std::setprecision(15);
+    str << "streaming_stats:" << '\n' << "{\n";
+    str << "    rate_hz: " << streaming_stats.rate_hz << '\n';
+    str << "    num_periods: " << streaming_stats.num_periods << '\n';
+    str << "    num_missed_deadlines: " << streaming_stats.num_missed_deadlines << '\n';
+    str << "    jitter_mean_us: " << streaming_stats.jitter_mean_us << '\n';
+    str << "    jitter_stddev_us: " << streaming_stats.jitter_stddev_us << '\n';
+    str << "    jitter_max_us: " << streaming_stats.jitter_max_us << '\n';
+    str << '}';
+    return str;
+}
+
 std::ostream& operator<<(std::ostream& str, Offboard::Result const& result)
 {
     switch (result) {
@@ -32,6 +32,8 @@ void OffboardImpl::init()
 
 void OffboardImpl::deinit()
 {
+    _streaming_thread.stop();
+    _streaming_rate_hz = 0.0;
     stop_sending_setpoints();
     _parent->unregister_all_mavlink_message_handlers(this);
 }
@@ -44,7 +46,7 @@ Offboard::Result OffboardImpl::start()
 {
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        if (_mode == Mode::NotActive) {
+        if (_setpoint.mode == Mode::NotActive) {
             return Offboard::Result::NoSetpointSet;
         }
         _last_started = _time.steady_time();
@@ -58,7 +60,7 @@ Offboard::Result OffboardImpl::stop()
 {
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        if (_mode != Mode::NotActive) {
+        if (_setpoint.mode != Mode::NotActive) {
             stop_sending_setpoints();
         }
     }
@@ -72,7 +74,7 @@ void OffboardImpl::start_async(Offboard::ResultCallback callback)
     {
         std::lock_guard<std::mutex> lock(_mutex);
 
-        if (_mode == Mode::NotActive) {
+        if (_setpoint.mode == Mode::NotActive) {
             if (callback) {
                 callback(Offboard::Result::NoSetpointSet);
             }
@@ -90,7 +92,7 @@ void OffboardImpl::stop_async(Offboard::ResultCallback callback)
 {
     {
         std::lock_guard<std::mutex> lock(_mutex);
-        if (_mode != Mode::NotActive) {
+        if (_setpoint.mode != Mode::NotActive) {
             stop_sending_setpoints();
         }
     }
@@ -103,7 +105,7 @@ void OffboardImpl::stop_async(Offboard::ResultCallback callback)
 bool OffboardImpl::is_active()
 {
     std::lock_guard<std::mutex> lock(_mutex);
-    return (_mode != Mode::NotActive);
+    return (_setpoint.mode != Mode::NotActive);
 }
 
 void OffboardImpl::receive_command_result(
@@ -117,197 +119,220 @@ void OffboardImpl::receive_command_result(
 
 Offboard::Result OffboardImpl::set_position_ned(Offboard::PositionNedYaw position_ned_yaw)
 {
-    _mutex.lock();
-    _position_ned_yaw = position_ned_yaw;
-
-    if (_mode != Mode::PositionNed) {
-        if (_call_every_cookie) {
-            // If we're already sending other setpoints, stop that now.
-            _parent->remove_call_every(_call_every_cookie);
-            _call_every_cookie = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _setpoint.position_ned_yaw = position_ned_yaw;
+        if (!update_setpoint(Mode::PositionNed)) {
+            return Offboard::Result::Success;
         }
-        // We automatically send Ned setpoints from now on.
-        _parent->add_call_every(
-            [this]() { send_position_ned(); }, SEND_INTERVAL_S, &_call_every_cookie);
-
-        _mode = Mode::PositionNed;
-    } else {
-        // We're already sending these kind of setpoints. Since the setpoint change, let's
-        // reschedule the next call, so we don't send setpoints too often.
-        _parent->reset_call_every(_call_every_cookie);
     }
-    _mutex.unlock();
 
     // also send it right now to reduce latency
-    return send_position_ned();
+    return send_position_ned(position_ned_yaw);
 }
 
 Offboard::Result OffboardImpl::set_velocity_ned(Offboard::VelocityNedYaw velocity_ned_yaw)
 {
-    _mutex.lock();
-    _velocity_ned_yaw = velocity_ned_yaw;
-
-    if (_mode != Mode::VelocityNed) {
-        if (_call_every_cookie) {
-            // If we're already sending other setpoints, stop that now.
-            _parent->remove_call_every(_call_every_cookie);
-            _call_every_cookie = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _setpoint.velocity_ned_yaw = velocity_ned_yaw;
+        if (!update_setpoint(Mode::VelocityNed)) {
+            return Offboard::Result::Success;
         }
-        // We automatically send Ned setpoints from now on.
-        _parent->add_call_every(
-            [this]() { send_velocity_ned(); }, SEND_INTERVAL_S, &_call_every_cookie);
-
-        _mode = Mode::VelocityNed;
-    } else {
-        // We're already sending these kind of setpoints. Since the setpoint change, let's
-        // reschedule the next call, so we don't send setpoints too often.
-        _parent->reset_call_every(_call_every_cookie);
     }
-    _mutex.unlock();
 
     // also send it right now to reduce latency
-    return send_velocity_ned();
+    return send_velocity_ned(velocity_ned_yaw);
 }
 
 Offboard::Result OffboardImpl::set_position_velocity_ned(
     Offboard::PositionNedYaw position_ned_yaw, Offboard::VelocityNedYaw velocity_ned_yaw)
 {
-    _mutex.lock();
-    _position_ned_yaw = position_ned_yaw;
-    _velocity_ned_yaw = velocity_ned_yaw;
-
-    if (_mode != Mode::PositionVelocityNed) {
-        if (_call_every_cookie) {
-            // If we're already sending other setpoints, stop that now.
-            _parent->remove_call_every(_call_every_cookie);
-            _call_every_cookie = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _setpoint.position_ned_yaw = position_ned_yaw;
+        _setpoint.velocity_ned_yaw = velocity_ned_yaw;
+        if (!update_setpoint(Mode::PositionVelocityNed)) {
+            return Offboard::Result::Success;
         }
-        // We automatically send Ned setpoints from now on.
-        _parent->add_call_every(
-            [this]() { send_position_velocity_ned(); }, SEND_INTERVAL_S, &_call_every_cookie);
-
-        _mode = Mode::PositionVelocityNed;
-    } else {
-        // We're already sending these kind of setpoints. Since the setpoint change, let's
-        // reschedule the next call, so we don't send setpoints too often.
-        _parent->reset_call_every(_call_every_cookie);
     }
-    _mutex.unlock();
 
     // also send it right now to reduce latency
-    return send_position_velocity_ned();
+    return send_position_velocity_ned(position_ned_yaw, velocity_ned_yaw);
 }
 
 Offboard::Result
 OffboardImpl::set_velocity_body(Offboard::VelocityBodyYawspeed velocity_body_yawspeed)
 {
-    _mutex.lock();
-    _velocity_body_yawspeed = velocity_body_yawspeed;
-
-    if (_mode != Mode::VelocityBody) {
-        if (_call_every_cookie) {
-            // If we're already sending other setpoints, stop that now.
-            _parent->remove_call_every(_call_every_cookie);
-            _call_every_cookie = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _setpoint.velocity_body_yawspeed = velocity_body_yawspeed;
+        if (!update_setpoint(Mode::VelocityBody)) {
+            return Offboard::Result::Success;
         }
-        // We automatically send body setpoints from now on.
-        _parent->add_call_every(
-            [this]() { send_velocity_body(); }, SEND_INTERVAL_S, &_call_every_cookie);
-
-        _mode = Mode::VelocityBody;
-    } else {
-        // We're already sending these kind of setpoints. Since the setpoint change, let's
-        // reschedule the next call, so we don't send setpoints too often.
-        _parent->reset_call_every(_call_every_cookie);
     }
-    _mutex.unlock();
 
     // also send it right now to reduce latency
-    return send_velocity_body();
+    return send_velocity_body(velocity_body_yawspeed);
 }
 
 Offboard::Result OffboardImpl::set_attitude(Offboard::Attitude attitude)
 {
-    _mutex.lock();
-    _attitude = attitude;
-
-    if (_mode != Mode::Attitude) {
-        if (_call_every_cookie) {
-            // If we're already sending other setpoints, stop that now.
-            _parent->remove_call_every(_call_every_cookie);
-            _call_every_cookie = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _setpoint.attitude = attitude;
+        if (!update_setpoint(Mode::Attitude)) {
+            return Offboard::Result::Success;
         }
-        // We automatically send body setpoints from now on.
-        _parent->add_call_every(
-            [this]() { send_attitude(); }, SEND_INTERVAL_S, &_call_every_cookie);
-
-        _mode = Mode::Attitude;
-    } else {
-        // We're already sending these kind of setpoints. Since the setpoint change, let's
-        // reschedule the next call, so we don't send setpoints too often.
-        _parent->reset_call_every(_call_every_cookie);
     }
-    _mutex.unlock();
 
     // also send it right now to reduce latency
-    return send_attitude();
+    return send_attitude(attitude);
 }
 
 Offboard::Result OffboardImpl::set_attitude_rate(Offboard::AttitudeRate attitude_rate)
 {
-    _mutex.lock();
-    _attitude_rate = attitude_rate;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _setpoint.attitude_rate = attitude_rate;
+        if (!update_setpoint(Mode::AttitudeRate)) {
+            return Offboard::Result::Success;
+        }
+    }
 
-    if (_mode != Mode::AttitudeRate) {
-        if (_call_every_cookie) {
-            // If we're already sending other setpoints, stop that now.
-            _parent->remove_call_every(_call_every_cookie);
-            _call_every_cookie = nullptr;
+    // also send it right now to reduce latency
+    return send_attitude_rate(attitude_rate);
+}
+
+Offboard::Result OffboardImpl::set_actuator_control(Offboard::ActuatorControl actuator_control)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _setpoint.actuator_control = actuator_control;
+        if (!update_setpoint(Mode::ActuatorControl)) {
+            return Offboard::Result::Success;
         }
-        // We automatically send body setpoints from now on.
-        _parent->add_call_every(
-            [this]() { send_attitude_rate(); }, SEND_INTERVAL_S, &_call_every_cookie);
+    }
+
+    // also send it right now to reduce latency
+    return send_actuator_control(actuator_control);
+}
+
+bool OffboardImpl::update_setpoint(Mode mode)
+{
+    _setpoint.mode = mode;
 
-        _mode = Mode::AttitudeRate;
+    if (_streaming_rate_hz > 0.0) {
+        // The streaming thread sends it at its next deadline, sending it in
+        // between would mess up the rate.
+        _setpoint_mailbox.write(_setpoint);
+        return false;
+    }
+
+    if (_call_every_cookie == nullptr) {
+        // We automatically send setpoints from now on.
+        _parent->add_call_every(
+            [this]() { send_current_setpoint(); }, SEND_INTERVAL_S, &_call_every_cookie);
     } else {
-        // We're already sending these kind of setpoints. Since the setpoint change, let's
+        // We're already sending setpoints. Since the setpoint changed, let's
         // reschedule the next call, so we don't send setpoints too often.
         _parent->reset_call_every(_call_every_cookie);
     }
-    _mutex.unlock();
-
-    // also send it right now to reduce latency
-    return send_attitude_rate();
+    return true;
 }
 
-Offboard::Result OffboardImpl::set_actuator_control(Offboard::ActuatorControl actuator_control)
+Offboard::Result OffboardImpl::set_streaming_rate(double rate_hz)
 {
-    _mutex.lock();
-    _actuator_control = actuator_control;
+    if (!(rate_hz > 0.0)) {
+        rate_hz = 0.0;
+    } else if (rate_hz > MAX_STREAMING_RATE_HZ) {
+        LogWarn() << "Streaming rate limited to " << MAX_STREAMING_RATE_HZ << " Hz";
+        rate_hz = MAX_STREAMING_RATE_HZ;
+    }
 
-    if (_mode != Mode::ActuatorControl) {
-        if (_call_every_cookie) {
-            // If we're already sending other setpoints, stop that now.
-            _parent->remove_call_every(_call_every_cookie);
-            _call_every_cookie = nullptr;
-        }
-        // We automatically send motor rate values from now on.
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // The streaming thread never takes the lock, so we can wait for it here.
+    _streaming_thread.stop();
+    if (_call_every_cookie != nullptr) {
+        _parent->remove_call_every(_call_every_cookie);
+        _call_every_cookie = nullptr;
+    }
+
+    _streaming_rate_hz = rate_hz;
+
+    if (_streaming_rate_hz > 0.0) {
+        _setpoint_mailbox.write(_setpoint);
+        _streaming_thread.start(_streaming_rate_hz, [this]() { stream_setpoint(); });
+    } else if (_setpoint.mode != Mode::NotActive) {
         _parent->add_call_every(
-            [this]() { send_actuator_control(); }, SEND_INTERVAL_S, &_call_every_cookie);
+            [this]() { send_current_setpoint(); }, SEND_INTERVAL_S, &_call_every_cookie);
+    }
 
-        _mode = Mode::ActuatorControl;
-    } else {
-        // We're already sending these kind of values. Since the value changes, let's
-        // reschedule the next call, so we don't send values too often.
-        _parent->reset_call_every(_call_every_cookie);
+    return Offboard::Result::Success;
+}
+
+std::pair<Offboard::Result, Offboard::StreamingStats> OffboardImpl::get_streaming_stats()
+{
+    const auto thread_stats = _streaming_thread.stats();
+
+    Offboard::StreamingStats stats{};
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        stats.rate_hz = _streaming_rate_hz;
     }
-    _mutex.unlock();
+    stats.num_periods = thread_stats.num_calls;
+    stats.num_missed_deadlines = thread_stats.num_missed_deadlines;
+    stats.jitter_mean_us = thread_stats.jitter_mean_us;
+    stats.jitter_stddev_us = thread_stats.jitter_stddev_us;
+    stats.jitter_max_us = thread_stats.jitter_max_us;
 
-    // also send it right now to reduce latency
-    return send_actuator_control();
+    return std::make_pair<>(Offboard::Result::Success, stats);
+}
+
+void OffboardImpl::send_current_setpoint()
+{
+    Setpoint setpoint;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        setpoint = _setpoint;
+    }
+    send_setpoint(setpoint);
+}
+
+void OffboardImpl::stream_setpoint()
+{
+    // Called from the streaming thread only, without locking.
+    _setpoint_mailbox.read(_streamed_setpoint);
+    send_setpoint(_streamed_setpoint);
+}
+
+Offboard::Result OffboardImpl::send_setpoint(const Setpoint& setpoint)
+{
+    switch (setpoint.mode) {
+        case Mode::PositionNed:
+            return send_position_ned(setpoint.position_ned_yaw);
+        case Mode::VelocityNed:
+            return send_velocity_ned(setpoint.velocity_ned_yaw);
+        case Mode::PositionVelocityNed:
+            return send_position_velocity_ned(
+                setpoint.position_ned_yaw, setpoint.velocity_ned_yaw);
+        case Mode::VelocityBody:
+            return send_velocity_body(setpoint.velocity_body_yawspeed);
+        case Mode::Attitude:
+            return send_attitude(setpoint.attitude);
+        case Mode::AttitudeRate:
+            return send_attitude_rate(setpoint.attitude_rate);
+        case Mode::ActuatorControl:
+            return send_actuator_control(setpoint.actuator_control);
+        case Mode::NotActive:
+        default:
+            return Offboard::Result::NoSetpointSet;
+    }
 }
 
-Offboard::Result OffboardImpl::send_position_ned()
+Offboard::Result
+OffboardImpl::send_position_ned(const Offboard::PositionNedYaw& position_ned_yaw)
 {
     // const static uint16_t IGNORE_X = (1 << 0);
     // const static uint16_t IGNORE_Y = (1 << 1);
@@ -322,19 +347,17 @@ Offboard::Result OffboardImpl::send_position_ned()
     // const static uint16_t IGNORE_YAW = (1 << 10);
     const static uint16_t IGNORE_YAW_RATE = (1 << 11);
 
-    _mutex.lock();
-    const float yaw = to_rad_from_deg(_position_ned_yaw.yaw_deg);
+    const float yaw = to_rad_from_deg(position_ned_yaw.yaw_deg);
     const float yaw_rate = 0.0f;
-    const float x = _position_ned_yaw.north_m;
-    const float y = _position_ned_yaw.east_m;
-    const float z = _position_ned_yaw.down_m;
+    const float x = position_ned_yaw.north_m;
+    const float y = position_ned_yaw.east_m;
+    const float z = position_ned_yaw.down_m;
     const float vx = 0.0f;
     const float vy = 0.0f;
     const float vz = 0.0f;
     const float afx = 0.0f;
     const float afy = 0.0f;
     const float afz = 0.0f;
-    _mutex.unlock();
 
     mavlink_message_t message;
     mavlink_msg_set_position_target_local_ned_pack(
@@ -361,7 +384,8 @@ Offboard::Result OffboardImpl::send_position_ned()
                                             Offboard::Result::ConnectionError;
 }
 
-Offboard::Result OffboardImpl::send_velocity_ned()
+Offboard::Result
+OffboardImpl::send_velocity_ned(const Offboard::VelocityNedYaw& velocity_ned_yaw)
 {
     const static uint16_t IGNORE_X = (1 << 0);
     const static uint16_t IGNORE_Y = (1 << 1);
@@ -376,19 +400,17 @@ Offboard::Result OffboardImpl::send_velocity_ned()
     // const static uint16_t IGNORE_YAW = (1 << 10);
     const static uint16_t IGNORE_YAW_RATE = (1 << 11);
 
-    _mutex.lock();
-    const float yaw = to_rad_from_deg(_velocity_ned_yaw.yaw_deg);
+    const float yaw = to_rad_from_deg(velocity_ned_yaw.yaw_deg);
     const float yaw_rate = 0.0f;
     const float x = 0.0f;
     const float y = 0.0f;
     const float z = 0.0f;
-    const float vx = _velocity_ned_yaw.north_m_s;
-    const float vy = _velocity_ned_yaw.east_m_s;
-    const float vz = _velocity_ned_yaw.down_m_s;
+    const float vx = velocity_ned_yaw.north_m_s;
+    const float vy = velocity_ned_yaw.east_m_s;
+    const float vz = velocity_ned_yaw.down_m_s;
     const float afx = 0.0f;
     const float afy = 0.0f;
     const float afz = 0.0f;
-    _mutex.unlock();
 
     mavlink_message_t message;
     mavlink_msg_set_position_target_local_ned_pack(
@@ -415,7 +437,9 @@ Offboard::Result OffboardImpl::send_velocity_ned()
                                             Offboard::Result::ConnectionError;
 }
 
-Offboard::Result OffboardImpl::send_position_velocity_ned()
+Offboard::Result OffboardImpl::send_position_velocity_ned(
+    const Offboard::PositionNedYaw& position_ned_yaw,
+    const Offboard::VelocityNedYaw& velocity_ned_yaw)
 {
     // const static uint16_t IGNORE_X = (1 << 0);
     // const static uint16_t IGNORE_Y = (1 << 1);
@@ -430,19 +454,17 @@ Offboard::Result OffboardImpl::send_position_velocity_ned()
     // const static uint16_t IGNORE_YAW = (1 << 10);
     const static uint16_t IGNORE_YAW_RATE = (1 << 11);
 
-    _mutex.lock();
-    const float yaw = to_rad_from_deg(_position_ned_yaw.yaw_deg);
+    const float yaw = to_rad_from_deg(position_ned_yaw.yaw_deg);
     const float yaw_rate = 0.0f;
-    const float x = _position_ned_yaw.north_m;
-    const float y = _position_ned_yaw.east_m;
-    const float z = _position_ned_yaw.down_m;
-    const float vx = _velocity_ned_yaw.north_m_s;
-    const float vy = _velocity_ned_yaw.east_m_s;
-    const float vz = _velocity_ned_yaw.down_m_s;
+    const float x = position_ned_yaw.north_m;
+    const float y = position_ned_yaw.east_m;
+    const float z = position_ned_yaw.down_m;
+    const float vx = velocity_ned_yaw.north_m_s;
+    const float vy = velocity_ned_yaw.east_m_s;
+    const float vz = velocity_ned_yaw.down_m_s;
     const float afx = 0.0f;
     const float afy = 0.0f;
     const float afz = 0.0f;
-    _mutex.unlock();
 
     mavlink_message_t message;
     mavlink_msg_set_position_target_local_ned_pack(
@@ -469,7 +491,8 @@ Offboard::Result OffboardImpl::send_position_velocity_ned()
                                             Offboard::Result::ConnectionError;
 }
 
-Offboard::Result OffboardImpl::send_velocity_body()
+Offboard::Result
+OffboardImpl::send_velocity_body(const Offboard::VelocityBodyYawspeed& velocity_body_yawspeed)
 {
     const static uint16_t IGNORE_X = (1 << 0);
     const static uint16_t IGNORE_Y = (1 << 1);
@@ -484,19 +507,17 @@ Offboard::Result OffboardImpl::send_velocity_body()
     const static uint16_t IGNORE_YAW = (1 << 10);
     // const static uint16_t IGNORE_YAW_RATE = (1 << 11);
 
-    _mutex.lock();
     const float yaw = 0.0f;
-    const float yaw_rate = to_rad_from_deg(_velocity_body_yawspeed.yawspeed_deg_s);
+    const float yaw_rate = to_rad_from_deg(velocity_body_yawspeed.yawspeed_deg_s);
     const float x = 0.0f;
     const float y = 0.0f;
     const float z = 0.0f;
-    const float vx = _velocity_body_yawspeed.forward_m_s;
-    const float vy = _velocity_body_yawspeed.right_m_s;
-    const float vz = _velocity_body_yawspeed.down_m_s;
+    const float vx = velocity_body_yawspeed.forward_m_s;
+    const float vy = velocity_body_yawspeed.right_m_s;
+    const float vz = velocity_body_yawspeed.down_m_s;
     const float afx = 0.0f;
     const float afy = 0.0f;
     const float afz = 0.0f;
-    _mutex.unlock();
 
     mavlink_message_t message;
     mavlink_msg_set_position_target_local_ned_pack(
@@ -523,7 +544,7 @@ Offboard::Result OffboardImpl::send_velocity_body()
                                             Offboard::Result::ConnectionError;
 }
 
-Offboard::Result OffboardImpl::send_attitude()
+Offboard::Result OffboardImpl::send_attitude(const Offboard::Attitude& attitude)
 {
     const static uint8_t IGNORE_BODY_ROLL_RATE = (1 << 0);
     const static uint8_t IGNORE_BODY_PITCH_RATE = (1 << 1);
@@ -534,12 +555,10 @@ Offboard::Result OffboardImpl::send_attitude()
     // const static uint8_t IGNORE_THRUST = (1 << 6);
     // const static uint8_t IGNORE_ATTITUDE = (1 << 7);
 
-    _mutex.lock();
-    const float thrust = _attitude.thrust_value;
-    const float roll = to_rad_from_deg(_attitude.roll_deg);
-    const float pitch = to_rad_from_deg(_attitude.pitch_deg);
-    const float yaw = to_rad_from_deg(_attitude.yaw_deg);
-    _mutex.unlock();
+    const float thrust = attitude.thrust_value;
+    const float roll = to_rad_from_deg(attitude.roll_deg);
+    const float pitch = to_rad_from_deg(attitude.pitch_deg);
+    const float yaw = to_rad_from_deg(attitude.yaw_deg);
 
     const double cos_phi_2 = cos(double(roll) / 2.0);
     const double sin_phi_2 = sin(double(roll) / 2.0);
@@ -573,7 +592,7 @@ Offboard::Result OffboardImpl::send_attitude()
                                             Offboard::Result::ConnectionError;
 }
 
-Offboard::Result OffboardImpl::send_attitude_rate()
+Offboard::Result OffboardImpl::send_attitude_rate(const Offboard::AttitudeRate& attitude_rate)
 {
     // const static uint8_t IGNORE_BODY_ROLL_RATE = (1 << 0);
     // const static uint8_t IGNORE_BODY_PITCH_RATE = (1 << 1);
@@ -584,12 +603,10 @@ Offboard::Result OffboardImpl::send_attitude_rate()
     // const static uint8_t IGNORE_THRUST = (1 << 6);
     const static uint8_t IGNORE_ATTITUDE = (1 << 7);
 
-    _mutex.lock();
-    const float thrust = _attitude_rate.thrust_value;
-    const float body_roll_rate = to_rad_from_deg(_attitude_rate.roll_deg_s);
-    const float body_pitch_rate = to_rad_from_deg(_attitude_rate.pitch_deg_s);
-    const float body_yaw_rate = to_rad_from_deg(_attitude_rate.yaw_deg_s);
-    _mutex.unlock();
+    const float thrust = attitude_rate.thrust_value;
+    const float body_roll_rate = to_rad_from_deg(attitude_rate.roll_deg_s);
+    const float body_pitch_rate = to_rad_from_deg(attitude_rate.pitch_deg_s);
+    const float body_yaw_rate = to_rad_from_deg(attitude_rate.yaw_deg_s);
 
     mavlink_message_t message;
     mavlink_msg_set_attitude_target_pack(
@@ -626,12 +643,9 @@ OffboardImpl::send_actuator_control_message(const float* controls, uint8_t group
                                             Offboard::Result::ConnectionError;
 }
 
-Offboard::Result OffboardImpl::send_actuator_control()
+Offboard::Result
+OffboardImpl::send_actuator_control(Offboard::ActuatorControl actuator_control)
 {
-    _mutex.lock();
-    Offboard::ActuatorControl actuator_control = _actuator_control;
-    _mutex.unlock();
-
     for (int i = 0; i < 2; i++) {
         int nan_count = 0;
         for (int j = 0; j < 8; j++) {
@@ -676,7 +690,7 @@ void OffboardImpl::process_heartbeat(const mavlink_message_t& message)
         // Therefore, we make sure we don't stop too eagerly and ignore
         // possibly stale heartbeats for some time.
         std::lock_guard<std::mutex> lock(_mutex);
-        if (!offboard_mode_active && _mode != Mode::NotActive &&
+        if (!offboard_mode_active && _setpoint.mode != Mode::NotActive &&
             _time.elapsed_since_s(_last_started) > 1.5) {
             // It seems that we are no longer in offboard mode but still trying to send
             // setpoints. Let's stop for now.
@@ -693,7 +707,11 @@ void OffboardImpl::stop_sending_setpoints()
         _parent->remove_call_every(_call_every_cookie);
         _call_every_cookie = nullptr;
     }
-    _mode = Mode::NotActive;
+    _setpoint.mode = Mode::NotActive;
+
+    if (_streaming_rate_hz > 0.0) {
+        _setpoint_mailbox.write(_setpoint);
+    }
 }
 
 Offboard::Result
@@ -2,7 +2,9 @@
 
 #include <mutex>
 
+#include "mailbox.h"
 #include "mavlink_include.h"
+#include "periodic_thread.h"
 #include "plugins/offboard/offboard.h"
 #include "plugin_impl_base.h"
 #include "system.h"
@@ -38,17 +40,45 @@ public:
     Offboard::Result set_attitude_rate(Offboard::AttitudeRate attitude_rate);
     Offboard::Result set_actuator_control(Offboard::ActuatorControl actuator_control);
 
+    Offboard::Result set_streaming_rate(double rate_hz);
+    std::pair<Offboard::Result, Offboard::StreamingStats> get_streaming_stats();
+
     OffboardImpl(const OffboardImpl&);
     OffboardImpl& operator=(const OffboardImpl&) = delete;
 
 private:
-    Offboard::Result send_position_ned();
-    Offboard::Result send_velocity_ned();
-    Offboard::Result send_position_velocity_ned();
-    Offboard::Result send_velocity_body();
-    Offboard::Result send_attitude_rate();
-    Offboard::Result send_attitude();
-    Offboard::Result send_actuator_control();
+    enum class Mode {
+        NotActive,
+        PositionNed,
+        VelocityNed,
+        PositionVelocityNed,
+        VelocityBody,
+        Attitude,
+        AttitudeRate,
+        ActuatorControl
+    };
+
+    struct Setpoint {
+        Mode mode{Mode::NotActive};
+        Offboard::PositionNedYaw position_ned_yaw{};
+        Offboard::VelocityNedYaw velocity_ned_yaw{};
+        Offboard::VelocityBodyYawspeed velocity_body_yawspeed{};
+        Offboard::Attitude attitude{};
+        Offboard::AttitudeRate attitude_rate{};
+        Offboard::ActuatorControl actuator_control{};
+    };
+
+    Offboard::Result send_setpoint(const Setpoint& setpoint);
+    Offboard::Result send_position_ned(const Offboard::PositionNedYaw& position_ned_yaw);
+    Offboard::Result send_velocity_ned(const Offboard::VelocityNedYaw& velocity_ned_yaw);
+    Offboard::Result send_position_velocity_ned(
+        const Offboard::PositionNedYaw& position_ned_yaw,
+        const Offboard::VelocityNedYaw& velocity_ned_yaw);
+    Offboard::Result
+    send_velocity_body(const Offboard::VelocityBodyYawspeed& velocity_body_yawspeed);
+    Offboard::Result send_attitude_rate(const Offboard::AttitudeRate& attitude_rate);
+    Offboard::Result send_attitude(const Offboard::Attitude& attitude);
+    Offboard::Result send_actuator_control(Offboard::ActuatorControl actuator_control);
     Offboard::Result send_actuator_control_message(const float* controls, uint8_t group_number = 0);
 
     void process_heartbeat(const mavlink_message_t& message);
@@ -58,32 +88,34 @@ private:
     static Offboard::Result
     offboard_result_from_command_result(MavlinkCommandSender::Result result);
 
+    // Assumes to have the lock for _mutex.
+    // Returns false if the setpoint is left to the streaming thread.
+    bool update_setpoint(Mode mode);
     void stop_sending_setpoints();
 
+    void send_current_setpoint();
+    void stream_setpoint();
+
     Time _time{};
 
     mutable std::mutex _mutex{};
-    enum class Mode {
-        NotActive,
-        PositionNed,
-        VelocityNed,
-        PositionVelocityNed,
-        VelocityBody,
-        Attitude,
-        AttitudeRate,
-        ActuatorControl
-    } _mode = Mode::NotActive;
-    Offboard::PositionNedYaw _position_ned_yaw{};
-    Offboard::VelocityNedYaw _velocity_ned_yaw{};
-    Offboard::VelocityBodyYawspeed _velocity_body_yawspeed{};
-    Offboard::Attitude _attitude{};
-    Offboard::AttitudeRate _attitude_rate{};
-    Offboard::ActuatorControl _actuator_control{};
+    Setpoint _setpoint{};
     dl_time_t _last_started{};
 
     void* _call_every_cookie = nullptr;
 
     const float SEND_INTERVAL_S = 0.05f;
+
+    // Instead of the call every handler, setpoints can be sent from a
+    // thread of their own, which is not held up by other work.
+    double _streaming_rate_hz{0.0};
+    Mailbox<Setpoint> _setpoint_mailbox{};
+    // Only used by the streaming thread.
+    Setpoint _streamed_setpoint{};
+    // Declared last, so it is stopped before what it uses is destroyed.
+    PeriodicThread _streaming_thread{};
+
+    static constexpr double MAX_STREAMING_RATE_HZ = 1000.0;
 };
 
 } // namespace mavsdk
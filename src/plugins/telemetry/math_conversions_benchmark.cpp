@@ -0,0 +1,37 @@
+#include "math_conversions.h"
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+static void BM_MathConversionsQuaternionToEuler(benchmark::State& state)
+{
+    Telemetry::Quaternion quaternion;
+    quaternion.w = 0.8536f;
+    quaternion.x = 0.1464f;
+    quaternion.y = 0.3536f;
+    quaternion.z = 0.3536f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(quaternion);
+        benchmark::DoNotOptimize(to_euler_angle_from_quaternion(quaternion));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MathConversionsQuaternionToEuler);
+
+static void BM_MathConversionsEulerToQuaternion(benchmark::State& state)
+{
+    Telemetry::EulerAngle euler_angle;
+    euler_angle.roll_deg = 10.0f;
+    euler_angle.pitch_deg = 20.0f;
+    euler_angle.yaw_deg = 30.0f;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(euler_angle);
+        benchmark::DoNotOptimize(to_quaternion_from_euler_angle(euler_angle));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MathConversionsEulerToQuaternion);
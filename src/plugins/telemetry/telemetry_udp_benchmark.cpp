@@ -0,0 +1,93 @@
+#include "mavsdk.h"
+#include "plugins/telemetry/telemetry.h"
+#include "udp_connection.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+using namespace mavsdk;
+
+// Messages from a fake autopilot through a loopback UDP connection, all the
+// way up to the Telemetry callbacks of the user.
+static void BM_TelemetryUdpAttitudeQuaternion(benchmark::State& state)
+{
+    constexpr int mavsdk_port = 24540;
+    constexpr int autopilot_port = 24541;
+    // Batches stay below 100, the user callback queue drops callbacks beyond that.
+    const auto batch_size = static_cast<unsigned>(state.range(0));
+
+    Mavsdk mavsdk;
+    if (mavsdk.add_udp_connection("127.0.0.1", mavsdk_port) != ConnectionResult::Success) {
+        state.SkipWithError("Could not add connection");
+        return;
+    }
+
+    UdpConnection autopilot([](mavlink_message_t&) {}, "127.0.0.1", autopilot_port);
+    if (autopilot.start() != ConnectionResult::Success) {
+        state.SkipWithError("Could not start fake autopilot");
+        return;
+    }
+    autopilot.add_remote("127.0.0.1", mavsdk_port);
+
+    mavlink_message_t heartbeat;
+    mavlink_msg_heartbeat_pack(
+        1, 1, &heartbeat, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+
+    for (unsigned i = 0; i < 100 && mavsdk.systems().empty(); ++i) {
+        autopilot.send_message(heartbeat);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    if (mavsdk.systems().empty()) {
+        state.SkipWithError("System not discovered");
+        return;
+    }
+
+    auto telemetry = std::make_shared<Telemetry>(mavsdk.systems().at(0));
+    std::atomic<uint64_t> num_received{0};
+    telemetry->subscribe_attitude_quaternion(
+        [&num_received](Telemetry::Quaternion) { ++num_received; });
+
+    std::vector<mavlink_message_t> batch(batch_size);
+    uint64_t num_sent = 0;
+    uint64_t num_lost = 0;
+
+    for (auto _ : state) {
+        for (auto& message : batch) {
+            mavlink_msg_attitude_quaternion_pack(
+                1,
+                1,
+                &message,
+                static_cast<uint32_t>(num_sent),
+                1.0f,
+                0.0f,
+                0.0f,
+                0.0f,
+                0.1f,
+                0.2f,
+                0.3f,
+                nullptr);
+            ++num_sent;
+        }
+        autopilot.send_messages(batch);
+
+        // Wait until the batch is through, UDP might drop some.
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+        while (num_received + num_lost < num_sent) {
+            if (std::chrono::steady_clock::now() > timeout) {
+                num_lost = num_sent - num_received;
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    telemetry->subscribe_attitude_quaternion(nullptr);
+    autopilot.stop();
+
+    state.SetItemsProcessed(static_cast<int64_t>(num_received.load()));
+    state.counters["lost"] = static_cast<double>(num_lost);
+}
+BENCHMARK(BM_TelemetryUdpAttitudeQuaternion)->Arg(1)->Arg(20)->UseRealTime();